@@ -0,0 +1,442 @@
+/** @file
+
+MODULE				: MotionEstimatorBenchmark
+
+TAG						: MEB
+
+FILE NAME			: MotionEstimatorBenchmark.cpp
+
+DESCRIPTION		: Benchmark and quality harness for the IMotionEstimator
+                implementations. Each estimator is run on the same luminance
+                frames read from a raw YUV 4:2:0 file and the speed, the block
+                metric evaluations, the distortion and the agreement of the
+                vectors with the full search estimator are written as comma
+                separated values to stdout.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <math.h>
+#include <chrono>
+
+#include "YuvRawFileHandler.h"
+#include "VectorStructList.h"
+#include "OverlayMem2Dv2.h"
+#include "OverlayExtMem2Dv2.h"
+#include "MacroBlockH264.h"
+#include "H263MotionVectorPredictorImpl1.h"
+#include "H264MotionVectorPredictorImpl1.h"
+#include "H264RefFrameStore.h"
+
+#include "MotionEstimatorH263ImplStd.h"
+#include "MotionEstimatorH263ImplUnres.h"
+#include "MotionEstimatorH263ImplE3SS.h"
+#include "MotionEstimatorH263ImplMultiresCross.h"
+#include "MotionEstimatorH263ImplMultiresCrossVer2.h"
+#include "MotionEstimatorH264ImplFull.h"
+#include "MotionEstimatorH264ImplCross.h"
+#include "MotionEstimatorH264ImplFHS.h"
+#include "MotionEstimatorH264ImplUMHS.h"
+#include "MotionEstimatorH264ImplMultires.h"
+#include "MotionEstimatorH264ImplMultiresCross.h"
+#include "MotionEstimatorH264ImplMultiresCrossVer2.h"
+#include "MotionEstimatorH264ImplTest.h"
+#include "MotionEstimatorH264ImplPartition.h"
+#include "MotionEstimatorH264ImplMultiRef.h"
+
+/*
+--------------------------------------------------------------------------
+  Constants. 
+--------------------------------------------------------------------------
+*/
+/// Estimators in the order that they are run. The full search estimator must
+/// be first as it is the reference for the vector agreement.
+#define MEB_H264_FULL									0
+#define MEB_H264_CROSS								1
+#define MEB_H264_FHS									2
+#define MEB_H264_UMHS									3
+#define MEB_H264_MULTIRES							4
+#define MEB_H264_MULTIRESCROSS				5
+#define MEB_H264_MULTIRESCROSSVER2		6
+#define MEB_H264_TEST									7
+#define MEB_H264_PARTITION						8
+#define MEB_H264_MULTIREF							9
+#define MEB_H263_STD									10
+#define MEB_H263_UNRES								11
+#define MEB_H263_E3SS									12
+#define MEB_H263_MULTIRESCROSS				13
+#define MEB_H263_MULTIRESCROSSVER2		14
+#define MEB_NUM_ESTIMATORS						15
+
+static const char* MEB_Names[MEB_NUM_ESTIMATORS] = 
+{
+	"H264ImplFull", "H264ImplCross", "H264ImplFHS", "H264ImplUMHS", "H264ImplMultires", 
+	"H264ImplMultiresCross", "H264ImplMultiresCrossVer2", "H264ImplTest", "H264ImplPartition", 
+	"H264ImplMultiRef", "H263ImplStd", "H263ImplUnres", "H263ImplE3SS", "H263ImplMultiresCross",
+	"H263ImplMultiresCrossVer2"
+};
+
+/// H.263 vectors are in 1/2 pel units and are scaled to the 1/4 pel units of H.264.
+#define MEB_IS_H263(id)								((id) >= MEB_H263_STD)
+
+/// Boundary around the distortion ref to hold blocks of the longest vectors.
+#define MEB_BOUNDARY									19
+
+/*
+--------------------------------------------------------------------------
+  Helpers. 
+--------------------------------------------------------------------------
+*/
+
+/** Instantiate an estimator with its predictor.
+The predictor and the ref store are only created for the estimators that
+require them and must be deleted by the caller.
+@param id				: Estimator id.
+@param pSrc			: Source image that is estimated.
+@param pRef			: Reference image.
+@param width		: Image dimensions.
+@param height		:
+@param range		: Full pel motion range.
+@param pMb			: Macroblocks of the frame for the H.264 predictor.
+@param pIncluded	: Flag per macroblock to include in the estimator distortion.
+@param ppPred		: Returned predictor or NULL.
+@param ppStore	: Returned ref store or NULL.
+@return					: The estimator or NULL if it failed to create.
+*/
+static IMotionEstimator* CreateEstimator(int id, short* pSrc, short* pRef, int width, int height, int range, 
+																				 MacroBlockH264* pMb, bool* pIncluded, IMotionVectorPredictor** ppPred, H264RefFrameStore** ppStore)
+{
+	IMotionEstimator* pME = NULL;
+	int r263 = 2 * range;	///< 1/2 pel units.
+	int r264 = 4 * range;	///< 1/4 pel units.
+
+	*ppPred		= NULL;
+	*ppStore	= NULL;
+	if(MEB_IS_H263(id))
+		*ppPred = new H263MotionVectorPredictorImpl1(width, height);
+	else
+		*ppPred = new H264MotionVectorPredictorImpl1(pMb);
+
+	switch(id)
+	{
+	case MEB_H264_FULL:
+		pME = new MotionEstimatorH264ImplFull(pSrc, pRef, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H264_CROSS:
+		pME = new MotionEstimatorH264ImplCross(pSrc, pRef, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H264_FHS:
+		pME = new MotionEstimatorH264ImplFHS(pSrc, pRef, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H264_UMHS:
+		pME = new MotionEstimatorH264ImplUMHS(pSrc, pRef, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H264_MULTIRES:
+		pME = new MotionEstimatorH264ImplMultires(pSrc, pRef, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H264_MULTIRESCROSS:
+		pME = new MotionEstimatorH264ImplMultiresCross(pSrc, pRef, width, height, r264, pIncluded);
+		break;
+	case MEB_H264_MULTIRESCROSSVER2:
+		pME = new MotionEstimatorH264ImplMultiresCrossVer2(pSrc, pRef, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H264_TEST:
+		pME = new MotionEstimatorH264ImplTest(pSrc, pRef, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H264_PARTITION:
+		pME = new MotionEstimatorH264ImplPartition(pSrc, pRef, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H264_MULTIREF:
+		*ppStore = new H264RefFrameStore();
+		if(!(*ppStore)->Create(width, height, 1))
+			return(NULL);
+		pME = new MotionEstimatorH264ImplMultiRef(pSrc, *ppStore, width, height, r264, *ppPred, pIncluded);
+		break;
+	case MEB_H263_STD:	///< Fixed range.
+		pME = new MotionEstimatorH263ImplStd(pSrc, pRef, width, height);
+		break;
+	case MEB_H263_UNRES:
+		pME = new MotionEstimatorH263ImplUnres(pSrc, pRef, width, height, r263, pIncluded);
+		break;
+	case MEB_H263_E3SS:
+		pME = new MotionEstimatorH263ImplE3SS(pSrc, pRef, width, height, r263);
+		break;
+	case MEB_H263_MULTIRESCROSS:
+		pME = new MotionEstimatorH263ImplMultiresCross(pSrc, pRef, width, height, r263, pIncluded);
+		break;
+	case MEB_H263_MULTIRESCROSSVER2:
+		pME = new MotionEstimatorH263ImplMultiresCrossVer2(pSrc, pRef, width, height, r263, *ppPred, pIncluded);
+		break;
+	}//end switch id...
+
+	if(pME == NULL)
+		return(NULL);
+	if(!pME->Create())
+	{
+		delete pME;
+		return(NULL);
+	}//end if !Create...
+
+	return(pME);
+}//end CreateEstimator.
+
+/** Total square difference of the motion compensated 16x16 block.
+@param pIn		: Input overlay set to the block origin.
+@param pRef		: Extended ref overlay.
+@param pBlk		: 16x16 temp block.
+@param x			: Block origin.
+@param y			:
+@param mvx		: Vector in 1/4 pel units.
+@param mvy		:
+@return				: Total square diff.
+*/
+static int CompensatedTsd(OverlayMem2Dv2* pIn, OverlayExtMem2Dv2* pRef, OverlayMem2Dv2* pBlk, int x, int y, int mvx, int mvy)
+{
+	int fx = (mvx >= 0) ? (mvx/4) : -((3 - mvx)/4);	///< Floor to full pel.
+	int fy = (mvy >= 0) ? (mvy/4) : -((3 - mvy)/4);
+	pRef->SetOrigin(x + fx, y + fy);
+	pRef->QuarterRead(*pBlk, mvx - (4 * fx), mvy - (4 * fy));
+	return(pIn->Tsd16x16(*pBlk));
+}//end CompensatedTsd.
+
+/*
+--------------------------------------------------------------------------
+  Main. 
+--------------------------------------------------------------------------
+*/
+
+int main(int argc, char* argv[])
+{
+	if(argc < 4)
+	{
+		fprintf(stderr, "Usage: %s <file.yuv> <width> <height> [frames] [range]\n", argv[0]);
+		fprintf(stderr, "  Raw 8-bit YUV 4:2:0 planar input. The full pel motion range defaults to 16.\n");
+		return(1);
+	}//end if argc...
+
+	int width			= atoi(argv[2]);
+	int height		= atoi(argv[3]);
+	int frames		= (argc > 4) ? atoi(argv[4]) : 10;
+	int range			= (argc > 5) ? atoi(argv[5]) : 16;
+	if( (width <= 0)||(height <= 0)||((width % 16) != 0)||((height % 16) != 0)||(range < 1)||(range > 16) )
+	{
+		fprintf(stderr, "Dimensions must be multiples of 16 and the range in [1..16]\n");
+		return(1);
+	}//end if width...
+
+	/// --------------- Load the luminance of the frames -----------------------
+	int frameLen = (width * height) + ((width * height)/2);
+	FILE* pF = fopen(argv[1], "rb");
+	if(pF == NULL)
+	{
+		fprintf(stderr, "Cannot open %s\n", argv[1]);
+		return(1);
+	}//end if !pF...
+	fseek(pF, 0, SEEK_END);
+	int available = (int)(ftell(pF) / frameLen);
+	fclose(pF);
+	if(frames > available)
+		frames = available;
+	if(frames < 2)
+	{
+		fprintf(stderr, "At least 2 frames are required\n");
+		return(1);
+	}//end if frames...
+
+	YuvRawFileHandler yuv;
+	yuv.SetWidth(width);
+	yuv.SetHeight(height);
+	yuv.SetType(YuvRawFileHandler::YUV4208P, YuvRawFileHandler::YUV42016P);
+	if(!yuv.Open(argv[1], RawFileHandlerBase::READ))
+	{
+		fprintf(stderr, "Cannot read %s\n", argv[1]);
+		return(1);
+	}//end if !Open...
+
+	int		lumLen	= width * height;
+	short* pLum		= new short[frames * lumLen];
+	for(int f = 0; f < frames; f++)
+	{
+		int len;
+		short* pUnit = (short *)yuv.GetNextUnit(&len);
+		memcpy((void *)&(pLum[f * lumLen]), (const void *)pUnit, lumLen * sizeof(short));
+	}//end for f...
+	yuv.Close();
+
+	/// --------------- Working mem ------------------------------------------
+	int mbCols	= width/16;
+	int mbRows	= height/16;
+	int numMbs	= mbCols * mbRows;
+	int pairs		= frames - 1;
+
+	short* pSrc = new short[lumLen];
+	short* pRef = new short[lumLen];
+
+	/// Distortion is measured on the same interpolated ref for every estimator.
+	int extWidth	= width + (2 * MEB_BOUNDARY);
+	int extHeight	= height + (2 * MEB_BOUNDARY);
+	short* pExt		= new short[extWidth * extHeight];
+	short* pBlkMem	= new short[16 * 16];
+	OverlayExtMem2Dv2 extOver(pExt, extWidth, extHeight, 16, 16, MEB_BOUNDARY, MEB_BOUNDARY);
+	OverlayMem2Dv2 inOver(pSrc, width, height, 16, 16);
+	OverlayMem2Dv2 blkOver(pBlkMem, 16, 16, 16, 16);
+
+	/// Full search vectors for every frame pair.
+	int* pFullMv = new int[pairs * numMbs * 2];
+
+	MacroBlockH264*		pMb		= new MacroBlockH264[numMbs];
+	MacroBlockH264**	ppMb	= new MacroBlockH264*[mbRows];
+	for(int i = 0; i < mbRows; i++)
+		ppMb[i] = &(pMb[i * mbCols]);
+
+	bool* pIncluded = new bool[numMbs];
+	for(int i = 0; i < numMbs; i++)
+		pIncluded[i] = true;
+
+	bool counts = (OverlayMem2Dv2::CountsEvaluations() != 0);
+
+	printf("estimator,frames,macroblocks,ns_per_mb,evals_per_mb,avg_tsd,est_avg_distortion,agree,agree_1pel\n");
+	for(int id = 0; id < MEB_NUM_ESTIMATORS; id++)
+	{
+		MacroBlockH264::Initialise(mbRows, mbCols, 0, numMbs - 1, 0, ppMb);
+
+		IMotionVectorPredictor* pPred		= NULL;
+		H264RefFrameStore*			pStore	= NULL;
+		IMotionEstimator* pME = CreateEstimator(id, pSrc, pRef, width, height, range, pMb, pIncluded, &pPred, &pStore);
+		if(pME == NULL)
+		{
+			fprintf(stderr, "%s failed to create\n", MEB_Names[id]);
+			if(pPred != NULL)		delete pPred;
+			if(pStore != NULL)	delete pStore;
+			continue;
+		}//end if !pME...
+
+		long long totalNs		= 0;
+		long long evals			= 0;
+		double		totalTsd	= 0.0;
+		double		totalEst	= 0.0;
+		int				agree			= 0;
+		int				agree1		= 0;
+		for(int f = 0; f < pairs; f++)
+		{
+			memcpy((void *)pRef, (const void *)&(pLum[f * lumLen]), lumLen * sizeof(short));
+			memcpy((void *)pSrc, (const void *)&(pLum[(f + 1) * lumLen]), lumLen * sizeof(short));
+
+			/// Only the estimation is timed. The store insertion is included as the
+			/// other estimators extend their refs within Estimate().
+			long avgDist = 0;
+			OverlayMem2Dv2::ResetEvaluations();
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			if(pStore != NULL)
+				pStore->Insert(pRef);
+			VectorStructList* pMv = (VectorStructList *)pME->Estimate(&avgDist);
+			totalNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			evals += OverlayMem2Dv2::GetEvaluations();
+			totalEst += (double)avgDist;
+
+			/// Measure on a common footing.
+			for(int y = 0; y < height; y++)
+				memcpy((void *)&(pExt[((y + MEB_BOUNDARY) * extWidth) + MEB_BOUNDARY]), (const void *)&(pRef[y * width]), width * sizeof(short));
+			extOver.FillBoundaryProxy();
+
+			for(int mb = 0; mb < numMbs; mb++)
+			{
+				int mvx, mvy;
+				if(pMv->GetType() == VectorStructList::COMPLEX2D)	///< The 16x16 partition vector is first.
+				{
+					mvx = pMv->GetComplexElement(mb, 0, 0);
+					mvy = pMv->GetComplexElement(mb, 0, 1);
+				}//end if COMPLEX2D...
+				else
+				{
+					mvx = pMv->GetSimpleElement(mb, 0);
+					mvy = pMv->GetSimpleElement(mb, 1);
+				}//end else...
+				if(MEB_IS_H263(id))
+				{
+					mvx *= 2;
+					mvy *= 2;
+				}//end if H263...
+
+				int x = (mb % mbCols) * 16;
+				int y = (mb / mbCols) * 16;
+				inOver.SetOrigin(x, y);
+				totalTsd += (double)CompensatedTsd(&inOver, &extOver, &blkOver, x, y, mvx, mvy);
+
+				int* pFull = &(pFullMv[((f * numMbs) + mb) * 2]);
+				if(id == MEB_H264_FULL)
+				{
+					pFull[0] = mvx;
+					pFull[1] = mvy;
+				}//end if full...
+				int dx = mvx - pFull[0];
+				int dy = mvy - pFull[1];
+				if( (dx == 0)&&(dy == 0) )
+					agree++;
+				if( (dx >= -4)&&(dx <= 4)&&(dy >= -4)&&(dy <= 4) )
+					agree1++;
+			}//end for mb...
+		}//end for f...
+
+		double mbs = (double)pairs * (double)numMbs;
+		printf("%s,%d,%d,%.1f,", MEB_Names[id], frames, numMbs, (double)totalNs / mbs);
+		if(counts)
+			printf("%.1f,", (double)evals / mbs);
+		else
+			printf("-1,");	///< Not built with OM2DV2_COUNT_EVALUATIONS.
+		printf("%.1f,%.1f,%.4f,%.4f\n", totalTsd / mbs, totalEst / (double)pairs, (double)agree / mbs, (double)agree1 / mbs);
+		fflush(stdout);
+
+		delete pME;
+		delete pPred;
+		if(pStore != NULL)
+			delete pStore;
+	}//end for id...
+
+	delete[] pIncluded;
+	delete[] pFullMv;
+	delete[] ppMb;
+	delete[] pMb;
+	delete[] pBlkMem;
+	delete[] pExt;
+	delete[] pRef;
+	delete[] pSrc;
+	delete[] pLum;
+	return(0);
+}//end main.
+
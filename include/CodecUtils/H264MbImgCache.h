@@ -45,6 +45,7 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #pragma once
 
 #include "OverlayMem2Dv2.h"
+#include "ViewMem2Dv2.h"
 #include "MacroBlockH264.h"
 
 /*
@@ -61,7 +62,7 @@ public:
 /// Cache operations.
 public:
 	/** Create mem container.
-	Set the mem for a 16x16 lum and two 8x8 chr blocks with their overlays.
+	Set the views onto the member mem for a 16x16 lum and two 8x8 chr blocks.
 	@return			: 1 = success, 0 = failed.
 	*/
 	int Create(void);
@@ -106,9 +107,9 @@ public:
 
 /// Member access.
 public:
-	OverlayMem2Dv2*	GetLumCache(void)		{ return(_lum16x16); }
-	OverlayMem2Dv2*	GetCbCache(void)		{ return(_cb8x8); }
-	OverlayMem2Dv2*	GetCrCache(void)		{ return(_cr8x8); }
+	const ViewMem2Dv2&	GetLumCache(void)		{ return(_lum16x16); }
+	const ViewMem2Dv2&	GetCbCache(void)		{ return(_cb8x8); }
+	const ViewMem2Dv2&	GetCrCache(void)		{ return(_cr8x8); }
 
 /// Private methods.
 protected:
@@ -121,13 +122,14 @@ protected:
   OverlayMem2Dv2* _cb;
   OverlayMem2Dv2* _cr;
 
-  /// Cache blocks and overlays.
-  short*          _plumCache;
-  OverlayMem2Dv2* _lum16x16;
-  short*          _pCbCache;
-  OverlayMem2Dv2* _cb8x8;
-  short*          _pCrCache;
-  OverlayMem2Dv2* _cr8x8;
+  /// Cache blocks and their views. The mem is held in the object so the
+  /// per mb operations are free of heap and row table indirection.
+  short           _lumCache[256];
+  ViewMem2Dv2     _lum16x16;
+  short           _cbCache[64];
+  ViewMem2Dv2     _cb8x8;
+  short           _crCache[64];
+  ViewMem2Dv2     _cr8x8;
 
 };// end class H264MbImgCache.
 
@@ -0,0 +1,154 @@
+/** @file
+
+MODULE				: H264MotionSearchStats
+
+TAG						: H264MSS
+
+FILE NAME			: H264MotionSearchStats.h
+
+DESCRIPTION		: Online statistics of the final 16x16 motion search distortions
+                and vectors of a sequence. The distribution of the best 
+                distortions over the frame and a per macroblock region 
+                history give early termination thresholds for the pattern
+                searches that adapt to the content and the QP, and the
+                vector spread gives a search depth for multiresolution 
+                estimators.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _H264MOTIONSEARCHSTATS_H
+#define _H264MOTIONSEARCHSTATS_H
+
+#pragma once
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class H264MotionSearchStats
+{
+public:
+	H264MotionSearchStats(void);
+	virtual ~H264MotionSearchStats(void);
+
+/// Interface.
+public:
+	/** Create the statistics for a frame size.
+	@param mbCols	: Num of macroblock columns in the image.
+	@param mbRows	: Num of macroblock rows in the image.
+	@return				: 1 = success, 0 = failed.
+	*/
+	int   Create(int mbCols, int mbRows);
+	void  Destroy(void);
+
+	/** Forget the sequence history.
+	Typically called on a scene change. Until the next Update() the thresholds
+  revert to the defaults given by the estimator.
+	@return	: none.
+	*/
+	void  Reset(void);
+
+	/** Record the final search result of a macroblock.
+	Macroblocks that bypassed the search should not be added.
+	@param vecPos	: Macroblock position in raster order.
+	@param dist		: Final distortion of the selected vector.
+	@param mvx		: Selected vector in 1/4 pel units.
+	@param mvy		:
+	@return				: none.
+	*/
+	void  Add(int vecPos, int dist, int mvx, int mvy);
+
+	/** Fold the recorded frame into the sequence statistics.
+	Must be called once per frame after the estimation is complete.
+	@return	: none.
+	*/
+	void  Update(void);
+
+	/** Get an early termination threshold for a macroblock.
+	The sequence threshold is the running lower quartile of the final distortions
+  doubled for every search level and capped at the running upper quartile. It is 
+  further limited by the region history of the macroblock so that easy regions 
+  are not accepted at a worse distortion than they usually achieve. The result is 
+  never below 1/4 of the quantisation noise energy of the QP.
+	@param vecPos				: Macroblock position in raster order.
+	@param level				: Search depth [0 = local refinement only, 1 = short search, 2 = wide search].
+	@param defThreshold	: Returned until there is a sequence history.
+	@return							: Threshold below which the search may terminate.
+	*/
+	int   GetThreshold(int vecPos, int level, int defThreshold);
+
+	/** Choose a multiresolution search depth from the vector spread.
+	Level 2 is chosen when more than 1/10 of the searched macroblocks had vectors
+  beyond 3/4 of the reach set with SetReach() or when the upper quartile distortion
+  of the last frame jumped to above 4 times its running average. It returns to 
+  level 1 when fewer than 1/50 exceed 1/2 of the reach.
+	@param level	: Current level {1, 2}.
+	@return				: Recommended level {1, 2}.
+	*/
+	int   GetSearchLevel(int level);
+
+	/// Member access.
+	bool  Ready(void)							{ return(_pFrameDist != NULL); }
+	bool  Learned(void)						{ return(_frames > 0); }
+	void  SetQP(int qp)						{ _qp = qp; }
+	void  SetReach(int reach)			{ _reach = reach; }	///< Level 1 search reach in full pels.
+	int   GetLowQuartile(void)		{ return(_seqLow); }
+	int   GetHighQuartile(void)		{ return(_seqHigh); }
+
+/// Private methods.
+protected:
+	void  ResetMembers(void);
+
+/// Private members.
+protected:
+	int   _mbCols;
+	int   _mbRows;
+	int   _qp;
+	int   _frames;			///< Num of frames folded into the sequence statistics.
+
+	/// Current frame records.
+	int*  _pFrameDist;	///< Final distortions in the order added.
+	int*  _pFrameMag;		///< Max abs vector component in full pels in the order added.
+	int   _frameCount;
+
+	/// Sequence statistics as running averages.
+	int*  _pRegion;			///< Per macroblock final distortion. Negative = no history.
+	int   _seqLow;			///< Lower quartile final distortion.
+	int   _seqHigh;			///< Upper quartile final distortion.
+	int   _farHalf;			///< Num of vectors beyond 1/2 reach per 1024 macroblocks.
+	int   _farThreeQuart;	///< Num of vectors beyond 3/4 reach per 1024 macroblocks.
+	int   _reach;				///< Level 1 search reach in full pels.
+	bool  _distJump;		///< The last frame distortion jumped.
+};//end H264MotionSearchStats.
+
+#endif	// _H264MOTIONSEARCHSTATS_H
+
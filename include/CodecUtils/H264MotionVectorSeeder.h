@@ -0,0 +1,158 @@
+/** @file
+
+MODULE				: H264MotionVectorSeeder
+
+TAG						: H264MVS
+
+FILE NAME			: H264MotionVectorSeeder.h
+
+DESCRIPTION		: A class to generate EPZS-style spatial and temporal full pel 
+                candidate motion vectors to seed H.264 16x16 motion estimator 
+                searches. The temporal candidates are drawn from a two frame 
+                history of the previously encoded macroblock motion field and
+                include an accelerated motion candidate. An adaptive early 
+                termination threshold is derived from the neighbourhood 
+                distortions.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _H264MOTIONVECTORSEEDER_H
+#define _H264MOTIONVECTORSEEDER_H
+
+#pragma once
+
+#include "VectorStructList.h"
+#include "MacroBlockH264.h"
+
+/*
+---------------------------------------------------------------------------
+	Struct definition.
+---------------------------------------------------------------------------
+*/
+typedef struct _H264MVS_COORD
+{
+	short int x;
+	short int y;
+} H264MVS_COORD;
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class H264MotionVectorSeeder
+{
+public:
+	H264MotionVectorSeeder(void);
+	virtual ~H264MotionVectorSeeder(void);
+
+/// Interface.
+public:
+	/** Create the motion field history.
+	Two frames of 16x16 motion vectors and distortions are held, one entry per
+  macroblock.
+	@param mbCols	: Num of macroblock columns in the image.
+	@param mbRows	: Num of macroblock rows in the image.
+	@return				: 1 = success, 0 = failed.
+	*/
+	int   Create(int mbCols, int mbRows);
+	void  Destroy(void);
+
+	/** Forget the motion field history.
+	Typically called on a scene change where the previous motion is no longer
+  a good predictor. The mem is retained.
+	@return	: none.
+	*/
+	void  Reset(void);
+
+	/** Roll the motion field history.
+	Must be called once per frame before the estimation starts. The previous frame 
+  motion field moves to the frame before that and is replaced by the 16x16 vectors 
+  and distortions of the previously encoded frame macroblocks. Intra macroblocks 
+  are marked as having no valid vector.
+	@param pPrevFrmMBlk	: Macroblocks of the previously encoded frame in raster order.
+	@return							: none.
+	*/
+	void  Update(MacroBlockH264* pPrevFrmMBlk);
+
+	/** Load the seed candidates for a macroblock.
+	The candidates are the unique full pel vectors of the current frame left, above and
+  above right neighbours (already estimated in raster order), the previous frame 
+  co-located vector and its four neighbours and the accelerated co-located motion 
+  vector. The zero vector and the predicted vector are excluded as the estimators test
+  them as a matter of course.
+	@param vecPos		: Macroblock position in raster order.
+	@param pCurr		: The current frame motion vector list being estimated in 1/4 pel units.
+	@param predX0		: Full pel predicted vector.
+	@param predY0		:
+	@param list			: Returned candidates in full pel units with at least MaxCandidates entries.
+	@return					: Num of candidates loaded into the list.
+	*/
+	int   GetCandidates(int vecPos, VectorStructList* pCurr, int predX0, int predY0, H264MVS_COORD* list);
+
+	/** Get the adaptive early termination threshold for a macroblock.
+	The threshold scales the smallest of the predicted neighbourhood distortion and the 
+  previous frame co-located distortion. Without any history the min threshold is returned.
+	@param vecPos				: Macroblock position in raster order.
+	@param predD				: Predicted distortion from the current frame neighbourhood (0 = not available).
+	@param minThreshold	: Lower bound.
+	@param maxThreshold	: Upper bound.
+	@return							: Threshold below which the best seed is accepted.
+	*/
+	int   GetThreshold(int vecPos, int predD, int minThreshold, int maxThreshold);
+
+	/// Member access.
+	bool  Ready(void) { return(_pMvX[0] != NULL); }
+
+/// Constants.
+public:
+	static const int MaxCandidates = 9;
+
+/// Private methods.
+protected:
+	/// Add a full pel candidate to the list if it is unique. Returns the new list length.
+	int   AddUnique(int x, int y, int predX0, int predY0, H264MVS_COORD* list, int len);
+
+/// Private members.
+protected:
+	int   _mbCols;
+	int   _mbRows;
+	int   _frames;	///< Num of valid history frames {0, 1, 2}.
+
+	/// [0] = previous frame, [1] = frame before previous. Vectors in 1/4 pel units.
+	int*  _pMvX[2];
+	int*  _pMvY[2];
+	bool* _pValid[2];
+	int*  _pDistortion;	///< Previous frame 16x16 distortion.
+
+};// end class H264MotionVectorSeeder.
+
+#endif	// _H264MOTIONVECTORSEEDER_H
@@ -0,0 +1,163 @@
+/** @file
+
+MODULE				: H264RefFrameStore
+
+TAG						: H264RFS
+
+FILE NAME			: H264RefFrameStore.h
+
+DESCRIPTION		: A store of the last N reconstructed luminance reference frames 
+                for multiple reference frame motion estimation. Each frame is
+                held with its boundary extended for out of picture vectors and
+                with a cached half resolution level of its pyramid, also with
+                an extended boundary, so that the work is done once per frame
+                and shared by all the estimators that search it.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _H264REFFRAMESTORE_H
+#define _H264REFFRAMESTORE_H
+
+#pragma once
+
+#include "OverlayMem2Dv2.h"
+#include "OverlayExtMem2Dv2.h"
+#include "OverlayMem2Dv2u8.h"
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class H264RefFrameStore
+{
+public:
+	H264RefFrameStore(void);
+	virtual ~H264RefFrameStore(void);
+
+/// Interface.
+public:
+	/** Create the store.
+	@param imgWidth		: Luminance width as a multiple of 16.
+	@param imgHeight	: Luminance height as a multiple of 16.
+	@param maxRefs		: Num of reference frames held [1..16].
+	@param pel8				: Hold the references as 8-bit pels instead of 16-bit.
+	@return						: 1 = success, 0 = failed.
+	*/
+	int   Create(int imgWidth, int imgHeight, int maxRefs, int pel8 = 0);
+	void  Destroy(void);
+
+	/** Empty the store.
+	Typically called on an IDR picture. The mem is retained.
+	@return	: none.
+	*/
+	void  Reset(void);
+
+	/** Insert a reconstructed frame as the newest reference.
+	The frame is copied into the slot of the oldest reference when the store is
+  full. Its boundary is extended and its level 1 is subsampled and extended. All
+  reference indices shift up by one so that the new frame is index 0.
+	@param pRecon	: Reconstructed luminance frame of imgWidth x imgHeight.
+	@return				: Num of references held.
+	*/
+	int   Insert(const short* pRecon);
+	int   Insert(const unsigned char* pRecon);
+
+	/** Get the extended boundary level 0 reference.
+	The overlay block dim is 16x16 and its origin is in image coordinates.
+	@param refIdx	: Reference index where 0 is the most recently inserted.
+	@return				: The overlay or NULL if refIdx is not held.
+	*/
+	OverlayExtMem2Dv2* GetRef(int refIdx);
+
+	/** Get the extended boundary level 1 (half resolution) reference.
+	The overlay block dim is 8x8 and its origin is in level 1 image coordinates.
+	@param refIdx	: Reference index where 0 is the most recently inserted.
+	@return				: The overlay or NULL if refIdx is not held.
+	*/
+	OverlayExtMem2Dv2* GetRefL1(int refIdx);
+
+	/** Get the 8-bit extended boundary level 0 and level 1 references.
+	Only valid when created with pel8. The overlay block dims and origins are as
+	for GetRef() and GetRefL1().
+	@param refIdx	: Reference index where 0 is the most recently inserted.
+	@return				: The overlay or NULL if refIdx is not held.
+	*/
+	OverlayMem2Dv2u8* GetRefPel8(int refIdx);
+	OverlayMem2Dv2u8* GetRefL1Pel8(int refIdx);
+
+	/// Member access.
+	bool  Ready(void)							{ return( (_ppExtOver != NULL)||(_ppExtOver8 != NULL) ); }
+	int   IsPel8(void)						{ return(_pel8); }
+	int   GetNumRefs(void)				{ return(_numRefs); }
+	int   GetMaxRefs(void)				{ return(_maxRefs); }
+	int   GetWidth(void)					{ return(_imgWidth); }
+	int   GetHeight(void)					{ return(_imgHeight); }
+	int   GetBoundary(void)				{ return(_boundary); }		///< Level 0 extension in pels.
+	int   GetL1Boundary(void)			{ return(_l1Boundary); }	///< Level 1 extension in pels.
+
+/// Private methods.
+protected:
+	void  ResetMembers(void);
+	int   InsertPel8(void);
+	/// Slot holding a reference index.
+	int   Slot(int refIdx) { return((_newest + _maxRefs - refIdx) % _maxRefs); }
+
+/// Private members.
+protected:
+	int   _imgWidth;
+	int   _imgHeight;
+	int   _maxRefs;
+	int   _numRefs;
+	int   _newest;			///< Slot of reference index 0.
+	int   _boundary;
+	int   _l1Boundary;
+	int   _pel8;
+
+	/// Per slot extended level 0 and level 1 mem and their overlays.
+	short**							_ppExtMem;
+	OverlayExtMem2Dv2**	_ppExtOver;
+	short**							_ppL1Mem;
+	OverlayExtMem2Dv2**	_ppL1Over;
+
+	/// Per slot 8-bit mem and overlays when created with pel8.
+	unsigned char**			_ppExtMem8;
+	OverlayMem2Dv2u8**	_ppExtOver8;
+	unsigned char**			_ppL1Mem8;
+	OverlayMem2Dv2u8**	_ppL1Over8;
+
+	/// Row addresses of the frame being inserted.
+	short**							_ppRecon;
+	unsigned char**			_ppRecon8;
+};//end H264RefFrameStore.
+
+#endif	// _H264REFFRAMESTORE_H
+
@@ -0,0 +1,116 @@
+/** @file
+
+MODULE				: H264StaticMbDetector
+
+TAG						: H264SMD
+
+FILE NAME			: H264StaticMbDetector.h
+
+DESCRIPTION		: A frame pre-pass that classifies static macroblocks as skip
+								candidates before motion estimation. The (0,0) vector square
+								error of each 16x16 macroblock is measured with an SSE2 path
+								where available and compared against a QP dependent
+								quantisation noise threshold.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _H264STATICMBDETECTOR_H
+#define _H264STATICMBDETECTOR_H
+
+#pragma once
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class H264StaticMbDetector
+{
+public:
+	H264StaticMbDetector(void);
+	virtual ~H264StaticMbDetector(void);
+
+/// Interface.
+public:
+	/** Create the per macroblock classification.
+	@param imgWidth		: Luminance image width as a multiple of 16.
+	@param imgHeight	: Luminance image height as a multiple of 16.
+	@return						: 1 = success, 0 = failed.
+	*/
+	int   Create(int imgWidth, int imgHeight);
+	void  Destroy(void);
+
+	/** Classify every macroblock in the frame.
+	A macroblock is static when its (0,0) vector total square error does not 
+  exceed the quantisation noise energy of a 16x16 block at the given QP. With
+  the MacroBlockH264::SkippedZeroMotionPredCondition() semantics such a block
+  codes as a P_Skip with a zero vector and need not be searched.
+	@param pSrc	: Luminance input image of 16-bit or 8-bit pels.
+	@param pRef	: Luminance reference image of the same pel type.
+	@param qp		: Quantisation parameter [0..51] of the frame to encode.
+	@return			: Num of static macroblocks.
+	*/
+	int   Classify(const short* pSrc, const short* pRef, int qp);
+	int   Classify(const unsigned char* pSrc, const unsigned char* pRef, int qp);
+
+	/// Member access.
+	bool  Ready(void)											{ return(_pStatic != NULL); }
+	bool  IsStatic(int mb)								{ return(_pStatic[mb]); }
+	int   GetZeroVecDistortion(int mb)		{ return(_pZeroVecDiff[mb]); }
+	int   GetStaticCount(void)						{ return(_staticCount); }
+	/// Total square error threshold for a 16x16 block at a QP.
+	static int GetThreshold(int qp);
+
+	/// Total square error of a 16x16 block between two images of the same width.
+	static int Tsd16x16(const short* pA, const short* pB, int width);
+	static int Tsd16x16(const unsigned char* pA, const unsigned char* pB, int width);
+
+/// Private methods.
+protected:
+	void  ResetMembers(void);
+	template<typename T> int ClassifyPels(const T* pSrc, const T* pRef, int qp);
+
+/// Members.
+protected:
+	int			_imgWidth;
+	int			_imgHeight;
+	int			_mbCols;
+	int			_mbRows;
+	int			_staticCount;		///< Result of the last classification.
+
+	bool*		_pStatic;				///< Static flag per macroblock in raster order.
+	int*		_pZeroVecDiff;	///< (0,0) vector total square error per macroblock.
+
+	static const int H264SMD_Threshold[52];
+};//end H264StaticMbDetector.
+
+#endif	// _H264STATICMBDETECTOR_H
+
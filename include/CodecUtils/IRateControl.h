@@ -85,7 +85,12 @@ public:
   virtual void Reset(void) = 0;
 
   /// Intervensions to normal operation.
+  /// The mse and mae are per pel lum errors of the motion compensated (or intra) prediction
+  /// of the next frame at full resolution, the same units as the StoreMeasurements() mse and mae.
   virtual void SignalSceneChange(double mse, double mae) {}
+  /// Complexity of the next frame relative to the frames around it from a lookahead
+  /// analysis. 1.0 is average. Applies to the next PredictDistortion() call only.
+  virtual void SignalComplexity(double ratio) {}
 
   /// Utility function for testing and research data collection.
   virtual void Dump(const char* filename) = 0;
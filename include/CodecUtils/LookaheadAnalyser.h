@@ -0,0 +1,197 @@
+/** @file
+
+MODULE				: LookaheadAnalyser
+
+TAG						: LKA
+
+FILE NAME			: LookaheadAnalyser.h
+
+DESCRIPTION		: A lookahead analysis stage that runs on its own thread,
+								pipelined with the encoder. Incoming luminance frames are
+								downsampled 4x, as for the multiresolution level 2, and a
+								cheap 4x4 block motion search gives per frame inter and
+								intra cost estimates, an intra/inter ratio and a scene cut
+								flag up to N frames ahead for rate control.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _LOOKAHEADANALYSER_H
+#define _LOOKAHEADANALYSER_H
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "OverlayMem2Dv2.h"
+#include "IRateControl.h"
+
+/*
+---------------------------------------------------------------------------
+	Struct definition.
+---------------------------------------------------------------------------
+*/
+/// Analysis results of one frame. Costs are total square errors measured on the
+/// 4x downsampled frame. The mse and mae are per full resolution pel estimates.
+typedef struct _LKA_FRAME_INFO
+{
+	int			frameNum;		///< Push order of the frame from 0.
+	double	interCost;	///< Sum over blocks of the least of inter and intra cost.
+	double	intraCost;	///< Sum over blocks of the intra (block mean) cost.
+	double	intraRatio;	///< Proportion of blocks cheaper to code as intra.
+	double	mse;				///< Per pel square error of the chosen block predictions at full resolution.
+	double	mae;				///< Per pel absolute error of the chosen block predictions at full resolution.
+	bool		sceneCut;		///< First frame of a new scene.
+} LKA_FRAME_INFO;
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class LookaheadAnalyser
+{
+public:
+	LookaheadAnalyser(void);
+	virtual ~LookaheadAnalyser(void);
+
+/// Interface.
+public:
+	/** Create the frame queue and start the analysis thread.
+	@param imgWidth		: Luminance width as a multiple of 16.
+	@param imgHeight	: Luminance height as a multiple of 16.
+	@param depth			: Num of frames that may be queued ahead of the encoder.
+	@return						: 1 = success, 0 = failed.
+	*/
+	int   Create(int imgWidth, int imgHeight, int depth);
+	/// Stop the thread and release the mem. Queued results are discarded.
+	void  Destroy(void);
+
+	/** Queue a luminance frame for analysis.
+	The frame is copied and the call blocks while the queue is full.
+	@param pLum	: Luminance frame of imgWidth x imgHeight.
+	@return			: 1 = queued, 0 = not ready.
+	*/
+	int   Push(const short* pLum);
+
+	/** Remove the results of the oldest queued frame.
+	Blocks until the analysis of that frame is complete.
+	@param pInfo	: Returned results.
+	@return				: 1 = success, 0 = queue is empty.
+	*/
+	int   Pop(LKA_FRAME_INFO* pInfo);
+
+	/** Read the results of a queued frame without removing it.
+	Does not block.
+	@param ahead	: Queue position where 0 is the next frame to Pop().
+	@param pInfo	: Returned results.
+	@return				: 1 = success, 0 = not queued or not yet analysed.
+	*/
+	int   Peek(int ahead, LKA_FRAME_INFO* pInfo);
+
+	/** Pop the results of the next frame to encode and signal them to a rate controller.
+	Call once per frame in the encoder frame loop before the rate controller
+	PredictDistortion() call for that frame. The complexity ratio is the frame
+	inter cost relative to the mean over it and the analysed frames queued
+	behind it up to the next scene cut. A scene cut also signals the frame mse
+	and mae, estimated at full resolution, as the scene change.
+	@param pRC		: Rate controller of the frame type being encoded.
+	@param pInfo	: Returned results. May be NULL.
+	@return				: 1 = success, 0 = queue is empty.
+	*/
+	int   Signal(IRateControl* pRC, LKA_FRAME_INFO* pInfo);
+
+	/// Num of frames queued and not yet popped.
+	int   GetQueueLength(void);
+
+	/// The next pushed frame is treated as a scene cut e.g. after a seek.
+	void  Reset(void);
+
+	/// Member access.
+	bool  Ready(void)											{ return(_ready); }
+	int   GetDepth(void)									{ return(_depth); }
+	void  SetSceneCutRatio(double ratio)	{ _sceneCutRatio = ratio; }
+	void  SetSearchRange(int range)				{ _range = range; }	///< Downsampled pels.
+
+/// Private methods.
+protected:
+	void  ResetMembers(void);
+	/// Thread entry point.
+	void  Run(void);
+	/// Analyse the frame in a queue slot against the previous analysed frame.
+	void  Analyse(int slot);
+
+/// Constants.
+protected:
+	static const int EMPTY		= 0;
+	static const int PENDING	= 1;
+	static const int DONE			= 2;
+
+/// Members.
+protected:
+	bool		_ready;
+	int			_imgWidth;
+	int			_imgHeight;
+	int			_depth;
+	double	_sceneCutRatio;	///< Intra ratio above which a frame is a scene cut.
+	int			_range;					///< Downsampled search range.
+
+	/// Frame queue of _depth slots.
+	short*						_pFrameMem;
+	OverlayMem2Dv2**	_ppFrameOver;
+	LKA_FRAME_INFO*		_pInfo;
+	int*							_pState;
+	bool*							_pForceCut;
+	int								_head;		///< Next slot to push.
+	int								_tail;		///< Next slot to pop.
+	int								_next;		///< Next slot to analyse.
+	int								_count;		///< Slots pushed and not popped.
+	int								_frameNum;
+	bool							_cutPending;
+
+	/// Downsampled working images. Level 1 scratch and level 2 current and previous.
+	short*						_pL1Mem;
+	OverlayMem2Dv2*		_pL1Over;
+	short*						_pL2Mem[2];
+	OverlayMem2Dv2*		_pL2Over[2];
+	int								_l2Curr;
+	bool							_l2PrevValid;
+	double						_l2PrevDetail;	///< Per pel detail of the previous frame lost to the downsampling.
+
+	std::thread								_thread;
+	std::mutex								_mutex;
+	std::condition_variable		_cond;
+	bool											_quit;
+};//end LookaheadAnalyser.
+
+#endif	// _LOOKAHEADANALYSER_H
+
@@ -49,6 +49,10 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include "VectorStructList.h"
 #include "OverlayMem2Dv2.h"
 #include "OverlayExtMem2Dv2.h"
+#include "OverlayMem2Dv2u8.h"
+
+/// Max num of row band threads for frame compensation.
+#define MCH264IS_MAX_THREADS	16
 
 /*
 ---------------------------------------------------------------------------
@@ -104,12 +108,80 @@ class MotionCompensatorH264ImplStd : public IMotionCompensator
 		virtual void PrepareForSingleVectorMode(void);
     virtual void Invalidate(void) { _invalid = 1; }
 
+	/// Implementation specific interface.
+	public:
+		/** Set the num of threads for frame compensation.
+		Compensate(pMotionList) splits the frame into this num of macroblock
+		row bands that are compensated concurrently. The single vector mode
+		is not affected. Can be called before or after Create().
+		@param threads	: Num of threads [1..MCH264IS_MAX_THREADS]. 1 = sequential.
+		@return					: 1 = success, 0 = failure.
+		*/
+		int SetThreads(int threads);
+		int GetThreads(void) { return(_threads); }
+
+		/** Set edge emulation for the temp ref.
+		With edge emulation the temp ref is not extended by a replicated boundary. 
+		Blocks that lie inside the image are read directly and only blocks that 
+		cross the image edge are fetched into a small edge clamped work block. 
+		Can be called before or after Create().
+		@param on	: 1 = edge emulation, 0 = extended boundary temp ref.
+		@return		: 1 = success, 0 = failure.
+		*/
+		int SetEdgeEmulation(int on);
+		int GetEdgeEmulation(void) { return(_edgeEmulation); }
+
+		/** Select an 8-bit lum ref.
+		The ref given to Create() then holds an unsigned char lum plane followed
+		by the short chr planes, as the codec chr is signed. The lum blocks are 
+		interpolated on a pooled 8-bit temp ref and written to the ref without 
+		widening. The ref layout depends on it so it must be called before 
+		Create(). Off by default.
+		@param on	: 1 = 8-bit lum ref, 0 = 16-bit lum ref.
+		@return		: 1 = success, 0 = failure.
+		*/
+		int SetPel8(int on);
+		int GetPel8(void) { return(_pel8); }
+
+	/// Local types.
+	protected:
+		/// The overlays on the shared ref and temp ref mem used by one thread.
+		typedef struct _MCH264IS_BAND
+		{
+			OverlayMem2Dv2*			pRefLumOver;
+			OverlayMem2Dv2*			pRefChrUOver;
+			OverlayMem2Dv2*			pRefChrVOver;
+			OverlayExtMem2Dv2*	pExtTmpLumOver;
+			OverlayExtMem2Dv2*	pExtTmpChrUOver;
+			OverlayExtMem2Dv2*	pExtTmpChrVOver;
+			short*							pMBlk;
+			OverlayMem2Dv2*			pMBlkOver;
+			short*							pEdgeLum;
+			OverlayMem2Dv2*			pEdgeLumOver;
+			short*							pEdgeChr;
+			OverlayMem2Dv2*			pEdgeChrOver;
+			OverlayMem2Dv2u8*		pRefLumOver8;
+			OverlayMem2Dv2u8*		pExtTmpLumOver8;
+			unsigned char*			pMBlk8;
+			OverlayMem2Dv2u8*		pMBlkOver8;
+			unsigned char*			pEdgeLum8;
+			OverlayMem2Dv2u8*		pEdgeLumOver8;
+		} MCH264IS_BAND;
+
 	/// Local methods.
 	protected:
 	void LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2* extRef);
 	void LoadQuartPelWindow(OverlayMem2Dv2* qPelWin, int hPelColOff, int hPelRowOff);
 	void QuarterRead(OverlayMem2Dv2* dstBlock, OverlayMem2Dv2* qPelWin, int qPelColOff, int qPelRowOff);
 
+	void CompensateBlock(MCH264IS_BAND* pBand, int tlx, int tly, int mvx, int mvy);
+	void CompensateBand(MCH264IS_BAND* pBand, VectorStructList* pL, int firstMbRow, int endMbRow, int invalid);
+	int	 CreateBands(void);
+	void DestroyBands(void);
+	int	 CrossesEdge(int x, int y, int width, int height, int imgWidth, int imgHeight, int margin);
+	void EdgeFetch(OverlayMem2Dv2* pImgOver, OverlayMem2Dv2* pEdgeOver, int x, int y, int width, int height, int margin);
+	void EdgeFetch(OverlayMem2Dv2u8* pImgOver, OverlayMem2Dv2u8* pEdgeOver, int x, int y, int width, int height, int margin);
+
 	/// Local methods.
 	protected:
 
@@ -148,10 +220,37 @@ class MotionCompensatorH264ImplStd : public IMotionCompensator
 		OverlayExtMem2Dv2*	_pExtTmpChrVOver;
 		int									_extChrWidth;
 		int									_extChrHeight;
+		int									_lumBoundary;		///< Boundary of the extended temp ref. Zero with edge emulation.
+		int									_chrBoundary;
+
+		/// Edge clamped work blocks for edge emulation that hold a macroblock and 
+		/// its interpolation margin.
+		int							_edgeEmulation;
+		short*					_pEdgeLum;
+		OverlayMem2Dv2* _pEdgeLumOver;
+		short*					_pEdgeChr;
+		OverlayMem2Dv2* _pEdgeChrOver;
 
 		/// A work block.
 		short*					_pMBlk;
 		OverlayMem2Dv2* _pMBlkOver;
+
+		/// The 8-bit lum ref and its temp ref replace _pRefLum and _pExtTmpLum. The
+		/// temp ref is from the plane pool and has the same extended dims.
+		int									_pel8;
+		unsigned char*			_pRefLum8;
+		OverlayMem2Dv2u8*		_pRefLumOver8;
+		unsigned char*			_pExtTmpLum8;
+		int									_extLumStride8;
+		OverlayMem2Dv2u8*		_pExtTmpLumOver8;
+		unsigned char*			_pEdgeLum8;
+		OverlayMem2Dv2u8*		_pEdgeLumOver8;
+		unsigned char*			_pMBlk8;
+		OverlayMem2Dv2u8*		_pMBlkOver8;
+
+		/// Row band overlays for threaded frame compensation.
+		int							_threads;
+		MCH264IS_BAND*	_pBand;
 };//end MotionCompensatorH264ImplStd.
 
 
@@ -51,7 +51,10 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include "VectorStructList.h"
 #include "OverlayMem2Dv2.h"
 #include "OverlayExtMem2Dv2.h"
+#include "H264StaticMbDetector.h"
 #include "MacroBlockH264.h"
+#include "H264MotionVectorSeeder.h"
+#include "H264MotionSearchStats.h"
 #include "CodecDistortionDef.h"
 
 //#define MEH264IFHS_TAKE_MEASUREMENTS 1
@@ -109,7 +112,7 @@ public:
 /// IMotionEstimator Interface.
 public:
 	virtual int		Create(void);
-  virtual void	Reset(void)       {}
+  virtual void	Reset(void)       { _seeder.Reset(); _searchStats.Reset(); }
 	virtual int		Ready(void)		    { return(_ready); }
   virtual void	SetMode(int mode) { _mode = mode; }
 	virtual int		GetMode(void)     { return(_mode); }
@@ -125,6 +128,37 @@ public:
 		{ return(Estimate(avgDistortion)); }
 	virtual void* Estimate(long* avgDistortion);
 
+	/** Enable/disable the static macroblock pre-pass.
+	Macroblocks whose (0,0) vector square error is within the quantisation noise
+	of the QP set by SetStaticMbQP() are given the zero vector without a search.
+	Disabled by default.
+	@param enable	: Pre-pass on/off.
+	*/
+	void	SetStaticMbSkip(bool enable)	{ _staticMbSkip = enable; }
+	bool	GetStaticMbSkip(void)					{ return(_staticMbSkip); }
+	void	SetStaticMbQP(int qp)					{ _staticMbQP = qp; }
+	/// Num of macroblocks that bypassed the search in the last Estimate() call.
+	int		GetStaticMbCount(void)				{ return(_staticMbSkip ? _staticMb.GetStaticCount() : 0); }
+
+	/** Enable/disable the spatial and temporal candidate seeding stage.
+	Seeding requires the previous frame macroblocks on construction and is
+	enabled by default when they are available.
+	@param enable	: Seeding on/off.
+	*/
+	void	SetCandidateSeeding(bool enable) { _seeding = enable && (_pPrevFrmMBlk != NULL); }
+	bool	GetCandidateSeeding(void)				 { return(_seeding); }
+
+	/** Enable/disable early termination thresholds learned from the sequence.
+	The fixed thresholds of the pattern search early exits are replaced with ones
+	derived from the running distribution of the final distortions and the region
+	history. They are bounded below by the quantisation noise of the QP set by 
+	SetStaticMbQP(). Disabled by default.
+	@param enable	: Adaptive thresholds on/off.
+	*/
+	void	SetAdaptiveThresholds(bool enable) { _adaptive = enable; }
+	bool	GetAdaptiveThresholds(void)				 { return(_adaptive); }
+	H264MotionSearchStats* GetSearchStats(void) { return(&_searchStats); }
+
 /// Local methods.
 protected:
 
@@ -183,6 +217,11 @@ protected:
 	int									_extBoundary;			///< Extended boundary for left, right, up and down.
 	OverlayExtMem2Dv2*	_pExtRefOver;			///< Extended ref overlay with motion block dim.
 
+	/// Static macroblock pre-pass classification.
+	bool									_staticMbSkip;
+	int										_staticMbQP;
+	H264StaticMbDetector	_staticMb;
+
 	/// A 1/4 pel refinement cache.
   int*                _pQuartPelBase;
   int**               _ppQuartPelBase;
@@ -203,6 +242,14 @@ protected:
   /// Reference to encoder macroblocks from the previously encoded frame. Used for prediction.
   MacroBlockH264*   _pPrevFrmMBlk;
 
+  /// EPZS-style seed candidates from the spatial and temporal neighbourhood motion field.
+  H264MotionVectorSeeder  _seeder;
+  bool                    _seeding;
+
+  /// Early termination thresholds learned online from the final search results.
+  H264MotionSearchStats   _searchStats;
+  bool                    _adaptive;
+
 #ifdef MEH264IFHS_TAKE_MEASUREMENTS
   MeasurementTable _mt;
   int _mtLen;
@@ -51,6 +51,10 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include "VectorStructList.h"
 #include "OverlayMem2Dv2.h"
 #include "OverlayExtMem2Dv2.h"
+#include "OverlayMem2Dv2u8.h"
+#include "ViewMem2Dv2.h"
+#include "H264StaticMbDetector.h"
+#include "IntegralImage2D.h"
 #include "Fifo.h"
 
 /*
@@ -110,6 +114,38 @@ public:
 		{ return(Estimate(avgDistortion)); }
 	virtual void* Estimate(long* avgDistortion);
 
+	/** Enable/disable the static macroblock pre-pass.
+	Macroblocks whose (0,0) vector square error is within the quantisation noise
+	of the QP set by SetStaticMbQP() are given the zero vector without a search.
+	Disabled by default.
+	@param enable	: Pre-pass on/off.
+	*/
+	void	SetStaticMbSkip(bool enable)	{ _staticMbSkip = enable; }
+	bool	GetStaticMbSkip(void)					{ return(_staticMbSkip); }
+	void	SetStaticMbQP(int qp)					{ _staticMbQP = qp; }
+	/// Num of macroblocks that bypassed the search in the last Estimate() call.
+	int		GetStaticMbCount(void)				{ return(_staticMbSkip ? _staticMb.GetStaticCount() : 0); }
+
+	/** Enable/disable successive elimination in the full pel search.
+	Candidates whose 8x8 quadrant block sum differences already bound the
+	distortion above the best so far are rejected without a full block
+	measure. The vectors are identical to the exhaustive search and it is
+	enabled by default.
+	@param enable	: Successive elimination on/off.
+	*/
+	void	SetSuccessiveElimination(bool enable) { _successiveElimination = enable; }
+	bool	GetSuccessiveElimination(void)				{ return(_successiveElimination); }
+
+	/** Select 8-bit lum planes.
+	The src and ref given on construction are unsigned char lum planes and
+	the search, the sub pel refinement and the static and successive 
+	elimination pre-passes read them directly. The extended ref is an 8-bit 
+	pooled plane. Disabled by default for 16-bit planes. Call before Create().
+	@param enable	: 8-bit planes on/off.
+	*/
+	void	SetPel8(bool enable)	{ _pel8 = enable; }
+	bool	GetPel8(void)					{ return(_pel8); }
+
 /// Local methods.
 protected:
 
@@ -130,8 +166,11 @@ protected:
 											int		range); 
 
 	void LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2* extRef);
+	void LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2u8* extRef);
+	template<typename T> void LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, T** ref, int refXPos, int refYPos);
 	void LoadQuartPelWindow(OverlayMem2Dv2* qPelWin, int hPelColOff, int hPelRowOff);
 	void QuarterRead(OverlayMem2Dv2* dstBlock, OverlayMem2Dv2* qPelWin, int qPelColOff, int qPelRowOff);
+	void QuarterRead(OverlayMem2Dv2u8* dstBlock, OverlayMem2Dv2* qPelWin, int qPelColOff, int qPelRowOff);
 
   /// Select the vector that minimised a cost function from a list of x, y and distortion ordered vectors. The
   /// euclidian distance is measured from a reference vector. Return the list index of the 
@@ -197,6 +236,23 @@ protected:
 	int									_extBoundary;			///< Extended boundary for left, right, up and down.
 	OverlayExtMem2Dv2*	_pExtRefOver;			///< Extended ref overlay with motion block dim.
 
+	/// Static macroblock pre-pass classification.
+	bool									_staticMbSkip;
+	int										_staticMbQP;
+	H264StaticMbDetector	_staticMb;
+
+	/// Successive elimination block sums of the extended ref and the curr mb quadrants.
+	bool								_successiveElimination;
+	IntegralImage2D			_extRefSum;
+	int									_inQuadSum[4];
+
+	/// 8-bit input, ref and extended ref overlays replacing the 16-bit ones with _pel8.
+	bool								_pel8;
+	OverlayMem2Dv2u8*		_pInOver8;
+	OverlayMem2Dv2u8*		_pRefOver8;
+	unsigned char*			_pExtRef8;				///< Pooled extended ref mem.
+	OverlayMem2Dv2u8*		_pExtRefOver8;
+
 	/// A 1/4 pel refinement window.
 	short*							_pWin;
 	OverlayMem2Dv2*			_Win;
@@ -204,6 +260,8 @@ protected:
 	/// Temp working block and its overlay.
 	short*							_pMBlk;						///< Motion block temp mem.
 	OverlayMem2Dv2*			_pMBlkOver;				///< Motion block overlay of temp mem.
+	unsigned char*			_pMBlk8;
+	OverlayMem2Dv2u8*		_pMBlkOver8;
 
 	/// Hold the resulting motion vectors in a byte array.
 	VectorStructList*	_pMotionVectorStruct;
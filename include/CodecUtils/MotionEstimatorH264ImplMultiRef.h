@@ -0,0 +1,209 @@
+/** @file
+
+MODULE				: MotionEstimatorH264ImplMultiRef
+
+TAG						: MEH264IMR
+
+FILE NAME			: MotionEstimatorH264ImplMultiRef.h
+
+DESCRIPTION		: Multiple reference frame H.264 16x16 motion estimator that
+                searches across the frames of an H264RefFrameStore. Reference
+                0 is searched with a level 1 coarse full search followed by a
+                level 0 predictive diamond refinement. Older references are
+                only searched from candidates pruned from the reference 0
+                result. Every candidate is ranked with a rate constrained cost
+                that includes the reference index bits.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _MOTIONESTIMATORH264IMPLMULTIREF_H
+#define _MOTIONESTIMATORH264IMPLMULTIREF_H
+
+#pragma once
+
+#include "IMotionEstimator.h"
+#include "IMotionVectorPredictor.h"
+#include "VectorStructList.h"
+#include "OverlayMem2Dv2.h"
+#include "OverlayExtMem2Dv2.h"
+#include "OverlayMem2Dv2u8.h"
+#include "H264RefFrameStore.h"
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class MotionEstimatorH264ImplMultiRef : public IMotionEstimator
+{
+/// Construction.
+public:
+
+	MotionEstimatorH264ImplMultiRef(const void*             pSrc, 
+																	H264RefFrameStore*      pStore, 
+																	int					            imgWidth, 
+																	int					            imgHeight,
+																	int					            motionRange,
+																	IMotionVectorPredictor* pMVPred);
+
+	MotionEstimatorH264ImplMultiRef(const void*             pSrc, 
+																	H264RefFrameStore*      pStore, 
+																	int					            imgWidth, 
+																	int					            imgHeight,
+																	int					            motionRange,
+																	IMotionVectorPredictor* pMVPred,
+																	void*				            pDistortionIncluded);
+
+	virtual ~MotionEstimatorH264ImplMultiRef(void);
+
+/// IMotionEstimator Interface.
+public:
+	virtual int		Create(void);
+  virtual void	Reset(void)       {}
+	virtual int		Ready(void)		    { return(_ready); }
+	/// Mode: [ 0 = pruned multiple ref (default), 1 = ref 0 only, 2 = exhaustive multiple ref.]
+  virtual void	SetMode(int mode) { _mode = mode; }
+	virtual int		GetMode(void)     { return(_mode); }
+
+	/** Motion estimate the source within the reference store.
+	The references are those held in the store at the time of the call. The 
+	pRef parameter is ignored as the store holds the references. The returned 
+	SIMPLE2D list holds the 1/4 pel vectors and GetRefIndex() holds the 
+	reference index selected per macroblock. The input on construction is an
+	unsigned char lum plane when the store holds 8-bit references.
+	@param pSrc		: Input image to estimate.
+	@param pRef		: Ignored.
+	@return				: The list of motion vectors.
+	*/
+	virtual void* Estimate(const void* pSrc, const void* pRef, long* avgDistortion)
+		{ return(Estimate(avgDistortion)); }
+	virtual void* Estimate(long* avgDistortion);
+
+	/// Reference index selected per macroblock in the last Estimate() call.
+	int		GetRefIndex(int mb)						{ return(_pRefIdx[mb]); }
+	/// Total num of reference searches over all macroblocks in the last Estimate() call.
+	int		GetSearchCount(void)					{ return(_searchCount); }
+
+	/// The QP sets the Lagrange multiplier of the rate constrained cost.
+	void	SetQP(int qp);
+	/// Limit the num of references searched. The store limits it further.
+	void	SetMaxRefs(int maxRefs)				{ _maxRefs = maxRefs; }
+	int		GetMaxRefs(void)							{ return(_maxRefs); }
+
+/// Local methods.
+protected:
+
+	/// Used by constructors to reset every member.
+	void ResetMembers(void);
+	/// Clear alloc mem.
+	void Destroy(void);
+	/// Vector limits for the block at (x,y) of a level within its extended boundary and the motion range.
+	void GetMotionRange(int		x,			int		y,
+											int*	xlr,		int*	xrr, 
+											int*	yur,		int*	ydr, 
+											int		level); 
+
+	/// The search with the input and store overlays of either pel type.
+	template<class TIn, class TRef> void* EstimatePels(TIn* pIn, TIn* pInL1, TIn* pMBlk, long* avgDistortion);
+
+	/// Level 1 full search for a coarse full pel vector in level 0 units.
+	template<class TIn, class TRef> void CoarseSearch(TIn* pInL1, TRef* pRefL1, int q, int p, int predX0, int predY0, int* cx, int* cy);
+
+	/** Test a full pel candidate against the best so far.
+	Candidates outside of the range {xl, xr, yu, yd} in rng are ignored.
+	@return	: 1 = the candidate is the new best.
+	*/
+	template<class TIn, class TRef> int TestCandidate(TIn* pIn, TRef* pRef, int n, int m, int x, int y, int* rng, int predX, int predY, int refBits,
+																										int* bestCost, int* bestDist, int* bestX, int* bestY);
+
+	/// The level 0 and level 1 store references of a pel type.
+	static void GetStoreRefs(H264RefFrameStore* pStore, int refIdx, OverlayExtMem2Dv2** ppRef, OverlayExtMem2Dv2** ppRefL1)
+		{ *ppRef = pStore->GetRef(refIdx); *ppRefL1 = pStore->GetRefL1(refIdx); }
+	static void GetStoreRefs(H264RefFrameStore* pStore, int refIdx, OverlayMem2Dv2u8** ppRef, OverlayMem2Dv2u8** ppRefL1)
+		{ *ppRef = pStore->GetRefPel8(refIdx); *ppRefL1 = pStore->GetRefL1Pel8(refIdx); }
+
+	/// Num of bits of signed and unsigned Exp-Golomb codes.
+	static int SeBits(int v);
+	static int UeBits(int v);
+	/// Num of bits of a reference index with numRefs references.
+	static int RefBits(int refIdx, int numRefs);
+
+protected:
+
+	int _ready;	///< Ready to estimate.
+	int _mode;	///< Speed mode. [ 0 = pruned, 1 = ref 0 only, 2 = exhaustive.]
+
+	/// Parameters must remain const for the life time of this instantiation.
+	int	_imgWidth;				///< Width of the src and ref images. 
+	int	_imgHeight;				///< Height of the src and ref images.
+	int	_macroBlkWidth;		///< Width of the motion block.
+	int	_macroBlkHeight;	///< Height of the motion block.
+	int	_motionRange;			///< (4x,4y) range of the motion vectors in 1/4 pel units.
+
+	const void*					_pInput;	///< Reference to the input image at construction.
+	H264RefFrameStore*	_pStore;	///< Attached reference store on construction.
+
+	int _qp;
+	int _lambda;			///< Lagrange multiplier for the square error distortion.
+	int _maxRefs;
+	int _searchCount;
+
+	/// Level 0: Input mem overlay.
+	OverlayMem2Dv2*		_pInOver;					///< Input overlay with motion block dim.
+	/// Level 1: Subsampled input by 2.
+	short*						_pInL1;
+	OverlayMem2Dv2*		_pInL1Over;				///< Input overlay with level 1 motion block dim.
+
+	/// Temp working block and its overlay.
+	short*						_pMBlk;						///< Motion block temp mem.
+	OverlayMem2Dv2*		_pMBlkOver;				///< Motion block overlay of temp mem.
+
+	/// 8-bit input overlays replacing those above when the store holds 8-bit references.
+	OverlayMem2Dv2u8*	_pInOver8;
+	unsigned char*		_pInL18;					///< Pooled level 1 input mem.
+	OverlayMem2Dv2u8*	_pInL1Over8;
+	unsigned char*		_pMBlk8;
+	OverlayMem2Dv2u8*	_pMBlkOver8;
+
+  /// Hold the resulting motion vectors in a byte array.
+	VectorStructList*	_pMotionVectorStruct;
+	/// Selected reference index per macroblock.
+	int*							_pRefIdx;
+
+  /// Attached motion vector predictor on construction.
+  IMotionVectorPredictor* _pMVPred;
+
+	/// A flag per macroblock to include it in the distortion accumulation.
+	bool*							_pDistortionIncluded;
+};//end MotionEstimatorH264ImplMultiRef.
+
+#endif // !_MOTIONESTIMATORH264IMPLMULTIREF_H
+
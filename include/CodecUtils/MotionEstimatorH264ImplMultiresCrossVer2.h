@@ -53,6 +53,8 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include "VectorStructList.h"
 #include "OverlayMem2Dv2.h"
 #include "OverlayExtMem2Dv2.h"
+#include "H264StaticMbDetector.h"
+#include "H264MotionSearchStats.h"
 #include "Fifo.h"
 
 /*
@@ -115,6 +117,18 @@ public:
 	virtual void* Estimate(long* avgDistortion);
 	virtual void* Estimate(long* avgDistortion, void* param);
 
+	/** Enable/disable the static macroblock pre-pass.
+	Macroblocks whose (0,0) vector square error is within the quantisation noise
+	of the QP set by SetStaticMbQP() are given the zero vector without a search.
+	Disabled by default.
+	@param enable	: Pre-pass on/off.
+	*/
+	void	SetStaticMbSkip(bool enable)	{ _staticMbSkip = enable; }
+	bool	GetStaticMbSkip(void)					{ return(_staticMbSkip); }
+	void	SetStaticMbQP(int qp)					{ _staticMbQP = qp; }
+	/// Num of macroblocks that bypassed the search in the last Estimate() call.
+	int		GetStaticMbCount(void)				{ return(_staticMbSkip ? _staticMb.GetStaticCount() : 0); }
+
 /// Local methods.
 protected:
 
@@ -200,6 +214,7 @@ protected:
 
 	int _ready;	///< Ready to estimate.
 	int _mode;	///< Speed mode or whatever. [ 0 = auto, 1 = level 1, 2 = level 2.]
+	bool _autoMode;	///< Mode 0 was set and the level adapts to the vector spread.
 
 	/// Parameters must remain const for the life time of this instantiation.
 	int	_imgWidth;				///< Width of the src and ref images. 
@@ -237,6 +252,14 @@ protected:
 	int									_extHeight;
 	int									_extBoundary;			///< Extended boundary for left, right, up and down.
 	OverlayExtMem2Dv2*	_pExtRefOver;			///< Extended ref overlay with motion block dim.
+
+	/// Static macroblock pre-pass classification.
+	bool									_staticMbSkip;
+	int										_staticMbQP;
+	H264StaticMbDetector	_staticMb;
+
+	/// Vector spread of the final search results for the auto mode.
+	H264MotionSearchStats	_searchStats;
 	/// Level 1: Subsampled ref by 2.		[_mode == 1]
 	short*							_pRefL1;					///< Ref mem at (_l1Width * _l1Height).
 	OverlayMem2Dv2*			_pRefL1Over; 			///< Ref overlay with whole level 1 block dim.
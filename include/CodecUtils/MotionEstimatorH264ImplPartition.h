@@ -0,0 +1,218 @@
+/** @file
+
+MODULE				: MotionEstimatorH264ImplPartition
+
+TAG						: MEH264IP
+
+FILE NAME			: MotionEstimatorH264ImplPartition.h
+
+DESCRIPTION		: A partition aware full search motion estimator implementation
+								for Recommendation H.264 (03/2005). For every candidate
+								position a grid of sixteen 4x4 block distortions is measured
+								once and summed into the 16x16, 16x8, 8x16 and 8x8 partition
+								costs, tracking the best vector per partition in the same
+								search. Access is via an IMotionEstimator interface and the
+								vectors are returned in a COMPLEX2D VectorStructList.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _MOTIONESTIMATORH264IMPLPARTITION_H
+#define _MOTIONESTIMATORH264IMPLPARTITION_H
+
+#pragma once
+
+#include "IMotionEstimator.h"
+#include "IMotionVectorPredictor.h"
+#include "VectorStructList.h"
+#include "OverlayMem2Dv2.h"
+#include "OverlayExtMem2Dv2.h"
+#include "OverlayMem2Dv2u8.h"
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class MotionEstimatorH264ImplPartition : public IMotionEstimator
+{
+/// Construction.
+public:
+
+	MotionEstimatorH264ImplPartition(	const void*             pSrc, 
+																		const void*             pRef, 
+																		int					            imgWidth, 
+																		int					            imgHeight,
+																		int					            motionRange,
+																		IMotionVectorPredictor* pMVPred);
+
+	MotionEstimatorH264ImplPartition(	const void*             pSrc, 
+																		const void*             pRef, 
+																		int					            imgWidth, 
+																		int					            imgHeight,
+																		int					            motionRange,
+																		IMotionVectorPredictor* pMVPred,
+																		void*				            pDistortionIncluded);
+
+	virtual ~MotionEstimatorH264ImplPartition(void);
+
+/// IMotionEstimator Interface.
+public:
+	virtual int		Create(void);
+  virtual void	Reset(void)       {}
+	virtual int		Ready(void)		    { return(_ready); }
+  virtual void	SetMode(int mode) { _mode = mode; }
+	virtual int		GetMode(void)     { return(_mode); }
+
+	/** Motion estimate the source within the reference.
+	Do the estimation with the block sizes and image sizes defined in
+	the implementation. The returned COMPLEX2D list holds, per macroblock,
+	all NumPartitions vectors in partition order with the pattern set to 
+	the selected MacroBlockH264 Inter_xxx partition mode.
+	@param pSrc		: Input image to estimate.
+	@param pRef		: Ref to estimate with.
+	@return				: The list of motion vectors.
+	*/
+	virtual void* Estimate(const void* pSrc, const void* pRef, long* avgDistortion)
+		{ return(Estimate(avgDistortion)); }
+	virtual void* Estimate(long* avgDistortion);
+
+	/// The winning distortion of a partition in the last Estimate() call.
+	int GetPartitionDistortion(int mb, int partition) { return(_pPartDist[(mb * NumPartitions) + partition]); }
+
+	/** Select 8-bit lum planes.
+	The src and ref given on construction are unsigned char lum planes and
+	the partition search and its sub pel refinement read them directly. The
+	extended ref is an 8-bit pooled plane. Disabled by default for 16-bit 
+	planes. Call before Create().
+	@param enable	: 8-bit planes on/off.
+	*/
+	void	SetPel8(bool enable)	{ _pel8 = enable; }
+	bool	GetPel8(void)					{ return(_pel8); }
+
+/// Partition layout of the vectors within each list struct.
+public:
+	static const int Part16x16		= 0;	///< 1 vector.
+	static const int Part16x8			= 1;	///< 2 vectors, top then bottom.
+	static const int Part8x16			= 3;	///< 2 vectors, left then right.
+	static const int Part8x8			= 5;	///< 4 vectors in raster order.
+	static const int NumPartitions	= 9;
+
+/// Local methods.
+protected:
+
+	/// Used by constructors to reset every member.
+	void ResetMembers(void);
+	/// Clear alloc mem.
+	void Destroy(void);
+	/// Motion search range in the reference limited to the picture extended boundaries and max vector range.
+	void GetMotionRange(int		x,			int		y,
+											int		offx,		int		offy,
+											int*	xlr,		int*	xrr, 
+											int*	yur,		int*	ydr, 
+											int		range); 
+
+	/// The sixteen 4x4 distortions between the 16x16 input and ref blocks summed into the partition costs.
+	void PartitionDistortion(OverlayMem2Dv2* pIn, OverlayMem2Dv2* pRef, int* partDist)
+		{ PartitionDistortionLessThan(pIn, pRef, partDist, NULL); }
+	/// ...with an early exit when all partitions are strictly greater than the limits.
+	int		PartitionDistortionLessThan(OverlayMem2Dv2* pIn, OverlayMem2Dv2* pRef, int* partDist, int* limit);
+	/// ...on 8-bit overlays.
+	void	PartitionDistortion(OverlayMem2Dv2u8* pIn, OverlayMem2Dv2u8* pRef, int* partDist)
+		{ PartitionDistortionLessThan(pIn, pRef, partDist, NULL); }
+	int		PartitionDistortionLessThan(OverlayMem2Dv2u8* pIn, OverlayMem2Dv2u8* pRef, int* partDist, int* limit);
+	/// The measure on the row addresses and block origins of either pel type.
+	template<typename T> int PartitionGridLessThan(T** in, int inX, int inY, T** ref, int refX, int refY, int* partDist, int* limit);
+	void	PartitionSum(int* grid, int* partDist);
+
+	void LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2* extRef);
+	void LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2u8* extRef);
+	template<typename T> void LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, T** ref, int refXPos, int refYPos);
+	void LoadQuartPelWindow(OverlayMem2Dv2* qPelWin, int hPelColOff, int hPelRowOff);
+	void QuarterRead(OverlayMem2Dv2* dstBlock, OverlayMem2Dv2* qPelWin, int qPelColOff, int qPelRowOff);
+	void QuarterRead(OverlayMem2Dv2u8* dstBlock, OverlayMem2Dv2* qPelWin, int qPelColOff, int qPelRowOff);
+
+protected:
+
+	int _ready;	///< Ready to estimate.
+	int _mode;	///< Speed mode or whatever. [ 0 = auto, 1 = level 1, 2 = level 2.]
+
+	/// Parameters must remain const for the life time of this instantiation.
+	int	_imgWidth;				///< Width of the src and ref images. 
+	int	_imgHeight;				///< Height of the src and ref images.
+	int	_macroBlkWidth;		///< Width of the motion block.
+	int	_macroBlkHeight;	///< Height of the motion block.
+	int	_motionRange;			///< (4x,4y) range of the motion vectors in 1/4 pel units.
+
+	const void*	_pInput;	///< References to the images at construction.
+	const void* _pRef;
+
+	/// Input mem overlay members.
+	OverlayMem2Dv2*		_pInOver;					///< Input overlay with motion block dim.
+
+	/// Ref mem overlay members.
+	OverlayMem2Dv2*			_pRefOver;				///< Ref overlay with whole block dim.
+	short*							_pExtRef;					///< Extended ref mem created by ExtendBoundary() call.
+	int									_extWidth;
+	int									_extHeight;
+	int									_extBoundary;			///< Extended boundary for left, right, up and down.
+	OverlayExtMem2Dv2*	_pExtRefOver;			///< Extended ref overlay with motion block dim.
+
+	/// 8-bit input, ref and extended ref overlays replacing the 16-bit ones with _pel8.
+	bool								_pel8;
+	OverlayMem2Dv2u8*		_pInOver8;
+	OverlayMem2Dv2u8*		_pRefOver8;
+	unsigned char*			_pExtRef8;				///< Pooled extended ref mem.
+	OverlayMem2Dv2u8*		_pExtRefOver8;
+
+	/// A 1/4 pel refinement window.
+	short*							_pWin;
+	OverlayMem2Dv2*			_Win;
+
+	/// Temp working block and its overlay.
+	short*							_pMBlk;						///< Motion block temp mem.
+	OverlayMem2Dv2*			_pMBlkOver;				///< Motion block overlay of temp mem.
+	unsigned char*			_pMBlk8;
+	OverlayMem2Dv2u8*		_pMBlkOver8;
+
+	/// Hold the resulting partition motion vectors.
+	VectorStructList*	_pMotionVectorStruct;
+	/// Winning distortion per partition per macroblock.
+	int*							_pPartDist;
+
+  /// Attached motion vector predictor on construction.
+  IMotionVectorPredictor* _pMVPred;
+
+	/// A flag per macroblock to include it in the distortion accumulation.
+	bool*							_pDistortionIncluded;
+};//end MotionEstimatorH264ImplPartition.
+
+#endif // !_MOTIONESTIMATORH264IMPLPARTITION_H
+
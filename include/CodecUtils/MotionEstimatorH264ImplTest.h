@@ -49,6 +49,7 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include "VectorStructList.h"
 #include "OverlayMem2Dv2.h"
 #include "OverlayExtMem2Dv2.h"
+#include "IntegralImage2D.h"
 
 #include  "MeasurementTable.h"
 //#undef MEH264IT_DUMP 
@@ -113,6 +114,16 @@ public:
 		{ return(Estimate(avgDistortion)); }
 	virtual void* Estimate(long* avgDistortion);
 
+	/** Enable/disable successive elimination in the full pel search.
+	Candidates whose 8x8 quadrant block sum differences already bound the
+	distortion above the best so far are rejected without a full block
+	measure. The vectors are identical to the exhaustive search and it is
+	enabled by default.
+	@param enable	: Successive elimination on/off.
+	*/
+	void	SetSuccessiveElimination(bool enable) { _successiveElimination = enable; }
+	bool	GetSuccessiveElimination(void)				{ return(_successiveElimination); }
+
 /// Local public methods.
 public:
 
@@ -167,6 +178,11 @@ protected:
 	int									_extBoundary;			///< Extended boundary for left, right, up and down.
 	OverlayExtMem2Dv2*	_pExtRefOver;			///< Extended ref overlay with motion block dim.
 
+	/// Successive elimination block sums of the extended ref and the curr mb quadrants.
+	bool								_successiveElimination;
+	IntegralImage2D			_extRefSum;
+	int									_inQuadSum[4];
+
 	/// A 1/4 pel refinement window.
 	short*							_pWin;
 	OverlayMem2Dv2*			_Win;
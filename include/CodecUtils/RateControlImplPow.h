@@ -106,6 +106,8 @@ public:
 
   /// In this implementation only the mean sqr err is used to indicate the degree of scene change. The signal is immediately reset to zero after use.
   void SignalSceneChange(double mse, double mae) { _mseSignal = mse; }
+  /// The target rate of the next frame is scaled by the limited complexity ratio.
+  void SignalComplexity(double ratio) { _complexitySignal = ratio; }
 
   /// Utility functions.
   void Dump(const char* filename);  ///< Requires RCIP_DUMP_RATECNTL to be set.
@@ -182,6 +184,7 @@ protected:
 
   /// Signalling parameters.
   double    _mseSignal;
+  double    _complexitySignal;  ///< 1.0 = no signal.
 
   MeasurementTable  _RCTable;
   int               _RCTableLen;
@@ -45,6 +45,7 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #pragma once
 
 #include "RawFileHandlerBase.h"
+#include "YUV420IngestConverter.h"
 /*
 ---------------------------------------------------------------------------
 	Class definition.
@@ -68,6 +69,9 @@ public:
 	/// Read/In or write/out parameter for Get/PutNextUnit() method.
 	static const int YUV4208P	    = 0;
 	static const int YUV420NV12   = 1;
+	/// Packed 4:2:2 in types are read as YUV 4:2:0 with the chr rows averaged in pairs.
+	static const int YUV422YUY2   = 2;
+	static const int YUV422UYVY   = 3;
 
 	static const int YUV42016P    = 16;
 
@@ -88,6 +92,10 @@ protected:
   short*          _pBuff16;   ///< Units are 16-bit shorts in this implementation.
   unsigned char*  _pBuff8;   ///< Units are 8-bit chars in this implementation.
   int             _buffLen;
+  int             _frameLen;  ///< Bytes of one in frame in the file.
+
+  /// Full in frames are converted to 16-bit planes in one pass.
+  YUV420IngestConverter _ingest;
 
   /// YUV 4:2:0 data is stored contiguously as 8/16-bits per component in planar format.
   int     _inType;
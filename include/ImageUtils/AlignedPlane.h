@@ -0,0 +1,81 @@
+/** @file
+
+MODULE				: AlignedPlane
+
+TAG						: AP
+
+FILE NAME			: AlignedPlane.h
+
+DESCRIPTION		: Static utility to allocate 2-D image planes aligned to
+								a cache line with a padded row stride. The stride is a 
+								multiple of the SIMD width and is offset from multiples 
+								of 1K bytes to avoid cache set aliasing of the rows of 
+								vertical filters at power of two widths.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _ALIGNEDPLANE_H
+#define _ALIGNEDPLANE_H
+
+/// Plane alignment in bytes. A cache line and a multiple of all SIMD widths in use.
+#define AP_ALIGNMENT	64
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class AlignedPlane
+{
+public:
+	/** The padded row stride for a plane width.
+	The row bytes are rounded up to AP_ALIGNMENT. A stride that is a multiple of
+	1K bytes is extended by AP_ALIGNMENT so that consecutive rows do not map onto
+	the same cache sets.
+	@param width		: Plane width in elements.
+	@param elemSize	: Element size in bytes [1, 2, 4].
+	@return					: Stride in elements.
+	*/
+	static int Stride(int width, int elemSize);
+
+	/** Allocate an aligned plane.
+	The mem must be released with Free().
+	@param stride		: Row stride in elements from Stride().
+	@param height		: Num of rows.
+	@param elemSize	: Element size in bytes.
+	@return					: AP_ALIGNMENT aligned mem or NULL on failure.
+	*/
+	static void* Alloc(int stride, int height, int elemSize);
+	static void	 Free(void* ptr);
+
+};//end AlignedPlane.
+
+#endif	// _ALIGNEDPLANE_H
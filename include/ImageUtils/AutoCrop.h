@@ -24,6 +24,11 @@ RESTRICTIONS			: The information/data/code contained within this file is
 
 #include "VicsDefs/VicsDefs.h"
 
+// Streaming mode constants.
+#define AC_MAX_SAMPLES	64		// Max sample pels per tracked line.
+#define AC_GRID					8			// Scene cut sample grid is AC_GRID x AC_GRID pels.
+#define AC_TOLERANCE		2			// Boundary jitter in pels that is not a change.
+
 class AutoCrop  
 {
 public:
@@ -33,6 +38,23 @@ public:
 	VICS_INT	ProcessImage(BITMAPINFOHEADER *pBmih);
 	void			Reset();
 
+	// Streaming mode for live video. Only sample pels near the previous boundaries
+	// are read and a boundary change is reported after it persists for the
+	// hysteresis frames. A full scan is done on scene cuts and periodically.
+	VICS_INT	ProcessStream(BITMAPINFOHEADER *pBmih);
+	VICS_INT	HasChanged(void) { return(_changed); }
+
+	void			SetHysteresis(VICS_INT frames)	{ _hysteresis = frames; }
+	VICS_INT	GetHysteresis(void)							{ return(_hysteresis); }
+	void			SetRescanPeriod(VICS_INT frames){ _rescanPeriod = frames; }
+	VICS_INT	GetRescanPeriod(void)						{ return(_rescanPeriod); }
+	void			SetSearchWindow(VICS_INT pels)	{ _window = pels; }
+	VICS_INT	GetSearchWindow(void)						{ return(_window); }
+	void			SetSamples(VICS_INT n)					{ _samples = (n < 1) ? 1 : ((n > AC_MAX_SAMPLES) ? AC_MAX_SAMPLES : n); }
+	VICS_INT	GetSamples(void)								{ return(_samples); }
+	void			SetSceneCutLevel(VICS_INT lum)	{ _sceneCutLevel = lum; }
+	VICS_INT	GetSceneCutLevel(void)					{ return(_sceneCutLevel); }
+
 	// Memeber access interface.
 	VICS_INT	GetLeftMargin()		{ return(_marginLeft); }
 	VICS_INT	GetRightMargin()	{ return(_marginRight); }
@@ -48,6 +70,18 @@ public:
 	VICS_INT	Find1stEdge(VICS_PINT32 x,VICS_INT len);
 	VICS_INT	FindLastEdge(VICS_PINT32 x,VICS_INT len);
 
+protected:
+	VICS_INT	LocateImage(BITMAPINFOHEADER *pBmih,VICS_PBYTE *ppBmp,VICS_INT *pStride);
+	void			Accumulate(VICS_PBYTE bmptr,VICS_INT stride);
+	void			SetMargins(VICS_INT firstCol,VICS_INT lastCol,VICS_INT firstRow,VICS_INT lastRow);
+
+	// Streaming mode.
+	VICS_INT	Lum(VICS_PBYTE bmptr,VICS_INT stride,VICS_INT col,VICS_INT row);
+	VICS_INT	IsDark(VICS_PBYTE bmptr,VICS_INT stride,VICS_INT edge,VICS_INT pos);
+	VICS_INT	TrackEdge(VICS_PBYTE bmptr,VICS_INT stride,VICS_INT edge,VICS_INT *pPos);
+	void			Rescan(VICS_PBYTE bmptr,VICS_INT stride,VICS_INT *pBound);
+	VICS_INT	SceneCut(VICS_PBYTE bmptr,VICS_INT stride);
+
 protected:
 	VICS_INT	_marginLeft;
 	VICS_INT	_marginRight;
@@ -61,6 +95,24 @@ protected:
 	VICS_INT			_height;
 	VICS_PINT32		_pLeftRightAcc;		// Length of 1 row = no. of cols.
 	VICS_PINT32		_pTopBottomAcc;		// Length of 1 col = no. of rows.
+
+	// Streaming mode members. Bounds are {first col, last col, first row, last row}
+	// of the image content.
+	VICS_INT			_hysteresis;			// Frames a change must persist.
+	VICS_INT			_rescanPeriod;		// Frames between full scans.
+	VICS_INT			_window;					// Search pels either side of a boundary.
+	VICS_INT			_samples;					// Sample pels per line.
+	VICS_INT			_sceneCutLevel;		// Mean abs lum diff of a scene cut.
+	VICS_INT			_streamValid;
+	VICS_INT			_changed;
+	VICS_INT			_frames;					// Since the last full scan.
+	VICS_INT			_track[4];				// Last detected bounds.
+	VICS_INT			_report[4];				// Reported bounds.
+	VICS_INT			_pending[4];			// Unreported change.
+	VICS_INT			_pendingCount;
+	VICS_INT32		_colBlack;				// Dark mean squared lum of a col.
+	VICS_INT32		_rowBlack;				// Dark mean squared lum of a row.
+	VICS_INT			_grid[AC_GRID * AC_GRID];
 };
 
 #endif // !defined(AUTOCROP__H)
@@ -0,0 +1,93 @@
+/** @file
+
+MODULE				: FastAvx2RGB24toYUV420Converter
+
+TAG						: FAVX2RGBYUVC
+
+FILE NAME			: FastAvx2RGB24toYUV420Converter.h
+
+DESCRIPTION		: Fixed point AVX2 RGB 24 bit to YUV420 colour conversion derived
+								from the RGBtoYUV420Converter base class. The 32 pel inner loop
+								deinterleaves the packed pels with byte shuffles and averages the
+								2x2 chr in register. Output to 16 bit or 8 bit planes. The result
+								is identical to FastFixedPointRGB24toYUV420Converter.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _FASTAVX2RGB24TOYUV420CONVERTER_H
+#define _FASTAVX2RGB24TOYUV420CONVERTER_H
+
+#include "RGBtoYUV420Converter.h"
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+/**
+ * \ingroup ImageLib
+ * Fixed point AVX2 RGB 24 bit to YUV420 colour conversion. The AVX2 kernel
+ * is selected at run time when the cpu supports it otherwise an equivalent
+ * scalar path is used.
+ */
+class FastAvx2RGB24toYUV420Converter: public RGBtoYUV420Converter
+{
+public:
+	/// Construction and destruction.
+	FastAvx2RGB24toYUV420Converter(void) { _pelBytes = 3; _byteOutput = false; }
+	FastAvx2RGB24toYUV420Converter(int width, int height): RGBtoYUV420Converter(width,height) { _pelBytes = 3; _byteOutput = false; }
+	FastAvx2RGB24toYUV420Converter(int width, int height, int chrOff): RGBtoYUV420Converter(width,height, chrOff) { _pelBytes = 3; _byteOutput = false; }
+	virtual ~FastAvx2RGB24toYUV420Converter(void) {}
+
+	/// Interface. The planes are of type yuvType or unsigned char depending on the byte output mode.
+	void Convert(void* pRgb, void* pY, void* pU, void* pV);
+
+	/// Member interface.
+	/** Select the output plane type.
+	8 bit output saturates the chr to [0..255] and is therefore only meaningful
+	with a chr offset of 128.
+	@param byteOutput	: true = unsigned char planes, false = yuvType planes.
+	@return						: none.
+	*/
+	void SetByteOutput(bool byteOutput) { _byteOutput = byteOutput; }
+	bool GetByteOutput(void) const { return(_byteOutput); }
+
+	/// Does the cpu support the AVX2 kernel (checked at run time).
+	static int HasAvx2(void);
+
+protected:
+	/// Bytes per packed pel in the BGR(A) input.
+	int		_pelBytes;
+	bool	_byteOutput;
+
+};//end FastAvx2RGB24toYUV420Converter.
+
+#endif	// _FASTAVX2RGB24TOYUV420CONVERTER_H
@@ -0,0 +1,68 @@
+/** @file
+
+MODULE				: FastAvx2RGB32toYUV420Converter
+
+TAG						: FAVX2RGBYUVC
+
+FILE NAME			: FastAvx2RGB32toYUV420Converter.h
+
+DESCRIPTION		: Fixed point AVX2 RGB 32 bit to YUV420 colour conversion. The
+								alpha channel is ignored and the kernels are shared with the
+								FastAvx2RGB24toYUV420Converter class.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _FASTAVX2RGB32TOYUV420CONVERTER_H
+#define _FASTAVX2RGB32TOYUV420CONVERTER_H
+
+#include "FastAvx2RGB24toYUV420Converter.h"
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+/**
+ * \ingroup ImageLib
+ * Fixed point AVX2 RGB 32 bit to YUV420 colour conversion.
+ */
+class FastAvx2RGB32toYUV420Converter: public FastAvx2RGB24toYUV420Converter
+{
+public:
+	/// Construction and destruction.
+	FastAvx2RGB32toYUV420Converter(void) { _pelBytes = 4; }
+	FastAvx2RGB32toYUV420Converter(int width, int height): FastAvx2RGB24toYUV420Converter(width,height) { _pelBytes = 4; }
+	FastAvx2RGB32toYUV420Converter(int width, int height, int chrOff): FastAvx2RGB24toYUV420Converter(width,height, chrOff) { _pelBytes = 4; }
+	virtual ~FastAvx2RGB32toYUV420Converter(void) {}
+
+};//end FastAvx2RGB32toYUV420Converter.
+
+#endif	// _FASTAVX2RGB32TOYUV420CONVERTER_H
@@ -0,0 +1,132 @@
+/** @file
+
+MODULE				: FastFixedPointRGB24toYUV420ScaleConverter
+
+TAG						: FFPRGBYUVSC
+
+FILE NAME			: FastFixedPointRGB24toYUV420ScaleConverter.h
+
+DESCRIPTION		: Fused fixed point RGB 24 bit to YUV420 colour conversion and
+								scaling in a single pass. Each output row converts only the input
+								rows its 3x3 filter taps need into small row rings, replacing the
+								full size intermediate YUV frame of a separate converter and
+								PicScalerYUV420PImpl pass. The output is identical to
+								FastFixedPointRGB24toYUV420Converter followed by the
+								PicScalerYUV420PImpl filter.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _FASTFIXEDPOINTRGB24TOYUV420SCALECONVERTER_H
+#define _FASTFIXEDPOINTRGB24TOYUV420SCALECONVERTER_H
+
+#include "RGBtoYUV420Converter.h"
+
+/*
+===========================================================================
+  Constants.
+===========================================================================
+*/
+/// Rows in each ring. The 3x3 filter taps of an output row span 3 input rows.
+#define FFPRGBYUVSC_RING_ROWS	3
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+/**
+ * \ingroup ImageLib
+ * Convert an RGB 24 bit input image of the base class dimensions into YUV420
+ * planes of the output dimensions. The row rings and the filter tap tables
+ * are allocated by Create() and are re-created by Convert() if the input or
+ * output dimensions are changed.
+ */
+class FastFixedPointRGB24toYUV420ScaleConverter: public RGBtoYUV420Converter
+{
+public:
+	/// Construction and destruction.
+	FastFixedPointRGB24toYUV420ScaleConverter(void) { ResetMembers(); _widthOut = 0; _heightOut = 0; }
+	FastFixedPointRGB24toYUV420ScaleConverter(int widthOut, int heightOut, int widthIn, int heightIn): RGBtoYUV420Converter(widthIn, heightIn) 
+		{ ResetMembers(); _widthOut = widthOut; _heightOut = heightOut; }
+	FastFixedPointRGB24toYUV420ScaleConverter(int widthOut, int heightOut, int widthIn, int heightIn, int chrOff): RGBtoYUV420Converter(widthIn, heightIn, chrOff) 
+		{ ResetMembers(); _widthOut = widthOut; _heightOut = heightOut; }
+	virtual ~FastFixedPointRGB24toYUV420ScaleConverter(void) { Destroy(); }
+
+	/// Allocate the row rings and tap tables for the current dimensions.
+	int		Create(void);
+	void	Destroy(void);
+
+	/// Interface. The Y, U and V planes are of the output dimensions.
+	void Convert(void* pRgb, void* pY, void* pU, void* pV);
+
+	/// Member interface.
+	int	GetOutWidth(void)		{ return(_widthOut); }
+	int	GetOutHeight(void)	{ return(_heightOut); }
+	void SetOutDimensions(int widthOut, int heightOut)	{ _widthOut = widthOut; _heightOut = heightOut; }
+
+protected:
+	void ResetMembers(void);
+
+	/// Row conversion into the rings on demand.
+	yuvType*	GetLumRow(unsigned char* pRgb, int row);
+	int				GetChrRows(unsigned char* pRgb, int chrRow, yuvType** ppU, yuvType** ppV);
+
+	/// Input rgb row after the flip mapping.
+	unsigned char* RgbRow(unsigned char* pRgb, int row) { return(pRgb + (_flip ? (_height - 1 - row) : row) * _width * 3); }
+
+protected:
+	int	_widthOut;
+	int	_heightOut;
+
+	/// Dimensions of the current allocation.
+	int	_createdWidth;
+	int	_createdHeight;
+	int	_createdWidthOut;
+	int	_createdHeightOut;
+
+	/// Rings of converted rows tagged with their input row.
+	yuvType*	_pRowMem;
+	yuvType*	_pLumRing[FFPRGBYUVSC_RING_ROWS];
+	int				_lumTag[FFPRGBYUVSC_RING_ROWS];
+	yuvType*	_pURing[FFPRGBYUVSC_RING_ROWS];
+	yuvType*	_pVRing[FFPRGBYUVSC_RING_ROWS];
+	int				_chrTag[FFPRGBYUVSC_RING_ROWS];
+
+	/// Clamped input rows and [left,centre,right] input cols of each output pel.
+	int*	_pTapMem;
+	int*	_pLumRow;
+	int*	_pLumCol;
+	int*	_pChrRow;
+	int*	_pChrCol;
+
+};//end FastFixedPointRGB24toYUV420ScaleConverter.
+
+#endif	// _FASTFIXEDPOINTRGB24TOYUV420SCALECONVERTER_H
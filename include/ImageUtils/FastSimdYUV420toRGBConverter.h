@@ -0,0 +1,172 @@
+/** @file
+
+MODULE				: FastSimdYUV420toRGBConverter
+
+TAG						: FSYUVRGBC
+
+FILE NAME			: FastSimdYUV420toRGBConverter.h
+
+DESCRIPTION		: SIMD YUV420 to RGB24, RGB32 and RGB16 colour conversion derived
+								from the YUV420toRGBConverter base class. The SSE2 or AVX2 row
+								kernels are selected at run time from the cpu features and an
+								equivalent scalar path handles rotation and the row tails. The
+								inverted (bottom up) and byte write layouts are thin derived
+								classes of the same implementation.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _FASTSIMDYUV420TORGBCONVERTER_H
+#define _FASTSIMDYUV420TORGBCONVERTER_H
+
+#include "YUV420toRGBConverter.h"
+
+/*
+===========================================================================
+  Constants.
+===========================================================================
+*/
+/// Output pel formats.
+#define FSYUVRGBC_RGB24		0		///< Packed B,G,R bytes.
+#define FSYUVRGBC_RGB32		1		///< Packed B,G,R,0 bytes.
+#define FSYUVRGBC_RGB16		2		///< 16 bit 5-6-5 with B in the lsbs.
+
+/// Kernel levels.
+#define FSYUVRGBC_SCALAR	0
+#define FSYUVRGBC_SSE2		1
+#define FSYUVRGBC_AVX2		2
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+/**
+ * \ingroup ImageLib
+ * Fixed point SIMD YUV420 to RGB colour conversion. The input planes are yuvType
+ * with lum and chr in the range [0..255] and the result is within +/-1 of
+ * RealYUV420toRGB24ConverterImpl2. The kernel level is the highest supported
+ * by the cpu unless lowered with SetSimdLevel(). The scalar, SSE2 and AVX2
+ * paths produce identical output.
+ */
+class FastSimdYUV420toRGBConverter: public YUV420toRGBConverter
+{
+public:
+	/// Construction and destruction.
+	FastSimdYUV420toRGBConverter(int format) { ResetMembers(format); }
+	FastSimdYUV420toRGBConverter(int format, int width, int height): YUV420toRGBConverter(width, height) { ResetMembers(format); }
+	FastSimdYUV420toRGBConverter(int format, int width, int height, int chrOff): YUV420toRGBConverter(width, height, chrOff) { ResetMembers(format); }
+	virtual ~FastSimdYUV420toRGBConverter(void) {}
+
+	/// Interface.
+	virtual void Convert(void* pY, void* pU, void* pV, void* pRgb);
+
+	/// Member interface.
+	int GetFormat(void)			{ return(_format); }
+	int GetSimdLevel(void)	{ return(_simdLevel); }
+	/** Select the kernel level.
+	@param level	: FSYUVRGBC_SCALAR, FSYUVRGBC_SSE2 or FSYUVRGBC_AVX2.
+	@return				: 1 = success, 0 = not supported on this cpu.
+	*/
+	int SetSimdLevel(int level);
+
+	/// The highest kernel level supported by the cpu.
+	static int GetMaxSimdLevel(void);
+
+protected:
+	void ResetMembers(int format) { _format = format; _simdLevel = GetMaxSimdLevel(); }
+
+protected:
+	int	_format;
+	int	_simdLevel;
+
+};//end FastSimdYUV420toRGBConverter.
+
+/*
+===========================================================================
+  Output format classes.
+===========================================================================
+*/
+/// Packed 24 bit top down and bottom up (inverted) output.
+class FastSimdYUV420toRGB24Converter: public FastSimdYUV420toRGBConverter
+{
+public:
+	FastSimdYUV420toRGB24Converter(void): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB24) {}
+	FastSimdYUV420toRGB24Converter(int width, int height): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB24, width, height) {}
+	FastSimdYUV420toRGB24Converter(int width, int height, int chrOff): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB24, width, height, chrOff) {}
+};//end FastSimdYUV420toRGB24Converter.
+
+class FastSimdYUV420toInvRGB24Converter: public FastSimdYUV420toRGB24Converter
+{
+public:
+	FastSimdYUV420toInvRGB24Converter(void) { _flip = true; }
+	FastSimdYUV420toInvRGB24Converter(int width, int height): FastSimdYUV420toRGB24Converter(width, height) { _flip = true; }
+	FastSimdYUV420toInvRGB24Converter(int width, int height, int chrOff): FastSimdYUV420toRGB24Converter(width, height, chrOff) { _flip = true; }
+};//end FastSimdYUV420toInvRGB24Converter.
+
+/// Packed 32 bit output. The vector stores write the B,G,R,0 byte layout and
+/// therefore also serve the byte write class names.
+class FastSimdYUV420toRGB32Converter: public FastSimdYUV420toRGBConverter
+{
+public:
+	FastSimdYUV420toRGB32Converter(void): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB32) {}
+	FastSimdYUV420toRGB32Converter(int width, int height): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB32, width, height) {}
+	FastSimdYUV420toRGB32Converter(int width, int height, int chrOff): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB32, width, height, chrOff) {}
+};//end FastSimdYUV420toRGB32Converter.
+
+class FastSimdYUV420toInvRGB32Converter: public FastSimdYUV420toRGB32Converter
+{
+public:
+	FastSimdYUV420toInvRGB32Converter(void) { _flip = true; }
+	FastSimdYUV420toInvRGB32Converter(int width, int height): FastSimdYUV420toRGB32Converter(width, height) { _flip = true; }
+	FastSimdYUV420toInvRGB32Converter(int width, int height, int chrOff): FastSimdYUV420toRGB32Converter(width, height, chrOff) { _flip = true; }
+};//end FastSimdYUV420toInvRGB32Converter.
+
+typedef FastSimdYUV420toRGB32Converter		FastSimdYUV420toRGB32Converter_ByteWrite;
+typedef FastSimdYUV420toInvRGB32Converter	FastSimdYUV420toInvRGB32Converter_ByteWrite;
+
+/// 16 bit 5-6-5 output.
+class FastSimdYUV420toRGB16Converter: public FastSimdYUV420toRGBConverter
+{
+public:
+	FastSimdYUV420toRGB16Converter(void): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB16) {}
+	FastSimdYUV420toRGB16Converter(int width, int height): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB16, width, height) {}
+	FastSimdYUV420toRGB16Converter(int width, int height, int chrOff): FastSimdYUV420toRGBConverter(FSYUVRGBC_RGB16, width, height, chrOff) {}
+};//end FastSimdYUV420toRGB16Converter.
+
+class FastSimdYUV420toInvRGB16Converter: public FastSimdYUV420toRGB16Converter
+{
+public:
+	FastSimdYUV420toInvRGB16Converter(void) { _flip = true; }
+	FastSimdYUV420toInvRGB16Converter(int width, int height): FastSimdYUV420toRGB16Converter(width, height) { _flip = true; }
+	FastSimdYUV420toInvRGB16Converter(int width, int height, int chrOff): FastSimdYUV420toRGB16Converter(width, height, chrOff) { _flip = true; }
+};//end FastSimdYUV420toInvRGB16Converter.
+
+#endif	// _FASTSIMDYUV420TORGBCONVERTER_H
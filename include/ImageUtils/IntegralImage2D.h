@@ -0,0 +1,100 @@
+/** @file
+
+MODULE				: IntegralImage2D
+
+TAG						: II2D
+
+FILE NAME			: IntegralImage2D.h
+
+DESCRIPTION		: A summed area table over a 2-D short mem block. Used to get
+								the sum of any rectangular block in 4 lookups. The table
+								is held as unsigned int so that block sums remain exact
+								under modulo 2^32 arithmetic for large images.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _INTEGRALIMAGE2D_H
+#define _INTEGRALIMAGE2D_H
+
+#pragma once
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class IntegralImage2D
+{
+/// Construction.
+public:
+	IntegralImage2D(void);
+	virtual ~IntegralImage2D(void);
+
+	/// Alloc the table for a width x height src. Returns 0 on failure.
+	int		Create(int width, int height);
+	void	Destroy(void);
+
+/// Interface.
+public:
+	int		Ready(void)			{ return(_pTable != NULL); }
+	int		GetWidth(void)	{ return(_width); }
+	int		GetHeight(void)	{ return(_height); }
+
+	/** Build the table from a short or 8-bit 2-D src with row address array.
+	The src dimensions must match those on Create().
+	@param pSrc	: Row address array of the src mem.
+	@return			: None.
+	*/
+	void Load(short** pSrc);
+	void Load(unsigned char** pSrc);
+
+	/// Sum of the width x height block with top left at (x,y).
+	int BlockSum(int x, int y, int width, int height)
+	{
+		unsigned int* pT = &(_pTable[(y * _stride) + x]);
+		unsigned int* pB = pT + (height * _stride);
+		return((int)(pB[width] - pB[0] - pT[width] + pT[0]));
+	}//end BlockSum.
+
+protected:
+	void ResetMembers(void);
+	template<typename T> void LoadRows(T** pSrc);
+
+protected:
+	int						_width;		///< Src dimensions.
+	int						_height;
+	int						_stride;	///< Table row length = _width + 1.
+	/// Table of (_width+1) x (_height+1) with a zero top row and left column.
+	unsigned int*	_pTable;
+};//end IntegralImage2D.
+
+#endif	// _INTEGRALIMAGE2D_H
+
@@ -58,6 +58,7 @@ protected:
 public:
 	virtual int GetWidth(void)	{ return(_width); }
 	virtual int GetHeight(void)	{ return(_height); }
+	virtual int GetStride(void)	{ return(_stride); }	// Padded row length in elements.
 
 	virtual M2D_TYPE** Get2DPtr(void)	{ return(_pBlock); }
 
@@ -131,9 +132,10 @@ public:
 protected:
 	int	_width;							// Mem width and height.
 	int	_height;
+	int	_stride;						// Aligned row length >= _width.
 
 	// Mem is 2-D with row address array for speed.
-	M2D_TYPE*		_pMem;			// Contiguous mem.
+	M2D_TYPE*		_pMem;			// Contiguous aligned mem of _stride x _height.
 	M2D_TYPE**	_pBlock;		// Rows within _pMem;
 
 	// Constants.
@@ -46,9 +46,10 @@ class MemBlock2D
 protected:
 	VICS_INT	_width;							// Block width and height.
 	VICS_INT	_height;
+	VICS_INT	_stride;						// Aligned row length >= _width.
 
 	// Mem block is 2-D with row address array for speed.
-	MB2D_TYPE*	_pMem;			// Contiguous mem.
+	MB2D_TYPE*	_pMem;			// Contiguous aligned mem of _stride x _height.
 	MB2D_TYPE**	_pBlock;		// Rows within _pMem;
 
 	// Candidate search support members.
@@ -71,6 +72,7 @@ public:
 	// Member access.
 	virtual VICS_INT GetWidth(void)		{ return(_width); }
 	virtual VICS_INT GetHeight(void)	{ return(_height); }
+	virtual VICS_INT GetStride(void)	{ return(_stride); }
 
 	// Interface.
 
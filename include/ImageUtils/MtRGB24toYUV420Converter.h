@@ -1,13 +1,17 @@
 /** @file
 
-MODULE				: RealRGB24toYUV420Converter
+MODULE				: MtRGB24toYUV420Converter
 
-FILE NAME			: RealRGB24toYUV420Converter.h
+TAG						: MTRGB24YUVC
+
+FILE NAME			: MtRGB24toYUV420Converter.h
+
+DESCRIPTION		: Multithreaded double precision floating point RGB 24 bit to 
+								YUV420 colour convertion. The frame is split into row stripes
+								aligned to the 2 row chr pairs and the stripes are converted 
+								on a persistent pool of std::thread workers. The output is 
+								identical to RealRGB24toYUV420ConverterImpl2.
 
-DESCRIPTION			: Double precision floating point RGB 24 bit to YUV420 colour 
-					convertion derived from the RGBtoYUV420Converter base class.
-					Use this implementation as the reference.
-	  
 LICENSE: Software License Agreement (BSD License)
 
 Copyright (c) 2008 - 2012, CSIR
@@ -35,81 +39,83 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include "RGBtoYUV420Converter.h"
-
-#ifdef USE_MULTI_THREADED
-#include <Winsock2.h>
-#include <boost/asio/io_service.hpp>
-#include <boost/thread.hpp>
-/**
- * \ingroup ImageLib
- * Double precision floating point RGB 24 bit to YUV420 colour 
- * convertion derived from the RGBtoYUV420Converter base class.
- * Use this implementation as the reference.
- */
-class MtRGB24toYUV420Converter: public RGBtoYUV420Converter
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "RealRGB24toYUV420ConverterImpl2.h"
+
+/*
+===========================================================================
+  Constants.
+===========================================================================
+*/
+#define MTRGB24YUVC_MAX_THREADS					16
+#define MTRGB24YUVC_STRIPES_PER_THREAD	4		///< Default load balancing granularity.
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+class MtRGB24toYUV420Converter: public RealRGB24toYUV420ConverterImpl2
 {
 public:
-    /// Construction and destruction.
-    MtRGB24toYUV420Converter(void)
-      : work(io_service),
-      finished1(false),
-      finished2(false),
-      uiConverted1(0),
-      uiConverted2(0)
-    { init(); }
-    MtRGB24toYUV420Converter(int width, int height)
-      : RGBtoYUV420Converter(width,height),
-      work(io_service),
-      finished1(false),
-      finished2(false),
-      uiConverted1(0),
-      uiConverted2(0)
-    { init(); }
-    MtRGB24toYUV420Converter(int width, int height, int chrOff)
-      : RGBtoYUV420Converter(width,height, chrOff),
-      work(io_service),
-      finished1(false),
-      finished2(false),
-      uiConverted1(0),
-      uiConverted2(0)
-    { init(); }
-    virtual ~MtRGB24toYUV420Converter(void) 
-    {
-      io_service.stop();
-      threads.join_all();
-    }
-
-    /// Interface.
-    void Convert(void* pRgb, void* pY, void* pU, void* pV);
+	/// Construction and destruction.
+	MtRGB24toYUV420Converter(void) { ResetMembers(); }
+	MtRGB24toYUV420Converter(int width, int height) : RealRGB24toYUV420ConverterImpl2(width, height) { ResetMembers(); }
+	MtRGB24toYUV420Converter(int width, int height, int chrOff) : RealRGB24toYUV420ConverterImpl2(width, height, chrOff) { ResetMembers(); }
+	virtual ~MtRGB24toYUV420Converter(void) { StopWorkers(); }
+
+	/// Interface. Returns when the whole frame is converted.
+	void Convert(void* pRgb, void* pY, void* pU, void* pV);
+
+	/// Member interface.
+	/** Set the num of threads that share a frame.
+	The calling thread is one of them, so 1 converts on the calling thread only.
+	The workers are started on the next Convert() call.
+	@param threads	: [1..MTRGB24YUVC_MAX_THREADS].
+	@return					: 1 = success, 0 = out of range.
+	*/
+	int SetThreads(int threads);
+	int GetThreads(void) { return(_threads); }
+
+	/** Set the num of row stripes per thread.
+	More stripes than threads balance uneven thread progress at the cost of more
+	scheduling. The stripes never split a 2 row chr pair.
+	@param stripes	: Stripes per thread >= 1.
+	@return					: 1 = success, 0 = out of range.
+	*/
+	int SetStripesPerThread(int stripes);
+	int GetStripesPerThread(void) { return(_stripesPerThread); }
 
 protected:
+	void ResetMembers(void);
+	int  StartWorkers(int workers);
+	void StopWorkers(void);
+	void Worker(unsigned int generation);
+	void RunStripes(void);	///< Claim and convert stripes of the current frame until none are left.
 
-  void init();
-  void doConvert(unsigned char* pRgb, yuvType* pY, yuvType* pU, yuvType* pV, unsigned uiThread);
-
-  float m_RRGB24YUVCI2_00[256];
-  float m_RRGB24YUVCI2_01[256];
-  float m_RRGB24YUVCI2_02[256];
-  float m_RRGB24YUVCI2_10[256];
-  float m_RRGB24YUVCI2_11[256];
-  float m_RRGB24YUVCI2_12[256];
-  float m_RRGB24YUVCI2_20[256];
-  float m_RRGB24YUVCI2_21[256];
-  float m_RRGB24YUVCI2_22[256];
-
-  // for threads
-  boost::asio::io_service io_service;
-  boost::asio::io_service::work work;
-  boost::thread_group threads;
-
-  bool finished1;
-  bool finished2;
-  unsigned uiConverted1;
-  unsigned uiConverted2;
-
-  boost::condition_variable condvar;
-  boost::mutex mutex;
-};
-
-#endif
+protected:
+	int						_threads;
+	int						_stripesPerThread;
+
+	/// Persistent workers. The caller is not counted.
+	std::thread*	_pWorker[MTRGB24YUVC_MAX_THREADS];
+	int						_workers;
+
+	/// Frame job shared with the workers under _mutex.
+	std::mutex							_mutex;
+	std::condition_variable	_startCond;
+	std::condition_variable	_doneCond;
+	unsigned int						_generation;	///< Incremented per frame to release the workers.
+	int											_stop;
+	void*										_pRgb;
+	void*										_pY;
+	void*										_pU;
+	void*										_pV;
+	int											_yBlks;				///< 2x2 block rows in the frame.
+	int											_stripes;
+	int											_nextStripe;
+	int											_doneStripes;
+
+};//end MtRGB24toYUV420Converter.
@@ -58,7 +58,8 @@ class OverlayExtMem2Dv2: public OverlayMem2Dv2
 public:
 	OverlayExtMem2Dv2(void* srcPtr, int srcWidth, int srcHeight, 
 																	int width,		int height,
-																	int bWidth,		int bHeight);
+																	int bWidth,		int bHeight,
+																	int srcStride = 0);
 
 	virtual ~OverlayExtMem2Dv2();
 
@@ -74,14 +75,24 @@ public:
 	/// Extend the boundary by alloc new mem. These static methods must
 	/// be called from the thread that owns the src mem to ensure it is
 	/// thread safe.	They are utility functions and are independent of the class. 
+	/// The mem of ExtendBoundary() is a new[] alloc that the caller delete[]s.
 	static int ExtendBoundary(void* srcPtr, 
 														int srcWidth,int srcHeight, 
 														int widthBy, int heightBy,
 														void** dstPtr);
+	/// The same extension into mem borrowed from the shared PlanePool that must be 
+	/// returned with ReleaseBoundary(). Re-opens at the same dimensions recycle the 
+	/// mem without a heap alloc.
+	static int AcquireBoundary(void* srcPtr, 
+														 int srcWidth,int srcHeight, 
+														 int widthBy, int heightBy,
+														 void** dstPtr);
+	static void ReleaseBoundary(void* extPtr);
 
 	/// Fill an existing boundary.
 	static void FillBoundary(void* srcPtr, int srcWidth,int srcHeight, 
-																				 int widthBy,	int heightBy);
+																				 int widthBy,	int heightBy,
+																				 int srcStride = 0);
 
 	/// Proxy class method.
 	void 	FillBoundaryProxy(void);
@@ -55,18 +55,19 @@ class OverlayMem2Dv2
 {
 	/// Construction and destruction.
 public:
-	OverlayMem2Dv2(void* srcPtr, int srcWidth, int srcHeight, int width, int height);
+	OverlayMem2Dv2(void* srcPtr, int srcWidth, int srcHeight, int width, int height, int srcStride = 0);
 	virtual ~OverlayMem2Dv2();
 
 protected:
 	void	ResetMembers(void);
 	void	Destroy(void);
-	int   SetMem(void* srcPtr, int srcWidth, int srcHeight);
+	int   SetMem(void* srcPtr, int srcWidth, int srcHeight, int srcStride = 0);
 
 	/// Member access.
 public:
 	int		GetWidth(void)	{ return(_width); }
 	int		GetHeight(void)	{ return(_height); }
+	int		GetStride(void)	{ return(_stride); }		///< Row stride of the underlying mem in shorts.
 	void	SetOverlayDim(int width, int height) { _width = width; _height = height; }
 
 	int		GetOriginX(void) { return(_xPos); }
@@ -145,6 +146,12 @@ public:
 		{ EighthRead(*this, dstBlock, eighthColOff, eighthRowOff); }
 	static void EighthRead(OverlayMem2Dv2& me, OverlayMem2Dv2& dstBlock, int eighthColOff, int eighthRowOff);
 
+	/// A destination sized block from a mem position that may lie partly or wholly
+	/// outside of the mem. The edge pels are replicated for the outside positions.
+	void EdgeRead(OverlayMem2Dv2& dstBlock, int fromCol, int fromRow)
+		{ EdgeRead(*this, dstBlock, fromCol, fromRow); }
+	static void EdgeRead(OverlayMem2Dv2& me, OverlayMem2Dv2& dstBlock, int fromCol, int fromRow);
+
 	/// Interface: Operation functions.
 public:
 
@@ -307,16 +314,25 @@ public:
   /// Dump the current block into a file.
   static void Dump(OverlayMem2Dv2* pBlk, char* filename, const char* title);
 
+	/// Num of Tsd/Tad block metric evaluations since the last reset. Only counted
+	/// when built with OM2DV2_COUNT_EVALUATIONS defined.
+	static int				CountsEvaluations(void);
+	static long long	GetEvaluations(void)		{ return(_evaluations); }
+	static void				ResetEvaluations(void)	{ _evaluations = 0; }
+	static void				CountEvaluation(void)	{ _evaluations++; }	///< For localised metrics outside of this class.
+
 protected:
 	/// Class constants
 	static int OM2DV2_Sp[17];
 	static int OM2DV2_Tp[17];
+	static long long _evaluations;
 
 protected:
 	int					_width;				///< Overlay mem width and height.
 	int					_height;
 	int					_srcWidth;		///< Underlying mem width, height and ptr
 	int					_srcHeight;		///< initialised in the constructor.
+	int					_stride;			///< Row stride of the mem >= _srcWidth.
 	short*			_pMem;
 
 	/// Mem is 2-D with row address array for speed.
@@ -0,0 +1,216 @@
+/** @file
+
+MODULE				: OverlayMem2Dv2u8
+
+TAG						: OM2DV2U8
+
+FILE NAME			: OverlayMem2Dv2u8.h
+
+DESCRIPTION		: A class to overlay a two-dimensional mem structure onto
+								a contiguous block (usually larger) of memory and provide
+								several operations on 2-D blocks where the data type is
+								unsigned char (8-bit pels). It is the reference and source
+								plane counterpart of OverlayMem2Dv2 that halves the mem
+								bandwidth of block metrics, interpolation and copies. An
+								optional boundary offsets the origin as in OverlayExtMem2Dv2.
+								The 16-bit type remains for residuals and coefficients.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _OVERLAYMEM2DV2U8_H
+#define _OVERLAYMEM2DV2U8_H
+
+#include "OverlayMem2Dv2.h"
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class OverlayMem2Dv2u8
+{
+	/// Construction and destruction.
+public:
+	OverlayMem2Dv2u8(void* srcPtr, int srcWidth, int srcHeight, int width, int height, int bWidth = 0, int bHeight = 0, int srcStride = 0);
+	virtual ~OverlayMem2Dv2u8();
+
+protected:
+	void	ResetMembers(void);
+	void	Destroy(void);
+	int		CreateWork(void);
+
+public:
+	int   SetMem(void* srcPtr, int srcWidth, int srcHeight, int srcStride = 0);
+
+	/// Member access.
+public:
+	int		GetWidth(void)	{ return(_width); }
+	int		GetHeight(void)	{ return(_height); }
+	int		GetStride(void)	{ return(_stride); }		///< Row stride of the underlying mem in bytes.
+	void	SetOverlayDim(int width, int height) { _width = width; _height = height; }
+	int		GetOriginX(void) { return(_xPos); }		///< In mem coords including the boundary.
+	int		GetOriginY(void) { return(_yPos); }
+	int		GetBoundaryWidth(void)	{ return(_bWidth); }
+	int		GetBoundaryHeight(void)	{ return(_bHeight); }
+
+	/// The origin is relative to the top left of the mem inside the boundary and
+	/// may be -ve into the boundary. It is clamped to the mem.
+	void	SetOrigin(int x, int y);
+	unsigned char**	Get2DSrcPtr(void) { return(_pBlock); }
+
+	/// Interface: Input/output functions.
+public:
+	/// Write a single value.
+	void Write(int toCol, int toRow, int value) 
+		{ _pBlock[_yPos + toRow][_xPos + toCol] = (unsigned char)value; }
+	/// All of the source to all of the block. Must be equal footprint.
+	void Write(OverlayMem2Dv2u8& srcBlock)
+		{ Write(*this, srcBlock); }
+	static void Write(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& srcBlock);
+	/// All of the 16-bit source to all of the block clipped to [0..255].
+	void Write(OverlayMem2Dv2& srcBlock)
+		{ Write(*this, srcBlock); }
+	static void Write(OverlayMem2Dv2u8& me, OverlayMem2Dv2& srcBlock);
+
+	/// Read a single value.
+	int	Read(int fromCol, int fromRow) 
+		{ return(_pBlock[_yPos + fromRow][_xPos + fromCol]); }
+	/// All of the block to all of the destination. Must be equal footprint.
+	void Read(OverlayMem2Dv2u8& dstBlock)
+		{ Read(*this, dstBlock); }
+	static void Read(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& dstBlock);
+	/// All of the block to all of the 16-bit destination.
+	void Read(OverlayMem2Dv2& dstBlock)
+		{ Read(*this, dstBlock); }
+	static void Read(OverlayMem2Dv2u8& me, OverlayMem2Dv2& dstBlock);
+
+	/// All of the block at 1/4 and 1/8 pel position to all of the destination. Bit
+	/// exact with the OverlayMem2Dv2 reads.
+	void QuarterRead(OverlayMem2Dv2u8& dstBlock, int quarterColOff, int quarterRowOff)
+		{ QuarterRead(*this, dstBlock, quarterColOff, quarterRowOff); }
+	static void QuarterRead(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& dstBlock, int quarterColOff, int quarterRowOff);
+	void EighthRead(OverlayMem2Dv2u8& dstBlock, int eighthColOff, int eighthRowOff)
+		{ EighthRead(*this, dstBlock, eighthColOff, eighthRowOff); }
+	static void EighthRead(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& dstBlock, int eighthColOff, int eighthRowOff);
+
+	/// A destination sized block from a mem position that may lie partly or wholly
+	/// outside of the mem. The edge pels are replicated for the outside positions.
+	void EdgeRead(OverlayMem2Dv2u8& dstBlock, int fromCol, int fromRow)
+		{ EdgeRead(*this, dstBlock, fromCol, fromRow); }
+	static void EdgeRead(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& dstBlock, int fromCol, int fromRow);
+
+	/// Interface: Operation functions.
+public:
+	/// Set block values to a value.
+	void Fill(int value)
+		{ Fill(*this, value); }
+	static void Fill(OverlayMem2Dv2u8& me, int value);
+
+	/// Calc total square difference with the input block.
+	int Tsd(OverlayMem2Dv2u8& b)
+		{ return( Tsd(*this, b) ); }
+	static int Tsd(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b);
+	int Tsd8x8(OverlayMem2Dv2u8& b)
+		{ return( Tsd8x8(*this, b) ); }
+	static int Tsd8x8(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b);			///< Fast for 8x8 blocks.
+	int Tsd16x16(OverlayMem2Dv2u8& b)
+		{ return( Tsd16x16(*this, b) ); }
+	static int Tsd16x16(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b);		///< Fast for 16x16 blocks.
+	/// The total square difference with the input to improve on an input value.
+	int Tsd8x8LessThan(OverlayMem2Dv2u8& b, int min)
+		{ return( Tsd8x8LessThan(*this, b, min) ); }
+	static int Tsd8x8LessThan(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b, int min);
+	int Tsd16x16LessThan(OverlayMem2Dv2u8& b, int min)
+		{ return( Tsd16x16LessThan(*this, b, min) ); }
+	static int Tsd16x16LessThan(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b, int min);
+
+	/// Calc total absolute difference with the input block.
+	int Tad(OverlayMem2Dv2u8& b)
+		{ return( Tad(*this, b) ); }
+	static int Tad(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b);
+	int Tad4x4(OverlayMem2Dv2u8& b)
+		{ return( Tad4x4(*this, b) ); }
+	static int Tad4x4(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b);			///< Fast for 4x4 blocks.
+	int Tad8x8(OverlayMem2Dv2u8& b)
+		{ return( Tad8x8(*this, b) ); }
+	static int Tad8x8(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b);			///< Fast for 8x8 blocks.
+	int Tad16x16(OverlayMem2Dv2u8& b)
+		{ return( Tad16x16(*this, b) ); }
+	static int Tad16x16(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b);		///< Fast for 16x16 blocks.
+	/// The total abs difference with the input to improve on an input value.
+	int Tad8x8LessThan(OverlayMem2Dv2u8& b, int min)
+		{ return( Tad8x8LessThan(*this, b, min) ); }
+	static int Tad8x8LessThan(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b, int min);
+	int Tad16x16LessThan(OverlayMem2Dv2u8& b, int min)
+		{ return( Tad16x16LessThan(*this, b, min) ); }
+	static int Tad16x16LessThan(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b, int min);
+
+	/// Static independent helper functions.
+public:
+	/// Replicate the edge pels of the mem inside the boundary into the boundary.
+	void FillBoundaryProxy(void)
+		{ FillBoundary(_pMem, _srcWidth, _srcHeight, _bWidth, _bHeight, _stride); }
+	static void FillBoundary(void* srcPtr, int srcWidth, int srcHeight, int widthBy, int heightBy, int srcStride = 0);
+
+	/// Sub sample the src by half into another 2D mem block with possible offset.
+	static void Half(void** srcPtr, int srcWidth, int srcHeight,
+									 void** dstPtr, int widthOff = 0, int heightOff = 0);
+
+	/// Convert contiguous pels between 16-bit and 8-bit. Narrowing clips to [0..255].
+	static void Narrow(const short* srcPtr, unsigned char* dstPtr, int len);
+	static void Widen(const unsigned char* srcPtr, short* dstPtr, int len);
+
+protected:
+	int							_width;				///< Overlay mem width and height.
+	int							_height;
+	int							_srcWidth;		///< Underlying mem width, height and ptr
+	int							_srcHeight;		///< initialised in the constructor.
+	int							_stride;			///< Row stride of the mem >= _srcWidth.
+	unsigned char*	_pMem;
+	/// Mem is 2-D with row address array for speed.
+	unsigned char**	_pBlock;			///< Rows within _srcPtr;
+	///< Origin of the top left corner of the overlay block within the mem.
+	int							_xPos;
+	int							_yPos;
+	/// Boundary around the mem that offsets the origin.
+	int							_bWidth;
+	int							_bHeight;
+
+	/// 16-bit work blocks for the vectorised interpolation. Created on first use
+	/// so an overlay must not be shared by concurrent threads.
+	short*					_pWin;
+	OverlayMem2Dv2*	_pWinOver;
+	short*					_pBlk;
+	OverlayMem2Dv2*	_pBlkOver;
+
+};// end class OverlayMem2Dv2u8.
+
+#endif	//end _OVERLAYMEM2DV2U8_H.
@@ -0,0 +1,178 @@
+/** @file
+
+MODULE				: PicMosaicBase
+
+TAG						: PMOS
+
+FILE NAME			: PicMosaicBase.h
+
+DESCRIPTION		: Base class of a multi-input mosaic compositor. Input
+								frames are optionally scaled to their layout regions
+								and the dirty regions are written to the canvas in one
+								pass of bands shared between threads.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _PICMOSAICBASE_H
+#define _PICMOSAICBASE_H
+
+#include <atomic>
+
+class PicScalerPolyphaseImpl;
+
+/*
+===========================================================================
+  Constants.
+===========================================================================
+*/
+#define PMOS_MAX_REGIONS		64
+#define PMOS_MAX_THREADS		16
+#define PMOS_MAX_PLANES			3
+/// Default canvas lum rows per band.
+#define PMOS_BAND_HEIGHT		32
+
+/// Layout region of an input.
+typedef struct _PMOS_REGION
+{
+	int							srcWidth;		///< Input frame dimensions.
+	int							srcHeight;
+	int							x;					///< Canvas rect.
+	int							y;
+	int							width;
+	int							height;
+	const void*			pImg;				///< Current input frame.
+	int							dirty;			///< Input changed since the last compose.
+	PicScalerPolyphaseImpl*	pScaler;	///< Scaler to the rect dimensions, NULL = no scaling.
+	unsigned char*	pScaled;		///< Scaled frame.
+} PMOS_REGION;
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+/**
+ * \ingroup ImageLib
+ * Composite up to PMOS_MAX_REGIONS input frames into a canvas. Regions are
+ * drawn in the order they were added so that later regions lie on top.
+ * SetInput() marks a region as dirty and Compose() only rewrites the canvas
+ * pels under dirty regions. The whole canvas is redrawn on the first compose,
+ * after a layout change or Invalidate() and when the canvas pointer differs
+ * from the previous compose. Dirty inputs that require scaling are scaled in
+ * parallel and then the canvas bands are claimed by the threads. The derived
+ * classes describe the planes of the image format.
+ */
+class PicMosaicBase
+{
+public:
+	PicMosaicBase(void);
+	virtual ~PicMosaicBase(void);
+
+	/// Canvas dimensions. Any previous layout is destroyed.
+	int		Create(int width, int height);
+	void	Destroy(void);
+
+	/// Layout. AddRegion() returns the region index or -1 if the region does not 
+	/// fit in the canvas or is not aligned to the format.
+	int		AddRegion(int srcWidth, int srcHeight, int x, int y, int width, int height);
+	/// Lay out cols x rows equal regions separated by gap pels. Returns 1 = success.
+	int		AddGrid(int cols, int rows, int srcWidth, int srcHeight, int gap);
+	void	ClearRegions(void);
+
+	/// Set the current frame of a region and mark it dirty. Return 1 = success.
+	/// The frame is referenced and not copied. The last frame set for EVERY region
+	/// must remain valid until it is replaced by another SetInput() or the regions
+	/// are cleared, as any Compose() may redraw clean regions that overlap a dirty
+	/// one and a full redraw re-reads and re-scales all of them.
+	int		SetInput(int region, const void* pImg);
+	/// Redraw the whole canvas on the next compose.
+	void	Invalidate(void) { _full = 1; }
+
+	/// Write the dirty regions into the canvas. Return 1 = success.
+	int		Compose(void* pCanvas);
+
+	/// Member interface.
+	int		GetWidth(void)			{ return(_width); }
+	int		GetHeight(void)			{ return(_height); }
+	int		GetRegions(void)		{ return(_regions); }
+	int		GetThreads(void)		{ return(_threads); }
+	int		SetThreads(int threads);
+	int		GetBandHeight(void)	{ return(_bandHeight); }
+	int		SetBandHeight(int height);
+	/// PicScalerPolyphaseImpl filter of regions added after the call.
+	int		GetFilter(void)			{ return(_filter); }
+	void	SetFilter(int filter)	{ _filter = filter; }
+
+protected:
+	void ResetMembers(void);
+
+	/// Byte offset of a plane in a contiguous image of the dimensions.
+	int		PlaneOffset(int plane, int width, int height);
+	/// Pel alignment of the sub sampled planes.
+	int		Alignment(void) { return(1 << _maxShift); }
+
+	void	Parallel(int phase, int jobs);
+	void	Work(int phase);
+	void	ScaleRegion(int region);
+	void	ComposeBand(int band);
+
+protected:
+	/// Format description set by the derived classes.
+	int							_planes;
+	int							_pelBytes[PMOS_MAX_PLANES];
+	int							_shift[PMOS_MAX_PLANES];
+	int							_maxShift;
+	unsigned char		_fill[PMOS_MAX_PLANES][4];	///< Background pel of each plane.
+	int							_scaleFormat;								///< PicScalerPolyphaseImpl format.
+	int							_chrOff;										///< Chr offset of the region scalers.
+
+	int							_width;
+	int							_height;
+	int							_threads;
+	int							_bandHeight;
+	int							_filter;
+
+	PMOS_REGION			_region[PMOS_MAX_REGIONS];
+	int							_regions;
+
+	/// Compose state.
+	int							_full;
+	void*						_pLastCanvas;
+	unsigned char*	_pCanvas;
+	int							_dirtyRect[PMOS_MAX_REGIONS + 1][4];
+	int							_dirtyRects;
+	int							_scaleList[PMOS_MAX_REGIONS];
+	int							_scales;
+	std::atomic<int>	_next;
+
+};//end PicMosaicBase.
+
+#endif	// _PICMOSAICBASE_H
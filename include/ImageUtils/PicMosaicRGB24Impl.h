@@ -0,0 +1,72 @@
+/** @file
+
+MODULE				: PicMosaicRGB24Impl
+
+TAG						: PMOS
+
+FILE NAME			: PicMosaicRGB24Impl.h
+
+DESCRIPTION		: A packed RGB24 implementation of the PicMosaicBase()
+								mosaic compositor.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _PICMOSAICRGB24IMPL_H
+#define _PICMOSAICRGB24IMPL_H
+
+#include "PicMosaicBase.h"
+#include "PicScalerPolyphaseImpl.h"
+
+/**
+ * \ingroup ImageLib
+ * Composite packed RGB24 input frames into an RGB24 canvas on a black background.
+ */
+class PicMosaicRGB24Impl: public PicMosaicBase
+{
+public:
+	PicMosaicRGB24Impl(void)
+	{
+		_planes				= 1;
+		_pelBytes[0]	= 3;
+		_shift[0]			= 0;
+		_maxShift			= 0;
+		_scaleFormat	= PSPOLY_RGB24;
+		SetBackground(0, 0, 0);
+	}//end constructor.
+	virtual ~PicMosaicRGB24Impl(void) {}
+
+	/// Background colour of the canvas outside the regions.
+	void SetBackground(int r, int g, int b) 
+		{ _fill[0][0] = (unsigned char)b; _fill[0][1] = (unsigned char)g; _fill[0][2] = (unsigned char)r; Invalidate(); }
+
+};//end PicMosaicRGB24Impl.
+
+#endif	// _PICMOSAICRGB24IMPL_H
@@ -0,0 +1,97 @@
+/** @file
+
+MODULE				: PicMosaicYUV420PImpl
+
+TAG						: PMOS
+
+FILE NAME			: PicMosaicYUV420PImpl.h
+
+DESCRIPTION		: A YUV420P planar implementation of the PicMosaicBase()
+								mosaic compositor.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _PICMOSAICYUV420PIMPL_H
+#define _PICMOSAICYUV420PIMPL_H
+
+#include <string.h>
+
+#include "PicMosaicBase.h"
+#include "PicScalerPolyphaseImpl.h"
+
+/**
+ * \ingroup ImageLib
+ * Composite YUV420P planar input frames into a YUV420P canvas without an RGB
+ * round trip. The samples are 1 byte with a chr offset of 128 or 2 byte codec
+ * shorts with signed chr. The canvas, region rects and input dimensions must
+ * be even.
+ */
+class PicMosaicYUV420PImpl: public PicMosaicBase
+{
+public:
+	PicMosaicYUV420PImpl(void) { SetFormat(1); }
+	PicMosaicYUV420PImpl(int sampleBytes) { SetFormat(sampleBytes); }
+	virtual ~PicMosaicYUV420PImpl(void) {}
+
+	/// Background of the canvas outside the regions.
+	void SetBackground(int y, int u, int v) { SetFill(0, y); SetFill(1, u); SetFill(2, v); Invalidate(); }
+
+protected:
+	void SetFormat(int sampleBytes)
+	{
+		int bytes			= (sampleBytes == 2) ? 2 : 1;
+		_planes				= 3;
+		_maxShift			= 1;
+		_scaleFormat	= (bytes == 2) ? PSPOLY_YUV420P16 : PSPOLY_YUV420P;
+		for(int p = 0; p < 3; p++)
+		{
+			_pelBytes[p]	= bytes;
+			_shift[p]			= (p == 0) ? 0 : 1;
+		}//end for p...
+		int chr = (bytes == 2) ? 0 : 128;
+		_chrOff				= chr;
+		SetBackground(0, chr, chr);
+	}//end SetFormat.
+
+	void SetFill(int plane, int value)
+	{
+		if(_pelBytes[plane] == 2)
+		{
+			short v = (short)value;
+			memcpy(_fill[plane], &v, sizeof(short));
+		}//end if _pelBytes...
+		else
+			_fill[plane][0] = (unsigned char)value;
+	}//end SetFill.
+
+};//end PicMosaicYUV420PImpl.
+
+#endif	// _PICMOSAICYUV420PIMPL_H
@@ -0,0 +1,168 @@
+/** @file
+
+MODULE				: PicPipelineRGB24
+
+TAG						: PPRGB24
+
+FILE NAME			: PicPipelineRGB24.h
+
+DESCRIPTION		: A tiled RGB 24 bit image operation pipeline. Crop, rotate, scale,
+								pic-in-pic and concat stages with the semantics of the PicCropper,
+								PicRotate, PicScaler, PicInPic and PicConcat RGB24 implementations
+								are chained and the output is produced tile by tile in a single
+								traversal, pulling only the region of each stage input that a
+								tile needs. The final stage writes RGB24 or fixed point YUV420
+								and the tiles are shared between threads.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _PICPIPELINERGB24_H
+#define _PICPIPELINERGB24_H
+
+#include <atomic>
+#include "PicRotateBase.h"
+
+/*
+===========================================================================
+  Constants.
+===========================================================================
+*/
+#define PPRGB24_MAX_STAGES		16
+#define PPRGB24_MAX_THREADS		16
+#define PPRGB24_TILE_WIDTH		64	///< Default tile dimensions in output pels.
+#define PPRGB24_TILE_HEIGHT		32
+
+/// Rectangle in the pel coordinates of a stage output.
+typedef struct _PPRGB24_RECT
+{
+	int x;
+	int y;
+	int width;
+	int height;
+} PPRGB24_RECT;
+
+/// Per thread tile scratch mem of each stage.
+typedef struct _PPRGB24_CTX
+{
+	unsigned char*	pScratch[PPRGB24_MAX_STAGES];
+	int							scratchLen[PPRGB24_MAX_STAGES];
+} PPRGB24_CTX;
+
+/// Stage implementations are private to the pipeline.
+class PicPipelineStageRGB24;
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+/**
+ * \ingroup ImageLib
+ * Compose image operations on a packed RGB 888 source image of fixed
+ * dimensions and execute them in one tiled traversal of the output. Each
+ * stage is pel identical to the full frame implementation it replaces. Pels
+ * of concat and pic-in-pic outputs that are not covered by an image are 0.
+ */
+class PicPipelineRGB24
+{
+public:
+	/// Construction and destruction.
+	PicPipelineRGB24(void);
+	virtual ~PicPipelineRGB24(void);
+
+	/// Start a new chain on a source image of these dimensions.
+	int		Create(int srcWidth, int srcHeight);
+	void	Destroy(void);
+
+	/// Stage composition in chain order. Return 1 = success, 0 = invalid parameters.
+	/// Crop a width x height region starting at pel column left of memory row top. This is the
+	/// PicCropperRGB24Impl (left, bottom) offset of a bottom-up image.
+	int AddCrop(int left, int top, int width, int height);
+	/// Rotate or flip as PicRotateRGB24Impl.
+	int AddRotate(ROTATE_MODE mode);
+	/// Scale with the 3x3 filter of PicScalerRGB24Impl.
+	int AddScale(int widthOut, int heightOut);
+	/// Insert a static sub image on top of the chain image as PicInPicRGB24Impl with an optional border.
+	int AddPicInPic(const void* pSubImg, int subWidth, int subHeight, int xPos, int yPos, int borderWidth);
+	/// Concat a static 2nd image to the chain image as PicConcatRGB24Impl. The orient is the
+	/// PicConcatBase {TOP, BOTTOM, LEFT, RIGHT} = {0, 1, 2, 3} position of the 2nd image.
+	int AddConcat(const void* pImg2nd, int width2nd, int height2nd, int width, int height, int orient);
+
+	/// Execute the chain into a packed RGB 888 output of the chain output dimensions.
+	int Run(const void* pSrc, void* pDst);
+	/// Execute the chain and convert the output to YUV420 planes with the fixed point
+	/// arithmetic of FastFixedPointRGB24toYUV420Converter. Even output dimensions only.
+	int RunYUV420(const void* pSrc, void* pY, void* pU, void* pV);
+
+	/// Member interface.
+	int GetWidth(void);		///< Chain output dimensions.
+	int GetHeight(void);
+	int GetStages(void)		{ return(_stages); }
+	int SetTileSize(int width, int height);
+	int GetTileWidth(void)	{ return(_tileWidth); }
+	int GetTileHeight(void)	{ return(_tileHeight); }
+	int SetThreads(int threads);
+	int GetThreads(void)		{ return(_threads); }
+	void SetChrominanceOffset(int val)	{ _chrOff = val; }
+	int GetChrominanceOffset(void)			{ return(_chrOff); }
+
+protected:
+	void	ResetMembers(void);
+	int		AddStage(PicPipelineStageRGB24* pStage);
+	int		Execute(const void* pSrc, void* pDst, void* pY, void* pU, void* pV);
+	void	RunTiles(int ctx);
+	void	Tile(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r);
+
+protected:
+	/// Stage 0 is the source.
+	PicPipelineStageRGB24*	_pStage[PPRGB24_MAX_STAGES];
+	int											_stages;
+
+	int	_tileWidth;
+	int	_tileHeight;
+	int	_threads;
+	int	_chrOff;
+
+	/// Per thread scratch retained between runs.
+	PPRGB24_CTX	_ctx[PPRGB24_MAX_THREADS];
+
+	/// Current run.
+	void*	_pDst;
+	void*	_pY;
+	void*	_pU;
+	void*	_pV;
+	int		_tilesX;
+	int		_tiles;
+	std::atomic<int>	_nextTile;
+
+};//end PicPipelineRGB24.
+
+#endif	// _PICPIPELINERGB24_H
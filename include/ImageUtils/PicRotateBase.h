@@ -79,6 +79,12 @@ public:
 	/// Implementation must be overidden by sub class
 	virtual bool Rotate(void* pInImg, void* pOutImg) = 0;
 
+	/// Rotate a plane of pelBytes = {1,2,3,4} byte pels into an output plane of the
+	/// rotated dimensions. Transposes are cache blocked with SSE2 register blocks where
+	/// compiled in and 3 byte pels use SSSE3 shuffles when the cpu has them. Returns 
+	/// false for an unsupported mode or pel size.
+	static bool RotatePlane(const void* pInImg, void* pOutImg, int nWidth, int nHeight, int pelBytes, ROTATE_MODE eMode);
+
 protected:
 	/// Width of input image
 	int m_nWidth;
@@ -0,0 +1,74 @@
+/** @file
+
+MODULE				: PicRotateYUV420PImpl
+
+TAG						: PRYUV
+
+FILE NAME			: PicRotateYUV420PImpl.h
+
+DESCRIPTION		: A YUV420P planar implementation derived from the
+								PicRotateBase() class. Rotate or flip the Y, U and V
+								planes of 8, 16 or 32 bit samples.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _PICROTATEYUV420PIMPL_H
+#define _PICROTATEYUV420PIMPL_H
+
+#include "PicRotateBase.h"
+
+/**
+ * \ingroup ImageLib
+ * A YUV420P planar implementation of PicRotateBase. The lum Y plane is followed
+ * immediately by the U and then V planes of half the lum dimensions. The sample
+ * size is 2 bytes for the codec short planes, 1 byte for byte planes and 4 bytes
+ * for the int planes of the image handlers. The input dimensions must be even.
+ */
+class PicRotateYUV420PImpl : public PicRotateBase
+{
+public:
+	PicRotateYUV420PImpl(void) { m_eMode = ROTATE_NONE; m_nWidth = 0; m_nHeight = 0; _sampleBytes = 2; }
+	PicRotateYUV420PImpl(int sampleBytes) { m_eMode = ROTATE_NONE; m_nWidth = 0; m_nHeight = 0; _sampleBytes = sampleBytes; }
+	virtual ~PicRotateYUV420PImpl(void) {}
+
+	virtual bool Rotate(void* pInImg, void* pOutImg);
+
+	/// Rotate separate planes.
+	bool Rotate(void* pInY, void* pInU, void* pInV, void* pOutY, void* pOutU, void* pOutV);
+
+	int		GetSampleBytes(void)					{ return(_sampleBytes); }
+	void	SetSampleBytes(int sampleBytes)	{ _sampleBytes = sampleBytes; }
+
+protected:
+	int	_sampleBytes;
+};//end PicRotateYUV420PImpl.
+
+#endif	// _PICROTATEYUV420PIMPL_H
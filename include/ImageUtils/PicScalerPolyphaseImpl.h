@@ -0,0 +1,162 @@
+/** @file
+
+MODULE				: PicScalerPolyphaseImpl
+
+TAG						: PSPOLY
+
+FILE NAME			: PicScalerPolyphaseImpl.h
+
+DESCRIPTION		: A separable polyphase implementation derived from the
+								general PicScalerBase() class. Scale YUV420P planar
+								or packed RGB24 images with bilinear, bicubic or area
+								filters from precomputed fixed point tap tables.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _PICSCALERPOLYPHASEIMPL_H
+#define _PICSCALERPOLYPHASEIMPL_H
+
+#include "PicScalerBase.h"
+
+/*
+===========================================================================
+  Constants.
+===========================================================================
+*/
+/// Image formats.
+#define PSPOLY_YUV420P			0		///< Planar YUV420 of 8 bit unsigned samples.
+#define PSPOLY_YUV420P16		1		///< Planar YUV420 of 16 bit (short) samples in 8 bit range with offset chr.
+#define PSPOLY_RGB24				2		///< Packed 24 bit RGB.
+
+/// Filters.
+#define PSPOLY_BILINEAR			0
+#define PSPOLY_BICUBIC			1
+#define PSPOLY_AREA					2
+
+/// Fixed point precision of the tap coefficients.
+#define PSPOLY_COEFF_BITS		14
+
+/// Tap table of one axis. The taps of each output pel start at a pel offset
+/// that keeps them all within the input and the coeffs sum to 1 << PSPOLY_COEFF_BITS.
+typedef struct _PSPOLY_TABLE
+{
+	int			taps;				///< Taps per output pel.
+	int			stride;			///< Coeffs per output pel, taps padded for SIMD loads.
+	int*		pOffset;		///< First input pel of each output pel.
+	short*	pCoeff;			///< stride coeffs of each output pel.
+} PSPOLY_TABLE;
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+/**
+ * \ingroup ImageLib
+ * A separable polyphase scaler derived from the general PicScalerBase() class.
+ * Rows are filtered horizontally into a ring of 16 bit intermediate rows on
+ * demand and the ring is filtered vertically into the output rows. The filter
+ * support is widened by the downscale ratio so that any downscale is low pass
+ * filtered. The tap tables are allocated by Create() and are re-created by
+ * Scale() if the dimensions, format or filter are changed.
+ */
+class PicScalerPolyphaseImpl: public PicScalerBase
+{
+public:
+	/// Construction and destruction.
+	PicScalerPolyphaseImpl(void) { ResetMembers(); _format = PSPOLY_YUV420P; _filter = PSPOLY_BICUBIC; _simd = 1; _chrOff = 0; }
+	PicScalerPolyphaseImpl(int widthOut, int heightOut, int widthIn, int heightIn): PicScalerBase(widthOut,heightOut,widthIn,heightIn) 
+		{ ResetMembers(); _format = PSPOLY_YUV420P; _filter = PSPOLY_BICUBIC; _simd = 1; _chrOff = 0; }
+	PicScalerPolyphaseImpl(int widthOut, int heightOut, int widthIn, int heightIn, int format, int filter): PicScalerBase(widthOut,heightOut,widthIn,heightIn) 
+		{ ResetMembers(); _format = format; _filter = filter; _simd = 1; _chrOff = 0; }
+	virtual ~PicScalerPolyphaseImpl(void) { Destroy(); }
+
+	/// Allocate the tap tables and the intermediate row ring.
+	int		Create(void);
+	void	Destroy(void);
+
+	/// Interface.
+	int Scale(void* pOutImg, void* pInImg);
+
+	/// Member interface.
+	int		GetFormat(void)							{ return(_format); }
+	void	SetFormat(int format)				{ _format = format; }
+	int		GetFilter(void)							{ return(_filter); }
+	void	SetFilter(int filter)				{ _filter = filter; }
+	/// SSE2 inner loops when compiled in. The results are identical to the scalar loops.
+	int		GetSimd(void)								{ return(_simd); }
+	void	SetSimd(int enable)					{ _simd = enable; }
+	/// The PSPOLY_YUV420P16 output is clamped to [0..255] for lum and to [chrOff-128..chrOff+127]
+	/// for chr. The default of 0 is the signed chr of the codec planes and 128 is unsigned chr.
+	int		GetChrominanceOffset(void)	{ return(_chrOff); }
+	void	SetChrominanceOffset(int val)	{ _chrOff = val; }
+
+protected:
+	void ResetMembers(void);
+
+	/// Fill a table for an in to out axis.
+	int		CreateTable(PSPOLY_TABLE* pTable, int in, int out);
+	void	DestroyTable(PSPOLY_TABLE* pTable);
+
+	/// Scale one plane of pels with channels interleaved samples.
+	void	ScalePlane(const void* pIn, void* pOut, int widthIn, int heightIn, int widthOut, int heightOut, int channels, PSPOLY_TABLE* pHorz, PSPOLY_TABLE* pVert, int lo, int hi);
+
+protected:
+	int	_format;
+	int	_filter;
+	int	_simd;
+	int	_chrOff;
+
+	/// Settings of the current allocation.
+	int	_createdWidthIn;
+	int	_createdHeightIn;
+	int	_createdWidthOut;
+	int	_createdHeightOut;
+	int	_createdFormat;
+	int	_createdFilter;
+
+	/// Lum (or RGB) and chr axis tables.
+	PSPOLY_TABLE	_lumHorz;
+	PSPOLY_TABLE	_lumVert;
+	PSPOLY_TABLE	_chrHorz;
+	PSPOLY_TABLE	_chrVert;
+
+	/// Ring of horizontally filtered rows tagged with their input row.
+	short*	_pRingMem;
+	short**	_pRing;
+	int*		_pRingTag;
+	int			_ringRows;
+	/// Ring rows of the vertical taps of the current output row.
+	short**	_pTapRow;
+
+};//end PicScalerPolyphaseImpl.
+
+#endif	// _PICSCALERPOLYPHASEIMPL_H
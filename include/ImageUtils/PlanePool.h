@@ -0,0 +1,149 @@
+/** @file
+
+MODULE				: PlanePool
+
+TAG						: PP
+
+FILE NAME			: PlanePool.h
+
+DESCRIPTION		: A thread safe pool of AlignedPlane allocated image planes
+								keyed by width, height, element size and row stride. Released
+								planes are held idle and recycled by later requests with the
+								same key so that codec re-opens do not return to the heap. The
+								usage statistics expose the mem high water mark.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _PLANEPOOL_H
+#define _PLANEPOOL_H
+
+#include <mutex>
+#include "AlignedPlane.h"
+
+/// Default upper limit on the bytes held in idle planes before the least
+/// recently released are returned to the heap.
+#define PP_DEFAULT_IDLE_LIMIT	(256LL * 1024LL * 1024LL)
+
+/*
+---------------------------------------------------------------------------
+	Struct definitions.
+---------------------------------------------------------------------------
+*/
+/// Usage counters since construction or the last ResetStats().
+typedef struct _PP_STATS
+{
+	long long	acquires;		///< Acquire() requests.
+	long long	hits;				///< Requests met from an idle plane.
+	long long	allocs;			///< Requests that went to the heap.
+	long long	frees;			///< Planes returned to the heap by limit, Trim() or destruction.
+	long long	liveBytes;	///< Bytes in planes currently acquired.
+	long long	idleBytes;	///< Bytes in planes held for recycling.
+	long long	peakBytes;	///< High water mark of liveBytes + idleBytes.
+	int				liveBlocks;
+	int				idleBlocks;
+} PP_STATS;
+
+/// A pooled plane and its key.
+typedef struct _PP_BLOCK
+{
+	void*							ptr;
+	int								width;
+	int								height;
+	int								elemSize;
+	int								stride;			///< In elements.
+	long long					bytes;
+	struct _PP_BLOCK*	next;
+} PP_BLOCK;
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+class PlanePool
+{
+	/// Construction and destruction.
+public:
+	PlanePool(void);
+	virtual ~PlanePool(void);
+
+	/// The process wide pool shared by the codec components.
+	static PlanePool* Shared(void);
+
+	/// Interface.
+public:
+	/** Borrow a plane.
+	The mem is AP_ALIGNMENT aligned. Padded rows use the AlignedPlane::Stride() 
+	stride otherwise the rows are contiguous with stride = width.
+	@param width		: Plane width in elements.
+	@param height		: Num of rows.
+	@param elemSize	: Element size in bytes.
+	@param padded		: 1 = padded stride, 0 = stride of width.
+	@param stride		: Returns the row stride in elements when not NULL.
+	@return					: Plane mem or NULL on failure.
+	*/
+	void* Acquire(int width, int height, int elemSize, int padded = 1, int* stride = NULL);
+
+	/** Return a plane to the pool.
+	The plane is held idle for a later Acquire() with the same key. NULL is ignored.
+	@param ptr	: Mem from Acquire().
+	@return			: 1 = success, 0 = not a live plane of this pool.
+	*/
+	int Release(void* ptr);
+
+	/// Return all idle planes to the heap.
+	void Trim(void);
+
+	/// Bytes that may be held idle. Release() evicts the least recently released
+	/// idle planes above this limit. 0 disables recycling.
+	void			SetIdleLimit(long long bytes);
+	long long	GetIdleLimit(void)	{ return(_idleLimit); }
+
+	/// Usage statistics.
+	void GetStats(PP_STATS* pStats);
+	void ResetStats(void);	///< Counters are cleared and the peak set to the current usage.
+
+	/// Private methods.
+protected:
+	void FreeBlock(PP_BLOCK* pBlk);
+	void EvictIdle(long long limit);
+
+	/// Private members.
+protected:
+	std::mutex	_mutex;
+	PP_BLOCK*		_pLive;				///< Acquired planes.
+	PP_BLOCK*		_pIdle;				///< Idle planes with the most recently released first.
+	long long		_idleLimit;
+	PP_STATS		_stats;
+
+};//end PlanePool.
+
+#endif	// _PLANEPOOL_H
@@ -60,7 +60,7 @@ public:
 	/// Construction and destruction.
 	RGBtoYUV420Converter(void) {_width = 0; _height = 0; _chrOff = 0; _flip = false; }
  	RGBtoYUV420Converter(int width, int height) {_width = width; _height = height; _chrOff = 0; _flip = false; }
-	RGBtoYUV420Converter(int width, int height, int chrOff) {_width = width; _height = height; _chrOff = chrOff; }
+	RGBtoYUV420Converter(int width, int height, int chrOff) {_width = width; _height = height; _chrOff = chrOff; _flip = false; }
 	virtual ~RGBtoYUV420Converter(void) {}
 
 	/// Interface.
@@ -63,9 +63,14 @@ public:
 	/// Interface.
 	void Convert(void* pRgb, void* pY, void* pU, void* pV);
 
+protected:
+  /// Convert the 2x2 pel block rows [ybStart, ybEnd) of the frame. Disjoint row
+  /// ranges may be converted concurrently.
+  void ConvertRows(void* pRgb, void* pY, void* pU, void* pV, int ybStart, int ybEnd);
+
 private:
-  void FlipConvert(void* pRgb, void* pY, void* pU, void* pV);
-  void NonFlipConvert(void* pRgb, void* pY, void* pU, void* pV);
+  void FlipConvert(void* pRgb, void* pY, void* pU, void* pV, int ybStart, int ybEnd);
+  void NonFlipConvert(void* pRgb, void* pY, void* pU, void* pV, int ybStart, int ybEnd);
 
 };//end _REALRGB24TOYUV420CONVERTERIMPL2_H.
 
@@ -0,0 +1,167 @@
+/** @file
+
+MODULE				: ViewMem2Dv2
+
+TAG						: VM2DV2
+
+FILE NAME			: ViewMem2Dv2.h
+
+DESCRIPTION		: A light weight value type view onto a 2-D block of shorts
+								described by a top left ptr, width, height and row stride.
+								Views are constructed without mem alloc and give single
+								indirection block copy and distortion metric operations.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _VIEWMEM2DV2_H
+#define _VIEWMEM2DV2_H
+
+#include <stddef.h>
+#include "OverlayMem2Dv2.h"
+
+/*
+---------------------------------------------------------------------------
+	Class definition.
+---------------------------------------------------------------------------
+*/
+/// A view does not own its mem and is cheap to copy by value. Sub block views
+/// and origin shifts are pointer arithmetic only so they may be created per
+/// macroblock or per search candidate without heap traffic. The metric methods
+/// follow the OverlayMem2Dv2 conventions and assume pel range [0..255] values.
+class ViewMem2Dv2
+{
+	/// Construction.
+public:
+	ViewMem2Dv2(void) : _pMem(NULL), _width(0), _height(0), _stride(0) {}
+	ViewMem2Dv2(short* ptr, int width, int height, int stride = 0) 
+		: _pMem(ptr), _width(width), _height(height), _stride((stride > width) ? stride : width) {}
+
+	/// A view of the overlay block at its current origin and overlay dimensions. The
+	/// overlay rows are _stride apart so the view remains valid while the overlay mem
+	/// exists. A later SetOrigin() on the overlay does not move the view.
+	static ViewMem2Dv2 Of(OverlayMem2Dv2& over)
+		{ return(ViewMem2Dv2(&(over.Get2DSrcPtr()[over.GetOriginY()][over.GetOriginX()]), over.GetWidth(), over.GetHeight(), over.GetStride())); }
+	/// A view of a block of the overlay mem with its top left at (col,row) in the mem
+	/// coords. The overlay origin is ignored and not altered.
+	static ViewMem2Dv2 Of(OverlayMem2Dv2& over, int col, int row, int width, int height)
+		{ return(ViewMem2Dv2(&(over.Get2DSrcPtr()[row][col]), width, height, over.GetStride())); }
+
+	/// Member access.
+public:
+	short*	GetPtr(void)		const { return(_pMem); }
+	int			GetWidth(void)	const { return(_width); }
+	int			GetHeight(void)	const { return(_height); }
+	int			GetStride(void)	const { return(_stride); }
+	short*	Row(int row)		const { return(&(_pMem[row * _stride])); }
+
+	/// Same dimension view with the top left shifted by (col,row). No bounds checking.
+	ViewMem2Dv2 At(int col, int row) const
+		{ return(ViewMem2Dv2(&(_pMem[(row * _stride) + col]), _width, _height, _stride)); }
+	/// A sub block view with its top left at (col,row). No bounds checking.
+	ViewMem2Dv2 Sub(int col, int row, int width, int height) const
+		{ return(ViewMem2Dv2(&(_pMem[(row * _stride) + col]), width, height, _stride)); }
+
+	/// Interface: Input/output functions.
+public:
+	/// Single values.
+	int		Read(int col, int row) const						{ return(_pMem[(row * _stride) + col]); }
+	void	Write(int col, int row, int value) const	{ _pMem[(row * _stride) + col] = (short)value; }
+
+	/// All of the source to all of this block. Must be equal footprint.
+	int	Write(const ViewMem2Dv2& src) const
+		{ return(Write(*this, src)); }
+	static int Write(const ViewMem2Dv2& me, const ViewMem2Dv2& src);
+
+	/// All of this block to all of the destination. Must be equal footprint.
+	int	Read(const ViewMem2Dv2& dst) const
+		{ return(Write(dst, *this)); }
+	static int Read(const ViewMem2Dv2& me, const ViewMem2Dv2& dst)
+		{ return(Write(dst, me)); }
+
+	/// Set block values to a value.
+	void Fill(int value) const
+		{ Fill(*this, value); }
+	static void Fill(const ViewMem2Dv2& me, int value);
+
+	/// Interface: Distortion metrics.
+public:
+	/// Total square difference with the input block. Must be equal footprint.
+	int Tsd(const ViewMem2Dv2& b) const
+		{ return(Tsd(*this, b)); }
+	static int Tsd(const ViewMem2Dv2& me, const ViewMem2Dv2& b);
+	int Tsd8x8(const ViewMem2Dv2& b) const
+		{ return(Tsd8x8(*this, b)); }
+	static int Tsd8x8(const ViewMem2Dv2& me, const ViewMem2Dv2& b);			///< No dimension checking.
+	int Tsd16x16(const ViewMem2Dv2& b) const
+		{ return(Tsd16x16(*this, b)); }
+	static int Tsd16x16(const ViewMem2Dv2& me, const ViewMem2Dv2& b);		///< No dimension checking.
+
+	/// The total square difference with the input to improve on an input value.
+	int TsdLessThan(const ViewMem2Dv2& b, int min) const
+		{ return(TsdLessThan(*this, b, min)); }
+	static int TsdLessThan(const ViewMem2Dv2& me, const ViewMem2Dv2& b, int min);
+	int Tsd16x16LessThan(const ViewMem2Dv2& b, int min) const
+		{ return(Tsd16x16LessThan(*this, b, min)); }
+	static int Tsd16x16LessThan(const ViewMem2Dv2& me, const ViewMem2Dv2& b, int min);	///< No dimension checking.
+
+	/// Total absolute difference with the input block. Must be equal footprint.
+	int Tad(const ViewMem2Dv2& b) const
+		{ return(Tad(*this, b)); }
+	static int Tad(const ViewMem2Dv2& me, const ViewMem2Dv2& b);
+	int Tad8x8(const ViewMem2Dv2& b) const
+		{ return(Tad8x8(*this, b)); }
+	static int Tad8x8(const ViewMem2Dv2& me, const ViewMem2Dv2& b);			///< No dimension checking.
+	int Tad16x16(const ViewMem2Dv2& b) const
+		{ return(Tad16x16(*this, b)); }
+	static int Tad16x16(const ViewMem2Dv2& me, const ViewMem2Dv2& b);		///< No dimension checking.
+
+	/// The total abs difference with the input to improve on an input value.
+	int TadLessThan(const ViewMem2Dv2& b, int min) const
+		{ return(TadLessThan(*this, b, min)); }
+	static int TadLessThan(const ViewMem2Dv2& me, const ViewMem2Dv2& b, int min);
+	int Tad16x16LessThan(const ViewMem2Dv2& b, int min) const
+		{ return(Tad16x16LessThan(*this, b, min)); }
+	static int Tad16x16LessThan(const ViewMem2Dv2& me, const ViewMem2Dv2& b, int min);	///< No dimension checking.
+
+	/// Block test operators.
+	int Equals(const ViewMem2Dv2& b) const
+		{ return(Equals(*this, b)); }
+	static int Equals(const ViewMem2Dv2& me, const ViewMem2Dv2& b);
+
+protected:
+	short*	_pMem;		///< Top left of the view.
+	int			_width;		///< View width and height.
+	int			_height;
+	int			_stride;	///< Row stride of the underlying mem in shorts >= _width.
+
+};// end class ViewMem2Dv2.
+
+#endif	//end _VIEWMEM2DV2_H.
@@ -0,0 +1,122 @@
+/** @file
+
+MODULE				: YUV420IngestConverter
+
+TAG						: YUVIC
+
+FILE NAME			: YUV420IngestConverter.h
+
+DESCRIPTION		: Convert 8 bit I420, NV12, YUY2 and UYVY images directly
+								into the planar 16 bit YUV420 layout of the codecs and
+								export the planar 16 bit layout back to the 8 bit formats.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifndef _YUV420INGESTCONVERTER_H
+#define _YUV420INGESTCONVERTER_H
+
+/*
+===========================================================================
+  Constants.
+===========================================================================
+*/
+/// 8 bit external formats.
+#define YUVIC_I420			0		///< Planar Y, U and V 4:2:0.
+#define YUVIC_NV12			1		///< Planar Y with interleaved UV 4:2:0.
+#define YUVIC_YUY2			2		///< Packed Y0 U Y1 V 4:2:2.
+#define YUVIC_UYVY			3		///< Packed U Y0 V Y1 4:2:2.
+
+typedef short yuvType;
+
+/*
+===========================================================================
+  Class definition.
+===========================================================================
+*/
+/**
+ * \ingroup ImageLib
+ * Converts between 8 bit camera and file formats and the planar 16 bit
+ * YUV420 layout of the codec input and output images. Lum samples are
+ * copied in their 8 bit range and chr samples are offset by (chrOff - 128)
+ * so that the default chrOff of 0 matches the RGB to YUV420 converters.
+ * The codec planes are written or read in place with no intermediate copy.
+ * The 4:2:2 chr rows are averaged in pairs on input and are repeated on
+ * output. The width and height must be even.
+ */
+class YUV420IngestConverter
+{
+public:
+	/// Construction and destruction.
+	YUV420IngestConverter(void) { ResetMembers(0, 0, YUVIC_I420, 0); }
+	YUV420IngestConverter(int width, int height, int format) { ResetMembers(width, height, format, 0); }
+	YUV420IngestConverter(int width, int height, int format, int chrOff) { ResetMembers(width, height, format, chrOff); }
+	virtual ~YUV420IngestConverter(void) {}
+
+	/// Interface.
+
+	/// Convert a contiguous 8 bit image into the contiguous 16 bit planes.
+	void Convert(const void* pIn, yuvType* pY, yuvType* pU, yuvType* pV) { Convert(pIn, 0, pY, pU, pV, _width); }
+	/// Convert with the in row stride in bytes of the lum plane (or packed row) and the out lum
+	/// row stride in samples. The chr strides are half the lum strides. A zero inStride is packed.
+	void Convert(const void* pIn, int inStride, yuvType* pY, yuvType* pU, yuvType* pV, int outStride);
+
+	/// Export the contiguous 16 bit planes to a contiguous 8 bit image with saturation.
+	void Export(const yuvType* pY, const yuvType* pU, const yuvType* pV, void* pOut) { Export(pY, pU, pV, _width, pOut, 0); }
+	void Export(const yuvType* pY, const yuvType* pU, const yuvType* pV, int inStride, void* pOut, int outStride);
+
+	/// Member interface.
+	void	SetDimensions(int width, int height)	{ _width = width; _height = height; }
+	int		GetWidth(void)												{ return(_width); }
+	int		GetHeight(void)												{ return(_height); }
+	void	SetFormat(int format)									{ _format = format; }
+	int		GetFormat(void)												{ return(_format); }
+	void	SetChrominanceOffset(int chrOff)			{ _chrOff = chrOff; }
+	int		GetChrominanceOffset(void)						{ return(_chrOff); }
+	/// SSE2 inner loops when compiled in. The results are identical to the scalar loops.
+	void	SetSimd(int enable)										{ _simd = enable; }
+	int		GetSimd(void)													{ return(_simd); }
+
+	/// Size in bytes of a packed 8 bit image in the current format.
+	int		GetFrameBytes(void)										{ return( ((_format == YUVIC_YUY2)||(_format == YUVIC_UYVY)) ? (2 * _width * _height) : ((3 * _width * _height)/2) ); }
+
+protected:
+	void ResetMembers(int width, int height, int format, int chrOff) { _width = width; _height = height; _format = format; _chrOff = chrOff; _simd = 1; }
+
+protected:
+	int	_width;
+	int	_height;
+	int	_format;
+	int	_chrOff;
+	int	_simd;
+
+};//end YUV420IngestConverter.
+
+#endif	//_YUV420INGESTCONVERTER_H
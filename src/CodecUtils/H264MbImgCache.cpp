@@ -62,14 +62,6 @@ H264MbImgCache::H264MbImgCache(void)
   _cb  = NULL;
   _cr  = NULL;
 
-  /// Cache blocks and overlays.
-  _plumCache  = NULL;
-  _lum16x16   = NULL;
-  _pCbCache   = NULL;
-  _cb8x8      = NULL;
-  _pCrCache   = NULL;
-  _cr8x8      = NULL;
-
 }//end constructor.
 
 H264MbImgCache::~H264MbImgCache(void)
@@ -79,26 +71,10 @@ H264MbImgCache::~H264MbImgCache(void)
 
 void H264MbImgCache::Destroy(void)
 {
-	if(_lum16x16 != NULL)
-		delete _lum16x16;
-	_lum16x16 = NULL;
-	if(_plumCache != NULL)
-		delete[] _plumCache;
-	_plumCache = NULL;
-
-	if(_cb8x8 != NULL)
-		delete _cb8x8;
-	_cb8x8 = NULL;
-	if(_pCbCache != NULL)
-		delete[] _pCbCache;
-	_pCbCache = NULL;
-
-	if(_cr8x8 != NULL)
-		delete _cr8x8;
-	_cr8x8 = NULL;
-	if(_pCrCache != NULL)
-		delete[] _pCrCache;
-	_pCrCache = NULL;
+  /// The cache mem is owned by the object so only the views are cleared.
+  _lum16x16 = ViewMem2Dv2();
+  _cb8x8    = ViewMem2Dv2();
+  _cr8x8    = ViewMem2Dv2();
 
 }//end Destroy.
 
@@ -108,7 +84,7 @@ void H264MbImgCache::Destroy(void)
 ---------------------------------------------------------------------------
 */
 /** Create mem container.
-Set the mem for a 16x16 lum and two 8x8 chr blocks with their overlays.
+Set the views onto the member mem for a 16x16 lum and two 8x8 chr blocks.
 @return			: 1 = success, 0 = failed.
 */
 int H264MbImgCache::Create(void)
@@ -116,20 +92,9 @@ int H264MbImgCache::Create(void)
   /// Clean out before starting.
   Destroy();
 
-	_plumCache = new short[256];	///< 16x16 block.
-	_lum16x16	= new OverlayMem2Dv2(_plumCache, 16, 16, 16, 16);
-	_pCbCache = new short[64];	///< 8x8 blocks for predicition operations.
-	_cb8x8	= new OverlayMem2Dv2(_pCbCache, 8, 8, 8, 8);
-	_pCrCache = new short[64];
-	_cr8x8	= new OverlayMem2Dv2(_pCrCache, 8, 8, 8, 8);
-
-  if( (_plumCache == NULL)||(_lum16x16 == NULL) ||																
-			(_pCbCache == NULL) ||(_cb8x8 == NULL) || 
-			(_pCrCache == NULL) ||(_cr8x8 == NULL) )
-  {
-    Destroy();
-	  return(0);
-  }//end if !_plumCache...
+	_lum16x16 = ViewMem2Dv2(_lumCache, 16, 16);	///< 16x16 block.
+	_cb8x8		= ViewMem2Dv2(_cbCache, 8, 8);		///< 8x8 blocks for predicition operations.
+	_cr8x8		= ViewMem2Dv2(_crCache, 8, 8);
 
   return(1);
 }//end Create.
@@ -147,19 +112,19 @@ int H264MbImgCache::Cache(MacroBlockH264* pMb)
 	_lum->SetOverlayDim(16, 16);
 	_lum->SetOrigin(pMb->_offLumX, pMb->_offLumY);
   /// Read from the Lum img block into the mb cache.
-  _lum->Read(*(_lum16x16));
+  _lum16x16.Write(ViewMem2Dv2::Of(*_lum));
   
   /// Align the Cb img block with this mb position
 	_cb->SetOverlayDim(8, 8);
 	_cb->SetOrigin(pMb->_offChrX, pMb->_offChrY);
   /// Read from the Cb img block into the mb cache.
-  _cb->Read(*(_cb8x8));
+  _cb8x8.Write(ViewMem2Dv2::Of(*_cb));
 
   /// Align the Cr img block with this mb position
 	_cr->SetOverlayDim(8, 8);
 	_cr->SetOrigin(pMb->_offChrX, pMb->_offChrY);
   /// Read from the Cr img block into the mb cache.
-  _cr->Read(*(_cr8x8));
+  _cr8x8.Write(ViewMem2Dv2::Of(*_cr));
 
   return(1);
 }//end Cache.
@@ -177,19 +142,19 @@ int H264MbImgCache::Restore(MacroBlockH264* pMb)
 	_lum->SetOverlayDim(16, 16);
 	_lum->SetOrigin(pMb->_offLumX, pMb->_offLumY);
   /// Read from the mb cache into the Lum img block .
-  _lum16x16->Read(*(_lum));
+  _lum16x16.Read(ViewMem2Dv2::Of(*_lum));
   
   /// Align the Cb img block with this mb position
 	_cb->SetOverlayDim(8, 8);
 	_cb->SetOrigin(pMb->_offChrX, pMb->_offChrY);
   /// Read from the mb cache into the Cb img block .
-  _cb8x8->Read(*(_cb));
+  _cb8x8.Read(ViewMem2Dv2::Of(*_cb));
 
   /// Align the Cr img block with this mb position
 	_cr->SetOverlayDim(8, 8);
 	_cr->SetOrigin(pMb->_offChrX, pMb->_offChrY);
   /// Read from the mb cache into the Cr img block .
-  _cr8x8->Read(*(_cr));
+  _cr8x8.Read(ViewMem2Dv2::Of(*_cr));
 
   return(1);
 }//end Restore.
@@ -207,17 +172,17 @@ int H264MbImgCache::Equal(MacroBlockH264* pMb)
   /// Align the Lum img block with this mb position
 	_lum->SetOverlayDim(16, 16);
 	_lum->SetOrigin(pMb->_offLumX, pMb->_offLumY);
-  lumEqual = _lum16x16->Equals(*(_lum));
+  lumEqual = _lum16x16.Equals(ViewMem2Dv2::Of(*_lum));
   
   /// Align the Cb img block with this mb position
 	_cb->SetOverlayDim(8, 8);
 	_cb->SetOrigin(pMb->_offChrX, pMb->_offChrY);
-  cbEqual = _cb8x8->Equals(*(_cb));
+  cbEqual = _cb8x8.Equals(ViewMem2Dv2::Of(*_cb));
 
   /// Align the Cr img block with this mb position
 	_cr->SetOverlayDim(8, 8);
 	_cr->SetOrigin(pMb->_offChrX, pMb->_offChrY);
-  crEqual = _cr8x8->Equals(*(_cr));
+  crEqual = _cr8x8.Equals(ViewMem2Dv2::Of(*_cr));
 
   return(lumEqual & cbEqual & crEqual);
 }//end Equal.
@@ -0,0 +1,277 @@
+/** @file
+
+MODULE				: H264MotionSearchStats
+
+TAG						: H264MSS
+
+FILE NAME			: H264MotionSearchStats.cpp
+
+DESCRIPTION		: Online statistics of the final 16x16 motion search distortions
+                and vectors of a sequence. The distribution of the best 
+                distortions over the frame and a per macroblock region 
+                history give early termination thresholds for the pattern
+                searches that adapt to the content and the QP, and the
+                vector spread gives a search depth for multiresolution 
+                estimators.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+#include <algorithm>
+#include "H264MotionSearchStats.h"
+#include "H264StaticMbDetector.h"
+
+/*
+---------------------------------------------------------------------------
+	Constants.
+---------------------------------------------------------------------------
+*/
+/// Running average weight of a new frame = 1/(2^H264MSS_SEQ_SHIFT).
+#define H264MSS_SEQ_SHIFT			2
+/// Running average weight of a new region value = 1/(2^H264MSS_REGION_SHIFT).
+#define H264MSS_REGION_SHIFT	1
+/// Running average weight of the far vector counts = 1/(2^H264MSS_FAR_SHIFT).
+#define H264MSS_FAR_SHIFT			1
+/// An upper quartile distortion above 2^H264MSS_JUMP_SHIFT times its running average is a jump.
+#define H264MSS_JUMP_SHIFT		2
+/// Far vector counts are per 1024 macroblocks.
+#define H264MSS_FAR_SCALE			1024
+/// Level 2 on above 1/10 and off below 1/50 of the macroblocks.
+#define H264MSS_FAR_ON				102
+#define H264MSS_FAR_OFF				20
+/// The threshold floor is 1/4 of the quantisation noise energy as the local
+/// refinement that follows an early exit still improves on it.
+#define H264MSS_FLOOR_SHIFT		2
+
+/*
+---------------------------------------------------------------------------
+	Construction and destruction.
+---------------------------------------------------------------------------
+*/
+H264MotionSearchStats::H264MotionSearchStats(void)
+{
+	ResetMembers();
+}//end constructor.
+
+H264MotionSearchStats::~H264MotionSearchStats(void)
+{
+	Destroy();
+}//end destructor.
+
+void H264MotionSearchStats::ResetMembers(void)
+{
+	_mbCols					= 0;
+	_mbRows					= 0;
+	_qp							= 26;
+	_frames					= 0;
+	_pFrameDist			= NULL;
+	_pFrameMag			= NULL;
+	_frameCount			= 0;
+	_pRegion				= NULL;
+	_seqLow					= 0;
+	_seqHigh				= 0;
+	_farHalf				= 0;
+	_farThreeQuart	= 0;
+	_reach					= 0;
+	_distJump				= false;
+}//end ResetMembers.
+
+int H264MotionSearchStats::Create(int mbCols, int mbRows)
+{
+	/// Clean out old mem.
+	Destroy();
+
+	int len = mbCols * mbRows;
+	if(len <= 0)
+		return(0);
+
+	_pFrameDist = new int[len];
+	_pFrameMag	= new int[len];
+	_pRegion		= new int[len];
+	if( (_pFrameDist == NULL)||(_pFrameMag == NULL)||(_pRegion == NULL) )
+	{
+		Destroy();
+		return(0);
+	}//end if !_pFrameDist...
+
+	_mbCols = mbCols;
+	_mbRows = mbRows;
+	Reset();
+
+	return(1);
+}//end Create.
+
+void H264MotionSearchStats::Destroy(void)
+{
+	if(_pFrameDist != NULL)
+		delete[] _pFrameDist;
+	_pFrameDist = NULL;
+	if(_pFrameMag != NULL)
+		delete[] _pFrameMag;
+	_pFrameMag = NULL;
+	if(_pRegion != NULL)
+		delete[] _pRegion;
+	_pRegion = NULL;
+
+	_mbCols			= 0;
+	_mbRows			= 0;
+	_frames			= 0;
+	_frameCount = 0;
+}//end Destroy.
+
+/*
+---------------------------------------------------------------------------
+	Interface methods.
+---------------------------------------------------------------------------
+*/
+void H264MotionSearchStats::Reset(void)
+{
+	int len = _mbCols * _mbRows;
+	for(int i = 0; i < len; i++)
+		_pRegion[i] = -1;
+	_frameCount			= 0;
+	_frames					= 0;
+	_seqLow					= 0;
+	_seqHigh				= 0;
+	_farHalf				= 0;
+	_farThreeQuart	= 0;
+	_distJump				= false;
+}//end Reset.
+
+void H264MotionSearchStats::Add(int vecPos, int dist, int mvx, int mvy)
+{
+	if( (!Ready())||(_frameCount >= (_mbCols * _mbRows)) )
+		return;
+
+	int x = ((mvx < 0) ? -mvx : mvx) >> 2;
+	int y = ((mvy < 0) ? -mvy : mvy) >> 2;
+	_pFrameDist[_frameCount]	= dist;
+	_pFrameMag[_frameCount]		= (x > y) ? x : y;
+	_frameCount++;
+
+	/// The region history is only read for this macroblock before it is added.
+	if(_pRegion[vecPos] < 0)
+		_pRegion[vecPos] = dist;
+	else
+		_pRegion[vecPos] += (dist - _pRegion[vecPos]) >> H264MSS_REGION_SHIFT;
+}//end Add.
+
+void H264MotionSearchStats::Update(void)
+{
+	if( (!Ready())||(_frameCount == 0) )
+		return;
+
+	/// Quartiles of the frame final distortions.
+	int* pEnd = _pFrameDist + _frameCount;
+	std::nth_element(_pFrameDist, _pFrameDist + (_frameCount/4), pEnd);
+	int low = _pFrameDist[_frameCount/4];
+	std::nth_element(_pFrameDist, _pFrameDist + ((3*_frameCount)/4), pEnd);
+	int high = _pFrameDist[(3*_frameCount)/4];
+
+	/// Vector spread relative to the level 1 reach.
+	int farHalf				= 0;
+	int farThreeQuart	= 0;
+	if(_reach > 0)
+	{
+		for(int i = 0; i < _frameCount; i++)
+		{
+			if((2*_pFrameMag[i]) > _reach)
+				farHalf++;
+			if((4*_pFrameMag[i]) > (3*_reach))
+				farThreeQuart++;
+		}//end for i...
+		farHalf				= (farHalf * H264MSS_FAR_SCALE)/_frameCount;
+		farThreeQuart = (farThreeQuart * H264MSS_FAR_SCALE)/_frameCount;
+	}//end if _reach...
+
+	/// A jump in distortion with small vectors is typically motion the search could not reach.
+	_distJump = (_frames > 0)&&(high > (_seqHigh << H264MSS_JUMP_SHIFT))&&(high > H264StaticMbDetector::GetThreshold(_qp));
+
+	if(_frames == 0)
+	{
+		_seqLow					= low;
+		_seqHigh				= high;
+		_farHalf				= farHalf;
+		_farThreeQuart	= farThreeQuart;
+	}//end if _frames...
+	else
+	{
+		_seqLow					+= (low - _seqLow) >> H264MSS_SEQ_SHIFT;
+		_seqHigh				+= (high - _seqHigh) >> H264MSS_SEQ_SHIFT;
+		_farHalf				+= (farHalf - _farHalf) >> H264MSS_FAR_SHIFT;
+		_farThreeQuart	+= (farThreeQuart - _farThreeQuart) >> H264MSS_FAR_SHIFT;
+	}//end else...
+
+	_frames++;
+	_frameCount = 0;
+}//end Update.
+
+int H264MotionSearchStats::GetThreshold(int vecPos, int level, int defThreshold)
+{
+	if(_frames == 0)
+		return(defThreshold);
+
+	int threshold = _seqLow << level;
+	if(threshold > _seqHigh)
+		threshold = _seqHigh;
+
+	/// Easy regions are held to their own history.
+	int region = _pRegion[vecPos];
+	if( (region >= 0)&&((region << level) < threshold) )
+		threshold = region << level;
+
+	/// Well below the quantisation noise the search can not make a difference.
+	int floor = H264StaticMbDetector::GetThreshold(_qp) >> H264MSS_FLOOR_SHIFT;
+	if(threshold < floor)
+		threshold = floor;
+
+	return(threshold);
+}//end GetThreshold.
+
+int H264MotionSearchStats::GetSearchLevel(int level)
+{
+	if( (_frames == 0)||(_reach <= 0) )
+		return(level);
+
+	if( (level < 2)&&((_farThreeQuart > H264MSS_FAR_ON)||_distJump) )
+		return(2);
+	if( (level == 2)&&(_farHalf < H264MSS_FAR_OFF) )
+		return(1);
+	return(level);
+}//end GetSearchLevel.
+
@@ -0,0 +1,275 @@
+/** @file
+
+MODULE				: H264MotionVectorSeeder
+
+TAG						: H264MVS
+
+FILE NAME			: H264MotionVectorSeeder.cpp
+
+DESCRIPTION		: A class to generate EPZS-style spatial and temporal full pel 
+                candidate motion vectors to seed H.264 16x16 motion estimator 
+                searches.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#include <string.h>
+#endif
+
+#include <memory.h>
+#include "H264MotionVectorSeeder.h"
+
+/*
+---------------------------------------------------------------------------
+	Constants.
+---------------------------------------------------------------------------
+*/
+/// Threshold = (5/4) x smallest neighbourhood distortion.
+#define H264MVS_THRESHOLD_NUM 5
+#define H264MVS_THRESHOLD_DEN 4
+
+/*
+---------------------------------------------------------------------------
+	Construction and destruction.
+---------------------------------------------------------------------------
+*/
+H264MotionVectorSeeder::H264MotionVectorSeeder(void)
+{
+	_mbCols = 0;
+	_mbRows = 0;
+	_frames = 0;
+	for(int i = 0; i < 2; i++)
+	{
+		_pMvX[i]		= NULL;
+		_pMvY[i]		= NULL;
+		_pValid[i]	= NULL;
+	}//end for i...
+	_pDistortion = NULL;
+}//end constructor.
+
+H264MotionVectorSeeder::~H264MotionVectorSeeder(void)
+{
+	Destroy();
+}//end destructor.
+
+int H264MotionVectorSeeder::Create(int mbCols, int mbRows)
+{
+	/// Clean out old mem.
+	Destroy();
+
+	int len = mbCols * mbRows;
+	if(len <= 0)
+		return(0);
+
+	for(int i = 0; i < 2; i++)
+	{
+		_pMvX[i]		= new int[len];
+		_pMvY[i]		= new int[len];
+		_pValid[i]	= new bool[len];
+		if( (_pMvX[i] == NULL)||(_pMvY[i] == NULL)||(_pValid[i] == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_pMvX...
+	}//end for i...
+	_pDistortion = new int[len];
+	if(_pDistortion == NULL)
+	{
+		Destroy();
+		return(0);
+	}//end if !_pDistortion...
+
+	_mbCols = mbCols;
+	_mbRows = mbRows;
+	Reset();
+
+	return(1);
+}//end Create.
+
+void H264MotionVectorSeeder::Destroy(void)
+{
+	for(int i = 0; i < 2; i++)
+	{
+		if(_pMvX[i] != NULL)
+			delete[] _pMvX[i];
+		_pMvX[i] = NULL;
+		if(_pMvY[i] != NULL)
+			delete[] _pMvY[i];
+		_pMvY[i] = NULL;
+		if(_pValid[i] != NULL)
+			delete[] _pValid[i];
+		_pValid[i] = NULL;
+	}//end for i...
+	if(_pDistortion != NULL)
+		delete[] _pDistortion;
+	_pDistortion = NULL;
+
+	_mbCols = 0;
+	_mbRows = 0;
+	_frames = 0;
+}//end Destroy.
+
+/*
+---------------------------------------------------------------------------
+	Interface methods.
+---------------------------------------------------------------------------
+*/
+void H264MotionVectorSeeder::Reset(void)
+{
+	int len = _mbCols * _mbRows;
+	for(int i = 0; i < 2; i++)
+	{
+		if(_pValid[i] != NULL)
+			memset((void *)_pValid[i], 0, len * sizeof(bool));
+	}//end for i...
+	_frames = 0;
+}//end Reset.
+
+void H264MotionVectorSeeder::Update(MacroBlockH264* pPrevFrmMBlk)
+{
+	if( (!Ready())||(pPrevFrmMBlk == NULL) )
+		return;
+
+	/// Swap the history buffers so that the previous frame becomes the one before it.
+	int*	pTmp = _pMvX[1]; _pMvX[1] = _pMvX[0]; _pMvX[0] = pTmp;
+	pTmp = _pMvY[1]; _pMvY[1] = _pMvY[0]; _pMvY[0] = pTmp;
+	bool* pTmpValid = _pValid[1]; _pValid[1] = _pValid[0]; _pValid[0] = pTmpValid;
+
+	int len = _mbCols * _mbRows;
+	for(int i = 0; i < len; i++)
+	{
+		MacroBlockH264* pMb = &(pPrevFrmMBlk[i]);
+		_pValid[0][i] = !(pMb->_intraFlag);
+		_pMvX[0][i]		= pMb->_mvX[MacroBlockH264::_16x16];
+		_pMvY[0][i]		= pMb->_mvY[MacroBlockH264::_16x16];
+		_pDistortion[i] = pMb->_intraFlag ? 0 : pMb->_distortion[0];
+	}//end for i...
+
+	if(_frames < 2)
+		_frames++;
+}//end Update.
+
+int H264MotionVectorSeeder::GetCandidates(int vecPos, VectorStructList* pCurr, int predX0, int predY0, H264MVS_COORD* list)
+{
+	int len = 0;
+	int col = vecPos % _mbCols;
+	int row = vecPos / _mbCols;
+
+	/// Spatial neighbours that have already been estimated in this frame.
+	if(pCurr != NULL)
+	{
+		if(col > 0)
+			len = AddUnique(pCurr->GetSimpleElement(vecPos - 1, 0)/4, pCurr->GetSimpleElement(vecPos - 1, 1)/4, predX0, predY0, list, len);
+		if(row > 0)
+		{
+			int above = vecPos - _mbCols;
+			len = AddUnique(pCurr->GetSimpleElement(above, 0)/4, pCurr->GetSimpleElement(above, 1)/4, predX0, predY0, list, len);
+			if(col < (_mbCols - 1))
+				len = AddUnique(pCurr->GetSimpleElement(above + 1, 0)/4, pCurr->GetSimpleElement(above + 1, 1)/4, predX0, predY0, list, len);
+		}//end if row...
+	}//end if pCurr...
+
+	if(_frames == 0)
+		return(len);
+
+	/// Temporal co-located and its neighbours from the previous frame. The right and below
+	/// neighbours are the useful ones as they are not available spatially.
+	int*	mvx		= _pMvX[0];
+	int*	mvy		= _pMvY[0];
+	bool*	valid = _pValid[0];
+	if(valid[vecPos])
+		len = AddUnique(mvx[vecPos]/4, mvy[vecPos]/4, predX0, predY0, list, len);
+	if( (col < (_mbCols - 1))&&valid[vecPos + 1] )
+		len = AddUnique(mvx[vecPos + 1]/4, mvy[vecPos + 1]/4, predX0, predY0, list, len);
+	if( (row < (_mbRows - 1))&&valid[vecPos + _mbCols] )
+		len = AddUnique(mvx[vecPos + _mbCols]/4, mvy[vecPos + _mbCols]/4, predX0, predY0, list, len);
+	if( (col > 0)&&valid[vecPos - 1] )
+		len = AddUnique(mvx[vecPos - 1]/4, mvy[vecPos - 1]/4, predX0, predY0, list, len);
+	if( (row > 0)&&valid[vecPos - _mbCols] )
+		len = AddUnique(mvx[vecPos - _mbCols]/4, mvy[vecPos - _mbCols]/4, predX0, predY0, list, len);
+
+	/// Accelerated motion: extrapolate the co-located vector with its change over the last two frames.
+	if( (_frames > 1)&&valid[vecPos]&&_pValid[1][vecPos] )
+	{
+		int accX = (2 * mvx[vecPos]) - _pMvX[1][vecPos];
+		int accY = (2 * mvy[vecPos]) - _pMvY[1][vecPos];
+		len = AddUnique(accX/4, accY/4, predX0, predY0, list, len);
+	}//end if _frames...
+
+	return(len);
+}//end GetCandidates.
+
+int H264MotionVectorSeeder::GetThreshold(int vecPos, int predD, int minThreshold, int maxThreshold)
+{
+	int base = predD;
+	if( (_frames > 0)&&_pValid[0][vecPos]&&(_pDistortion[vecPos] > 0) )
+	{
+		if( (base <= 0)||(_pDistortion[vecPos] < base) )
+			base = _pDistortion[vecPos];
+	}//end if _frames...
+
+	if(base <= 0)
+		return(minThreshold);
+
+	int t = (base * H264MVS_THRESHOLD_NUM) / H264MVS_THRESHOLD_DEN;
+	if(t < minThreshold)
+		t = minThreshold;
+	else if(t > maxThreshold)
+		t = maxThreshold;
+	return(t);
+}//end GetThreshold.
+
+/*
+---------------------------------------------------------------------------
+	Private methods.
+---------------------------------------------------------------------------
+*/
+int H264MotionVectorSeeder::AddUnique(int x, int y, int predX0, int predY0, H264MVS_COORD* list, int len)
+{
+	/// The zero and predicted vectors are always tested by the estimators.
+	if( ((x == 0)&&(y == 0))||((x == predX0)&&(y == predY0)) )
+		return(len);
+	for(int i = 0; i < len; i++)
+	{
+		if( (list[i].x == x)&&(list[i].y == y) )
+			return(len);
+	}//end for i...
+	if(len >= MaxCandidates)
+		return(len);
+
+	list[len].x = (short int)x;
+	list[len].y = (short int)y;
+	return(len + 1);
+}//end AddUnique.
@@ -0,0 +1,405 @@
+/** @file
+
+MODULE				: H264RefFrameStore
+
+TAG						: H264RFS
+
+FILE NAME			: H264RefFrameStore.cpp
+
+DESCRIPTION		: A store of the last N reconstructed luminance reference frames 
+                for multiple reference frame motion estimation. Each frame is
+                held with its boundary extended for out of picture vectors and
+                with a cached half resolution level of its pyramid, also with
+                an extended boundary, so that the work is done once per frame
+                and shared by all the estimators that search it.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+#include "H264RefFrameStore.h"
+#include "PlanePool.h"
+
+/*
+---------------------------------------------------------------------------
+	Constants.
+---------------------------------------------------------------------------
+*/
+/// Level 0 boundary = mb dim + 1/4 pel interpolation padding.
+#define H264RFS_BOUNDARY			(16 + 3)
+/// Level 1 boundary = level 1 mb dim + padding.
+#define H264RFS_L1_BOUNDARY		(8 + 1)
+#define H264RFS_MAX_REFS			16
+
+/*
+---------------------------------------------------------------------------
+	Construction and destruction.
+---------------------------------------------------------------------------
+*/
+H264RefFrameStore::H264RefFrameStore(void)
+{
+	ResetMembers();
+}//end constructor.
+
+H264RefFrameStore::~H264RefFrameStore(void)
+{
+	Destroy();
+}//end destructor.
+
+void H264RefFrameStore::ResetMembers(void)
+{
+	_imgWidth		= 0;
+	_imgHeight	= 0;
+	_maxRefs		= 0;
+	_numRefs		= 0;
+	_newest			= 0;
+	_boundary		= H264RFS_BOUNDARY;
+	_l1Boundary	= H264RFS_L1_BOUNDARY;
+	_pel8				= 0;
+
+	_ppExtMem		= NULL;
+	_ppExtOver	= NULL;
+	_ppL1Mem		= NULL;
+	_ppL1Over		= NULL;
+	_ppExtMem8	= NULL;
+	_ppExtOver8	= NULL;
+	_ppL1Mem8		= NULL;
+	_ppL1Over8	= NULL;
+	_ppRecon		= NULL;
+	_ppRecon8		= NULL;
+}//end ResetMembers.
+
+int H264RefFrameStore::Create(int imgWidth, int imgHeight, int maxRefs, int pel8)
+{
+	/// Clean out old mem.
+	Destroy();
+
+	if( (imgWidth < 16)||(imgHeight < 16)||(maxRefs < 1)||(maxRefs > H264RFS_MAX_REFS) )
+		return(0);
+
+	_imgWidth		= imgWidth;
+	_imgHeight	= imgHeight;
+	_maxRefs		= maxRefs;
+	_pel8				= (pel8 != 0);
+
+	int extWidth		= imgWidth + (2 * _boundary);
+	int extHeight		= imgHeight + (2 * _boundary);
+	int l1ExtWidth	= (imgWidth/2) + (2 * _l1Boundary);
+	int l1ExtHeight = (imgHeight/2) + (2 * _l1Boundary);
+	/// Planes are cache aligned with padded rows and borrowed from the shared
+	/// pool so that a re-create at the same dimensions does not touch the heap.
+	PlanePool* pPool	= PlanePool::Shared();
+	int elemSize			= _pel8 ? (int)sizeof(unsigned char) : (int)sizeof(short);
+	int extStride			= AlignedPlane::Stride(extWidth, elemSize);
+	int l1ExtStride		= AlignedPlane::Stride(l1ExtWidth, elemSize);
+
+	int i;
+	if(_pel8)
+	{
+		_ppExtMem8	= new unsigned char*[maxRefs];
+		_ppExtOver8	= new OverlayMem2Dv2u8*[maxRefs];
+		_ppL1Mem8		= new unsigned char*[maxRefs];
+		_ppL1Over8	= new OverlayMem2Dv2u8*[maxRefs];
+		_ppRecon8		= new unsigned char*[imgHeight];
+		if( (_ppExtMem8 == NULL)||(_ppExtOver8 == NULL)||(_ppL1Mem8 == NULL)||(_ppL1Over8 == NULL)||(_ppRecon8 == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_ppExtMem8...
+		for(i = 0; i < maxRefs; i++)
+		{
+			_ppExtMem8[i]		= NULL;
+			_ppExtOver8[i]	= NULL;
+			_ppL1Mem8[i]		= NULL;
+			_ppL1Over8[i]		= NULL;
+		}//end for i...
+
+		for(i = 0; i < maxRefs; i++)
+		{
+			_ppExtMem8[i]	= (unsigned char *)pPool->Acquire(extWidth, extHeight, elemSize);
+			_ppL1Mem8[i]	= (unsigned char *)pPool->Acquire(l1ExtWidth, l1ExtHeight, elemSize);
+			if( (_ppExtMem8[i] == NULL)||(_ppL1Mem8[i] == NULL) )
+			{
+				Destroy();
+				return(0);
+			}//end if !_ppExtMem8...
+			_ppExtOver8[i]	= new OverlayMem2Dv2u8(_ppExtMem8[i], extWidth, extHeight, 16, 16, _boundary, _boundary, extStride);
+			_ppL1Over8[i]		= new OverlayMem2Dv2u8(_ppL1Mem8[i], l1ExtWidth, l1ExtHeight, 8, 8, _l1Boundary, _l1Boundary, l1ExtStride);
+			if( (_ppExtOver8[i] == NULL)||(_ppL1Over8[i] == NULL) )
+			{
+				Destroy();
+				return(0);
+			}//end if !_ppExtOver8...
+		}//end for i...
+
+		Reset();
+		return(1);
+	}//end if _pel8...
+
+	_ppExtMem		= new short*[maxRefs];
+	_ppExtOver	= new OverlayExtMem2Dv2*[maxRefs];
+	_ppL1Mem		= new short*[maxRefs];
+	_ppL1Over		= new OverlayExtMem2Dv2*[maxRefs];
+	_ppRecon		= new short*[imgHeight];
+	if( (_ppExtMem == NULL)||(_ppExtOver == NULL)||(_ppL1Mem == NULL)||(_ppL1Over == NULL)||(_ppRecon == NULL) )
+	{
+		Destroy();
+		return(0);
+	}//end if !_ppExtMem...
+	for(i = 0; i < maxRefs; i++)
+	{
+		_ppExtMem[i]	= NULL;
+		_ppExtOver[i] = NULL;
+		_ppL1Mem[i]		= NULL;
+		_ppL1Over[i]	= NULL;
+	}//end for i...
+
+	for(i = 0; i < maxRefs; i++)
+	{
+		_ppExtMem[i]	= (short *)pPool->Acquire(extWidth, extHeight, elemSize);
+		_ppL1Mem[i]		= (short *)pPool->Acquire(l1ExtWidth, l1ExtHeight, elemSize);
+		if( (_ppExtMem[i] == NULL)||(_ppL1Mem[i] == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_ppExtMem...
+		_ppExtOver[i] = new OverlayExtMem2Dv2(_ppExtMem[i], extWidth, extHeight, 16, 16, _boundary, _boundary, extStride);
+		_ppL1Over[i]	= new OverlayExtMem2Dv2(_ppL1Mem[i], l1ExtWidth, l1ExtHeight, 8, 8, _l1Boundary, _l1Boundary, l1ExtStride);
+		if( (_ppExtOver[i] == NULL)||(_ppL1Over[i] == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_ppExtOver...
+	}//end for i...
+
+	Reset();
+	return(1);
+}//end Create.
+
+void H264RefFrameStore::Destroy(void)
+{
+	int i;
+	if(_ppExtOver != NULL)
+	{
+		for(i = 0; i < _maxRefs; i++)
+		{
+			if(_ppExtOver[i] != NULL)
+				delete _ppExtOver[i];
+		}//end for i...
+		delete[] _ppExtOver;
+	}//end if _ppExtOver...
+	if(_ppExtMem != NULL)
+	{
+		for(i = 0; i < _maxRefs; i++)
+		{
+			if(_ppExtMem[i] != NULL)
+				PlanePool::Shared()->Release(_ppExtMem[i]);
+		}//end for i...
+		delete[] _ppExtMem;
+	}//end if _ppExtMem...
+	if(_ppL1Over != NULL)
+	{
+		for(i = 0; i < _maxRefs; i++)
+		{
+			if(_ppL1Over[i] != NULL)
+				delete _ppL1Over[i];
+		}//end for i...
+		delete[] _ppL1Over;
+	}//end if _ppL1Over...
+	if(_ppL1Mem != NULL)
+	{
+		for(i = 0; i < _maxRefs; i++)
+		{
+			if(_ppL1Mem[i] != NULL)
+				PlanePool::Shared()->Release(_ppL1Mem[i]);
+		}//end for i...
+		delete[] _ppL1Mem;
+	}//end if _ppL1Mem...
+	if(_ppRecon != NULL)
+		delete[] _ppRecon;
+
+	if(_ppExtOver8 != NULL)
+	{
+		for(i = 0; i < _maxRefs; i++)
+		{
+			if(_ppExtOver8[i] != NULL)
+				delete _ppExtOver8[i];
+		}//end for i...
+		delete[] _ppExtOver8;
+	}//end if _ppExtOver8...
+	if(_ppExtMem8 != NULL)
+	{
+		for(i = 0; i < _maxRefs; i++)
+		{
+			if(_ppExtMem8[i] != NULL)
+				PlanePool::Shared()->Release(_ppExtMem8[i]);
+		}//end for i...
+		delete[] _ppExtMem8;
+	}//end if _ppExtMem8...
+	if(_ppL1Over8 != NULL)
+	{
+		for(i = 0; i < _maxRefs; i++)
+		{
+			if(_ppL1Over8[i] != NULL)
+				delete _ppL1Over8[i];
+		}//end for i...
+		delete[] _ppL1Over8;
+	}//end if _ppL1Over8...
+	if(_ppL1Mem8 != NULL)
+	{
+		for(i = 0; i < _maxRefs; i++)
+		{
+			if(_ppL1Mem8[i] != NULL)
+				PlanePool::Shared()->Release(_ppL1Mem8[i]);
+		}//end for i...
+		delete[] _ppL1Mem8;
+	}//end if _ppL1Mem8...
+	if(_ppRecon8 != NULL)
+		delete[] _ppRecon8;
+
+	ResetMembers();
+}//end Destroy.
+
+/*
+---------------------------------------------------------------------------
+	Interface methods.
+---------------------------------------------------------------------------
+*/
+void H264RefFrameStore::Reset(void)
+{
+	_numRefs	= 0;
+	_newest		= _maxRefs - 1;	///< The first insert wraps to slot 0.
+}//end Reset.
+
+int H264RefFrameStore::Insert(const short* pRecon)
+{
+	if(!Ready())
+		return(0);
+
+	/// The oldest reference slot is reused.
+	_newest = (_newest + 1) % _maxRefs;
+	if(_numRefs < _maxRefs)
+		_numRefs++;
+
+	int y;
+	if(_pel8)
+	{
+		/// Narrow into the centre of the 8-bit reference.
+		unsigned char** ppExt8 = _ppExtOver8[_newest]->Get2DSrcPtr();
+		for(y = 0; y < _imgHeight; y++)
+			OverlayMem2Dv2u8::Narrow(&(pRecon[y * _imgWidth]), &(ppExt8[_boundary + y][_boundary]), _imgWidth);
+		return(InsertPel8());
+	}//end if _pel8...
+
+	for(y = 0; y < _imgHeight; y++)
+		_ppRecon[y] = (short *)(&(pRecon[y * _imgWidth]));
+
+	/// Level 0: Copy into the centre and extend the boundary.
+	short** ppExt = _ppExtOver[_newest]->Get2DSrcPtr();
+	for(y = 0; y < _imgHeight; y++)
+		memcpy((void *)(&(ppExt[_boundary + y][_boundary])), (const void *)_ppRecon[y], _imgWidth * sizeof(short));
+	_ppExtOver[_newest]->FillBoundaryProxy();
+
+	/// Level 1: Subsample directly into the centre and extend the boundary.
+	OverlayMem2Dv2::Half((void **)_ppRecon, _imgWidth, _imgHeight, (void **)(_ppL1Over[_newest]->Get2DSrcPtr()), _l1Boundary, _l1Boundary);
+	_ppL1Over[_newest]->FillBoundaryProxy();
+
+	return(_numRefs);
+}//end Insert.
+
+int H264RefFrameStore::Insert(const unsigned char* pRecon)
+{
+	if(!Ready() || !_pel8)
+		return(0);
+
+	/// The oldest reference slot is reused.
+	_newest = (_newest + 1) % _maxRefs;
+	if(_numRefs < _maxRefs)
+		_numRefs++;
+
+	unsigned char** ppExt8 = _ppExtOver8[_newest]->Get2DSrcPtr();
+	for(int y = 0; y < _imgHeight; y++)
+		memcpy((void *)(&(ppExt8[_boundary + y][_boundary])), (const void *)(&(pRecon[y * _imgWidth])), _imgWidth);
+	return(InsertPel8());
+}//end Insert.
+
+/** Complete the insert of an 8-bit reference.
+The centre of the newest level 0 reference is filled. Its boundary is extended
+and its level 1 is subsampled and extended.
+@return	: Num of references held.
+*/
+int H264RefFrameStore::InsertPel8(void)
+{
+	unsigned char** ppExt8 = _ppExtOver8[_newest]->Get2DSrcPtr();
+	_ppExtOver8[_newest]->FillBoundaryProxy();
+
+	for(int y = 0; y < _imgHeight; y++)
+		_ppRecon8[y] = &(ppExt8[_boundary + y][_boundary]);
+	OverlayMem2Dv2u8::Half((void **)_ppRecon8, _imgWidth, _imgHeight, (void **)(_ppL1Over8[_newest]->Get2DSrcPtr()), _l1Boundary, _l1Boundary);
+	_ppL1Over8[_newest]->FillBoundaryProxy();
+
+	return(_numRefs);
+}//end InsertPel8.
+
+OverlayExtMem2Dv2* H264RefFrameStore::GetRef(int refIdx)
+{
+	if( _pel8 || (refIdx < 0)||(refIdx >= _numRefs) )
+		return(NULL);
+	return(_ppExtOver[Slot(refIdx)]);
+}//end GetRef.
+
+OverlayExtMem2Dv2* H264RefFrameStore::GetRefL1(int refIdx)
+{
+	if( _pel8 || (refIdx < 0)||(refIdx >= _numRefs) )
+		return(NULL);
+	return(_ppL1Over[Slot(refIdx)]);
+}//end GetRefL1.
+
+OverlayMem2Dv2u8* H264RefFrameStore::GetRefPel8(int refIdx)
+{
+	if( !_pel8 || (refIdx < 0)||(refIdx >= _numRefs) )
+		return(NULL);
+	return(_ppExtOver8[Slot(refIdx)]);
+}//end GetRefPel8.
+
+OverlayMem2Dv2u8* H264RefFrameStore::GetRefL1Pel8(int refIdx)
+{
+	if( !_pel8 || (refIdx < 0)||(refIdx >= _numRefs) )
+		return(NULL);
+	return(_ppL1Over8[Slot(refIdx)]);
+}//end GetRefL1Pel8.
+
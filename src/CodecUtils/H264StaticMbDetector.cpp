@@ -0,0 +1,262 @@
+/** @file
+
+MODULE				: H264StaticMbDetector
+
+TAG						: H264SMD
+
+FILE NAME			: H264StaticMbDetector.cpp
+
+DESCRIPTION		: A frame pre-pass that classifies static macroblocks as skip
+								candidates before motion estimation. The (0,0) vector square
+								error of each 16x16 macroblock is measured with an SSE2 path
+								where available and compared against a QP dependent
+								quantisation noise threshold.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+
+#include "H264StaticMbDetector.h"
+
+/// SSE2 is part of every x64 target. Otherwise the scalar implementation is used.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define H264SMD_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+--------------------------------------------------------------------------
+  Constants. 
+--------------------------------------------------------------------------
+*/
+/// Quantisation noise energy of a 16x16 block = 256 * Qstep^2 / 12 with 
+/// Qstep = 0.625 * 2^(qp/6) indexed by qp = [0..51].
+const int H264StaticMbDetector::H264SMD_Threshold[52] =
+{
+       8,     10,     13,     17,     21,     26,     33,     42,     53,     67,
+      84,    106,    133,    168,    212,    267,    336,    423,    533,    672,
+     847,   1067,   1344,   1693,   2133,   2688,   3386,   4267,   5376,   6773,
+    8533,  10751,  13546,  17067,  21503,  27092,  34133,  43005,  54183,  68267,
+   86011, 108367, 136533, 172021, 216733, 273067, 344042, 433466, 546133, 688085,
+  866933,1092267
+};
+
+/*
+--------------------------------------------------------------------------
+  Construction. 
+--------------------------------------------------------------------------
+*/
+H264StaticMbDetector::H264StaticMbDetector(void)
+{
+	ResetMembers();
+}//end constructor.
+
+H264StaticMbDetector::~H264StaticMbDetector(void)
+{
+	Destroy();
+}//end destructor.
+
+void H264StaticMbDetector::ResetMembers(void)
+{
+	_imgWidth			= 0;
+	_imgHeight		= 0;
+	_mbCols				= 0;
+	_mbRows				= 0;
+	_staticCount	= 0;
+	_pStatic			= NULL;
+	_pZeroVecDiff	= NULL;
+}//end ResetMembers.
+
+int H264StaticMbDetector::Create(int imgWidth, int imgHeight)
+{
+	/// Clean out old mem.
+	Destroy();
+
+	_imgWidth		= imgWidth;
+	_imgHeight	= imgHeight;
+	_mbCols			= imgWidth/16;
+	_mbRows			= imgHeight/16;
+	int mbs			= _mbCols * _mbRows;
+	if(mbs <= 0)
+		return(0);
+
+	_pStatic			= new bool[mbs];
+	_pZeroVecDiff	= new int[mbs];
+	if( (_pStatic == NULL)||(_pZeroVecDiff == NULL) )
+	{
+		Destroy();
+		return(0);
+	}//end if !_pStatic...
+
+	memset((void *)_pStatic, 0, mbs * sizeof(bool));
+	memset((void *)_pZeroVecDiff, 0, mbs * sizeof(int));
+
+	return(1);
+}//end Create.
+
+void H264StaticMbDetector::Destroy(void)
+{
+	if(_pStatic != NULL)
+		delete[] _pStatic;
+	if(_pZeroVecDiff != NULL)
+		delete[] _pZeroVecDiff;
+	ResetMembers();
+}//end Destroy.
+
+/*
+--------------------------------------------------------------------------
+  Interface. 
+--------------------------------------------------------------------------
+*/
+template<typename T> int H264StaticMbDetector::ClassifyPels(const T* pSrc, const T* pRef, int qp)
+{
+	int threshold = GetThreshold(qp);
+
+	_staticCount = 0;
+	int mb = 0;
+	for(int m = 0; m < _mbRows; m++)
+	{
+		int rowOff = (m * 16) * _imgWidth;
+		for(int n = 0; n < _mbCols; n++, mb++)
+		{
+			int d = Tsd16x16(&(pSrc[rowOff + (n * 16)]), &(pRef[rowOff + (n * 16)]), _imgWidth);
+			_pZeroVecDiff[mb] = d;
+			_pStatic[mb]			= (d <= threshold);
+			if(_pStatic[mb])
+				_staticCount++;
+		}//end for n...
+	}//end for m...
+
+	return(_staticCount);
+}//end ClassifyPels.
+
+int H264StaticMbDetector::Classify(const short* pSrc, const short* pRef, int qp)
+{
+	return(ClassifyPels(pSrc, pRef, qp));
+}//end Classify.
+
+int H264StaticMbDetector::Classify(const unsigned char* pSrc, const unsigned char* pRef, int qp)
+{
+	return(ClassifyPels(pSrc, pRef, qp));
+}//end Classify.
+
+int H264StaticMbDetector::GetThreshold(int qp)
+{
+	if(qp < 0)
+		qp = 0;
+	else if(qp > 51)
+		qp = 51;
+	return(H264SMD_Threshold[qp]);
+}//end GetThreshold.
+
+/** Total square error of a 16x16 block.
+The SSE2 path holds 8 pel differences per register and accumulates the 
+pairwise products in 32 bit lanes. The pels are 9 bit at most so there is
+no overflow.
+@param pA			: Top left of the first block.
+@param pB			: Top left of the second block.
+@param width	: Row stride of both images in pels.
+@return				: Total square error.
+*/
+int H264StaticMbDetector::Tsd16x16(const short* pA, const short* pB, int width)
+{
+#ifdef H264SMD_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for(int row = 0; row < 16; row++, pA += width, pB += width)
+	{
+		__m128i d0 = _mm_sub_epi16(_mm_loadu_si128((const __m128i *)pA), _mm_loadu_si128((const __m128i *)pB));
+		__m128i d1 = _mm_sub_epi16(_mm_loadu_si128((const __m128i *)(pA + 8)), _mm_loadu_si128((const __m128i *)(pB + 8)));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(d0, d0));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(d1, d1));
+	}//end for row...
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+	return(_mm_cvtsi128_si32(acc));
+#else
+	int acc = 0;
+	for(int row = 0; row < 16; row++, pA += width, pB += width)
+	{
+		for(int col = 0; col < 16; col++)
+		{
+			int d = (int)pA[col] - (int)pB[col];
+			acc += d * d;
+		}//end for col...
+	}//end for row...
+	return(acc);
+#endif
+}//end Tsd16x16.
+
+/** Total square error of a 16x16 block of 8-bit pels.
+The SSE2 path widens 8 pels per register and then proceeds as for the 16-bit
+pels.
+@param pA			: Top left of the first block.
+@param pB			: Top left of the second block.
+@param width	: Row stride of both images in pels.
+@return				: Total square error.
+*/
+int H264StaticMbDetector::Tsd16x16(const unsigned char* pA, const unsigned char* pB, int width)
+{
+#ifdef H264SMD_SSE2
+	__m128i zero	= _mm_setzero_si128();
+	__m128i acc		= _mm_setzero_si128();
+	for(int row = 0; row < 16; row++, pA += width, pB += width)
+	{
+		__m128i a		= _mm_loadu_si128((const __m128i *)pA);
+		__m128i b		= _mm_loadu_si128((const __m128i *)pB);
+		__m128i d0	= _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+		__m128i d1	= _mm_sub_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(d0, d0));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(d1, d1));
+	}//end for row...
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+	return(_mm_cvtsi128_si32(acc));
+#else
+	int acc = 0;
+	for(int row = 0; row < 16; row++, pA += width, pB += width)
+	{
+		for(int col = 0; col < 16; col++)
+		{
+			int d = (int)pA[col] - (int)pB[col];
+			acc += d * d;
+		}//end for col...
+	}//end for row...
+	return(acc);
+#endif
+}//end Tsd16x16.
+
@@ -0,0 +1,513 @@
+/** @file
+
+MODULE				: LookaheadAnalyser
+
+TAG						: LKA
+
+FILE NAME			: LookaheadAnalyser.cpp
+
+DESCRIPTION		: A lookahead analysis stage that runs on its own thread,
+								pipelined with the encoder. Incoming luminance frames are
+								downsampled 4x, as for the multiresolution level 2, and a
+								cheap 4x4 block motion search gives per frame inter and
+								intra cost estimates, an intra/inter ratio and a scene cut
+								flag up to N frames ahead for rate control.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+#include <math.h>
+
+#include "LookaheadAnalyser.h"
+
+/*
+--------------------------------------------------------------------------
+  Constants. 
+--------------------------------------------------------------------------
+*/
+/// Default proportion of intra blocks that signals a scene cut.
+#define LKA_SCENE_CUT_RATIO			0.7
+/// Default downsampled search range = 16 full pels.
+#define LKA_SEARCH_RANGE				4
+/// Inter cost bias of a 4x4 block in favour of intra. Calc = 16[pels] * 1.
+#define LKA_INTRA_BIAS					16
+
+/*
+--------------------------------------------------------------------------
+  Construction. 
+--------------------------------------------------------------------------
+*/
+LookaheadAnalyser::LookaheadAnalyser(void)
+{
+	ResetMembers();
+}//end constructor.
+
+LookaheadAnalyser::~LookaheadAnalyser(void)
+{
+	Destroy();
+}//end destructor.
+
+void LookaheadAnalyser::ResetMembers(void)
+{
+	_ready					= false;
+	_imgWidth				= 0;
+	_imgHeight			= 0;
+	_depth					= 0;
+	_sceneCutRatio	= LKA_SCENE_CUT_RATIO;
+	_range					= LKA_SEARCH_RANGE;
+
+	_pFrameMem			= NULL;
+	_ppFrameOver		= NULL;
+	_pInfo					= NULL;
+	_pState					= NULL;
+	_pForceCut			= NULL;
+	_head						= 0;
+	_tail						= 0;
+	_next						= 0;
+	_count					= 0;
+	_frameNum				= 0;
+	_cutPending			= true;
+
+	_pL1Mem					= NULL;
+	_pL1Over				= NULL;
+	_pL2Mem[0]			= NULL;
+	_pL2Mem[1]			= NULL;
+	_pL2Over[0]			= NULL;
+	_pL2Over[1]			= NULL;
+	_l2Curr					= 0;
+	_l2PrevValid		= false;
+	_l2PrevDetail		= 0.0;
+
+	_quit						= false;
+}//end ResetMembers.
+
+int LookaheadAnalyser::Create(int imgWidth, int imgHeight, int depth)
+{
+	/// Clean out old mem.
+	Destroy();
+
+	if( (imgWidth < 16)||(imgHeight < 16)||(depth < 1) )
+		return(0);
+
+	_imgWidth		= imgWidth;
+	_imgHeight	= imgHeight;
+	_depth			= depth;
+	int frmSize	= imgWidth * imgHeight;
+
+	/// --------------- Frame queue ---------------------------------------
+	_pFrameMem		= new short[frmSize * depth];
+	_ppFrameOver	= new OverlayMem2Dv2*[depth];
+	_pInfo				= new LKA_FRAME_INFO[depth];
+	_pState				= new int[depth];
+	_pForceCut		= new bool[depth];
+	if( (_pFrameMem == NULL)||(_ppFrameOver == NULL)||(_pInfo == NULL)||(_pState == NULL)||(_pForceCut == NULL) )
+	{
+		Destroy();
+		return(0);
+	}//end if !_pFrameMem...
+	int i;
+	for(i = 0; i < depth; i++)
+	{
+		_pState[i]			= EMPTY;
+		_pForceCut[i]		= false;
+		_ppFrameOver[i] = new OverlayMem2Dv2((void *)(&(_pFrameMem[i * frmSize])), imgWidth, imgHeight, imgWidth, imgHeight);
+	}//end for i...
+	for(i = 0; i < depth; i++)
+	{
+		if(_ppFrameOver[i] == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end if !_ppFrameOver...
+	}//end for i...
+
+	/// --------------- Downsampled levels --------------------------------
+	/// Level 1 is the whole image scratch and level 2 is overlayed with 4x4 blocks.
+	_pL1Mem		= new short[frmSize/4];
+	_pL1Over	= new OverlayMem2Dv2((void *)_pL1Mem, imgWidth/2, imgHeight/2, imgWidth/2, imgHeight/2);
+	if( (_pL1Mem == NULL)||(_pL1Over == NULL) )
+	{
+		Destroy();
+		return(0);
+	}//end if !_pL1Mem...
+	for(i = 0; i < 2; i++)
+	{
+		_pL2Mem[i]	= new short[frmSize/16];
+		_pL2Over[i] = new OverlayMem2Dv2((void *)_pL2Mem[i], imgWidth/4, imgHeight/4, 4, 4);
+		if( (_pL2Mem[i] == NULL)||(_pL2Over[i] == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_pL2Mem...
+	}//end for i...
+
+	/// --------------- Analysis thread -----------------------------------
+	_quit		= false;
+	_thread = std::thread(&LookaheadAnalyser::Run, this);
+
+	_ready = true;
+	return(1);
+}//end Create.
+
+void LookaheadAnalyser::Destroy(void)
+{
+	/// Stop the thread before the mem goes.
+	if(_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_quit = true;
+		}
+		_cond.notify_all();
+		_thread.join();
+	}//end if joinable...
+
+	int i;
+	if(_ppFrameOver != NULL)
+	{
+		for(i = 0; i < _depth; i++)
+		{
+			if(_ppFrameOver[i] != NULL)
+				delete _ppFrameOver[i];
+		}//end for i...
+		delete[] _ppFrameOver;
+	}//end if _ppFrameOver...
+	if(_pFrameMem != NULL)
+		delete[] _pFrameMem;
+	if(_pInfo != NULL)
+		delete[] _pInfo;
+	if(_pState != NULL)
+		delete[] _pState;
+	if(_pForceCut != NULL)
+		delete[] _pForceCut;
+
+	if(_pL1Over != NULL)
+		delete _pL1Over;
+	if(_pL1Mem != NULL)
+		delete[] _pL1Mem;
+	for(i = 0; i < 2; i++)
+	{
+		if(_pL2Over[i] != NULL)
+			delete _pL2Over[i];
+		if(_pL2Mem[i] != NULL)
+			delete[] _pL2Mem[i];
+	}//end for i...
+
+	ResetMembers();
+}//end Destroy.
+
+/*
+--------------------------------------------------------------------------
+  Interface. 
+--------------------------------------------------------------------------
+*/
+int LookaheadAnalyser::Push(const short* pLum)
+{
+	if(!_ready)
+		return(0);
+
+	int slot;
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cond.wait(lock, [this]{ return((_count < _depth)||_quit); });
+		if(_quit)
+			return(0);
+		slot = _head;
+	}
+
+	/// The empty slot belongs to the caller until it is marked as pending.
+	memcpy((void *)(&(_pFrameMem[slot * _imgWidth * _imgHeight])), (const void *)pLum, _imgWidth * _imgHeight * sizeof(short));
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_pInfo[slot].frameNum = _frameNum++;
+		_pForceCut[slot]			= _cutPending;
+		_cutPending						= false;
+		_pState[slot]					= PENDING;
+		_head									= (_head + 1) % _depth;
+		_count++;
+	}
+	_cond.notify_all();
+
+	return(1);
+}//end Push.
+
+int LookaheadAnalyser::Pop(LKA_FRAME_INFO* pInfo)
+{
+	if(!_ready)
+		return(0);
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		if(_count == 0)
+			return(0);
+		_cond.wait(lock, [this]{ return((_pState[_tail] == DONE)||_quit); });
+		if(_quit)
+			return(0);
+
+		*pInfo					= _pInfo[_tail];
+		_pState[_tail]	= EMPTY;
+		_tail						= (_tail + 1) % _depth;
+		_count--;
+	}
+	_cond.notify_all();
+
+	return(1);
+}//end Pop.
+
+int LookaheadAnalyser::Peek(int ahead, LKA_FRAME_INFO* pInfo)
+{
+	if(!_ready)
+		return(0);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	if( (ahead < 0)||(ahead >= _count) )
+		return(0);
+	int slot = (_tail + ahead) % _depth;
+	if(_pState[slot] != DONE)
+		return(0);
+	*pInfo = _pInfo[slot];
+
+	return(1);
+}//end Peek.
+
+int LookaheadAnalyser::Signal(IRateControl* pRC, LKA_FRAME_INFO* pInfo)
+{
+	LKA_FRAME_INFO info;
+	if(!Pop(&info))
+		return(0);
+
+	/// Mean cost over the frame and the frames ahead of it in the same scene.
+	double	sum = info.interCost;
+	int			n		= 1;
+	LKA_FRAME_INFO next;
+	for(int i = 0; Peek(i, &next) && !next.sceneCut; i++, n++)
+		sum += next.interCost;
+	double mean = sum/(double)n;
+
+	if(pRC != NULL)
+	{
+		if(info.sceneCut)
+			pRC->SignalSceneChange(info.mse, info.mae);
+		pRC->SignalComplexity((mean > 0.0) ? (info.interCost/mean) : 1.0);
+	}//end if pRC...
+
+	if(pInfo != NULL)
+		*pInfo = info;
+	return(1);
+}//end Signal.
+
+int LookaheadAnalyser::GetQueueLength(void)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return(_count);
+}//end GetQueueLength.
+
+void LookaheadAnalyser::Reset(void)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_cutPending = true;
+}//end Reset.
+
+/*
+--------------------------------------------------------------------------
+  Private methods. 
+--------------------------------------------------------------------------
+*/
+void LookaheadAnalyser::Run(void)
+{
+	while(true)
+	{
+		int slot;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cond.wait(lock, [this]{ return((_pState[_next] == PENDING)||_quit); });
+			if(_quit)
+				return;
+			slot = _next;
+		}
+
+		/// The pending slot is not touched by the other methods.
+		Analyse(slot);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_pState[slot] = DONE;
+			_next					= (_next + 1) % _depth;
+		}
+		_cond.notify_all();
+	}//end while...
+}//end Run.
+
+/** Analyse a queued frame.
+The frame is downsampled 4x and each 4x4 block, i.e. each macroblock at full
+resolution, is full searched within the previous downsampled frame. The intra
+cost is the block square error from its mean. The block takes the least of the 
+two costs and is counted as intra if its inter cost is not better by a bias.
+The frame mse and mae are estimated at full resolution by adding back the
+detail, the square error of the full resolution pels from their downsampled
+pel, of the frame and, for inter blocks, of the reference. The detail of the
+reference is treated as uncorrelated with that of the frame, as at a scene cut.
+@param slot	: Queue slot of the frame.
+@return			: none.
+*/
+void LookaheadAnalyser::Analyse(int slot)
+{
+	int l2Width		= _imgWidth/4;
+	int l2Height	= _imgHeight/4;
+	int l2Prev		= 1 - _l2Curr;
+
+	/// Reuse the multiresolution subsampling to level 2.
+	OverlayMem2Dv2::Half((void **)(_ppFrameOver[slot]->Get2DSrcPtr()), _imgWidth, _imgHeight, 
+											 (void **)(_pL1Over->Get2DSrcPtr()));
+	OverlayMem2Dv2::Half((void **)(_pL1Over->Get2DSrcPtr()), _imgWidth/2, _imgHeight/2, 
+											 (void **)(_pL2Over[_l2Curr]->Get2DSrcPtr()));
+
+	OverlayMem2Dv2* pCurr = _pL2Over[_l2Curr];
+	OverlayMem2Dv2* pPrev = _pL2Over[l2Prev];
+	short**					curr	= pCurr->Get2DSrcPtr();
+	short**					prev	= pPrev->Get2DSrcPtr();
+	short**					full	= _ppFrameOver[slot]->Get2DSrcPtr();
+	bool						inter	= _l2PrevValid && !_pForceCut[slot];
+
+	double	interCost		= 0.0;
+	double	intraCost		= 0.0;
+	double	absErr			= 0.0;
+	double	fullErr			= 0.0;	///< Full resolution square error estimate.
+	double	detailSum		= 0.0;
+	int			intraBlks		= 0;
+	int			blks				= 0;
+
+	for(int m = 0; m < l2Height; m += 4)
+		for(int n = 0; n < l2Width; n += 4, blks++)
+	{
+		int i, j;
+
+		/// Intra cost from the block mean.
+		int sum = 0;
+		int sqr = 0;
+		for(i = 0; i < 4; i++)
+			for(j = 0; j < 4; j++)
+			{
+				int x = curr[m + i][n + j];
+				sum += x;
+				sqr += x * x;
+			}//end for i & j...
+		int intraDiff = sqr - ((sum * sum) >> 4);
+		int mean			= (sum + 8) >> 4;
+
+		/// Detail lost to the downsampling in the 16x16 full resolution block.
+		int detail = 0;
+		for(i = 0; i < 16; i++)
+			for(j = 0; j < 16; j++)
+			{
+				int d = full[4*m + i][4*n + j] - curr[m + (i >> 2)][n + (j >> 2)];
+				detail += d * d;
+			}//end for i & j...
+		detailSum += (double)detail;
+
+		int minDiff = intraDiff + LKA_INTRA_BIAS + 1;
+		int mx = 0;
+		int my = 0;
+		if(inter)
+		{
+			/// Full search clipped to the image.
+			pCurr->SetOrigin(n, m);
+			for(i = -_range; i <= _range; i++)
+			{
+				if( ((m + i) < 0)||((m + i) > (l2Height - 4)) ) continue;
+				for(j = -_range; j <= _range; j++)
+				{
+					if( ((n + j) < 0)||((n + j) > (l2Width - 4)) ) continue;
+					pPrev->SetOrigin(n + j, m + i);
+					int blkDiff = pCurr->Tsd4x4LessThan(*pPrev, minDiff);
+					if(blkDiff < minDiff)
+					{
+						minDiff = blkDiff;
+						mx = j;
+						my = i;
+					}//end if blkDiff...
+				}//end for j...
+			}//end for i...
+		}//end if inter...
+
+		intraCost += (double)intraDiff;
+		if(minDiff > (intraDiff + LKA_INTRA_BIAS))
+		{
+			/// Intra is cheaper.
+			intraBlks++;
+			interCost += (double)intraDiff;
+			fullErr		+= (double)(16 * intraDiff + detail);
+			for(i = 0; i < 4; i++)
+				for(j = 0; j < 4; j++)
+				{
+					int d = curr[m + i][n + j] - mean;
+					absErr += (double)((d < 0) ? -d : d);
+				}//end for i & j...
+		}//end if minDiff...
+		else
+		{
+			interCost += (double)minDiff;
+			fullErr		+= (double)(16 * minDiff + detail) + (256.0 * _l2PrevDetail);
+			for(i = 0; i < 4; i++)
+				for(j = 0; j < 4; j++)
+				{
+					int d = curr[m + i][n + j] - prev[m + my + i][n + mx + j];
+					absErr += (double)((d < 0) ? -d : d);
+				}//end for i & j...
+		}//end else...
+	}//end for m & n...
+
+	LKA_FRAME_INFO* pInfo = &(_pInfo[slot]);
+	double pels					= (double)(blks * 16);
+	pInfo->interCost		= interCost;
+	pInfo->intraCost		= intraCost;
+	pInfo->intraRatio		= (double)intraBlks/(double)blks;
+	pInfo->mse					= fullErr/(16.0 * pels);
+	/// The mae is scaled with the rms error and bounded by it when the downsampled error is zero.
+	double l2Mse				= interCost/pels;
+	pInfo->mae					= (l2Mse > 0.0) ? ((absErr/pels) * sqrt(pInfo->mse/l2Mse)) : sqrt(pInfo->mse);
+	pInfo->sceneCut			= !inter || (pInfo->intraRatio > _sceneCutRatio);
+
+	/// This frame is the reference for the next.
+	_l2Curr				= l2Prev;
+	_l2PrevValid	= true;
+	_l2PrevDetail	= detailSum/(16.0 * pels);
+
+}//end Analyse.
+
@@ -141,7 +141,7 @@ int MotionCompensatorH263ImplUnres::Create(	void* ref,
 	// Create the new extended boundary temp ref into _pExtTmpLum, _pExtTmpChrU
 	// and _pExtTmpChrV. These are required before placing overlays on them.
 
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefLum, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefLum, 
 																			_imgWidth,						
 																			_imgHeight, 
 																			_range + 1, // Extend left and right by...
@@ -154,7 +154,7 @@ int MotionCompensatorH263ImplUnres::Create(	void* ref,
 	_extLumWidth	= _imgWidth + (_range + 1)*2;
 	_extLumHeight	= _imgHeight + (_range + 1)*2;
 
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefChrU, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefChrU, 
 																			_chrWidth,						
 																			_chrHeight, 
 																			(_range/2) + 2, // Extend left and right by...
@@ -164,7 +164,7 @@ int MotionCompensatorH263ImplUnres::Create(	void* ref,
 		Destroy();
 	  return(0);
   }//end if !ExtendBoundary...
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefChrV, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefChrV, 
 																			_chrWidth,						
 																			_chrHeight, 
 																			(_range/2) + 2, // Extend left and right by...
@@ -261,13 +261,13 @@ void MotionCompensatorH263ImplUnres::Destroy(void)
 
 	// Delete extended temp ref mem.
 	if(_pExtTmpLum != NULL)
-		delete[] _pExtTmpLum;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtTmpLum);
 	_pExtTmpLum = NULL;
 	if(_pExtTmpChrU != NULL)
-		delete[] _pExtTmpChrU;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtTmpChrU);
 	_pExtTmpChrU = NULL;
 	if(_pExtTmpChrV != NULL)
-		delete[] _pExtTmpChrV;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtTmpChrV);
 	_pExtTmpChrV = NULL;
 
 	if(_pMBlkOver != NULL)
@@ -53,13 +53,20 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
+#include <thread>
 
 #include	"MotionCompensatorH264ImplStd.h"
+#include	"PlanePool.h"
 
 /// Boundary padding past the motion vector extremes. Required for calculating
 /// sub-pixel interpolations. Only required at level 0 resolution.
 #define MCH264IS_PADDING	4
 
+/// Margin around a macroblock in the edge emulation work blocks that covers 
+/// the interpolation filter taps of a quarter pel lum and eighth pel chr read.
+#define MCH264IS_EDGE_LUM_MARGIN	4
+#define MCH264IS_EDGE_CHR_MARGIN	2
+
 /*
 --------------------------------------------------------------------------
   Macros. 
@@ -106,10 +113,32 @@ MotionCompensatorH264ImplStd::MotionCompensatorH264ImplStd(int range)
 	_pExtTmpChrVOver		= NULL;
 	_extChrWidth				= 0;
 	_extChrHeight				= 0;
+	_lumBoundary				= 0;
+	_chrBoundary				= 0;
 
 	_pMBlk							= NULL;
 	_pMBlkOver					= NULL;
 
+	_edgeEmulation			= 0;
+	_pEdgeLum						= NULL;
+	_pEdgeLumOver				= NULL;
+	_pEdgeChr						= NULL;
+	_pEdgeChrOver				= NULL;
+
+	_pel8								= 0;			///< 16-bit lum ref.
+	_pRefLum8						= NULL;
+	_pRefLumOver8				= NULL;
+	_pExtTmpLum8				= NULL;
+	_extLumStride8			= 0;
+	_pExtTmpLumOver8		= NULL;
+	_pEdgeLum8					= NULL;
+	_pEdgeLumOver8			= NULL;
+	_pMBlk8							= NULL;
+	_pMBlkOver8					= NULL;
+
+	_threads						= 1;
+	_pBand							= NULL;
+
 }//end constructor.
 
 MotionCompensatorH264ImplStd::~MotionCompensatorH264ImplStd(void)
@@ -144,18 +173,30 @@ int MotionCompensatorH264ImplStd::Create(	void* ref,
 	_chrMacroBlkHeight	= macroBlkHeight/2;
 	_refSize						= (_imgWidth * _imgHeight) + 2*(_chrWidth * _chrHeight);
 
-	/// Assign the head of contiguous mem to the lum ref.
-	_pRefLum = (short *)ref;
-	_pRefChrU = &_pRefLum[_imgWidth * _imgHeight];
-	_pRefChrV = &_pRefLum[(_imgWidth * _imgHeight) + (_chrWidth * _chrHeight)];
+	/// Assign the head of contiguous mem to the lum ref. An 8-bit lum ref is
+	/// followed by the short chr refs.
+	if(_pel8)
+	{
+		_pRefLum8 = (unsigned char *)ref;
+		_pRefChrU = (short *)(&_pRefLum8[_imgWidth * _imgHeight]);
+	}//end if _pel8...
+	else
+	{
+		_pRefLum = (short *)ref;
+		_pRefChrU = &_pRefLum[_imgWidth * _imgHeight];
+	}//end else...
+	_pRefChrV = &_pRefChrU[_chrWidth * _chrHeight];
 
 	/// --------------- Configure ref overlays --------------------------------
 	/// Overlay the reference and set to the motion block size.  
-	_pRefLumOver	= new OverlayMem2Dv2( (void *)_pRefLum, 
-																			_imgWidth, 
-																			_imgHeight, 
-																			_macroBlkWidth, 
-																			_macroBlkHeight );
+	if(_pel8)
+		_pRefLumOver8	= new OverlayMem2Dv2u8((void *)_pRefLum8, _imgWidth, _imgHeight, _macroBlkWidth, _macroBlkHeight);
+	else
+		_pRefLumOver	= new OverlayMem2Dv2( (void *)_pRefLum, 
+																				_imgWidth, 
+																				_imgHeight, 
+																				_macroBlkWidth, 
+																				_macroBlkHeight );
 	_pRefChrUOver	= new OverlayMem2Dv2( (void *)_pRefChrU, 
 																			_chrWidth, 
 																			_chrHeight, 
@@ -166,7 +207,7 @@ int MotionCompensatorH264ImplStd::Create(	void* ref,
 																			_chrHeight, 
 																			_chrMacroBlkWidth, 
 																			_chrMacroBlkHeight );
-	if( (_pRefLumOver == NULL)||(_pRefChrUOver == NULL)||(_pRefChrVOver == NULL) )
+	if( ((_pRefLumOver == NULL)&&(_pRefLumOver8 == NULL))||(_pRefChrUOver == NULL)||(_pRefChrVOver == NULL) )
   {
 		Destroy();
 	  return(0);
@@ -174,73 +215,98 @@ int MotionCompensatorH264ImplStd::Create(	void* ref,
 
 	/// --------------- Create extended boundary mem ---------------------------
 	/// Create the new extended boundary temp ref into _pExtTmpLum, _pExtTmpChrU
-	/// and _pExtTmpChrV. These are required before placing overlays on them.
-
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefLum, 
-																				_imgWidth,						
-																				_imgHeight, 
-																				_range + 1 + MCH264IS_PADDING,	///< Extend left and right by...
-																				_range + 1 + MCH264IS_PADDING,	///< Extend top and bottom by...
-																				(void **)(&_pExtTmpLum)) )			///< Created in the method.
+	/// and _pExtTmpChrV. These are required before placing overlays on them. With
+	/// edge emulation there is no boundary and the temp ref is a plain copy.
+	if(_edgeEmulation)
+	{
+		_lumBoundary = 0;
+		_chrBoundary = 0;
+	}//end if _edgeEmulation...
+	else
+	{
+		_lumBoundary = _range + 1 + MCH264IS_PADDING;
+		_chrBoundary = (_range/2) + 4;
+	}//end else...
+
+	_extLumWidth	= _imgWidth + _lumBoundary*2;
+	_extLumHeight	= _imgHeight + _lumBoundary*2;
+	/// The 8-bit lum temp ref is filled in PrepareForSingleVectorMode().
+	if(_pel8)
+	{
+		_pExtTmpLum8 = (unsigned char *)PlanePool::Shared()->Acquire(_extLumWidth, _extLumHeight, sizeof(unsigned char), 1, &_extLumStride8);
+		if(_pExtTmpLum8 == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end if !_pExtTmpLum8...
+	}//end if _pel8...
+	else if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefLum, 
+																							_imgWidth,						
+																							_imgHeight, 
+																							_lumBoundary,										///< Extend left and right by...
+																							_lumBoundary,										///< Extend top and bottom by...
+																							(void **)(&_pExtTmpLum)) )			///< Created in the method.
   {
 		Destroy();
 	  return(0);
   }//end if !ExtendBoundary...
-	_extLumWidth	= _imgWidth + (_range + 1 + MCH264IS_PADDING)*2;
-	_extLumHeight	= _imgHeight + (_range + 1 + MCH264IS_PADDING)*2;
 
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefChrU, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefChrU, 
 																				_chrWidth,						
 																				_chrHeight, 
-																				(_range/2) + 4, ///< Extend left and right by...
-																				(_range/2) + 4,	///< Extend top and bottom by...
+																				_chrBoundary,	///< Extend left and right by...
+																				_chrBoundary,	///< Extend top and bottom by...
 																				(void **)(&_pExtTmpChrU)) )	///< Created in the method.
   {
 		Destroy();
 	  return(0);
   }//end if !ExtendBoundary...
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefChrV, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefChrV, 
 																				_chrWidth,						
 																				_chrHeight, 
-																				(_range/2) + 4, ///< Extend left and right by...
-																				(_range/2) + 4,	///< Extend top and bottom by...
+																				_chrBoundary,	///< Extend left and right by...
+																				_chrBoundary,	///< Extend top and bottom by...
 																				(void **)(&_pExtTmpChrV)) )	///< Created in the method.
   {
 		Destroy();
 	  return(0);
   }//end if !ExtendBoundary...
-	_extChrWidth	= _chrWidth + ((_range/2) + 4)*2;
-	_extChrHeight	= _chrHeight + ((_range/2) + 4)*2;
+	_extChrWidth	= _chrWidth + _chrBoundary*2;
+	_extChrHeight	= _chrHeight + _chrBoundary*2;
 
 	/// --------------- Configure temp extended ref overlays -------------------------
 	/// Overlay the extended temp ref and set to the whole image block size. In use 
 	/// call the SetOverlayDim() method to switch the block size.
 
-	_pExtTmpLumOver = new OverlayExtMem2Dv2(_pExtTmpLum, 
-																					_extLumWidth,		///< new mem width.
-																					_extLumHeight,	///< new mem height.
-																					_imgWidth,			///< block width.
-																					_imgHeight,			///< block height.
-																					_range + 1 + MCH264IS_PADDING,		///< boundary width.
-																					_range + 1 + MCH264IS_PADDING);		///< boundary height.
+	if(_pel8)
+		_pExtTmpLumOver8 = new OverlayMem2Dv2u8(_pExtTmpLum8, _extLumWidth, _extLumHeight, _macroBlkWidth, _macroBlkHeight, 
+																						_lumBoundary, _lumBoundary, _extLumStride8);
+	else
+		_pExtTmpLumOver = new OverlayExtMem2Dv2(_pExtTmpLum, 
+																						_extLumWidth,		///< new mem width.
+																						_extLumHeight,	///< new mem height.
+																						_imgWidth,			///< block width.
+																						_imgHeight,			///< block height.
+																						_lumBoundary,		///< boundary width.
+																						_lumBoundary);	///< boundary height.
 
 	_pExtTmpChrUOver = new OverlayExtMem2Dv2(	_pExtTmpChrU, 
 																						_extChrWidth,		///< new mem width.
 																						_extChrHeight,	///< new mem height.
 																						_chrWidth,			///< block width.
 																						_chrHeight,			///< block height.
-																						(_range/2) + 4,	///< boundary width.
-																						(_range/2) + 4);///< boundary height.
+																						_chrBoundary,		///< boundary width.
+																						_chrBoundary);	///< boundary height.
 
 	_pExtTmpChrVOver = new OverlayExtMem2Dv2(	_pExtTmpChrV, 
 																						_extChrWidth,		///< new mem width.
 																						_extChrHeight,	///< new mem height.
 																						_chrWidth,			///< block width.
 																						_chrHeight,			///< block height.
-																						(_range/2) + 4,	///< boundary width.
-																						(_range/2) + 4);///< boundary height.
+																						_chrBoundary,		///< boundary width.
+																						_chrBoundary);	///< boundary height.
 
-	if( (_pExtTmpLumOver == NULL)||(_pExtTmpChrUOver == NULL)||(_pExtTmpChrVOver == NULL) )
+	if( ((_pExtTmpLumOver == NULL)&&(_pExtTmpLumOver8 == NULL))||(_pExtTmpChrUOver == NULL)||(_pExtTmpChrVOver == NULL) )
   {
 		Destroy();
 	  return(0);
@@ -256,17 +322,73 @@ int MotionCompensatorH264ImplStd::Create(	void* ref,
 		Destroy();
 	  return(0);
   }//end if !_pMBlk...
+	if(_pel8)
+	{
+		_pMBlk8			= new unsigned char[_macroBlkWidth * _macroBlkHeight];
+		if(_pMBlk8 != NULL)
+			_pMBlkOver8	= new OverlayMem2Dv2u8(_pMBlk8, _macroBlkWidth, _macroBlkHeight, _macroBlkWidth, _macroBlkHeight);
+		if(_pMBlkOver8 == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end if !_pMBlkOver8...
+	}//end if _pel8...
+
+	/// Edge clamped work blocks are only required with edge emulation.
+	if(_edgeEmulation)
+	{
+		int lumEdgeWidth	= _macroBlkWidth + 2*MCH264IS_EDGE_LUM_MARGIN;
+		int lumEdgeHeight	= _macroBlkHeight + 2*MCH264IS_EDGE_LUM_MARGIN;
+		int chrEdgeWidth	= _chrMacroBlkWidth + 2*MCH264IS_EDGE_CHR_MARGIN;
+		int chrEdgeHeight	= _chrMacroBlkHeight + 2*MCH264IS_EDGE_CHR_MARGIN;
+		_pEdgeLum			= new short[lumEdgeWidth * lumEdgeHeight];
+		_pEdgeLumOver = new OverlayMem2Dv2(_pEdgeLum, lumEdgeWidth, lumEdgeHeight, lumEdgeWidth, lumEdgeHeight);
+		_pEdgeChr			= new short[chrEdgeWidth * chrEdgeHeight];
+		_pEdgeChrOver = new OverlayMem2Dv2(_pEdgeChr, chrEdgeWidth, chrEdgeHeight, chrEdgeWidth, chrEdgeHeight);
+		if( (_pEdgeLum == NULL)||(_pEdgeLumOver == NULL)||(_pEdgeChr == NULL)||(_pEdgeChrOver == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_pEdgeLum...
+		if(_pel8)
+		{
+			_pEdgeLum8			= new unsigned char[lumEdgeWidth * lumEdgeHeight];
+			if(_pEdgeLum8 != NULL)
+				_pEdgeLumOver8	= new OverlayMem2Dv2u8(_pEdgeLum8, lumEdgeWidth, lumEdgeHeight, lumEdgeWidth, lumEdgeHeight);
+			if(_pEdgeLumOver8 == NULL)
+			{
+				Destroy();
+				return(0);
+			}//end if !_pEdgeLumOver8...
+		}//end if _pel8...
+	}//end if _edgeEmulation...
+
+	/// Overlays for each row band when threaded.
+	if(!CreateBands())
+  {
+		Destroy();
+	  return(0);
+  }//end if !CreateBands...
 
 	return(1);
 }//end Create.
 
 void	MotionCompensatorH264ImplStd::Reset(void)
 {
-	memset((void *)_pRefLum, 0, _refSize * sizeof(short));
+	if(_pel8)
+	{
+		memset((void *)_pRefLum8, 0, _imgWidth * _imgHeight);
+		memset((void *)_pRefChrU, 0, 2 * _chrWidth * _chrHeight * sizeof(short));
+	}//end if _pel8...
+	else
+		memset((void *)_pRefLum, 0, _refSize * sizeof(short));
 }//end Reset.
 
 void MotionCompensatorH264ImplStd::Destroy(void)
 {
+	/// The band overlays are on the mem below.
+	DestroyBands();
+
 	if(_pRefLumOver != NULL)
 		delete _pRefLumOver;
 	_pRefLumOver = NULL;
@@ -279,7 +401,12 @@ void MotionCompensatorH264ImplStd::Destroy(void)
 		delete _pRefChrVOver;
 	_pRefChrVOver = NULL;
 
+	if(_pRefLumOver8 != NULL)
+		delete _pRefLumOver8;
+	_pRefLumOver8 = NULL;
+
 	_pRefLum		= NULL;
+	_pRefLum8		= NULL;
 	_pRefChrU		= NULL;
 	_pRefChrV		= NULL;
 
@@ -296,13 +423,13 @@ void MotionCompensatorH264ImplStd::Destroy(void)
 
 	/// Delete extended temp ref mem.
 	if(_pExtTmpLum != NULL)
-		delete[] _pExtTmpLum;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtTmpLum);
 	_pExtTmpLum = NULL;
 	if(_pExtTmpChrU != NULL)
-		delete[] _pExtTmpChrU;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtTmpChrU);
 	_pExtTmpChrU = NULL;
 	if(_pExtTmpChrV != NULL)
-		delete[] _pExtTmpChrV;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtTmpChrV);
 	_pExtTmpChrV = NULL;
 
 	if(_pMBlkOver != NULL)
@@ -312,6 +439,38 @@ void MotionCompensatorH264ImplStd::Destroy(void)
 	if(_pMBlk != NULL)
 		delete[] _pMBlk;
 	_pMBlk = NULL;
+
+	if(_pEdgeLumOver != NULL)
+		delete _pEdgeLumOver;
+	_pEdgeLumOver = NULL;
+	if(_pEdgeLum != NULL)
+		delete[] _pEdgeLum;
+	_pEdgeLum = NULL;
+	if(_pEdgeChrOver != NULL)
+		delete _pEdgeChrOver;
+	_pEdgeChrOver = NULL;
+	if(_pEdgeChr != NULL)
+		delete[] _pEdgeChr;
+	_pEdgeChr = NULL;
+
+	if(_pExtTmpLumOver8 != NULL)
+		delete _pExtTmpLumOver8;
+	_pExtTmpLumOver8 = NULL;
+	if(_pExtTmpLum8 != NULL)
+		PlanePool::Shared()->Release(_pExtTmpLum8);
+	_pExtTmpLum8 = NULL;
+	if(_pMBlkOver8 != NULL)
+		delete _pMBlkOver8;
+	_pMBlkOver8 = NULL;
+	if(_pMBlk8 != NULL)
+		delete[] _pMBlk8;
+	_pMBlk8 = NULL;
+	if(_pEdgeLumOver8 != NULL)
+		delete _pEdgeLumOver8;
+	_pEdgeLumOver8 = NULL;
+	if(_pEdgeLum8 != NULL)
+		delete[] _pEdgeLum8;
+	_pEdgeLum8 = NULL;
 }//end Destroy.
 
 /** Motion compensate to the reference.
@@ -335,6 +494,29 @@ void MotionCompensatorH264ImplStd::Compensate(void* pMotionList)
   /// from the tmp and written back to the ref. 
 	PrepareForSingleVectorMode();
 
+	/// Split the macroblock rows into bands that are compensated concurrently. The 
+	/// macroblocks only read from the tmp and write to their own area of the ref.
+	int mbRows	= _imgHeight/_macroBlkHeight;
+	int threads = (_threads < mbRows) ? _threads : mbRows;
+	if( (threads > 1)&&(_pBand != NULL)&&(listLen >= (mbRows * (_imgWidth/_macroBlkWidth))) )
+	{
+		std::thread* pThread[MCH264IS_MAX_THREADS];
+		int t;
+		for(t = 1; t < threads; t++)
+			pThread[t] = new std::thread(&MotionCompensatorH264ImplStd::CompensateBand, this, &(_pBand[t]), pL, 
+																	 (t * mbRows)/threads, ((t + 1) * mbRows)/threads, 0);
+		/// The invalidation only applies to the first macroblock of the frame.
+		CompensateBand(&(_pBand[0]), pL, 0, mbRows/threads, _invalid);
+		for(t = 1; t < threads; t++)
+		{
+			pThread[t]->join();
+			delete pThread[t];
+		}//end for t...
+
+		_invalid = 0;
+		return;
+	}//end if threads...
+
   /// Do compensation in the sequence order from tmp to ref.
 	int mvx	= 0;
 	int mvy	= 0;
@@ -361,26 +543,43 @@ void MotionCompensatorH264ImplStd::PrepareForSingleVectorMode(void)
 {
 	/// Write the ref to the temp ref and fill its extended boundary. The 
 	/// centre part of _pExtTmpLumOver is copied from _pRefLumOver before 
-	/// filling the boundary.
-
-	/// Set pos and block size to whole image for temp and ref.
-	_pExtTmpLumOver->SetOrigin(0, 0);
-	_pExtTmpLumOver->SetOverlayDim(_imgWidth, _imgHeight);
-	_pRefLumOver->SetOrigin(0, 0);
-	_pRefLumOver->SetOverlayDim(_imgWidth, _imgHeight);
-	/// Fill and extend boundary.
-	_pExtTmpLumOver->Write(*_pRefLumOver);
-	_pExtTmpLumOver->FillBoundaryProxy();
-	/// Set block sizes back to the macroblock.
-	_pExtTmpLumOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
-	_pRefLumOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+	/// filling the boundary. There is no boundary to fill with edge emulation.
+
+	if(_pel8)
+	{
+		_pExtTmpLumOver8->SetOrigin(0, 0);
+		_pExtTmpLumOver8->SetOverlayDim(_imgWidth, _imgHeight);
+		_pRefLumOver8->SetOrigin(0, 0);
+		_pRefLumOver8->SetOverlayDim(_imgWidth, _imgHeight);
+		_pExtTmpLumOver8->Write(*_pRefLumOver8);
+		if(!_edgeEmulation)
+			_pExtTmpLumOver8->FillBoundaryProxy();
+		_pExtTmpLumOver8->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+		_pRefLumOver8->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+	}//end if _pel8...
+	else
+	{
+		/// Set pos and block size to whole image for temp and ref.
+		_pExtTmpLumOver->SetOrigin(0, 0);
+		_pExtTmpLumOver->SetOverlayDim(_imgWidth, _imgHeight);
+		_pRefLumOver->SetOrigin(0, 0);
+		_pRefLumOver->SetOverlayDim(_imgWidth, _imgHeight);
+		/// Fill and extend boundary.
+		_pExtTmpLumOver->Write(*_pRefLumOver);
+		if(!_edgeEmulation)
+			_pExtTmpLumOver->FillBoundaryProxy();
+		/// Set block sizes back to the macroblock.
+		_pExtTmpLumOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+		_pRefLumOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+	}//end else...
 
 	_pExtTmpChrUOver->SetOrigin(0, 0);
 	_pExtTmpChrUOver->SetOverlayDim(_chrWidth, _chrHeight);
 	_pRefChrUOver->SetOrigin(0, 0);
 	_pRefChrUOver->SetOverlayDim(_chrWidth, _chrHeight);
 	_pExtTmpChrUOver->Write(*_pRefChrUOver);
-	_pExtTmpChrUOver->FillBoundaryProxy();
+	if(!_edgeEmulation)
+		_pExtTmpChrUOver->FillBoundaryProxy();
 	_pExtTmpChrUOver->SetOverlayDim(_chrMacroBlkWidth, _chrMacroBlkHeight);
 	_pRefChrUOver->SetOverlayDim(_chrMacroBlkWidth, _chrMacroBlkHeight);
 
@@ -389,7 +588,8 @@ void MotionCompensatorH264ImplStd::PrepareForSingleVectorMode(void)
 	_pRefChrVOver->SetOrigin(0, 0);
 	_pRefChrVOver->SetOverlayDim(_chrWidth, _chrHeight);
 	_pExtTmpChrVOver->Write(*_pRefChrVOver);
-	_pExtTmpChrVOver->FillBoundaryProxy();
+	if(!_edgeEmulation)
+		_pExtTmpChrVOver->FillBoundaryProxy();
 	_pExtTmpChrVOver->SetOverlayDim(_chrMacroBlkWidth, _chrMacroBlkHeight);
 	_pRefChrVOver->SetOverlayDim(_chrMacroBlkWidth, _chrMacroBlkHeight);
 
@@ -412,65 +612,402 @@ void MotionCompensatorH264ImplStd::Compensate(int tlx, int tly, int mvx, int mvy
 	/// Don't bother if the vector is zero unless invalidated.
 	if( mvx || mvy || _invalid )
   {
-    /// Lum first.
-    _pMBlkOver->SetOverlayDim(16,16);
-
-    int motion_x			= mvx / 4;	///< Convert quarter pel units to full and quarter offsets.
-    int motion_y			= mvy / 4;
-    int quarter_motion_x	= mvx % 4;
-    int quarter_motion_y	= mvy % 4;
-
- 		/// Position the overlays. The vector is always assumed to fall within
-		/// the extended img bounds and relies on the range not to generate
-		/// invalid vectors.
-		_pRefLumOver->SetOrigin(tlx, tly);
-		_pExtTmpLumOver->SetOrigin(tlx+motion_x, tly+ motion_y);
+		MCH264IS_BAND band = { _pRefLumOver, _pRefChrUOver, _pRefChrVOver, _pExtTmpLumOver, 
+													 _pExtTmpChrUOver, _pExtTmpChrVOver, _pMBlk, _pMBlkOver,
+													 _pEdgeLum, _pEdgeLumOver, _pEdgeChr, _pEdgeChrOver,
+													 _pRefLumOver8, _pExtTmpLumOver8, _pMBlk8, _pMBlkOver8, _pEdgeLum8, _pEdgeLumOver8 };
+		CompensateBlock(&band, tlx, tly, mvx, mvy);
+
+    /// Reset the invalidation.
+    _invalid = 0;
+  }//end if mvx...
+
+}//end Compensate.
+
+/** Set the num of threads for frame compensation.
+Compensate(pMotionList) splits the frame into this num of macroblock
+row bands that are compensated concurrently.
+@param threads	: Num of threads [1..MCH264IS_MAX_THREADS]. 1 = sequential.
+@return					: 1 = success, 0 = failure.
+*/
+int MotionCompensatorH264ImplStd::SetThreads(int threads)
+{
+	if( (threads < 1)||(threads > MCH264IS_MAX_THREADS) )
+		return(0);
+
+	/// The band overlays are sized by the previous num of threads.
+	DestroyBands();
+	_threads = threads;
+	/// Replace the band overlays if already created.
+	if(_pRefChrU != NULL)
+		return(CreateBands());
+	return(1);
+}//end SetThreads.
+
+/** Set edge emulation for the temp ref.
+With edge emulation the temp ref is not extended by a replicated boundary
+and border crossing blocks are fetched with edge clamping. The mem is 
+re-created if already created.
+@param on	: 1 = edge emulation, 0 = extended boundary temp ref.
+@return		: 1 = success, 0 = failure.
+*/
+int MotionCompensatorH264ImplStd::SetEdgeEmulation(int on)
+{
+	on = (on != 0);
+	if(on == _edgeEmulation)
+		return(1);
+	_edgeEmulation = on;
+
+	/// Re-create the temp ref with the same parameters if already created.
+	if(_pRefChrU != NULL)
+	{
+		void* ref				= _pel8 ? (void *)_pRefLum8 : (void *)_pRefLum;
+		int imgWidth		= _imgWidth;
+		int imgHeight		= _imgHeight;
+		int mbWidth			= _macroBlkWidth;
+		int mbHeight		= _macroBlkHeight;
+		return(Create(ref, imgWidth, imgHeight, mbWidth, mbHeight));
+	}//end if _pRefChrU...
+	return(1);
+}//end SetEdgeEmulation.
+
+/** Select an 8-bit lum ref.
+The ref given to Create() then holds an unsigned char lum plane followed 
+by the short chr planes. The ref layout depends on it so it cannot be 
+changed after Create().
+@param on	: 1 = 8-bit lum ref, 0 = 16-bit lum ref.
+@return		: 1 = success, 0 = failure.
+*/
+int MotionCompensatorH264ImplStd::SetPel8(int on)
+{
+	on = (on != 0);
+	if(on == _pel8)
+		return(1);
+	if(_pRefChrU != NULL)
+		return(0);
+	_pel8 = on;
+	return(1);
+}//end SetPel8.
+
+/*
+--------------------------------------------------------------------------
+  Private methods. 
+--------------------------------------------------------------------------
+*/
+
+/** Compensate a single block with a band's overlays.
+The vector is compensated even if it is zero.
+@param pBand	: Overlays to use.
+@param tlx		: Top left x coord of block.
+@param tly		: Top left y coord of block.
+@param mvx		: X coord of the motion vector in 1/4 pel units.
+@param mvy		: Y coord of the motion vector in 1/4 pel units.
+@return				: None.
+*/
+void MotionCompensatorH264ImplStd::CompensateBlock(MCH264IS_BAND* pBand, int tlx, int tly, int mvx, int mvy)
+{
+  /// Lum first.
+  pBand->pMBlkOver->SetOverlayDim(16,16);
+
+  int motion_x			= mvx / 4;	///< Convert quarter pel units to full and quarter offsets.
+  int motion_y			= mvy / 4;
+  int quarter_motion_x	= mvx % 4;
+  int quarter_motion_y	= mvy % 4;
+
+	/// Position the overlays. The vector is always assumed to fall within
+	/// the extended img bounds and relies on the range not to generate
+	/// invalid vectors. With edge emulation a block that, with its filter 
+	/// margin, crosses the img edge is first fetched into the edge work block.
+	if(_pel8)
+	{
+		pBand->pRefLumOver8->SetOrigin(tlx, tly);
+		OverlayMem2Dv2u8* pSrcOver8 = pBand->pExtTmpLumOver8;
+		if(_edgeEmulation && CrossesEdge(tlx+motion_x, tly+motion_y, _macroBlkWidth, _macroBlkHeight, 
+																		 _imgWidth, _imgHeight, MCH264IS_EDGE_LUM_MARGIN))
+		{
+			pSrcOver8 = pBand->pEdgeLumOver8;
+			EdgeFetch(pBand->pExtTmpLumOver8, pSrcOver8, tlx+motion_x, tly+motion_y, 
+								_macroBlkWidth, _macroBlkHeight, MCH264IS_EDGE_LUM_MARGIN);
+		}//end if _edgeEmulation...
+		else
+			pSrcOver8->SetOrigin(tlx+motion_x, tly+ motion_y);
+		if( !quarter_motion_x && !quarter_motion_y )
+			pBand->pRefLumOver8->Write(*pSrcOver8);
+		else
+		{
+			pSrcOver8->QuarterRead(*(pBand->pMBlkOver8), quarter_motion_x, quarter_motion_y);
+			pBand->pRefLumOver8->Write(*(pBand->pMBlkOver8));
+		}//end else...
+	}//end if _pel8...
+	else
+	{
+		pBand->pRefLumOver->SetOrigin(tlx, tly);
+		OverlayMem2Dv2* pSrcOver = pBand->pExtTmpLumOver;
+		if(_edgeEmulation && CrossesEdge(tlx+motion_x, tly+motion_y, _macroBlkWidth, _macroBlkHeight, 
+																		 _imgWidth, _imgHeight, MCH264IS_EDGE_LUM_MARGIN))
+		{
+			pSrcOver = pBand->pEdgeLumOver;
+			EdgeFetch(pBand->pExtTmpLumOver, pSrcOver, tlx+motion_x, tly+motion_y, 
+								_macroBlkWidth, _macroBlkHeight, MCH264IS_EDGE_LUM_MARGIN);
+		}//end if _edgeEmulation...
+		else
+			pBand->pExtTmpLumOver->SetOrigin(tlx+motion_x, tly+ motion_y);
 		if( !quarter_motion_x && !quarter_motion_y )	///< No quarter pel implies straight copy.
-			_pRefLumOver->Write(*_pExtTmpLumOver);
+			pBand->pRefLumOver->Write(*pSrcOver);
 		else
 		{
 			/// Read the compensated block into a work area.
-			_pExtTmpLumOver->QuarterRead(*_pMBlkOver, quarter_motion_x, quarter_motion_y);
+			pSrcOver->QuarterRead(*(pBand->pMBlkOver), quarter_motion_x, quarter_motion_y);
 			/// Write it to the ref.
-			_pRefLumOver->Write(*_pMBlkOver);
+			pBand->pRefLumOver->Write(*(pBand->pMBlkOver));
+		}//end else...
+	}//end else...
+
+  /// Chr second.
+  pBand->pMBlkOver->SetOverlayDim(8,8);
+
+  int offvecx	= tlx/2;
+  int offvecy	= tly/2;
+	int eighth_motion_x = mvx % 8;
+	int eighth_motion_y = mvy % 8;
+  motion_x = mvx / 8;
+  motion_y = mvy / 8;
+
+	/// Position the overlays. The vector is always assumed to fall within
+	/// the extended img bounds and relies on the range not to generate
+	/// invalid vectors.
+	pBand->pRefChrUOver->SetOrigin(offvecx, offvecy);
+	pBand->pRefChrVOver->SetOrigin(offvecx, offvecy);
+	if(_edgeEmulation && CrossesEdge(offvecx+motion_x, offvecy+motion_y, _chrMacroBlkWidth, _chrMacroBlkHeight,
+																	 _chrWidth, _chrHeight, MCH264IS_EDGE_CHR_MARGIN))
+	{
+		/// One edge work block is shared by both chr components in turn.
+		OverlayMem2Dv2* pSrcOver = pBand->pEdgeChrOver;
+		EdgeFetch(pBand->pExtTmpChrUOver, pSrcOver, offvecx+motion_x, offvecy+motion_y, 
+							_chrMacroBlkWidth, _chrMacroBlkHeight, MCH264IS_EDGE_CHR_MARGIN);
+		if( !eighth_motion_x && !eighth_motion_y )
+			pBand->pRefChrUOver->Write(*pSrcOver);
+		else
+		{
+			pSrcOver->EighthRead(*(pBand->pMBlkOver), eighth_motion_x, eighth_motion_y);
+			pBand->pRefChrUOver->Write(*(pBand->pMBlkOver));
+		}//end else...
+		EdgeFetch(pBand->pExtTmpChrVOver, pSrcOver, offvecx+motion_x, offvecy+motion_y, 
+							_chrMacroBlkWidth, _chrMacroBlkHeight, MCH264IS_EDGE_CHR_MARGIN);
+		if( !eighth_motion_x && !eighth_motion_y )
+			pBand->pRefChrVOver->Write(*pSrcOver);
+		else
+		{
+			pSrcOver->EighthRead(*(pBand->pMBlkOver), eighth_motion_x, eighth_motion_y);
+			pBand->pRefChrVOver->Write(*(pBand->pMBlkOver));
 		}//end else...
+		return;
+	}//end if _edgeEmulation...
+
+	pBand->pExtTmpChrUOver->SetOrigin(offvecx+motion_x, offvecy+ motion_y);
+	pBand->pExtTmpChrVOver->SetOrigin(offvecx+motion_x, offvecy+ motion_y);
+	if( !eighth_motion_x && !eighth_motion_y )	/// No eighth pel implies straight copy.
+	{
+		pBand->pRefChrUOver->Write(*(pBand->pExtTmpChrUOver));
+		pBand->pRefChrVOver->Write(*(pBand->pExtTmpChrVOver));
+	}//end if !eighth_motion_x...
+	else
+	{
+		/// Read the compensated block into a work area and write it to the ref.
+		pBand->pExtTmpChrUOver->EighthRead(*(pBand->pMBlkOver), eighth_motion_x, eighth_motion_y);
+		pBand->pRefChrUOver->Write(*(pBand->pMBlkOver));
+		pBand->pExtTmpChrVOver->EighthRead(*(pBand->pMBlkOver), eighth_motion_x, eighth_motion_y);
+		pBand->pRefChrVOver->Write(*(pBand->pMBlkOver));
+	}//end else...
+
+}//end CompensateBlock.
+
+/** Test if a block and its filter margin cross the img edge.
+@param x				: Top left x coord of block in the img.
+@param y				: Top left y coord of block in the img.
+@param width		: Block width.
+@param height		: Block height.
+@param imgWidth	: Img width.
+@param imgHeight: Img height.
+@param margin		: Filter margin around the block.
+@return					: 1 = crosses the edge, 0 = inside.
+*/
+int MotionCompensatorH264ImplStd::CrossesEdge(int x, int y, int width, int height, int imgWidth, int imgHeight, int margin)
+{
+	if( ((x - margin) < 0)||((x + width + margin) > imgWidth)||((y - margin) < 0)||((y + height + margin) > imgHeight) )
+		return(1);
+	return(0);
+}//end CrossesEdge.
+
+/** Fetch a block and its filter margin into an edge work block.
+The img edge pels are replicated for positions outside of the img. The edge
+work block overlay is left at the block size with its origin on the block.
+@param pImgOver		: Overlay on the whole img mem.
+@param pEdgeOver	: Edge work block overlay.
+@param x					: Top left x coord of block in the img.
+@param y					: Top left y coord of block in the img.
+@param width			: Block width.
+@param height			: Block height.
+@param margin			: Filter margin around the block.
+@return						: None.
+*/
+void MotionCompensatorH264ImplStd::EdgeFetch(OverlayMem2Dv2* pImgOver, OverlayMem2Dv2* pEdgeOver, int x, int y, int width, int height, int margin)
+{
+	pEdgeOver->SetOverlayDim(width + 2*margin, height + 2*margin);
+	pEdgeOver->SetOrigin(0, 0);
+	pImgOver->EdgeRead(*pEdgeOver, x - margin, y - margin);
+	pEdgeOver->SetOverlayDim(width, height);
+	pEdgeOver->SetOrigin(margin, margin);
+}//end EdgeFetch.
+
+/// ...for the 8-bit lum temp ref.
+void MotionCompensatorH264ImplStd::EdgeFetch(OverlayMem2Dv2u8* pImgOver, OverlayMem2Dv2u8* pEdgeOver, int x, int y, int width, int height, int margin)
+{
+	pEdgeOver->SetOverlayDim(width + 2*margin, height + 2*margin);
+	pEdgeOver->SetOrigin(0, 0);
+	pImgOver->EdgeRead(*pEdgeOver, x - margin, y - margin);
+	pEdgeOver->SetOverlayDim(width, height);
+	pEdgeOver->SetOrigin(margin, margin);
+}//end EdgeFetch.
+
+/** Compensate a band of macroblock rows from a vector list.
+Zero vectors are skipped as the ref and the tmp are equal after a call to
+PrepareForSingleVectorMode().
+@param pBand			: Overlays for the exclusive use of this band.
+@param pL					: SIMPLE2D vector list for the frame.
+@param firstMbRow	: First macroblock row of the band.
+@param endMbRow		: One past the last macroblock row of the band.
+@param invalid		: Compensate the first macroblock of the band even if its vector is zero.
+@return						: None.
+*/
+void MotionCompensatorH264ImplStd::CompensateBand(MCH264IS_BAND* pBand, VectorStructList* pL, int firstMbRow, int endMbRow, int invalid)
+{
+	int mbCols = _imgWidth/_macroBlkWidth;
+	int vecPos = firstMbRow * mbCols;
+  for(int m = firstMbRow * _macroBlkHeight; m < (endMbRow * _macroBlkHeight); m += _macroBlkHeight)
+	  for(int n = 0; n < _imgWidth; n += _macroBlkWidth, vecPos++)
+  {
+		int mvx = pL->GetSimpleElement(vecPos, 0);
+		int mvy = pL->GetSimpleElement(vecPos, 1);
+		if( mvx || mvy || invalid )
+		{
+			CompensateBlock(pBand, n, m, mvx, mvy);
+			invalid = 0;
+		}//end if mvx...
+  }//end for m & n...
 
-    /// Chr second.
-    _pMBlkOver->SetOverlayDim(8,8);
+}//end CompensateBand.
 
-    int offvecx	= tlx/2;
-    int offvecy	= tly/2;
-		int eighth_motion_x = mvx % 8;
-		int eighth_motion_y = mvy % 8;
-    motion_x = mvx / 8;
-    motion_y = mvy / 8;
-
- 		/// Position the overlays. The vector is always assumed to fall within
-		/// the extended img bounds and relies on the range not to generate
-		/// invalid vectors.
-		_pRefChrUOver->SetOrigin(offvecx, offvecy);
-		_pRefChrVOver->SetOrigin(offvecx, offvecy);
-		_pExtTmpChrUOver->SetOrigin(offvecx+motion_x, offvecy+ motion_y);
-		_pExtTmpChrVOver->SetOrigin(offvecx+motion_x, offvecy+ motion_y);
-		if( !eighth_motion_x && !eighth_motion_y )	/// No eighth pel implies straight copy.
+/** Create the overlays for each row band.
+The overlays are placed on the mem of the ref and the extended temp ref so 
+that only the work block mem is private to a band.
+@return	: 1 = success, 0 = failure.
+*/
+int MotionCompensatorH264ImplStd::CreateBands(void)
+{
+	DestroyBands();
+	if(_threads < 2)
+		return(1);
+
+	int lumBoundary = _lumBoundary;
+	int chrBoundary	= _chrBoundary;
+	_pBand = new MCH264IS_BAND[_threads];
+	if(_pBand == NULL)
+		return(0);
+	memset((void *)_pBand, 0, _threads * sizeof(MCH264IS_BAND));
+
+	for(int t = 0; t < _threads; t++)
+	{
+		MCH264IS_BAND* pB = &(_pBand[t]);
+		pB->pRefChrUOver		= new OverlayMem2Dv2((void *)_pRefChrU, _chrWidth, _chrHeight, _chrMacroBlkWidth, _chrMacroBlkHeight);
+		pB->pRefChrVOver		= new OverlayMem2Dv2((void *)_pRefChrV, _chrWidth, _chrHeight, _chrMacroBlkWidth, _chrMacroBlkHeight);
+		if(_pel8)
 		{
-			_pRefChrUOver->Write(*_pExtTmpChrUOver);
-			_pRefChrVOver->Write(*_pExtTmpChrVOver);
-		}//end if !eighth_motion_x...
+			/// Each band has its own 8-bit overlays as they hold interpolation work blocks.
+			pB->pRefLumOver8		= new OverlayMem2Dv2u8((void *)_pRefLum8, _imgWidth, _imgHeight, _macroBlkWidth, _macroBlkHeight);
+			pB->pExtTmpLumOver8	= new OverlayMem2Dv2u8(_pExtTmpLum8, _extLumWidth, _extLumHeight, _macroBlkWidth, _macroBlkHeight, lumBoundary, lumBoundary, _extLumStride8);
+			pB->pMBlk8					= new unsigned char[_macroBlkWidth * _macroBlkHeight];
+			if(pB->pMBlk8 != NULL)
+				pB->pMBlkOver8		= new OverlayMem2Dv2u8(pB->pMBlk8, _macroBlkWidth, _macroBlkHeight, _macroBlkWidth, _macroBlkHeight);
+		}//end if _pel8...
 		else
 		{
-			/// Read the compensated block into a work area and write it to the ref.
-			_pExtTmpChrUOver->EighthRead(*_pMBlkOver, eighth_motion_x, eighth_motion_y);
-			_pRefChrUOver->Write(*_pMBlkOver);
-			_pExtTmpChrVOver->EighthRead(*_pMBlkOver, eighth_motion_x, eighth_motion_y);
-			_pRefChrVOver->Write(*_pMBlkOver);
+			pB->pRefLumOver			= new OverlayMem2Dv2((void *)_pRefLum, _imgWidth, _imgHeight, _macroBlkWidth, _macroBlkHeight);
+			pB->pExtTmpLumOver	= new OverlayExtMem2Dv2(_pExtTmpLum, _extLumWidth, _extLumHeight, _macroBlkWidth, _macroBlkHeight, lumBoundary, lumBoundary);
 		}//end else...
+		pB->pExtTmpChrUOver	= new OverlayExtMem2Dv2(_pExtTmpChrU, _extChrWidth, _extChrHeight, _chrMacroBlkWidth, _chrMacroBlkHeight, chrBoundary, chrBoundary);
+		pB->pExtTmpChrVOver	= new OverlayExtMem2Dv2(_pExtTmpChrV, _extChrWidth, _extChrHeight, _chrMacroBlkWidth, _chrMacroBlkHeight, chrBoundary, chrBoundary);
+		pB->pMBlk						= new short[_macroBlkWidth * _macroBlkHeight];
+		if(pB->pMBlk != NULL)
+			pB->pMBlkOver			= new OverlayMem2Dv2(pB->pMBlk, _macroBlkWidth, _macroBlkHeight, _macroBlkWidth, _macroBlkHeight);
+		int edgeFail = 0;
+		if(_edgeEmulation)
+		{
+			int lumEdgeWidth	= _macroBlkWidth + 2*MCH264IS_EDGE_LUM_MARGIN;
+			int lumEdgeHeight	= _macroBlkHeight + 2*MCH264IS_EDGE_LUM_MARGIN;
+			int chrEdgeWidth	= _chrMacroBlkWidth + 2*MCH264IS_EDGE_CHR_MARGIN;
+			int chrEdgeHeight	= _chrMacroBlkHeight + 2*MCH264IS_EDGE_CHR_MARGIN;
+			pB->pEdgeLum			= new short[lumEdgeWidth * lumEdgeHeight];
+			if(pB->pEdgeLum != NULL)
+				pB->pEdgeLumOver	= new OverlayMem2Dv2(pB->pEdgeLum, lumEdgeWidth, lumEdgeHeight, lumEdgeWidth, lumEdgeHeight);
+			pB->pEdgeChr			= new short[chrEdgeWidth * chrEdgeHeight];
+			if(pB->pEdgeChr != NULL)
+				pB->pEdgeChrOver	= new OverlayMem2Dv2(pB->pEdgeChr, chrEdgeWidth, chrEdgeHeight, chrEdgeWidth, chrEdgeHeight);
+			edgeFail = (pB->pEdgeLumOver == NULL)||(pB->pEdgeChrOver == NULL);
+			if(_pel8)
+			{
+				pB->pEdgeLum8				= new unsigned char[lumEdgeWidth * lumEdgeHeight];
+				if(pB->pEdgeLum8 != NULL)
+					pB->pEdgeLumOver8	= new OverlayMem2Dv2u8(pB->pEdgeLum8, lumEdgeWidth, lumEdgeHeight, lumEdgeWidth, lumEdgeHeight);
+				edgeFail |= (pB->pEdgeLumOver8 == NULL);
+			}//end if _pel8...
+		}//end if _edgeEmulation...
+		int lumFail = _pel8 ? ((pB->pRefLumOver8 == NULL)||(pB->pExtTmpLumOver8 == NULL)||(pB->pMBlkOver8 == NULL)) : 
+													((pB->pRefLumOver == NULL)||(pB->pExtTmpLumOver == NULL));
+
+		if( (pB->pRefChrUOver == NULL)||(pB->pRefChrVOver == NULL)||lumFail||
+				(pB->pExtTmpChrUOver == NULL)||(pB->pExtTmpChrVOver == NULL)||(pB->pMBlkOver == NULL)||edgeFail )
+		{
+			DestroyBands();
+			return(0);
+		}//end if !pRefLumOver...
+	}//end for t...
 
-    /// Reset the invalidation.
-    _invalid = 0;
-  }//end if mvx...
+	return(1);
+}//end CreateBands.
+
+void MotionCompensatorH264ImplStd::DestroyBands(void)
+{
+	if(_pBand == NULL)
+		return;
+
+	for(int t = 0; t < _threads; t++)
+	{
+		MCH264IS_BAND* pB = &(_pBand[t]);
+		if(pB->pRefLumOver != NULL)			delete pB->pRefLumOver;
+		if(pB->pRefChrUOver != NULL)		delete pB->pRefChrUOver;
+		if(pB->pRefChrVOver != NULL)		delete pB->pRefChrVOver;
+		if(pB->pExtTmpLumOver != NULL)	delete pB->pExtTmpLumOver;
+		if(pB->pExtTmpChrUOver != NULL)	delete pB->pExtTmpChrUOver;
+		if(pB->pExtTmpChrVOver != NULL)	delete pB->pExtTmpChrVOver;
+		if(pB->pMBlkOver != NULL)				delete pB->pMBlkOver;
+		if(pB->pMBlk != NULL)						delete[] pB->pMBlk;
+		if(pB->pEdgeLumOver != NULL)		delete pB->pEdgeLumOver;
+		if(pB->pEdgeLum != NULL)				delete[] pB->pEdgeLum;
+		if(pB->pEdgeChrOver != NULL)		delete pB->pEdgeChrOver;
+		if(pB->pEdgeChr != NULL)				delete[] pB->pEdgeChr;
+		if(pB->pRefLumOver8 != NULL)		delete pB->pRefLumOver8;
+		if(pB->pExtTmpLumOver8 != NULL)	delete pB->pExtTmpLumOver8;
+		if(pB->pMBlkOver8 != NULL)			delete pB->pMBlkOver8;
+		if(pB->pMBlk8 != NULL)					delete[] pB->pMBlk8;
+		if(pB->pEdgeLumOver8 != NULL)		delete pB->pEdgeLumOver8;
+		if(pB->pEdgeLum8 != NULL)				delete[] pB->pEdgeLum8;
+	}//end for t...
+
+	delete[] _pBand;
+	_pBand = NULL;
+}//end DestroyBands.
 
-}//end Compensate.
 
 /*
 --------------------------------------------------------------------------------------
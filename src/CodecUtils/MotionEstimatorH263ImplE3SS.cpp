@@ -258,7 +258,7 @@ int MotionEstimatorH263ImplE3SS::Create(void)
 	_extBoundary = _macroBlkWidth + 1;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + 1;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																			_imgWidth,						
 																			_imgHeight, 
 																			_extBoundary,	///< Extend left and right by...
@@ -705,7 +705,7 @@ void MotionEstimatorH263ImplE3SS::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
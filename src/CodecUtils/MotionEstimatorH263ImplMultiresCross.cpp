@@ -327,7 +327,7 @@ int MotionEstimatorH263ImplMultiresCross::Create(void)
 	_extBoundary = _macroBlkWidth + MEH263IMC_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH263IMC_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																			_imgWidth,						
 																			_imgHeight, 
 																			_extBoundary,	// Extend left and right by...
@@ -378,7 +378,7 @@ int MotionEstimatorH263ImplMultiresCross::Create(void)
 	_extL1Boundary = _l1MacroBlkWidth + MEH263IMC_L1_PADDING;
 	if(_l1MacroBlkHeight > _l1MacroBlkWidth)
 		_extL1Boundary = _l1MacroBlkHeight + MEH263IMC_L1_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL1, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL1, 
 																			_l1Width,						
 																			_l1Height, 
 																			_extL1Boundary,
@@ -428,7 +428,7 @@ int MotionEstimatorH263ImplMultiresCross::Create(void)
 	_extL2Boundary = _l2MacroBlkWidth + MEH263IMC_L2_PADDING;
 	if(_l2MacroBlkHeight > _l2MacroBlkWidth)
 		_extL2Boundary = _l2MacroBlkHeight + MEH263IMC_L2_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL2, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL2, 
 																			_l2Width,						
 																			_l2Height, 
 																			_extL2Boundary,
@@ -1057,7 +1057,7 @@ void MotionEstimatorH263ImplMultiresCross::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
@@ -1073,7 +1073,7 @@ void MotionEstimatorH263ImplMultiresCross::Destroy(void)
 	_pRefL1Over	= NULL;
 
 	if(_pExtRefL1 != NULL)
-		delete[] _pExtRefL1;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL1);
 	_pExtRefL1 = NULL;
 
 	if(_pExtRefL1Over != NULL)
@@ -1089,7 +1089,7 @@ void MotionEstimatorH263ImplMultiresCross::Destroy(void)
 	_pRefL2Over	= NULL;
 
 	if(_pExtRefL2 != NULL)
-		delete[] _pExtRefL2;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL2);
 	_pExtRefL2 = NULL;
 
 	if(_pExtRefL2Over != NULL)
@@ -333,7 +333,7 @@ int MotionEstimatorH263ImplMultiresCrossVer2::Create(void)
 	_extBoundary = _macroBlkWidth + MEH263IMCV2_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH263IMCV2_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																			_imgWidth,						
 																			_imgHeight, 
 																			_extBoundary,	// Extend left and right by...
@@ -384,7 +384,7 @@ int MotionEstimatorH263ImplMultiresCrossVer2::Create(void)
 	_extL1Boundary = _l1MacroBlkWidth + MEH263IMCV2_L1_PADDING;
 	if(_l1MacroBlkHeight > _l1MacroBlkWidth)
 		_extL1Boundary = _l1MacroBlkHeight + MEH263IMCV2_L1_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL1, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL1, 
 																			_l1Width,						
 																			_l1Height, 
 																			_extL1Boundary,
@@ -434,7 +434,7 @@ int MotionEstimatorH263ImplMultiresCrossVer2::Create(void)
 	_extL2Boundary = _l2MacroBlkWidth + MEH263IMCV2_L2_PADDING;
 	if(_l2MacroBlkHeight > _l2MacroBlkWidth)
 		_extL2Boundary = _l2MacroBlkHeight + MEH263IMCV2_L2_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL2, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL2, 
 																			_l2Width,						
 																			_l2Height, 
 																			_extL2Boundary,
@@ -1189,7 +1189,7 @@ void MotionEstimatorH263ImplMultiresCrossVer2::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
@@ -1205,7 +1205,7 @@ void MotionEstimatorH263ImplMultiresCrossVer2::Destroy(void)
 	_pRefL1Over	= NULL;
 
 	if(_pExtRefL1 != NULL)
-		delete[] _pExtRefL1;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL1);
 	_pExtRefL1 = NULL;
 
 	if(_pExtRefL1Over != NULL)
@@ -1221,7 +1221,7 @@ void MotionEstimatorH263ImplMultiresCrossVer2::Destroy(void)
 	_pRefL2Over	= NULL;
 
 	if(_pExtRefL2 != NULL)
-		delete[] _pExtRefL2;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL2);
 	_pExtRefL2 = NULL;
 
 	if(_pExtRefL2Over != NULL)
@@ -324,7 +324,7 @@ int MotionEstimatorH263ImplUnres::Create(void)
 	_extBoundary = _macroBlkWidth + 1;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + 1;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																			_imgWidth,						
 																			_imgHeight, 
 																			_extBoundary,	// Extend left and right by...
@@ -375,7 +375,7 @@ int MotionEstimatorH263ImplUnres::Create(void)
 	_extL1Boundary = _l1MacroBlkWidth + 1;
 	if(_l1MacroBlkHeight > _l1MacroBlkWidth)
 		_extL1Boundary = _l1MacroBlkHeight + 1;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL1, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL1, 
 																			_l1Width,						
 																			_l1Height, 
 																			_extL1Boundary,
@@ -425,7 +425,7 @@ int MotionEstimatorH263ImplUnres::Create(void)
 	_extL2Boundary = _l2MacroBlkWidth + 1;
 	if(_l2MacroBlkHeight > _l2MacroBlkWidth)
 		_extL2Boundary = _l2MacroBlkHeight + 1;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL2, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL2, 
 																			_l2Width,						
 																			_l2Height, 
 																			_extL2Boundary,
@@ -944,7 +944,7 @@ void MotionEstimatorH263ImplUnres::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
@@ -960,7 +960,7 @@ void MotionEstimatorH263ImplUnres::Destroy(void)
 	_pRefL1Over	= NULL;
 
 	if(_pExtRefL1 != NULL)
-		delete[] _pExtRefL1;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL1);
 	_pExtRefL1 = NULL;
 
 	if(_pExtRefL1Over != NULL)
@@ -976,7 +976,7 @@ void MotionEstimatorH263ImplUnres::Destroy(void)
 	_pRefL2Over	= NULL;
 
 	if(_pExtRefL2 != NULL)
-		delete[] _pExtRefL2;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL2);
 	_pExtRefL2 = NULL;
 
 	if(_pExtRefL2Over != NULL)
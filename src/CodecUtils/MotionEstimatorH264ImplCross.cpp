@@ -269,7 +269,7 @@ int MotionEstimatorH264ImplCross::Create(void)
 	_extBoundary = _macroBlkWidth + MEH264IC_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH264IC_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																				_imgWidth,						
 																				_imgHeight, 
 																				_extBoundary,	///< Extend left and right by...
@@ -680,7 +680,7 @@ void MotionEstimatorH264ImplCross::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
@@ -80,6 +80,12 @@ using namespace std;
 /// A threshold distortion value below which is considered a very good match.
 #define MEH264IFHS_THRESHOLD_MIN                    1000
 
+/// Upper bound on the adaptive early termination threshold for the seed candidates.
+#define MEH264IFHS_SEED_THRESHOLD_MAX               4000
+
+/// Fixed early termination threshold for a wide search when not learned.
+#define MEH264IFHS_THRESHOLD_HIGH                   4000
+
 /// Search range coord offsets for 5x5 pattern search ordered from inner to outer.
 #define MEH264IFHS_MOTION_5X5_POS_LENGTH 	24
 MEH264IFHS_COORD MEH264IFHS_5x5Pos[MEH264IFHS_MOTION_5X5_POS_LENGTH] =
@@ -293,6 +299,7 @@ MotionEstimatorH264ImplFHS::MotionEstimatorH264ImplFHS( const void*
   _pMVPred = pMVPred;
   _pDistortionIncluded = (bool *)pDistortionIncluded;
   _pPrevFrmMBlk = pPrevFrmMBlk;
+  _seeding = (pPrevFrmMBlk != NULL);
 }//end constructor.
 
 void MotionEstimatorH264ImplFHS::ResetMembers(void)
@@ -318,6 +325,9 @@ void MotionEstimatorH264ImplFHS::ResetMembers(void)
 	_extHeight				= 0;
 	_extBoundary			= 0;
 	_pExtRefOver			= NULL;			///< Extended ref overlay with motion block dim.
+	/// Static macroblock pre-pass is off by default.
+	_staticMbSkip			= false;
+	_staticMbQP				= 26;
   /// A 1/4 pel refinement cache.
   _pQuartPelBase    = NULL;
   _ppQuartPelBase   = NULL;
@@ -341,6 +351,12 @@ void MotionEstimatorH264ImplFHS::ResetMembers(void)
   /// Number of locations to test for partial sums along a path.
   _pathLength = 256;
 
+  /// Seeding is only possible with a previous frame motion field.
+  _seeding = false;
+
+  /// Fixed early termination thresholds by default.
+  _adaptive = false;
+
 }//end ResetMembers.
 
 MotionEstimatorH264ImplFHS::~MotionEstimatorH264ImplFHS(void)
@@ -385,7 +401,7 @@ int MotionEstimatorH264ImplFHS::Create(void)
 	_extBoundary = _macroBlkWidth + MEH264IFHS_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH264IFHS_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																				_imgWidth,						
 																				_imgHeight, 
 																				_extBoundary,	///< Extend left and right by...
@@ -413,6 +429,13 @@ int MotionEstimatorH264ImplFHS::Create(void)
 	  return(0);
   }//end if !_pExtRefOver...
 
+	/// Static macroblock classification for the pre-pass.
+	if(!_staticMb.Create(_imgWidth, _imgHeight))
+  {
+		Destroy();
+	  return(0);
+  }//end if !Create...
+
 	/// --------------- Configure temp overlays --------------------------------
 	/// Alloc some temp mem and overlay it to use for half/quarter pel motion 
   /// estimation and compensation. The block size is the same as the mem size.
@@ -462,6 +485,25 @@ int MotionEstimatorH264ImplFHS::Create(void)
   for (int i = 0; i < 3; i++)
     _quartPelCache[i] = &(_ppQuartPelBase[i * 18]); ///< 3 cache addresses for each 18th row.
 
+	/// --------------- Seed candidates ---------------------------------------
+	/// The motion field history is one entry per macroblock and is only required
+	/// when the previous frame macroblocks are available.
+	if(_pPrevFrmMBlk != NULL)
+	{
+		if(!_seeder.Create(_imgWidth/_macroBlkWidth, _imgHeight/_macroBlkHeight))
+		{
+			Destroy();
+			return(0);
+		}//end if !Create...
+	}//end if _pPrevFrmMBlk...
+
+	/// --------------- Search statistics -------------------------------------
+	if(!_searchStats.Create(_imgWidth/_macroBlkWidth, _imgHeight/_macroBlkHeight))
+	{
+		Destroy();
+		return(0);
+	}//end if !Create...
+
   /// --------------- Measurements -------------------------------------------
 #ifdef MEH264IFHS_TAKE_MEASUREMENTS
   _mtLen = 15000;
@@ -512,14 +554,45 @@ void* MotionEstimatorH264ImplFHS::Estimate(long* avgDistortion)
 	_pExtRefOver->FillBoundaryProxy();
 	_pExtRefOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
 
+  /// Classify the static macroblocks that bypass the search.
+  if (_staticMbSkip)
+    _staticMb.Classify((const short *)_pInput, (const short *)_pRef, _staticMbQP);
+
   /// _motionRange is in 1/4 pel units and must be converted to full pel units.
   int mRng = _motionRange / 4;  
 
+  /// Roll the temporal motion field history for the seed candidates.
+  if (_seeding)
+    _seeder.Update(_pPrevFrmMBlk);
+
+  /// The learned thresholds are bounded by the frame QP.
+  if (_adaptive)
+    _searchStats.SetQP(_staticMbQP);
+
   /// Gather the motion vector absolute differnce/square error data and choose the vector.
 	/// m,n step level 0 vec dim = _macroBlkHeight, _macroBlkWidth.
   for(m = 0; m < _imgHeight; m += _macroBlkHeight)
     for (n = 0; n < _imgWidth; n += _macroBlkWidth)
     {
+      /// Static macroblocks from the pre-pass take the zero vector without a search.
+      if (_staticMbSkip && _staticMb.IsStatic(vecPos))
+      {
+        int zeroVecDiff = _staticMb.GetZeroVecDistortion(vecPos);
+        if ((_pDistortionIncluded != NULL) && _pDistortionIncluded[vecPos])
+        {
+          included++;
+          totalDifference += zeroVecDiff;
+        }//end if _pDistortionIncluded...
+        if (vecPos < maxLength)
+        {
+          _pMotionVectorStruct->SetSimpleElement(vecPos, 0, 0);
+          _pMotionVectorStruct->SetSimpleElement(vecPos, 1, 0);
+          _pMVPred->Set16x16MotionVector(vecPos, 0, 0, zeroVecDiff);
+          vecPos++;
+        }//end if vecPos...
+        continue;
+      }//end if _staticMbSkip...
+
       int mx  = 0;	int my  = 0;  ///< Full pel grid.
       int hmx = 0;	int hmy = 0;  ///< 1/2 pel on 1/4 pel grid.
       int qmx = 0;	int qmy = 0;  ///< 1/4 pel grid.
@@ -594,7 +667,17 @@ void* MotionEstimatorH264ImplFHS::Estimate(long* avgDistortion)
       int minCost = predVecDiff / 256;
 
       int  priorMinDiff = 0; 
-      if(predVecDiff < MEH264IFHS_THRESHOLD_MIN)  ///< Early exit test.
+
+      /// Early termination thresholds for a short and a wide search.
+      int thrLow  = MEH264IFHS_THRESHOLD_MIN;
+      int thrHigh = MEH264IFHS_THRESHOLD_HIGH;
+      if (_adaptive)
+      {
+        thrLow  = _searchStats.GetThreshold(vecPos, 0, thrLow);
+        thrHigh = _searchStats.GetThreshold(vecPos, 2, thrHigh);
+      }//end if _adaptive...
+
+      if(predVecDiff < thrLow)  ///< Early exit test.
       { mvx = reconstructPredX; mvy = reconstructPredY; goto MEH264IFHS_ALL_DONE; }
 
       /// --------------- Zero 1/4 pel mv ------------------------------------------------------
@@ -620,7 +703,7 @@ void* MotionEstimatorH264ImplFHS::Estimate(long* avgDistortion)
         {
           int zeroCost = MEH264IFHS_COST(zeroVecDiff, 0, 0, predX0, predY0);
           if (zeroCost < minCost) { minDiff = zeroVecDiff; minCost = zeroCost; mx = 0; my = 0; }
-          if (zeroVecDiff < MEH264IFHS_THRESHOLD_MIN) { mvx = 0; mvy = 0; goto MEH264IFHS_ALL_DONE; } ///< Early exit test.
+          if (zeroVecDiff < thrLow) { mvx = 0; mvy = 0; goto MEH264IFHS_ALL_DONE; } ///< Early exit test.
         }//end if zeroVecDiff...
       }//end if reconstructPredX...
 
@@ -673,13 +756,43 @@ void* MotionEstimatorH264ImplFHS::Estimate(long* avgDistortion)
 
       }//end if !_intraFlag...
 */
+      /// --------------- Spatial and temporal seed candidates --------------------------------
+      /// Test the neighbourhood mvs of the current and previous frames, including the accelerated 
+      /// co-located mv, and skip the pattern searches if the best seed is already below the 
+      /// adaptive threshold.
+      if (_seeding)
+      {
+        H264MVS_COORD seeds[H264MotionVectorSeeder::MaxCandidates];
+        int numSeeds = _seeder.GetCandidates(vecPos, _pMotionVectorStruct, predX0, predY0, seeds);
+        for (int s = 0; s < numSeeds; s++)
+        {
+          j = seeds[s].x;
+          i = seeds[s].y;
+          if ((i >= yuRng) && (i <= ydRng) && (j >= xlRng) && (j <= xrRng))
+          {
+            _pExtRefOver->SetOrigin(n + j, m + i);
+            int blkDiff = Td16x16OptimalPathLessThan(_pInOver->Get2DSrcPtr(), _pInOver->GetOriginX(), _pInOver->GetOriginY(),
+                                                     _pExtRefOver->Get2DSrcPtr(), _pExtRefOver->GetOriginX(), _pExtRefOver->GetOriginY(),
+                                                     minDiff);
+            if (blkDiff <= minDiff)  ///< Better partial candidate mv.
+            {
+              int seedCost = MEH264IFHS_COST(blkDiff, j, i, predX0, predY0);
+              if (seedCost < minCost) { minDiff = blkDiff; minCost = seedCost; mx = j; my = i; }
+            }//end if blkDiff...
+          }//end if i...
+        }//end for s...
+
+        if (minDiff < _seeder.GetThreshold(vecPos, predD, MEH264IFHS_THRESHOLD_MIN, MEH264IFHS_SEED_THRESHOLD_MAX))
+          goto MEH264IFHS_EXTENDED_DIAMOND_SEARCH;
+      }//end if _seeding...
+
     ///------------ 1st predicted mv Early Termination exit test to full pel local refinement searchs -----------
     /// Absolute thresholding used. In addition, if the predicted mv is the best initial mv and if its distortion
     /// is within 20% of the predicted distortion (i.e. the prediction is accurate) then assume the pred mv is
     /// the most likley mv and jump to the local refinement.
 
-    if(minDiff < MEH264IFHS_THRESHOLD_MIN)  goto MEH264IFHS_EXTENDED_DIAMOND_SEARCH;
-    else if ((minDiff < 4000) || ((minDiff == predVecDiff) && (minDiff < (predD * 12 / 10)) && (minDiff >(predD * 8 / 10))))
+    if(minDiff < thrLow)  goto MEH264IFHS_EXTENDED_DIAMOND_SEARCH;
+    else if ((minDiff < thrHigh) || ((minDiff == predVecDiff) && (minDiff < (predD * 12 / 10)) && (minDiff >(predD * 8 / 10))))
       goto MEH264IFHS_EXTENDED_HEX_SEARCH; /// Go to hexigon & diamond search
 
     ///--------------------------- Full pel uneven multi-hexagon grid search -------------------------------------
@@ -869,6 +982,10 @@ void* MotionEstimatorH264ImplFHS::Estimate(long* avgDistortion)
     /// This is a bail out point where no further searching is required but the distortion and mv coords must be set.
     MEH264IFHS_ALL_DONE:
 
+    /// Record the search result for the learned thresholds.
+    if (_adaptive)
+      _searchStats.Add(vecPos, minDiff, mvx, mvy);
+
     /// Check for inclusion in the distortion calculation.
     if (_pDistortionIncluded != NULL)
     {
@@ -891,6 +1008,10 @@ void* MotionEstimatorH264ImplFHS::Estimate(long* avgDistortion)
 
   }//end for m & n...
 
+  /// Fold the frame into the learned thresholds.
+  if (_adaptive)
+    _searchStats.Update();
+
 	/// In this context avg distortion is actually avg difference.
 //	*avgDistortion = totalDifference/maxLength;
 	if(included)	///< Prevent divide by zero error.
@@ -911,6 +1032,9 @@ void MotionEstimatorH264ImplFHS::Destroy(void)
 {
 	_ready = 0;
 
+	_seeder.Destroy();
+	_searchStats.Destroy();
+
 #ifdef MEH264IFHS_TAKE_MEASUREMENTS
   if(_mtPos > 0)
     _mt.Save("C:/Google Drive/PC/Excel/MotionEvaluation/experiment.csv", ",", 1);
@@ -935,13 +1059,15 @@ void MotionEstimatorH264ImplFHS::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
 		delete _pExtRefOver;
 	_pExtRefOver = NULL;
 
+	_staticMb.Destroy();
+
 	if(_pMBlk != NULL)
 		delete[] _pMBlk;
 	_pMBlk = NULL;
@@ -1684,6 +1810,9 @@ the speed of execution.
 */
 int MotionEstimatorH264ImplFHS::Td16x16OptimalPathLessThan(short** in, int inx, int iny, short** ref, int refx, int refy, int min)
 {
+#ifdef OM2DV2_COUNT_EVALUATIONS
+  OverlayMem2Dv2::CountEvaluation();
+#endif
   //------------------- Unrolled loop version -----------------------------------
   int Dp1 = 0; int Dp2 = 0;
   //int Dp    = 0;  ///< Accumulated partial partial distortion.
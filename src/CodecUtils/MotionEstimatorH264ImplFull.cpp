@@ -56,6 +56,7 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include <stdlib.h>
 
 #include	"MotionEstimatorH264ImplFull.h"
+#include	"PlanePool.h"
 
 /*
 --------------------------------------------------------------------------
@@ -175,6 +176,17 @@ void MotionEstimatorH264ImplFull::ResetMembers(void)
 	_extHeight				= 0;
 	_extBoundary			= 0;
 	_pExtRefOver			= NULL;			///< Extended ref overlay with motion block dim.
+	/// Static macroblock pre-pass is off by default.
+	_staticMbSkip			= false;
+	_staticMbQP				= 26;
+	/// Successive elimination is exact and therefore on by default.
+	_successiveElimination = true;
+	/// 16-bit src and ref planes by default.
+	_pel8							= false;
+	_pInOver8					= NULL;
+	_pRefOver8				= NULL;
+	_pExtRef8					= NULL;
+	_pExtRefOver8			= NULL;
   /// A 1/4 pel refinement window.
 	_pWin							= NULL;
 	_Win							= NULL;
@@ -182,6 +194,8 @@ void MotionEstimatorH264ImplFull::ResetMembers(void)
 	/// Temp working block and its overlay.
 	_pMBlk						= NULL;			///< Motion block temp mem.
 	_pMBlkOver				= NULL;			///< Motion block overlay of temp mem.
+	_pMBlk8						= NULL;
+	_pMBlkOver8				= NULL;
 
 	/// Hold the resulting motion vectors in a byte array.
 	_pMotionVectorStruct = NULL;
@@ -218,71 +232,112 @@ int MotionEstimatorH264ImplFull::Create(void)
 	/// Clean out old mem.
 	Destroy();
 
-	/// --------------- Configure input overlays --------------------------------
-	/// Put an overlay on the input image with the block size set to the mb vector 
-	/// dim. This is used to access input vectors.
-	_pInOver = new OverlayMem2Dv2((void *)_pInput,_imgWidth,_imgHeight,_macroBlkWidth,_macroBlkHeight);
-	if(_pInOver == NULL)
-	{
-		Destroy();
-		return(0);
-	}//end _pInOver...
-
-	/// --------------- Configure ref overlays --------------------------------
-	/// Overlay the whole reference. The reference will have an extended 
-	/// boundary for motion estimation and must therefore create its own mem.
-	_pRefOver = new OverlayMem2Dv2((void *)_pRef, _imgWidth, _imgHeight, _imgWidth, _imgHeight);
-	if(_pRefOver == NULL)
-  {
-		Destroy();
-	  return(0);
-  }//end if !_pRefOver...
-
-	/// Create the new extended boundary ref into _pExtRef. The boundary is extended by
-	/// the max dimension of the macroblock plus some padding to cater for quarter pel
-  /// searches on the edges of the boundary. The mem is allocated in the method call.
+	/// The extended ref boundary is the max dimension of the macroblock plus some padding
+  /// to cater for quarter pel searches on the edges of the boundary.
 	_extBoundary = _macroBlkWidth + MEH264IF_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH264IF_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
-																				_imgWidth,						
-																				_imgHeight, 
-																				_extBoundary,	///< Extend left and right by...
-																				_extBoundary,	///< Extend top and bottom by...
-																				(void **)(&_pExtRef)) )	///< Created in the method and returned.
-  {
-		Destroy();
-	  return(0);
-  }//end if !ExtendBoundary...
 	_extWidth	 = _imgWidth + (2 * _extBoundary);
 	_extHeight = _imgHeight + (2 * _extBoundary);
 
-	/// Place an overlay on the extended boundary ref with block size set to the mb motion 
-  /// vec dim.
-	_pExtRefOver = new OverlayExtMem2Dv2(	_pExtRef,				///< Src description created in the ExtendBoundary() call. 
-																				_extWidth, 
-																				_extHeight,
-																				_macroBlkWidth,	///< Block size description.
-																				_macroBlkHeight,
-																				_extBoundary,		///< Boundary size for both left and right.
-																				_extBoundary  );
-	if(_pExtRefOver == NULL)
+	if(_pel8)
+	{
+		/// --------------- Configure 8-bit overlays ----------------------------
+		/// The input and ref lum planes are overlaid directly. The extended ref is
+		/// borrowed from the shared pool with padded rows.
+		int extStride = 0;
+		_pExtRef8 = (unsigned char *)PlanePool::Shared()->Acquire(_extWidth, _extHeight, sizeof(unsigned char), 1, &extStride);
+		if(_pExtRef8 == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end if !_pExtRef8...
+		_pInOver8			= new OverlayMem2Dv2u8((void *)_pInput, _imgWidth, _imgHeight, _macroBlkWidth, _macroBlkHeight);
+		_pRefOver8		= new OverlayMem2Dv2u8((void *)_pRef, _imgWidth, _imgHeight, _imgWidth, _imgHeight);
+		_pExtRefOver8	= new OverlayMem2Dv2u8(_pExtRef8, _extWidth, _extHeight, _macroBlkWidth, _macroBlkHeight, _extBoundary, _extBoundary, extStride);
+		_pMBlk8				= new unsigned char[_macroBlkWidth * _macroBlkHeight];
+		_pMBlkOver8		= new OverlayMem2Dv2u8(_pMBlk8, _macroBlkWidth, _macroBlkHeight, _macroBlkWidth, _macroBlkHeight);
+		if( (_pInOver8 == NULL)||(_pRefOver8 == NULL)||(_pExtRefOver8 == NULL)||(_pMBlk8 == NULL)||(_pMBlkOver8 == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_pInOver8...
+	}//end if _pel8...
+	else
+	{
+		/// --------------- Configure input overlays --------------------------------
+		/// Put an overlay on the input image with the block size set to the mb vector 
+		/// dim. This is used to access input vectors.
+		_pInOver = new OverlayMem2Dv2((void *)_pInput,_imgWidth,_imgHeight,_macroBlkWidth,_macroBlkHeight);
+		if(_pInOver == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end _pInOver...
+
+		/// --------------- Configure ref overlays --------------------------------
+		/// Overlay the whole reference. The reference will have an extended 
+		/// boundary for motion estimation and must therefore create its own mem.
+		_pRefOver = new OverlayMem2Dv2((void *)_pRef, _imgWidth, _imgHeight, _imgWidth, _imgHeight);
+		if(_pRefOver == NULL)
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !_pRefOver...
+
+		/// Create the new extended boundary ref into _pExtRef. The mem is allocated in the method call.
+		if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
+																					_imgWidth,						
+																					_imgHeight, 
+																					_extBoundary,	///< Extend left and right by...
+																					_extBoundary,	///< Extend top and bottom by...
+																					(void **)(&_pExtRef)) )	///< Created in the method and returned.
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !ExtendBoundary...
+
+		/// Place an overlay on the extended boundary ref with block size set to the mb motion 
+	  /// vec dim.
+		_pExtRefOver = new OverlayExtMem2Dv2(	_pExtRef,				///< Src description created in the ExtendBoundary() call. 
+																					_extWidth, 
+																					_extHeight,
+																					_macroBlkWidth,	///< Block size description.
+																					_macroBlkHeight,
+																					_extBoundary,		///< Boundary size for both left and right.
+																					_extBoundary  );
+		if(_pExtRefOver == NULL)
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !_pExtRefOver...
+
+		/// --------------- Configure temp overlays --------------------------------
+		/// Alloc some temp mem and overlay it to use for half/quarter pel motion 
+	  /// estimation and compensation. The block size is the same as the mem size.
+		_pMBlk = new short[_macroBlkWidth * _macroBlkHeight];
+		_pMBlkOver = new OverlayMem2Dv2(_pMBlk, _macroBlkWidth, _macroBlkHeight, 
+																						_macroBlkWidth, _macroBlkHeight);
+		if( (_pMBlk == NULL)||(_pMBlkOver == NULL) )
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !_pMBlk...
+	}//end else...
+
+	/// Static macroblock classification for the pre-pass.
+	if(!_staticMb.Create(_imgWidth, _imgHeight))
   {
 		Destroy();
 	  return(0);
-  }//end if !_pExtRefOver...
-
-	/// --------------- Configure temp overlays --------------------------------
-	/// Alloc some temp mem and overlay it to use for half/quarter pel motion 
-  /// estimation and compensation. The block size is the same as the mem size.
-	_pMBlk = new short[_macroBlkWidth * _macroBlkHeight];
-	_pMBlkOver = new OverlayMem2Dv2(_pMBlk, _macroBlkWidth, _macroBlkHeight, 
-																					_macroBlkWidth, _macroBlkHeight);
-	if( (_pMBlk == NULL)||(_pMBlkOver == NULL) )
+  }//end if !Create...
+
+	/// Block sum table over the extended ref for successive elimination.
+	if(!_extRefSum.Create(_extWidth, _extHeight))
   {
 		Destroy();
 	  return(0);
-  }//end if !_pMBlk...
+  }//end if !Create...
 
 	/// --------------- Configure result ---------------------------------------
 	/// The structure container for the motion vectors.
@@ -339,17 +394,65 @@ void* MotionEstimatorH264ImplFull::Estimate(long* avgDistortion)
 
   /// Write the ref and fill its extended boundary. The centre part of
   /// _pExtRefOver is copied from _pRefOver before filling the boundary.
-  _pExtRefOver->SetOrigin(0, 0);
-  _pExtRefOver->SetOverlayDim(_imgWidth, _imgHeight);
-  _pExtRefOver->Write(*_pRefOver);	///< _pRefOver dimensions are always set to the whole image.
-  _pExtRefOver->FillBoundaryProxy();
-  _pExtRefOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+  if (_pel8)
+  {
+    _pExtRefOver8->SetOrigin(0, 0);
+    _pExtRefOver8->SetOverlayDim(_imgWidth, _imgHeight);
+    _pExtRefOver8->Write(*_pRefOver8);
+    _pExtRefOver8->FillBoundaryProxy();
+    _pExtRefOver8->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+  }//end if _pel8...
+  else
+  {
+    _pExtRefOver->SetOrigin(0, 0);
+    _pExtRefOver->SetOverlayDim(_imgWidth, _imgHeight);
+    _pExtRefOver->Write(*_pRefOver);	///< _pRefOver dimensions are always set to the whole image.
+    _pExtRefOver->FillBoundaryProxy();
+    _pExtRefOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+  }//end else...
+
+  /// Classify the static macroblocks that bypass the search.
+  if (_staticMbSkip)
+  {
+    if (_pel8)
+      _staticMb.Classify((const unsigned char *)_pInput, (const unsigned char *)_pRef, _staticMbQP);
+    else
+      _staticMb.Classify((const short *)_pInput, (const short *)_pRef, _staticMbQP);
+  }//end if _staticMbSkip...
+
+  /// Block sums of the extended ref for successive elimination.
+  if (_successiveElimination)
+  {
+    if (_pel8)
+      _extRefSum.Load(_pExtRefOver8->Get2DSrcPtr());
+    else
+      _extRefSum.Load(_pExtRefOver->Get2DSrcPtr());
+  }//end if _successiveElimination...
 
   /// Gather the motion vector absolute differnce/square error data and choose the vector.
   /// m,n step level 0 vec dim = _macroBlkHeight, _macroBlkWidth.
   for (m = 0; m < _imgHeight; m += _macroBlkHeight)
     for (n = 0; n < _imgWidth; n += _macroBlkWidth)
     {
+      /// Static macroblocks from the pre-pass take the zero vector without a search.
+      if (_staticMbSkip && _staticMb.IsStatic(vecPos))
+      {
+        int zeroVecDiff = _staticMb.GetZeroVecDistortion(vecPos);
+        if ((_pDistortionIncluded != NULL) && _pDistortionIncluded[vecPos])
+        {
+          included++;
+          totalDifference += zeroVecDiff;
+        }//end if _pDistortionIncluded...
+        if (vecPos < maxLength)
+        {
+          _pMotionVectorStruct->SetSimpleElement(vecPos, 0, 0);
+          _pMotionVectorStruct->SetSimpleElement(vecPos, 1, 0);
+          _pMVPred->Set16x16MotionVector(vecPos, 0, 0);
+          vecPos++;
+        }//end if vecPos...
+        continue;
+      }//end if _staticMbSkip...
+
       int mx = 0;	///< Full pel grid.
       int my = 0;
       int hmx = 0;	///< 1/2 pel on 1/4 pel grid.
@@ -380,14 +483,43 @@ void* MotionEstimatorH264ImplFull::Estimate(long* avgDistortion)
         predY0Rnd = (predY + 2) / 4;
 
       /// Set the input and ref blocks to work with.
-      _pInOver->SetOrigin(n, m);
-      _pExtRefOver->SetOrigin(n, m);
+      if (_pel8)
+      {
+        _pInOver8->SetOrigin(n, m);
+        _pExtRefOver8->SetOrigin(n, m);
+      }//end if _pel8...
+      else
+      {
+        _pInOver->SetOrigin(n, m);
+        _pExtRefOver->SetOrigin(n, m);
+      }//end else...
+
+      /// The 8x8 quadrant sums of the input mb for successive elimination.
+      if (_successiveElimination)
+      {
+        _inQuadSum[0] = _inQuadSum[1] = _inQuadSum[2] = _inQuadSum[3] = 0;
+        for (int k = 0; k < _macroBlkHeight; k++)
+          for (int l = 0; l < _macroBlkWidth; l++)
+            _inQuadSum[((k >> 3) << 1) + (l >> 3)] += _pel8 ? _pInOver8->Read(l, k) : _pInOver->Read(l, k);
+      }//end if _successiveElimination...
+
+      /// Single indirection views of the input mb for the full pel search.
+      ViewMem2Dv2 inView;
+      if (!_pel8)
+        inView = ViewMem2Dv2::Of(*_pInOver);
 
       /// The (0,0) motion vector is the one to beat with Absolute/Square diff comparison method.
+      int zeroVecDiff;
 #ifdef MEH264IF_ABS_DIFF
-      int zeroVecDiff = _pInOver->Tad16x16(*_pExtRefOver);
+      if (_pel8)
+        zeroVecDiff = _pInOver8->Tad16x16(*_pExtRefOver8);
+      else
+        zeroVecDiff = inView.Tad16x16(ViewMem2Dv2::Of(*_pExtRefOver));
 #else
-      int zeroVecDiff = _pInOver->Tsd16x16(*_pExtRefOver);
+      if (_pel8)
+        zeroVecDiff = _pInOver8->Tsd16x16(*_pExtRefOver8);
+      else
+        zeroVecDiff = inView.Tsd16x16(ViewMem2Dv2::Of(*_pExtRefOver));
       //int zeroVecDiff = _pInOver->Tsd16x16PartialPath(*_pExtRefOver, (void *)MEH264IC_LinearPath, _pathLength);
       //int zeroVecDiff = _pInOver->Tsd16x16PartialPath(*_pExtRefOver, (void *)MEH264IF_OptimalPath, _pathLength);
 #endif
@@ -411,12 +543,43 @@ void* MotionEstimatorH264ImplFull::Estimate(long* avgDistortion)
             goto MEH264IF_FULL_BREAK;
 
           /// Set the block to the [j,i] offset motion vector around the [n,m] reference location.
-          _pExtRefOver->SetOrigin(n+j, m+i);
+          if (_pel8)
+            _pExtRefOver8->SetOrigin(n+j, m+i);
+          else
+            _pExtRefOver->SetOrigin(n+j, m+i);
+
+          /// Successive elimination: the quadrant sum differences are a lower bound on the
+          /// distortion. Strictly greater than minDiff cannot win or tie so skip it.
+          if (_successiveElimination)
+          {
+            int x = _pel8 ? _pExtRefOver8->GetOriginX() : _pExtRefOver->GetOriginX();
+            int y = _pel8 ? _pExtRefOver8->GetOriginY() : _pExtRefOver->GetOriginY();
+            int d0 = _inQuadSum[0] - _extRefSum.BlockSum(x, y, 8, 8);
+            int d1 = _inQuadSum[1] - _extRefSum.BlockSum(x + 8, y, 8, 8);
+            int d2 = _inQuadSum[2] - _extRefSum.BlockSum(x, y + 8, 8, 8);
+            int d3 = _inQuadSum[3] - _extRefSum.BlockSum(x + 8, y + 8, 8, 8);
+#ifdef MEH264IF_ABS_DIFF
+            if ((abs(d0) + abs(d1) + abs(d2) + abs(d3)) > minDiff)
+#else
+            /// Tsd of a 64 pel quadrant >= (quadrant sum diff)^2 / 64.
+            if (((d0*d0) + (d1*d1) + (d2*d2) + (d3*d3)) > (minDiff << 6))
+#endif
+              goto MEH264IF_FULL_BREAK;
+          }//end if _successiveElimination...
 
+          if (_pel8)
+          {
+#ifdef MEH264IF_ABS_DIFF
+            blkDiff = _pInOver8->Tad16x16LessThan(*_pExtRefOver8, minDiff);
+#else
+            blkDiff = _pInOver8->Tsd16x16LessThan(*_pExtRefOver8, minDiff);
+#endif
+          }//end if _pel8...
+          else
 #ifdef MEH264IF_ABS_DIFF
-          int blkDiff = _pInOver->Tad16x16LessThan(*_pExtRefOver, minDiff);
+          blkDiff = inView.Tad16x16LessThan(ViewMem2Dv2::Of(*_pExtRefOver), minDiff);
 #else
-          blkDiff = _pInOver->Tsd16x16LessThan(*_pExtRefOver, minDiff);
+          blkDiff = inView.Tsd16x16LessThan(ViewMem2Dv2::Of(*_pExtRefOver), minDiff);
           //int blkDiff = _pInOver->Tsd16x16PartialLessThan(*_pExtRefOver, minDiff);
           //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pExtRefOver, (void *)MEH264IC_LinearPath, _pathLength, minDiff);
           //blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pExtRefOver, (void *)MEH264IF_OptimalPath, _pathLength, minDiff);
@@ -452,11 +615,18 @@ void* MotionEstimatorH264ImplFull::Estimate(long* avgDistortion)
       int mvx = mx << 2;	///< Convert to 1/4 pel units.
       int mvy = my << 2;
 
-      /// Set the location to the min diff motion vector (mx,my).
-      _pExtRefOver->SetOrigin(n + mx, m + my);
-
-      /// Fill the 1/4 pel window with valid values only in the 1/2 pel positions.
-      LoadHalfQuartPelWindow(_Win, _pExtRefOver);
+      /// Set the location to the min diff motion vector (mx,my) and fill the 1/4 pel 
+      /// window with valid values only in the 1/2 pel positions.
+      if (_pel8)
+      {
+        _pExtRefOver8->SetOrigin(n + mx, m + my);
+        LoadHalfQuartPelWindow(_Win, _pExtRefOver8);
+      }//end if _pel8...
+      else
+      {
+        _pExtRefOver->SetOrigin(n + mx, m + my);
+        LoadHalfQuartPelWindow(_Win, _pExtRefOver);
+      }//end else...
 
       for (int x = 0; x < MEH264IF_MOTION_SUB_POS_LENGTH; x++)
       {
@@ -464,16 +634,28 @@ void* MotionEstimatorH264ImplFull::Estimate(long* avgDistortion)
         int qOffY = 2 * MEH264IF_SubPos[x].y;
 
         /// Read the half grid pels into temp.
-        QuarterRead(_pMBlkOver, _Win, qOffX, qOffY);
-
+        int blkDiff;
+        if (_pel8)
+        {
+          QuarterRead(_pMBlkOver8, _Win, qOffX, qOffY);
 #ifdef MEH264IF_ABS_DIFF
-        int blkDiff = _pInOver->Tad16x16LessThan(*_pMBlkOver, minDiff);
+          blkDiff = _pInOver8->Tad16x16LessThan(*_pMBlkOver8, minDiff);
 #else
-        int blkDiff = _pInOver->Tsd16x16LessThan(*_pMBlkOver, minDiff);
-        //int blkDiff = _pInOver->Tsd16x16PartialLessThan(*_pMBlkOver, minDiff);
-        //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pExtRefOver, (void *)MEH264IC_LinearPath, _pathLength, minDiff);
-        //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pMBlkOver, (void *)MEH264IF_OptimalPath, _pathLength, minDiff);
+          blkDiff = _pInOver8->Tsd16x16LessThan(*_pMBlkOver8, minDiff);
+#endif
+        }//end if _pel8...
+        else
+        {
+          QuarterRead(_pMBlkOver, _Win, qOffX, qOffY);
+#ifdef MEH264IF_ABS_DIFF
+          blkDiff = _pInOver->Tad16x16LessThan(*_pMBlkOver, minDiff);
+#else
+          blkDiff = _pInOver->Tsd16x16LessThan(*_pMBlkOver, minDiff);
+          //int blkDiff = _pInOver->Tsd16x16PartialLessThan(*_pMBlkOver, minDiff);
+          //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pExtRefOver, (void *)MEH264IC_LinearPath, _pathLength, minDiff);
+          //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pMBlkOver, (void *)MEH264IF_OptimalPath, _pathLength, minDiff);
 #endif
+        }//end else...
         if (blkDiff < minDiff)
         {
           minDiff = blkDiff;
@@ -494,16 +676,28 @@ void* MotionEstimatorH264ImplFull::Estimate(long* avgDistortion)
         int qOffY = hmy + MEH264IF_SubPos[x].y;
 
         /// Read the quarter grid pels into temp.
-        QuarterRead(_pMBlkOver, _Win, qOffX, qOffY);
-
+        int blkDiff;
+        if (_pel8)
+        {
+          QuarterRead(_pMBlkOver8, _Win, qOffX, qOffY);
 #ifdef MEH264IF_ABS_DIFF
-        int blkDiff = _pInOver->Tad16x16LessThan(*_pMBlkOver, minDiff);
+          blkDiff = _pInOver8->Tad16x16LessThan(*_pMBlkOver8, minDiff);
 #else
-        int blkDiff = _pInOver->Tsd16x16LessThan(*_pMBlkOver, minDiff);
-        //int blkDiff = _pInOver->Tsd16x16PartialLessThan(*_pMBlkOver, minDiff);
-        //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pExtRefOver, (void *)MEH264IC_LinearPath, _pathLength, minDiff);
-        //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pMBlkOver, (void *)MEH264IF_OptimalPath, _pathLength, minDiff);
+          blkDiff = _pInOver8->Tsd16x16LessThan(*_pMBlkOver8, minDiff);
+#endif
+        }//end if _pel8...
+        else
+        {
+          QuarterRead(_pMBlkOver, _Win, qOffX, qOffY);
+#ifdef MEH264IF_ABS_DIFF
+          blkDiff = _pInOver->Tad16x16LessThan(*_pMBlkOver, minDiff);
+#else
+          blkDiff = _pInOver->Tsd16x16LessThan(*_pMBlkOver, minDiff);
+          //int blkDiff = _pInOver->Tsd16x16PartialLessThan(*_pMBlkOver, minDiff);
+          //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pExtRefOver, (void *)MEH264IC_LinearPath, _pathLength, minDiff);
+          //int blkDiff = _pInOver->Tsd16x16PartialPathLessThan(*_pMBlkOver, (void *)MEH264IF_OptimalPath, _pathLength, minDiff);
 #endif
+        }//end else...
         if (blkDiff < minDiff)
         {
           minDiff = blkDiff;
@@ -540,33 +734,57 @@ void* MotionEstimatorH264ImplFull::Estimate(long* avgDistortion)
       predX = (predX0 * 4) + predXQuart;
       predY = (predY0 * 4) + predYQuart;
 
-      _pExtRefOver->SetOrigin(predX0 + n, predY0 + m);
-
       /// Get distortion at pred mv.
       int predVecDiff = 0;
-      /// Quarter read first if necessary.
-      if (predXQuart || predYQuart)
+      if (_pel8)
       {
-        /// Read the quarter grid pels into temp.
-        _pExtRefOver->QuarterRead(*_pMBlkOver, predXQuart, predYQuart);
-        /// Absolute/square diff comparison method.
+        _pExtRefOver8->SetOrigin(predX0 + n, predY0 + m);
+        /// Quarter read first if necessary.
+        if (predXQuart || predYQuart)
+        {
+          _pExtRefOver8->QuarterRead(*_pMBlkOver8, predXQuart, predYQuart);
+#ifdef MEH264IF_ABS_DIFF
+          predVecDiff = _pInOver8->Tad16x16(*_pMBlkOver8);
+#else
+          predVecDiff = _pInOver8->Tsd16x16(*_pMBlkOver8);
+#endif
+        }//end if predXQuart...
+        else
+        {
 #ifdef MEH264IF_ABS_DIFF
-        predVecDiff = _pInOver->Tad16x16(*_pMBlkOver);
+          predVecDiff = _pInOver8->Tad16x16(*_pExtRefOver8);
 #else
-        predVecDiff = _pInOver->Tsd16x16(*_pMBlkOver);
-        //predVecDiff = _pInOver->Tsd16x16PartialPath(*_pMBlkOver, (void *)MEH264IC_LinearPath, _pathLength);
-        //predVecDiff = _pInOver->Tsd16x16PartialPath(*_pMBlkOver, (void *)MEH264IF_OptimalPath, _pathLength);
+          predVecDiff = _pInOver8->Tsd16x16(*_pExtRefOver8);
 #endif
-      }//end if predXQuart...
+        }//end else...
+      }//end if _pel8...
       else
       {
+        _pExtRefOver->SetOrigin(predX0 + n, predY0 + m);
+        /// Quarter read first if necessary.
+        if (predXQuart || predYQuart)
+        {
+          /// Read the quarter grid pels into temp.
+          _pExtRefOver->QuarterRead(*_pMBlkOver, predXQuart, predYQuart);
+          /// Absolute/square diff comparison method.
 #ifdef MEH264IF_ABS_DIFF
-        predVecDiff = _pInOver->Tad16x16(*_pExtRefOver);
+          predVecDiff = _pInOver->Tad16x16(*_pMBlkOver);
 #else
-        predVecDiff = _pInOver->Tsd16x16(*_pExtRefOver);
-        //predVecDiff = _pInOver->Tsd16x16PartialPath(*_pExtRefOver, (void *)MEH264IC_LinearPath, _pathLength);
-        //predVecDiff = _pInOver->Tsd16x16PartialPath(*_pExtRefOver, (void *)MEH264IF_OptimalPath, _pathLength);
+          predVecDiff = _pInOver->Tsd16x16(*_pMBlkOver);
+          //predVecDiff = _pInOver->Tsd16x16PartialPath(*_pMBlkOver, (void *)MEH264IC_LinearPath, _pathLength);
+          //predVecDiff = _pInOver->Tsd16x16PartialPath(*_pMBlkOver, (void *)MEH264IF_OptimalPath, _pathLength);
 #endif
+        }//end if predXQuart...
+        else
+        {
+#ifdef MEH264IF_ABS_DIFF
+          predVecDiff = _pInOver->Tad16x16(*_pExtRefOver);
+#else
+          predVecDiff = _pInOver->Tsd16x16(*_pExtRefOver);
+          //predVecDiff = _pInOver->Tsd16x16PartialPath(*_pExtRefOver, (void *)MEH264IC_LinearPath, _pathLength);
+          //predVecDiff = _pInOver->Tsd16x16PartialPath(*_pExtRefOver, (void *)MEH264IF_OptimalPath, _pathLength);
+#endif
+        }//end else...
       }//end else...
 
        /// Initialise the fifos and load the zero vector, pred vector and the curr best vector.
@@ -946,13 +1164,30 @@ void MotionEstimatorH264ImplFull::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
 		delete _pExtRefOver;
 	_pExtRefOver = NULL;
 
+	_staticMb.Destroy();
+
+	_extRefSum.Destroy();
+
+	if(_pInOver8 != NULL)
+		delete _pInOver8;
+	_pInOver8 = NULL;
+	if(_pRefOver8 != NULL)
+		delete _pRefOver8;
+	_pRefOver8 = NULL;
+	if(_pExtRefOver8 != NULL)
+		delete _pExtRefOver8;
+	_pExtRefOver8 = NULL;
+	if(_pExtRef8 != NULL)
+		PlanePool::Shared()->Release(_pExtRef8);
+	_pExtRef8 = NULL;
+
 	if(_pMBlk != NULL)
 		delete[] _pMBlk;
 	_pMBlk = NULL;
@@ -960,6 +1195,12 @@ void MotionEstimatorH264ImplFull::Destroy(void)
 	if(_pMBlkOver != NULL)
 		delete _pMBlkOver;
 	_pMBlkOver = NULL;
+	if(_pMBlkOver8 != NULL)
+		delete _pMBlkOver8;
+	_pMBlkOver8 = NULL;
+	if(_pMBlk8 != NULL)
+		delete[] _pMBlk8;
+	_pMBlk8 = NULL;
 
 	if(_pMotionVectorStruct != NULL)
 		delete _pMotionVectorStruct;
@@ -1089,10 +1330,12 @@ and therefore only the 1/2 pel positions are valid. This method must be followed
 method to complete the 1/4 pel values around a winning 1/2 pel position. The reference origin position is 
 aligned onto the full pel (3,3) position of the 1/4 pel window.
 @param qPelWin	: Window of size (4 * (_macroBlkHeight+6)) x (4 * (_macroBlkWidth+6))
-@param extRef		: Reference to derive the 1/4 pel window from.
+@param ref			: Row addresses of the 16-bit or 8-bit reference to derive the 1/4 pel window from.
+@param refXPos	: Reference origin X in mem coords.
+@param refYPos	: Reference origin Y in mem coords.
 @return					: none.
 */
-void MotionEstimatorH264ImplFull::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2* extRef)
+template<typename T> void MotionEstimatorH264ImplFull::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, T** ref, int refXPos, int refYPos)
 {
 	int fullRow, fullCol, quartRow, quartCol, refRow, refCol;
 
@@ -1100,10 +1343,6 @@ void MotionEstimatorH264ImplFull::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin
 	int			height	= qPelWin->GetHeight()/4;
 	short** window	= qPelWin->Get2DSrcPtr();
 
-	short** ref			= extRef->Get2DSrcPtr();
-	int			refXPos = extRef->GetOriginX();
-	int			refYPos = extRef->GetOriginY();
-
 	/// Set all the "h" half pel values in the window only at the positions that will be required for the other calcs. No
 	/// scaling or clipping is performed until "j" half pel values are completed.
 	for(fullRow = 2, quartRow = 10, refRow = refYPos - 1; fullRow < (_macroBlkHeight + 3); fullRow++, quartRow += 4, refRow++)
@@ -1181,6 +1420,16 @@ void MotionEstimatorH264ImplFull::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin
 
 }//end LoadHalfQuartPelWindow.
 
+void MotionEstimatorH264ImplFull::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2* extRef)
+{
+	LoadHalfQuartPelWindow(qPelWin, extRef->Get2DSrcPtr(), extRef->GetOriginX(), extRef->GetOriginY());
+}//end LoadHalfQuartPelWindow.
+
+void MotionEstimatorH264ImplFull::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2u8* extRef)
+{
+	LoadHalfQuartPelWindow(qPelWin, extRef->Get2DSrcPtr(), extRef->GetOriginX(), extRef->GetOriginY());
+}//end LoadHalfQuartPelWindow.
+
 /** Load a 1/4 pel window with 1/4 pel values not in 1/2 pel positions.
 The 1/4 pel window must be the macroblock size with a boundary of 3 extra pels on all sides. Only the inner
 macroblock size plus 1 extra pel boundary are filled with valid values. This window is used in a cascading 
@@ -1254,6 +1503,26 @@ void MotionEstimatorH264ImplFull::QuarterRead(OverlayMem2Dv2* dstBlock, OverlayM
 
 }//end QuarterRead.
 
+/// The window values are clipped to [0..255] and are read into an 8-bit block.
+void MotionEstimatorH264ImplFull::QuarterRead(OverlayMem2Dv2u8* dstBlock, OverlayMem2Dv2* qPelWin, int qPelColOff, int qPelRowOff)
+{
+	int fullRow, fullCol, quartRow, quartCol, dstX;
+
+	short**					window	= qPelWin->Get2DSrcPtr();
+	unsigned char**	dst			= dstBlock->Get2DSrcPtr();
+	int							width		= dstBlock->GetWidth();
+	int							height	= dstBlock->GetHeight();
+	int							dstXPos = dstBlock->GetOriginX();
+	int							dstYPos = dstBlock->GetOriginY();
+
+	for(fullRow = 0, quartRow = (12 + qPelRowOff); fullRow < height; fullRow++, dstYPos++, quartRow += 4)
+	{
+		for(fullCol = 0, quartCol = (12 + qPelColOff), dstX = dstXPos; fullCol < width; fullCol++, quartCol += 4, dstX++)
+			dst[dstYPos][dstX] = (unsigned char)window[quartRow][quartCol];
+	}//end fullRow...
+
+}//end QuarterRead.
+
 
 
 
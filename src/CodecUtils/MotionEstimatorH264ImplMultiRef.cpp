@@ -0,0 +1,677 @@
+/** @file
+
+MODULE				: MotionEstimatorH264ImplMultiRef
+
+TAG						: MEH264IMR
+
+FILE NAME			: MotionEstimatorH264ImplMultiRef.cpp
+
+DESCRIPTION		: Multiple reference frame H.264 16x16 motion estimator that
+                searches across the frames of an H264RefFrameStore. Reference
+                0 is searched with a level 1 coarse full search followed by a
+                level 0 predictive diamond refinement. Older references are
+                only searched from candidates pruned from the reference 0
+                result. Every candidate is ranked with a rate constrained cost
+                that includes the reference index bits.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+#include <math.h>
+#include <limits.h>
+
+#include	"MotionEstimatorH264ImplMultiRef.h"
+#include	"H264StaticMbDetector.h"
+#include	"PlanePool.h"
+
+/*
+--------------------------------------------------------------------------
+  Constants. 
+--------------------------------------------------------------------------
+*/
+/// Max num of small diamond steps in the level 0 refinement.
+#define MEH264IMR_DIAMOND_STEPS				8
+
+/// Search range coords for the small diamond.
+#define MEH264IMR_MOTION_CROSS_POS_LENGTH 	4
+static const int MEH264IMR_CrossPosX[MEH264IMR_MOTION_CROSS_POS_LENGTH]	= { 0,-1, 1, 0 };
+static const int MEH264IMR_CrossPosY[MEH264IMR_MOTION_CROSS_POS_LENGTH]	= {-1, 0, 0, 1 };
+
+/// Search range coords for the sub pel positions around a centre.
+#define MEH264IMR_MOTION_SUB_POS_LENGTH 	8
+static const int MEH264IMR_SubPosX[MEH264IMR_MOTION_SUB_POS_LENGTH]	= { -1, 0, 1,-1, 1,-1, 0, 1 };
+static const int MEH264IMR_SubPosY[MEH264IMR_MOTION_SUB_POS_LENGTH]	= { -1,-1,-1, 0, 0, 1, 1, 1 };
+
+/*
+--------------------------------------------------------------------------
+  Construction. 
+--------------------------------------------------------------------------
+*/
+
+MotionEstimatorH264ImplMultiRef::MotionEstimatorH264ImplMultiRef(const void*             pSrc, 
+																																 H264RefFrameStore*      pStore, 
+																																 int					           imgWidth, 
+																																 int					           imgHeight,
+																																 int					           motionRange,
+																																 IMotionVectorPredictor* pMVPred)
+{
+	ResetMembers();
+
+	/// Parameters must remain const for the life time of this instantiation.
+	_imgWidth				= imgWidth;					///< Width of the src and ref images. 
+	_imgHeight			= imgHeight;				///< Height of the src and ref images.
+	_macroBlkWidth	= 16;								///< Width of the motion block = 16 for H.264.
+	_macroBlkHeight	= 16;								///< Height of the motion block = 16 for H.264.
+	_motionRange		= motionRange;			///< (4x,4y) range of the motion vectors. _motionRange in 1/4 pel units.
+	_pInput					= pSrc;
+	_pStore					= pStore;
+  _pMVPred        = pMVPred;
+
+}//end constructor.
+
+MotionEstimatorH264ImplMultiRef::MotionEstimatorH264ImplMultiRef(const void*             pSrc, 
+																																 H264RefFrameStore*      pStore, 
+																																 int					           imgWidth, 
+																																 int					           imgHeight,
+																																 int					           motionRange,
+																																 IMotionVectorPredictor* pMVPred,
+																																 void*				           pDistortionIncluded)
+{
+	ResetMembers();
+
+	/// Parameters must remain const for the life time of this instantiation.
+	_imgWidth							= imgWidth;					///< Width of the src and ref images. 
+	_imgHeight						= imgHeight;				///< Height of the src and ref images.
+	_macroBlkWidth				= 16;								///< Width of the motion block = 16 for H.264.
+	_macroBlkHeight				= 16;								///< Height of the motion block = 16 for H.264.
+	_motionRange					= motionRange;			///< (4x,4y) range of the motion vectors. _motionRange in 1/4 pel units.
+	_pInput								= pSrc;
+	_pStore								= pStore;
+  _pMVPred              = pMVPred;
+	_pDistortionIncluded	= (bool *)pDistortionIncluded;
+
+}//end constructor.
+
+void MotionEstimatorH264ImplMultiRef::ResetMembers(void)
+{
+	_ready	= 0;	///< Ready to estimate.
+	_mode		= 0;	///< Default to pruned multiple ref.
+
+	/// Parameters must remain const for the life time of this instantiation.
+	_imgWidth				= 0;					///< Width of the src and ref images. 
+	_imgHeight			= 0;					///< Height of the src and ref images.
+	_macroBlkWidth	= 16;					///< Width of the motion block = 16 for H.264.
+	_macroBlkHeight	= 16;					///< Height of the motion block = 16 for H.264.
+	_motionRange		= 64;					///< (4x,4y) range of the motion vectors.
+	_pInput					= NULL;
+	_pStore					= NULL;
+
+	_maxRefs				= 16;
+	_searchCount		= 0;
+	SetQP(26);
+
+	/// Input mem overlay members.
+	_pInOver					= NULL;			///< Input overlay with mb motion block dim.
+	_pInL1						= NULL;
+	_pInL1Over				= NULL;
+
+	/// Temp working block and its overlay.
+	_pMBlk						= NULL;			///< Motion block temp mem.
+	_pMBlkOver				= NULL;			///< Motion block overlay of temp mem.
+
+	/// 8-bit input overlays.
+	_pInOver8					= NULL;
+	_pInL18						= NULL;
+	_pInL1Over8				= NULL;
+	_pMBlk8						= NULL;
+	_pMBlkOver8				= NULL;
+
+	/// Hold the resulting motion vectors and their refs.
+	_pMotionVectorStruct = NULL;
+	_pRefIdx						 = NULL;
+  /// Attached motion vector predictor on construction.
+  _pMVPred          = NULL;
+
+  /// A flag per macroblock to include it in the distortion accumulation.
+	_pDistortionIncluded = NULL;
+
+}//end ResetMembers.
+
+MotionEstimatorH264ImplMultiRef::~MotionEstimatorH264ImplMultiRef(void)
+{
+	Destroy();
+}//end destructor.
+
+/*
+--------------------------------------------------------------------------
+  Public IMotionEstimator Interface. 
+--------------------------------------------------------------------------
+*/
+
+int MotionEstimatorH264ImplMultiRef::Create(void)
+{
+	/// Clean out old mem.
+	Destroy();
+
+	/// The store must match the image.
+	if( (_pStore == NULL)||(!_pStore->Ready())||(_pStore->GetWidth() != _imgWidth)||(_pStore->GetHeight() != _imgHeight) )
+		return(0);
+
+	if(_pStore->IsPel8())
+	{
+		/// --------------- Configure 8-bit overlays ----------------------------
+		/// The input lum plane is overlaid directly and its level 1 is borrowed from
+		/// the shared pool with padded rows.
+		int l1Stride = 0;
+		_pInL18 = (unsigned char *)PlanePool::Shared()->Acquire(_imgWidth/2, _imgHeight/2, sizeof(unsigned char), 1, &l1Stride);
+		if(_pInL18 == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end if !_pInL18...
+		_pInOver8		= new OverlayMem2Dv2u8((void *)_pInput, _imgWidth, _imgHeight, _macroBlkWidth, _macroBlkHeight);
+		_pInL1Over8	= new OverlayMem2Dv2u8((void *)_pInL18, _imgWidth/2, _imgHeight/2, _macroBlkWidth/2, _macroBlkHeight/2, 0, 0, l1Stride);
+		_pMBlk8			= new unsigned char[_macroBlkWidth * _macroBlkHeight];
+		_pMBlkOver8	= new OverlayMem2Dv2u8(_pMBlk8, _macroBlkWidth, _macroBlkHeight, _macroBlkWidth, _macroBlkHeight);
+		if( (_pInOver8 == NULL)||(_pInL1Over8 == NULL)||(_pMBlk8 == NULL)||(_pMBlkOver8 == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_pInOver8...
+	}//end if IsPel8...
+	else
+	{
+		/// --------------- Configure input overlays --------------------------------
+		/// Put an overlay on the input image with the block size set to the mb vector 
+		/// dim. This is used to access input vectors.
+		_pInOver = new OverlayMem2Dv2((void *)_pInput,_imgWidth,_imgHeight,_macroBlkWidth,_macroBlkHeight);
+		if(_pInOver == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end _pInOver...
+
+		/// Level 1: Input mem at half resolution with level 1 motion block dim.
+		_pInL1 = new short[(_imgWidth/2) * (_imgHeight/2)];
+		if(_pInL1 != NULL)
+			_pInL1Over = new OverlayMem2Dv2((void *)_pInL1, _imgWidth/2, _imgHeight/2, _macroBlkWidth/2, _macroBlkHeight/2);
+		if(_pInL1Over == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end _pInL1Over...
+
+		/// --------------- Configure temp overlays --------------------------------
+		/// Alloc some temp mem and overlay it to use for half/quarter pel motion 
+	  /// estimation. The block size is the same as the mem size.
+		_pMBlk = new short[_macroBlkWidth * _macroBlkHeight];
+		_pMBlkOver = new OverlayMem2Dv2(_pMBlk, _macroBlkWidth, _macroBlkHeight, 
+																						_macroBlkWidth, _macroBlkHeight);
+		if( (_pMBlk == NULL)||(_pMBlkOver == NULL) )
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !_pMBlk...
+	}//end else...
+
+	/// --------------- Configure result ---------------------------------------
+	/// The structure container for the motion vectors and the ref per vector.
+	int numMbs = (_imgWidth/_macroBlkWidth) * (_imgHeight/_macroBlkHeight);
+	_pMotionVectorStruct = new VectorStructList(VectorStructList::SIMPLE2D);
+	if(_pMotionVectorStruct != NULL)
+	{
+		if(!_pMotionVectorStruct->SetLength(numMbs))
+		{
+			Destroy();
+			return(0);
+		}//end _pMotionVectorStruct...
+	}//end if _pMotionVectorStruct...
+	else
+  {
+		Destroy();
+	  return(0);
+  }//end if else...
+
+	_pRefIdx = new int[numMbs];
+	if(_pRefIdx == NULL)
+  {
+		Destroy();
+	  return(0);
+  }//end if !_pRefIdx...
+	memset((void *)_pRefIdx, 0, numMbs * sizeof(int));
+
+	_ready = 1;
+	return(1);
+}//end Create.
+
+/** Set the Lagrange multiplier from the QP.
+The multiplier for a square error distortion is 0.85 x 2^((qp-12)/3).
+@param qp	: Quantisation parameter [0..51].
+@return		: none.
+*/
+void MotionEstimatorH264ImplMultiRef::SetQP(int qp)
+{
+	if(qp < 0)	qp = 0;
+	if(qp > 51) qp = 51;
+	_qp			= qp;
+	_lambda = (int)((0.85 * pow(2.0, (double)(qp - 12)/3.0)) + 0.5);
+	if(_lambda < 1)
+		_lambda = 1;
+}//end SetQP.
+
+/** Motion estimate the source within the reference store.
+Every reference is searched on a full pel grid followed by a 1/2 and then 1/4 
+pel refinement, all ranked by the cost J = D + lambda x R where R is the bits of
+the vector difference from the prediction and of the reference index. Reference 
+0 (and every reference in exhaustive mode) starts from a level 1 coarse full 
+search. In pruned mode the older references start only from the zero, predicted 
+and the reference 0 full pel vector scaled by the temporal distance. They are 
+not searched at all when reference 0 is within the quantisation noise and the 
+search stops at the first reference that did not improve on the one before it.
+@param avgDistortion  : Return the motion compensated distortion.
+@return				        : The list of motion vectors.
+*/
+void* MotionEstimatorH264ImplMultiRef::Estimate(long* avgDistortion)
+{
+	if(_pStore->IsPel8())
+		return(EstimatePels<OverlayMem2Dv2u8, OverlayMem2Dv2u8>(_pInOver8, _pInL1Over8, _pMBlkOver8, avgDistortion));
+	return(EstimatePels<OverlayMem2Dv2, OverlayExtMem2Dv2>(_pInOver, _pInL1Over, _pMBlkOver, avgDistortion));
+}//end Estimate.
+
+/** The search on the input and store overlays of one pel type.
+@param pIn						: Level 0 input overlay with the motion block dim.
+@param pInL1					: Level 1 input overlay with the level 1 motion block dim.
+@param pMBlk					: Motion block temp overlay.
+@param avgDistortion  : Return the motion compensated distortion.
+@return				        : The list of motion vectors.
+*/
+template<class TIn, class TRef> void* MotionEstimatorH264ImplMultiRef::EstimatePels(TIn* pIn, TIn* pInL1, TIn* pMBlk, long* avgDistortion)
+{
+  int		m, n, p, q, r, x;
+  int		included = 0;
+  long	totalDifference = 0;
+
+  /// Set the motion vector struct storage structure.
+  int		maxLength = _pMotionVectorStruct->GetLength();
+  int		vecPos = 0;
+
+	int numRefs = _pStore->GetNumRefs();
+	if(numRefs > _maxRefs)
+		numRefs = _maxRefs;
+	if( (_mode == 1)&&(numRefs > 1) )
+		numRefs = 1;
+	_searchCount = 0;
+
+	/// Level 1 input for the coarse search. The refs are subsampled in the store.
+	TIn::Half( (void **)(pIn->Get2DSrcPtr()), _imgWidth, _imgHeight, (void **)(pInL1->Get2DSrcPtr()) );
+
+	/// Square error of the quantisation noise below which older refs can not do better.
+	int noiseFloor = H264StaticMbDetector::GetThreshold(_qp);
+
+  /// m,n step level 0 vec dim = _macroBlkHeight, _macroBlkWidth.
+	/// p,q step level 1 vec dim = _macroBlkHeight/2, _macroBlkWidth/2.
+  for (m = 0, p = 0; m < _imgHeight; m += _macroBlkHeight, p += _macroBlkHeight/2)
+    for (n = 0, q = 0; n < _imgWidth; n += _macroBlkWidth, q += _macroBlkWidth/2)
+    {
+			int bestRef		= 0;
+			int bestMvx		= 0;	///< 1/4 pel units.
+			int bestMvy		= 0;
+			int bestDist	= 0;
+			int bestCost	= INT_MAX;
+
+			int predX, predY, predX0, predY0;
+			_pMVPred->Get16x16Prediction(NULL, vecPos, &predX, &predY);
+			predX0 = (predX < 0) ? ((predX - 2)/4) : ((predX + 2)/4);	///< Nearest full pel pred vector.
+			predY0 = (predY < 0) ? ((predY - 2)/4) : ((predY + 2)/4);
+
+			int rng[4];
+			GetMotionRange(n, m, &(rng[0]), &(rng[1]), &(rng[2]), &(rng[3]), 0);
+
+      pIn->SetOrigin(n, m);
+			pInL1->SetOrigin(q, p);
+
+			int ref0X		= 0;	///< Ref 0 full pel winner.
+			int ref0Y		= 0;
+			int ref0Dist	= 0;
+			for(r = 0; r < numRefs; r++)
+			{
+				/// Pruning from the ref 0 result.
+				if( (r > 0)&&(_mode == 0) )
+				{
+					if(ref0Dist <= noiseFloor)
+						break;
+					if( (r > 1)&&(bestRef < (r - 1)) )
+						break;
+				}//end if r...
+
+				TRef* pRef;
+				TRef* pRefL1;
+				GetStoreRefs(_pStore, r, &pRef, &pRefL1);
+				int refBits	= RefBits(r, numRefs);
+				int cost	= INT_MAX;
+				int dist	= 0;
+				int mx		= 0;
+				int my		= 0;
+				_searchCount++;
+
+	      ///--------------------------- Full pel candidates ---------------------------------------------
+				TestCandidate(pIn, pRef, n, m, 0, 0, rng, predX, predY, refBits, &cost, &dist, &mx, &my);
+				TestCandidate(pIn, pRef, n, m, predX0, predY0, rng, predX, predY, refBits, &cost, &dist, &mx, &my);
+				if( (r == 0)||(_mode == 2) )
+				{
+					int cx, cy;
+					CoarseSearch(pInL1, pRefL1, q, p, predX0, predY0, &cx, &cy);
+					TestCandidate(pIn, pRef, n, m, cx, cy, rng, predX, predY, refBits, &cost, &dist, &mx, &my);
+				}//end if r...
+				if(r > 0)
+					TestCandidate(pIn, pRef, n, m, ref0X * (r + 1), ref0Y * (r + 1), rng, predX, predY, refBits, &cost, &dist, &mx, &my);
+
+	      ///--------------------------- Full pel small diamond refinement -------------------------------
+				for(int step = 0; step < MEH264IMR_DIAMOND_STEPS; step++)
+				{
+					int cx = mx;
+					int cy = my;
+					for(x = 0; x < MEH264IMR_MOTION_CROSS_POS_LENGTH; x++)
+						TestCandidate(pIn, pRef, n, m, cx + MEH264IMR_CrossPosX[x], cy + MEH264IMR_CrossPosY[x], rng, predX, predY, refBits, &cost, &dist, &mx, &my);
+					if( (mx == cx)&&(my == cy) )
+						break;
+				}//end for step...
+
+				if(r == 0)
+				{
+					ref0X = mx;
+					ref0Y = my;
+				}//end if r...
+
+	      ///--------------------------- 1/2 then 1/4 pel refinement -------------------------------------
+				int mvx = mx << 2;
+				int mvy = my << 2;
+				pRef->SetOrigin(n + mx, m + my);
+				for(int sub = 2; sub > 0; sub >>= 1)	///< 1/2 pel positions then 1/4 pel positions.
+				{
+					int cx = mvx - (mx << 2);	///< Winning centre offset from the full pel position.
+					int cy = mvy - (my << 2);
+					for(x = 0; x < MEH264IMR_MOTION_SUB_POS_LENGTH; x++)
+					{
+						int ox = cx + (sub * MEH264IMR_SubPosX[x]);
+						int oy = cy + (sub * MEH264IMR_SubPosY[x]);
+						int rate = _lambda * (SeBits((mx << 2) + ox - predX) + SeBits((my << 2) + oy - predY) + refBits);
+						if(rate >= cost)
+							continue;
+
+						pRef->QuarterRead(*pMBlk, ox, oy);
+						int blkDiff = pIn->Tsd16x16LessThan(*pMBlk, cost - rate);
+						if( (blkDiff + rate) < cost )
+						{
+							cost	= blkDiff + rate;
+							dist	= blkDiff;
+							mvx		= (mx << 2) + ox;
+							mvy		= (my << 2) + oy;
+						}//end if blkDiff...
+					}//end for x...
+				}//end for sub...
+
+				if(r == 0)
+					ref0Dist = dist;
+
+				if(cost < bestCost)
+				{
+					bestCost	= cost;
+					bestDist	= dist;
+					bestMvx		= mvx;
+					bestMvy		= mvy;
+					bestRef		= r;
+				}//end if cost...
+			}//end for r...
+
+	    /// Check for inclusion in the distortion calculation.
+		  if(_pDistortionIncluded != NULL)
+			{
+				if(_pDistortionIncluded[vecPos])
+				{
+					included++;
+					totalDifference += bestDist;
+				}//end if _pDistortionIncluded...
+			}//end if _pDistortionIncluded...
+
+			/// Load the selected vector coord and its ref.
+			if(vecPos < maxLength)
+			{
+				_pMotionVectorStruct->SetSimpleElement(vecPos, 0, bestMvx);
+				_pMotionVectorStruct->SetSimpleElement(vecPos, 1, bestMvy);
+				_pRefIdx[vecPos] = bestRef;
+	      /// Set macroblock vector for future predictions.
+		    _pMVPred->Set16x16MotionVector(vecPos, bestMvx, bestMvy, bestDist);
+				vecPos++;
+			}//end if vecPos...
+
+		}//end for m & n...
+
+	/// In this context avg distortion is actually avg difference.
+	if(included)	///< Prevent divide by zero error.
+		*avgDistortion = totalDifference/included;
+	else
+		*avgDistortion = 0;
+	return((void *)_pMotionVectorStruct);
+
+}//end EstimatePels.
+
+/*
+--------------------------------------------------------------------------
+  Private methods. 
+--------------------------------------------------------------------------
+*/
+
+void MotionEstimatorH264ImplMultiRef::Destroy(void)
+{
+	_ready = 0;
+
+	if(_pInOver != NULL)
+		delete _pInOver;
+	_pInOver = NULL;
+
+	if(_pInL1Over != NULL)
+		delete _pInL1Over;
+	_pInL1Over = NULL;
+	if(_pInL1 != NULL)
+		delete[] _pInL1;
+	_pInL1 = NULL;
+
+	if(_pMBlk != NULL)
+		delete[] _pMBlk;
+	_pMBlk = NULL;
+
+	if(_pMBlkOver != NULL)
+		delete _pMBlkOver;
+	_pMBlkOver = NULL;
+
+	if(_pInOver8 != NULL)
+		delete _pInOver8;
+	_pInOver8 = NULL;
+	if(_pInL1Over8 != NULL)
+		delete _pInL1Over8;
+	_pInL1Over8 = NULL;
+	if(_pInL18 != NULL)
+		PlanePool::Shared()->Release(_pInL18);
+	_pInL18 = NULL;
+	if(_pMBlkOver8 != NULL)
+		delete _pMBlkOver8;
+	_pMBlkOver8 = NULL;
+	if(_pMBlk8 != NULL)
+		delete[] _pMBlk8;
+	_pMBlk8 = NULL;
+
+	if(_pMotionVectorStruct != NULL)
+		delete _pMotionVectorStruct;
+	_pMotionVectorStruct = NULL;
+
+	if(_pRefIdx != NULL)
+		delete[] _pRefIdx;
+	_pRefIdx = NULL;
+
+}//end Destroy.
+
+/** Get the allowed motion vector limits for this block.
+The block may lie wholly within the extended boundary of the level but the
+vector is further limited to the motion range scaled to the level.
+@param x			: X coord of the block at the level.
+@param y			: Y coord of the block at the level.
+@param xlr		: Returned left vector limit.
+@param xrr		: Returned right vector limit.
+@param yur		: Returned up vector limit.
+@param ydr		: Returned down vector limit.
+@param level	: 0 = full resolution, 1 = half resolution.
+@return				: none.
+*/
+void MotionEstimatorH264ImplMultiRef::GetMotionRange(int  x,		int  y,
+																										 int* xlr,	int* xrr, 
+																										 int* yur,	int* ydr,
+																										 int	level)
+{
+	int range		= (_motionRange/4) >> level;	///< Convert 1/4 pel range to full pel units at the level.
+	int blkW		= _macroBlkWidth >> level;
+	int blkH		= _macroBlkHeight >> level;
+	int width		= _imgWidth >> level;
+	int height	= _imgHeight >> level;
+
+	*xlr = ((x + blkW) < range) ? -(x + blkW) : -range;
+	*xrr = ((width - x) < (range - 1)) ? (width - x) : (range - 1);
+	*yur = ((y + blkH) < range) ? -(y + blkH) : -range;
+	*ydr = ((height - y) < (range - 1)) ? (height - y) : (range - 1);
+}//end GetMotionRange.
+
+/** Level 1 full search for a coarse vector.
+Equal distortions are resolved in favour of the vector nearest the prediction.
+@param pInL1	: Level 1 input.
+@param pRefL1	: Level 1 ref.
+@param q			: Level 1 block coords.
+@param p			:
+@param predX0	: Full pel level 0 predicted vector.
+@param predY0	:
+@param cx			: Returned coarse vector in level 0 full pel units.
+@param cy			:
+@return				: none.
+*/
+template<class TIn, class TRef> void MotionEstimatorH264ImplMultiRef::CoarseSearch(TIn* pInL1, TRef* pRefL1, int q, int p, int predX0, int predY0, int* cx, int* cy)
+{
+	int xl, xr, yu, yd, i, j;
+	GetMotionRange(q, p, &xl, &xr, &yu, &yd, 1);
+
+	int predX1 = predX0/2;
+	int predY1 = predY0/2;
+	int mx = 0;
+	int my = 0;
+	pRefL1->SetOrigin(q, p);
+	int minDiff = pInL1->Tsd8x8(*pRefL1);
+
+	for(i = yu; i <= yd; i++)
+	{
+		for(j = xl; j <= xr; j++)
+		{
+			if( !(i||j) ) continue;
+
+			pRefL1->SetOrigin(q + j, p + i);
+			int blkDiff = pInL1->Tsd8x8LessThan(*pRefL1, minDiff);
+			if(blkDiff <= minDiff)
+			{
+				if(blkDiff == minDiff)
+				{
+					int currX = mx - predX1;
+					int currY = my - predY1;
+					int newX	= j - predX1;
+					int newY	= i - predY1;
+					if( ((newX*newX) + (newY*newY)) >= ((currX*currX) + (currY*currY)) )
+						continue;
+				}//end if blkDiff...
+				minDiff = blkDiff;
+				mx			= j;
+				my			= i;
+			}//end if blkDiff...
+		}//end for j...
+	}//end for i...
+
+	*cx = mx << 1;
+	*cy = my << 1;
+}//end CoarseSearch.
+
+template<class TIn, class TRef> int MotionEstimatorH264ImplMultiRef::TestCandidate(TIn* pIn, TRef* pRef, int n, int m, int x, int y, int* rng, 
+																																									 int predX, int predY, int refBits,
+																																									 int* bestCost, int* bestDist, int* bestX, int* bestY)
+{
+	if( (x < rng[0])||(x > rng[1])||(y < rng[2])||(y > rng[3]) )
+		return(0);
+
+	int rate = _lambda * (SeBits((x << 2) - predX) + SeBits((y << 2) - predY) + refBits);
+	if(rate >= *bestCost)
+		return(0);
+
+	pRef->SetOrigin(n + x, m + y);
+	int blkDiff = pIn->Tsd16x16LessThan(*pRef, *bestCost - rate);
+	if( (blkDiff + rate) >= *bestCost )
+		return(0);
+
+	*bestCost = blkDiff + rate;
+	*bestDist = blkDiff;
+	*bestX		= x;
+	*bestY		= y;
+	return(1);
+}//end TestCandidate.
+
+int MotionEstimatorH264ImplMultiRef::UeBits(int v)
+{
+	int bits = 1;
+	for(v++; v > 1; v >>= 1)
+		bits += 2;
+	return(bits);
+}//end UeBits.
+
+int MotionEstimatorH264ImplMultiRef::SeBits(int v)
+{
+	return(UeBits((v > 0) ? ((2 * v) - 1) : (-2 * v)));
+}//end SeBits.
+
+/// The ref index is te(v) coded: nothing for 1 ref, 1 bit for 2 refs and ue(v) otherwise.
+int MotionEstimatorH264ImplMultiRef::RefBits(int refIdx, int numRefs)
+{
+	if(numRefs < 2)
+		return(0);
+	if(numRefs == 2)
+		return(1);
+	return(UeBits(refIdx));
+}//end RefBits.
+
@@ -309,7 +309,7 @@ int MotionEstimatorH264ImplMultiresCross::Create(void)
 	_extBoundary = _macroBlkWidth + MEH264IMC_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH264IMC_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																				_imgWidth,						
 																				_imgHeight, 
 																				_extBoundary,	///< Extend left and right by...
@@ -360,7 +360,7 @@ int MotionEstimatorH264ImplMultiresCross::Create(void)
 	_extL1Boundary = _l1MacroBlkWidth + MEH264IMC_L1_PADDING;
 	if(_l1MacroBlkHeight > _l1MacroBlkWidth)
 		_extL1Boundary = _l1MacroBlkHeight + MEH264IMC_L1_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL1, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL1, 
 																				_l1Width,						
 																				_l1Height, 
 																				_extL1Boundary,
@@ -410,7 +410,7 @@ int MotionEstimatorH264ImplMultiresCross::Create(void)
 	_extL2Boundary = _l2MacroBlkWidth + MEH264IMC_L2_PADDING;
 	if(_l2MacroBlkHeight > _l2MacroBlkWidth)
 		_extL2Boundary = _l2MacroBlkHeight + MEH264IMC_L2_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL2, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL2, 
 																				_l2Width,						
 																				_l2Height, 
 																				_extL2Boundary,
@@ -1060,7 +1060,7 @@ void MotionEstimatorH264ImplMultiresCross::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
@@ -1076,7 +1076,7 @@ void MotionEstimatorH264ImplMultiresCross::Destroy(void)
 	_pRefL1Over	= NULL;
 
 	if(_pExtRefL1 != NULL)
-		delete[] _pExtRefL1;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL1);
 	_pExtRefL1 = NULL;
 
 	if(_pExtRefL1Over != NULL)
@@ -1092,7 +1092,7 @@ void MotionEstimatorH264ImplMultiresCross::Destroy(void)
 	_pRefL2Over	= NULL;
 
 	if(_pExtRefL2 != NULL)
-		delete[] _pExtRefL2;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL2);
 	_pExtRefL2 = NULL;
 
 	if(_pExtRefL2Over != NULL)
@@ -156,6 +156,7 @@ void MotionEstimatorH264ImplMultiresCrossVer2::ResetMembers(void)
 {
 	_ready	= 0;	///< Ready to estimate.
 	_mode		= 1;	///< Speed mode or whatever. Default to slower speed.
+	_autoMode	= false;
 
 	/// Parameters must remain const for the life time of this instantiation.
 	_imgWidth				= 0;					///< Width of the src and ref images. 
@@ -192,6 +193,9 @@ void MotionEstimatorH264ImplMultiresCrossVer2::ResetMembers(void)
 	_extHeight				= 0;
 	_extBoundary			= 0;
 	_pExtRefOver			= NULL;			///< Extended ref overlay with motion block dim.
+	/// Static macroblock pre-pass is off by default.
+	_staticMbSkip			= false;
+	_staticMbQP				= 26;
 	/// Level 1: Subsampled ref by 2.
 	_pRefL1						= NULL;			///< Ref mem at (_l1Width * _l1Height).
 	_pRefL1Over				= NULL; 		///< Ref overlay with whole level 1 block dim.
@@ -323,7 +327,7 @@ int MotionEstimatorH264ImplMultiresCrossVer2::Create(void)
 	_extBoundary = _macroBlkWidth + MEH264IMCV2_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH264IMCV2_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																				_imgWidth,						
 																				_imgHeight, 
 																				_extBoundary,	///< Extend left and right by...
@@ -351,6 +355,21 @@ int MotionEstimatorH264ImplMultiresCrossVer2::Create(void)
 	  return(0);
   }//end if !_pExtRefOver...
 
+	/// Static macroblock classification for the pre-pass.
+	if(!_staticMb.Create(_imgWidth, _imgHeight))
+  {
+		Destroy();
+	  return(0);
+  }//end if !Create...
+
+	/// Search statistics for the auto mode measured against the level 1 reach in level 0 pels.
+	if(!_searchStats.Create(_imgWidth/_macroBlkWidth, _imgHeight/_macroBlkHeight))
+  {
+		Destroy();
+	  return(0);
+  }//end if !Create...
+	_searchStats.SetReach(2 * _l1MotionRange);
+
 	/// Level 1: Ref mem at (_l1Width * _l1Height).
 	_pRefL1 = new short[_l1Width * _l1Height];
 
@@ -374,7 +393,7 @@ int MotionEstimatorH264ImplMultiresCrossVer2::Create(void)
 	_extL1Boundary = _l1MacroBlkWidth + MEH264IMCV2_L1_PADDING;
 	if(_l1MacroBlkHeight > _l1MacroBlkWidth)
 		_extL1Boundary = _l1MacroBlkHeight + MEH264IMCV2_L1_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL1, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL1, 
 																				_l1Width,						
 																				_l1Height, 
 																				_extL1Boundary,
@@ -424,7 +443,7 @@ int MotionEstimatorH264ImplMultiresCrossVer2::Create(void)
 	_extL2Boundary = _l2MacroBlkWidth + MEH264IMCV2_L2_PADDING;
 	if(_l2MacroBlkHeight > _l2MacroBlkWidth)
 		_extL2Boundary = _l2MacroBlkHeight + MEH264IMCV2_L2_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL2, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL2, 
 																				_l2Width,						
 																				_l2Height, 
 																				_extL2Boundary,
@@ -500,14 +519,16 @@ int MotionEstimatorH264ImplMultiresCrossVer2::Create(void)
 
 void	MotionEstimatorH264ImplMultiresCrossVer2::Reset(void)
 {
+	_searchStats.Reset();
 }//end Reset.
 
 /** Set the speed mode.
 This is a multresolution algorithm and the speed is increased by estimating
 at lower levels but it is less accurate. Mode = 1 implies level 1 and mode = 2
-for level 2. Mode = 0 is auto mode that selects an appropriate mode depending
-on the resolution of the image. The selection is set to 2 if the image has
-an area larger than 200x200.
+for level 2. Mode = 0 is auto mode that starts with a mode depending on the 
+resolution of the image, set to 2 if the image has an area larger than 200x200.
+Thereafter the level adapts after every frame to the spread of the estimated 
+vectors relative to the level 1 search reach.
 
 @param pRef		: Ref to estimate with.
 @return				: The list of motion vectors.
@@ -521,9 +542,13 @@ void	MotionEstimatorH264ImplMultiresCrossVer2::SetMode(int mode)
 			_mode = 2;
 		else
 			_mode = 1;
+		_autoMode = true;
 	}//end if mode...
 	else
-		_mode = mode;
+	{
+		_mode			= mode;
+		_autoMode = false;
+	}//end else...
 }//end SetMode.
 
 /** Motion estimate the source within the reference.
@@ -558,6 +583,10 @@ void* MotionEstimatorH264ImplMultiresCrossVer2::Estimate(long* avgDistortion)
 	_pExtRefOver->FillBoundaryProxy();
 	_pExtRefOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
 
+	/// Classify the static macroblocks that bypass the search.
+	if(_staticMbSkip)
+		_staticMb.Classify((const short *)_pInput, (const short *)_pRef, _staticMbQP);
+
 	/// Subsample level 0 ref (_pRefOver) to produce level 1 ref (_pRefL1Over).
 	OverlayMem2Dv2::Half( (void **)(_pRefOver->Get2DSrcPtr()),			///< Src 2D ptr.
 												_imgWidth, 																///< Src width.
@@ -607,6 +636,25 @@ void* MotionEstimatorH264ImplMultiresCrossVer2::Estimate(long* avgDistortion)
   for(m = 0, p = 0, k = 0; m < _imgHeight; m += _macroBlkHeight, p += _l1MacroBlkHeight, k += _l2MacroBlkHeight)
 		for(n = 0, q = 0, l = 0; n < _imgWidth; n += _macroBlkWidth, q += _l1MacroBlkWidth, l += _l2MacroBlkWidth)
   {
+		/// Static macroblocks from the pre-pass take the zero vector without a search.
+		if(_staticMbSkip && _staticMb.IsStatic(vecPos))
+		{
+			int zeroVecDiff = _staticMb.GetZeroVecDistortion(vecPos);
+			if( (_pDistortionIncluded != NULL) && _pDistortionIncluded[vecPos] )
+			{
+				included++;
+				totalDifference += zeroVecDiff;
+			}//end if _pDistortionIncluded...
+			if(vecPos < maxLength)
+			{
+				_pMotionVectorStruct->SetSimpleElement(vecPos, 0, 0);
+				_pMotionVectorStruct->SetSimpleElement(vecPos, 1, 0);
+				_pMVPred->Set16x16MotionVector(vecPos, 0, 0);
+				vecPos++;
+			}//end if vecPos...
+			continue;
+		}//end if _staticMbSkip...
+
 		int mx	= 0;	///< Full pel grid.
 		int my	= 0;
 		int hmx	= 0;	///< 1/2 pel on 1/4 pel grid.
@@ -1128,6 +1176,10 @@ void* MotionEstimatorH264ImplMultiresCrossVer2::Estimate(long* avgDistortion)
 				totalDifference += zeroVecDiff;
 		}//end else...
 */
+		/// Record the vector spread for the auto mode.
+		if(_autoMode)
+			_searchStats.Add(vecPos, (int)_distVector.GetItem(vpos), mvx, mvy);
+
 		/// Load the selected vector coord.
 		if(vecPos < maxLength)
 		{
@@ -1140,6 +1192,13 @@ void* MotionEstimatorH264ImplMultiresCrossVer2::Estimate(long* avgDistortion)
 
   }//end for m & n...
 
+	/// Choose the level for the next frame.
+	if(_autoMode)
+	{
+		_searchStats.Update();
+		_mode = _searchStats.GetSearchLevel(_mode);
+	}//end if _autoMode...
+
 	/// In this context avg distortion is actually avg difference.
 //	*avgDistortion = totalDifference/maxLength;
 	if(included)	///< Prevent divide by zero error.
@@ -1188,6 +1247,10 @@ void* MotionEstimatorH264ImplMultiresCrossVer2::Estimate(long* avgDistortion, vo
 	_pExtRefOver->FillBoundaryProxy();
 	_pExtRefOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
 
+	/// Classify the static macroblocks that bypass the search.
+	if(_staticMbSkip)
+		_staticMb.Classify((const short *)_pInput, (const short *)_pRef, _staticMbQP);
+
 	/// Subsample level 0 ref (_pRefOver) to produce level 1 ref (_pRefL1Over).
 	OverlayMem2Dv2::Half( (void **)(_pRefOver->Get2DSrcPtr()),			///< Src 2D ptr.
 												_imgWidth, 																///< Src width.
@@ -1237,6 +1300,25 @@ void* MotionEstimatorH264ImplMultiresCrossVer2::Estimate(long* avgDistortion, vo
   for(m = 0, p = 0, k = 0; m < _imgHeight; m += _macroBlkHeight, p += _l1MacroBlkHeight, k += _l2MacroBlkHeight)
 		for(n = 0, q = 0, l = 0; n < _imgWidth; n += _macroBlkWidth, q += _l1MacroBlkWidth, l += _l2MacroBlkWidth)
   {
+		/// Static macroblocks from the pre-pass take the zero vector without a search.
+		if(_staticMbSkip && _staticMb.IsStatic(vecPos))
+		{
+			int zeroVecDiff = _staticMb.GetZeroVecDistortion(vecPos);
+			if( (_pDistortionIncluded != NULL) && _pDistortionIncluded[vecPos] )
+			{
+				included++;
+				totalDifference += zeroVecDiff;
+			}//end if _pDistortionIncluded...
+			if(vecPos < maxLength)
+			{
+				_pMotionVectorStruct->SetSimpleElement(vecPos, 0, 0);
+				_pMotionVectorStruct->SetSimpleElement(vecPos, 1, 0);
+				_pMVPred->Set16x16MotionVector(vecPos, 0, 0);
+				vecPos++;
+			}//end if vecPos...
+			continue;
+		}//end if _staticMbSkip...
+
 		int mx	= 0;	///< Full pel grid.
 		int my	= 0;
 		int hmx	= 0;	///< 1/2 pel on 1/4 pel grid.
@@ -1721,6 +1803,10 @@ void* MotionEstimatorH264ImplMultiresCrossVer2::Estimate(long* avgDistortion, vo
       }//end if _pDistortionIncluded...
     }//end if _pDistortionIncluded...
 
+		/// Record the vector spread for the auto mode.
+		if(_autoMode)
+			_searchStats.Add(vecPos, (int)_distVector.GetItem(vpos), mvx, mvy);
+
 		/// Load the selected vector coord.
 		if(vecPos < maxLength)
 		{
@@ -1733,6 +1819,13 @@ void* MotionEstimatorH264ImplMultiresCrossVer2::Estimate(long* avgDistortion, vo
 
   }//end for m & n...
 
+	/// Choose the level for the next frame.
+	if(_autoMode)
+	{
+		_searchStats.Update();
+		_mode = _searchStats.GetSearchLevel(_mode);
+	}//end if _autoMode...
+
 	/// In this context avg distortion is actually avg difference.
 	if(included)	///< Prevent divide by zero error.
 		*avgDistortion = totalDifference/included;
@@ -1784,13 +1877,16 @@ void MotionEstimatorH264ImplMultiresCrossVer2::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
 		delete _pExtRefOver;
 	_pExtRefOver = NULL;
 
+	_staticMb.Destroy();
+	_searchStats.Destroy();
+
 	if(_pRefL1 != NULL)
 		delete[] _pRefL1;
 	_pRefL1	= NULL;
@@ -1800,7 +1896,7 @@ void MotionEstimatorH264ImplMultiresCrossVer2::Destroy(void)
 	_pRefL1Over	= NULL;
 
 	if(_pExtRefL1 != NULL)
-		delete[] _pExtRefL1;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL1);
 	_pExtRefL1 = NULL;
 
 	if(_pExtRefL1Over != NULL)
@@ -1816,7 +1912,7 @@ void MotionEstimatorH264ImplMultiresCrossVer2::Destroy(void)
 	_pRefL2Over	= NULL;
 
 	if(_pExtRefL2 != NULL)
-		delete[] _pExtRefL2;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL2);
 	_pExtRefL2 = NULL;
 
 	if(_pExtRefL2Over != NULL)
@@ -0,0 +1,1074 @@
+/** @file
+
+MODULE				: MotionEstimatorH264ImplPartition
+
+TAG						: MEH264IP
+
+FILE NAME			: MotionEstimatorH264ImplPartition.cpp
+
+DESCRIPTION		: A partition aware full search motion estimator implementation
+								for Recommendation H.264 (03/2005). For every candidate
+								position a grid of sixteen 4x4 block distortions is measured
+								once and summed into the 16x16, 16x8, 8x16 and 8x8 partition
+								costs, tracking the best vector per partition in the same
+								search. Access is via an IMotionEstimator interface and the
+								vectors are returned in a COMPLEX2D VectorStructList.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include	"MotionEstimatorH264ImplPartition.h"
+#include	"MacroBlockH264.h"
+#include	"PlanePool.h"
+
+/*
+--------------------------------------------------------------------------
+  Constants. 
+--------------------------------------------------------------------------
+*/
+/// Boundary padding past the motion vector extremes. Required for calculating
+/// sub-pixel interpolations. 
+#define MEH264IP_PADDING													3	
+
+/// Choose between sqr err distortion or abs diff metric.
+#undef MEH264IP_ABS_DIFF
+
+/// Mode decision cost added per additional partition vector. Calc = 16[vec dim] * 16[vec dim] * 2.
+#define MEH264IP_PARTITION_PENALTY							512
+
+/// Search range coords for centre motion vectors.
+#define MEH264IP_MOTION_SUB_POS_LENGTH 	8
+static const int MEH264IP_SubPosX[MEH264IP_MOTION_SUB_POS_LENGTH]	= { -1, 0, 1,-1, 1,-1, 0, 1 };
+static const int MEH264IP_SubPosY[MEH264IP_MOTION_SUB_POS_LENGTH]	= { -1,-1,-1, 0, 0, 1, 1, 1 };
+
+/*
+--------------------------------------------------------------------------
+  Macros. 
+--------------------------------------------------------------------------
+*/
+#define MEH264IP_CLIP255(x)	( (((x) <= 255)&&((x) >= 0))? (x) : ( ((x) < 0)? 0:255 ) )
+
+/*
+--------------------------------------------------------------------------
+  Construction. 
+--------------------------------------------------------------------------
+*/
+
+MotionEstimatorH264ImplPartition::MotionEstimatorH264ImplPartition(	const void*             pSrc, 
+																													const void*             pRef, 
+																													int					            imgWidth, 
+																													int					            imgHeight,
+																													int					            motionRange,
+                                                          IMotionVectorPredictor* pMVPred)
+{
+	ResetMembers();
+
+	/// Parameters must remain const for the life time of this instantiation.
+	_imgWidth				= imgWidth;					///< Width of the src and ref images. 
+	_imgHeight			= imgHeight;				///< Height of the src and ref images.
+	_macroBlkWidth	= 16;								///< Width of the motion block = 16 for H.264.
+	_macroBlkHeight	= 16;								///< Height of the motion block = 16 for H.264.
+	_motionRange		= motionRange;			///< (4x,4y) range of the motion vectors. _motionRange in 1/4 pel units.
+	_pInput					= pSrc;
+	_pRef						= pRef;
+  _pMVPred        = pMVPred;
+
+}//end constructor.
+
+MotionEstimatorH264ImplPartition::MotionEstimatorH264ImplPartition(	const void*             pSrc, 
+																													const void*             pRef, 
+																													int					            imgWidth, 
+																													int					            imgHeight,
+																													int					            motionRange,
+                                                          IMotionVectorPredictor* pMVPred,
+																													void*				            pDistortionIncluded)
+{
+	ResetMembers();
+
+	/// Parameters must remain const for the life time of this instantiation.
+	_imgWidth							= imgWidth;					///< Width of the src and ref images. 
+	_imgHeight						= imgHeight;				///< Height of the src and ref images.
+	_macroBlkWidth				= 16;								///< Width of the motion block = 16 for H.264.
+	_macroBlkHeight				= 16;								///< Height of the motion block = 16 for H.264.
+	_motionRange					= motionRange;			///< (4x,4y) range of the motion vectors. _motionRange in 1/4 pel units.
+	_pInput								= pSrc;
+	_pRef									= pRef;
+  _pMVPred              = pMVPred;
+	_pDistortionIncluded	= (bool *)pDistortionIncluded;
+
+}//end constructor.
+
+void MotionEstimatorH264ImplPartition::ResetMembers(void)
+{
+	_ready	= 0;	///< Ready to estimate.
+	_mode		= 1;	///< Speed mode or whatever. Default to slower speed.
+
+	/// Parameters must remain const for the life time of this instantiation.
+	_imgWidth				= 0;					///< Width of the src and ref images. 
+	_imgHeight			= 0;					///< Height of the src and ref images.
+	_macroBlkWidth	= 16;					///< Width of the motion block = 16 for H.264.
+	_macroBlkHeight	= 16;					///< Height of the motion block = 16 for H.264.
+	_motionRange		= 64;					///< (4x,4y) range of the motion vectors.
+	_pInput					= NULL;
+	_pRef						= NULL;
+
+	/// Input mem overlay members.
+	_pInOver					= NULL;			///< Input overlay with mb motion block dim.
+	/// Ref mem overlay members.
+	_pRefOver					= NULL;			///< Ref overlay with whole block dim.
+	_pExtRef					= NULL;			///< Extended ref mem created by ExtendBoundary() call.
+	_extWidth					= 0;
+	_extHeight				= 0;
+	_extBoundary			= 0;
+	_pExtRefOver			= NULL;			///< Extended ref overlay with motion block dim.
+	/// 16-bit src and ref planes by default.
+	_pel8							= false;
+	_pInOver8					= NULL;
+	_pRefOver8				= NULL;
+	_pExtRef8					= NULL;
+	_pExtRefOver8			= NULL;
+  /// A 1/4 pel refinement window.
+	_pWin							= NULL;
+	_Win							= NULL;
+
+	/// Temp working block and its overlay.
+	_pMBlk						= NULL;			///< Motion block temp mem.
+	_pMBlkOver				= NULL;			///< Motion block overlay of temp mem.
+	_pMBlk8						= NULL;
+	_pMBlkOver8				= NULL;
+
+	/// Hold the resulting partition motion vectors.
+	_pMotionVectorStruct = NULL;
+	_pPartDist					 = NULL;
+  /// Attached motion vector predictor on construction.
+  _pMVPred          = NULL;
+
+  /// A flag per macroblock to include it in the distortion accumulation.
+	_pDistortionIncluded = NULL;
+
+}//end ResetMembers.
+
+MotionEstimatorH264ImplPartition::~MotionEstimatorH264ImplPartition(void)
+{
+	Destroy();
+}//end destructor.
+
+/*
+--------------------------------------------------------------------------
+  Public IMotionEstimator Interface. 
+--------------------------------------------------------------------------
+*/
+
+int MotionEstimatorH264ImplPartition::Create(void)
+{
+	/// Clean out old mem.
+	Destroy();
+
+	/// The extended ref boundary is the max dimension of the macroblock plus some padding
+  /// to cater for quarter pel searches on the edges of the boundary.
+	_extBoundary = _macroBlkWidth + MEH264IP_PADDING;
+	if(_macroBlkHeight > _macroBlkWidth)
+		_extBoundary = _macroBlkHeight + MEH264IP_PADDING;
+	_extWidth	 = _imgWidth + (2 * _extBoundary);
+	_extHeight = _imgHeight + (2 * _extBoundary);
+
+	if(_pel8)
+	{
+		/// --------------- Configure 8-bit overlays ----------------------------
+		/// The input and ref lum planes are overlaid directly. The extended ref is
+		/// borrowed from the shared pool with padded rows.
+		int extStride = 0;
+		_pExtRef8 = (unsigned char *)PlanePool::Shared()->Acquire(_extWidth, _extHeight, sizeof(unsigned char), 1, &extStride);
+		if(_pExtRef8 == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end if !_pExtRef8...
+		_pInOver8			= new OverlayMem2Dv2u8((void *)_pInput, _imgWidth, _imgHeight, _macroBlkWidth, _macroBlkHeight);
+		_pRefOver8		= new OverlayMem2Dv2u8((void *)_pRef, _imgWidth, _imgHeight, _imgWidth, _imgHeight);
+		_pExtRefOver8	= new OverlayMem2Dv2u8(_pExtRef8, _extWidth, _extHeight, _macroBlkWidth, _macroBlkHeight, _extBoundary, _extBoundary, extStride);
+		_pMBlk8				= new unsigned char[_macroBlkWidth * _macroBlkHeight];
+		_pMBlkOver8		= new OverlayMem2Dv2u8(_pMBlk8, _macroBlkWidth, _macroBlkHeight, _macroBlkWidth, _macroBlkHeight);
+		if( (_pInOver8 == NULL)||(_pRefOver8 == NULL)||(_pExtRefOver8 == NULL)||(_pMBlk8 == NULL)||(_pMBlkOver8 == NULL) )
+		{
+			Destroy();
+			return(0);
+		}//end if !_pInOver8...
+	}//end if _pel8...
+	else
+	{
+		/// --------------- Configure input overlays --------------------------------
+		/// Put an overlay on the input image with the block size set to the mb vector 
+		/// dim. This is used to access input vectors.
+		_pInOver = new OverlayMem2Dv2((void *)_pInput,_imgWidth,_imgHeight,_macroBlkWidth,_macroBlkHeight);
+		if(_pInOver == NULL)
+		{
+			Destroy();
+			return(0);
+		}//end _pInOver...
+
+		/// --------------- Configure ref overlays --------------------------------
+		/// Overlay the whole reference. The reference will have an extended 
+		/// boundary for motion estimation and must therefore create its own mem.
+		_pRefOver = new OverlayMem2Dv2((void *)_pRef, _imgWidth, _imgHeight, _imgWidth, _imgHeight);
+		if(_pRefOver == NULL)
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !_pRefOver...
+
+		/// Create the new extended boundary ref into _pExtRef. The mem is allocated in the method call.
+		if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
+																					_imgWidth,						
+																					_imgHeight, 
+																					_extBoundary,	///< Extend left and right by...
+																					_extBoundary,	///< Extend top and bottom by...
+																					(void **)(&_pExtRef)) )	///< Created in the method and returned.
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !ExtendBoundary...
+
+		/// Place an overlay on the extended boundary ref with block size set to the mb motion 
+	  /// vec dim.
+		_pExtRefOver = new OverlayExtMem2Dv2(	_pExtRef,				///< Src description created in the ExtendBoundary() call. 
+																					_extWidth, 
+																					_extHeight,
+																					_macroBlkWidth,	///< Block size description.
+																					_macroBlkHeight,
+																					_extBoundary,		///< Boundary size for both left and right.
+																					_extBoundary  );
+		if(_pExtRefOver == NULL)
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !_pExtRefOver...
+
+		/// --------------- Configure temp overlays --------------------------------
+		/// Alloc some temp mem and overlay it to use for half/quarter pel motion 
+	  /// estimation and compensation. The block size is the same as the mem size.
+		_pMBlk = new short[_macroBlkWidth * _macroBlkHeight];
+		_pMBlkOver = new OverlayMem2Dv2(_pMBlk, _macroBlkWidth, _macroBlkHeight, 
+																						_macroBlkWidth, _macroBlkHeight);
+		if( (_pMBlk == NULL)||(_pMBlkOver == NULL) )
+	  {
+			Destroy();
+		  return(0);
+	  }//end if !_pMBlk...
+	}//end else...
+
+	/// --------------- Configure result ---------------------------------------
+	/// The structure container for the motion vectors with all partition vectors per macroblock.
+	int numMbs = (_imgWidth/_macroBlkWidth) * (_imgHeight/_macroBlkHeight);
+	_pMotionVectorStruct = new VectorStructList(VectorStructList::COMPLEX2D, 2, NumPartitions);
+	if(_pMotionVectorStruct != NULL)
+	{
+		if(!_pMotionVectorStruct->SetLength(numMbs))
+		{
+			Destroy();
+			return(0);
+		}//end _pMotionVectorStruct...
+	}//end if _pMotionVectorStruct...
+	else
+  {
+		Destroy();
+	  return(0);
+  }//end if else...
+
+	_pPartDist = new int[numMbs * NumPartitions];
+	if(_pPartDist == NULL)
+  {
+		Destroy();
+	  return(0);
+  }//end if !_pPartDist...
+	memset((void *)_pPartDist, 0, numMbs * NumPartitions * sizeof(int));
+
+	/// --------------- Refinement Window ---------------------------------------
+	/// Prepare a 1/4 pel search window block for motion estimation refinement.
+	int winWidth	= ((6 + _macroBlkWidth) * 4);
+	int winHeight = ((6 + _macroBlkHeight) * 4);
+	_pWin					= new short[winWidth * winHeight];
+	_Win					= new OverlayMem2Dv2((void *)_pWin, winWidth, winHeight, winWidth, winHeight);
+	if( (_pWin == NULL)||(_Win == NULL) )
+  {
+		Destroy();
+	  return(0);
+  }//end if !_pWin...
+
+	_ready = 1;
+	return(1);
+}//end Create.
+
+/** Motion estimate the source within the reference.
+Do the estimation with the block sizes and image sizes defined in
+the implementation. A full search is done where each candidate has its 
+sixteen 4x4 distortions measured once and summed into all the partition 
+costs so that the best vector per partition is found in the same search. 
+The winners are refined on the 1/2 and then 1/4 pel grid around each 
+distinct full pel winner. The partition mode with the least distortion, 
+penalised per additional vector, is set as the list struct pattern.
+@param avgDistortion  : Return the motion compensated distortion.
+@return				        : The list of motion vectors.
+*/
+void* MotionEstimatorH264ImplPartition::Estimate(long* avgDistortion)
+{
+  int		i, j, m, n, p, q, x;
+  int		included = 0;
+  long	totalDifference = 0;
+
+  /// Set the motion vector struct storage structure.
+  int		maxLength = _pMotionVectorStruct->GetLength();
+  int		vecPos = 0;
+
+  /// Write the ref and fill its extended boundary. The centre part of
+  /// _pExtRefOver is copied from _pRefOver before filling the boundary.
+  if (_pel8)
+  {
+    _pExtRefOver8->SetOrigin(0, 0);
+    _pExtRefOver8->SetOverlayDim(_imgWidth, _imgHeight);
+    _pExtRefOver8->Write(*_pRefOver8);
+    _pExtRefOver8->FillBoundaryProxy();
+    _pExtRefOver8->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+  }//end if _pel8...
+  else
+  {
+    _pExtRefOver->SetOrigin(0, 0);
+    _pExtRefOver->SetOverlayDim(_imgWidth, _imgHeight);
+    _pExtRefOver->Write(*_pRefOver);	///< _pRefOver dimensions are always set to the whole image.
+    _pExtRefOver->FillBoundaryProxy();
+    _pExtRefOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
+  }//end else...
+
+  /// m,n step level 0 vec dim = _macroBlkHeight, _macroBlkWidth.
+  for (m = 0; m < _imgHeight; m += _macroBlkHeight)
+    for (n = 0; n < _imgWidth; n += _macroBlkWidth)
+    {
+      int partDist[NumPartitions];  ///< Partition distortions at the current candidate.
+      int minDiff[NumPartitions];   ///< Best so far per partition.
+      int mx[NumPartitions];        ///< Full pel grid per partition.
+      int my[NumPartitions];
+      int hmx[NumPartitions];       ///< 1/2 pel on 1/4 pel grid per partition.
+      int hmy[NumPartitions];
+      int qmx[NumPartitions];       ///< 1/4 pel grid per partition.
+      int qmy[NumPartitions];
+      bool refined[NumPartitions];
+
+      /// Depending on which img boundary we are on will limit the full search range.
+      int xlRng, xrRng, yuRng, ydRng;
+
+      /// The 16x16 predicted vector is used to weight equal distortion vectors for all partitions.
+      int predX, predY, predX0Rnd, predY0Rnd;
+      _pMVPred->Get16x16Prediction(NULL, vecPos, &predX, &predY);
+      if (predX < 0)             ///< Nearest level 0 pred motion vector.
+        predX0Rnd = (predX - 2) / 4;
+      else
+        predX0Rnd = (predX + 2) / 4;
+      if (predY < 0)
+        predY0Rnd = (predY - 2) / 4;
+      else
+        predY0Rnd = (predY + 2) / 4;
+
+      /// Set the input and ref blocks to work with. The (0,0) motion vector is the one 
+      /// to beat for every partition.
+      if (_pel8)
+      {
+        _pInOver8->SetOrigin(n, m);
+        _pExtRefOver8->SetOrigin(n, m);
+        PartitionDistortion(_pInOver8, _pExtRefOver8, minDiff);
+      }//end if _pel8...
+      else
+      {
+        _pInOver->SetOrigin(n, m);
+        _pExtRefOver->SetOrigin(n, m);
+        PartitionDistortion(_pInOver, _pExtRefOver, minDiff);
+      }//end else...
+      for (p = 0; p < NumPartitions; p++)
+      {
+        mx[p] = 0; my[p] = 0;
+        hmx[p] = 0; hmy[p] = 0;
+        refined[p] = false;
+      }//end for p...
+
+      ///--------------------------- Full pel grid search ---------------------------------------------------
+      /// From this mb position determine the full pel search range permitted for the motion vector.
+      int mRng = _motionRange / 4;  ///< _motionRange is in 1/4 pel units and must be converted to full pel units.
+      GetMotionRange(n, m, 0, 0, &xlRng, &xrRng, &yuRng, &ydRng, mRng);
+
+      for (i = yuRng; i <= ydRng; i++)
+      {
+        for (j = xlRng; j <= xrRng; j++)
+        {
+          /// Zero motion vec already checked.
+          if (!(i || j)) continue;
+
+          /// Set the block to the [j,i] offset motion vector around the [n,m] reference location
+          /// and measure all partitions from the one 4x4 grid.
+          if (_pel8)
+          {
+            _pExtRefOver8->SetOrigin(n + j, m + i);
+            if (!PartitionDistortionLessThan(_pInOver8, _pExtRefOver8, partDist, minDiff))
+              continue;
+          }//end if _pel8...
+          else
+          {
+            _pExtRefOver->SetOrigin(n + j, m + i);
+            if (!PartitionDistortionLessThan(_pInOver, _pExtRefOver, partDist, minDiff))
+              continue;
+          }//end else...
+
+          for (p = 0; p < NumPartitions; p++)
+          {
+            if (partDist[p] > minDiff[p]) continue;
+
+            /// Weight the equal diff case with the smallest global mv magnitude from the pred mv. 
+            if (partDist[p] == minDiff[p])
+            {
+              int currX = mx[p] - predX0Rnd;
+              int currY = my[p] - predY0Rnd;
+              int newX = j - predX0Rnd;
+              int newY = i - predY0Rnd;
+              if ((((currY*currY) + (currX*currX)) - ((newY*newY) + (newX*newX))) < 0)
+                continue;
+            }//end if partDist...
+
+            minDiff[p] = partDist[p];
+            mx[p] = j;
+            my[p] = i;
+          }//end for p...
+
+        }//end for j...
+      }//end for i...
+
+      ///----------------------- Quarter pel refined search ----------------------------------------
+      /// Partitions that share a full pel winner share the 1/4 pel window and each 1/2 and 1/4 pel 
+      /// candidate grid. The 1/4 pel stage is done around each distinct winning 1/2 pel position.
+      for (p = 0; p < NumPartitions; p++)
+      {
+        if (refined[p]) continue;
+
+        /// Set the location to the full pel winner of this partition group.
+        if (_pel8)
+        {
+          _pExtRefOver8->SetOrigin(n + mx[p], m + my[p]);
+          LoadHalfQuartPelWindow(_Win, _pExtRefOver8);
+        }//end if _pel8...
+        else
+        {
+          _pExtRefOver->SetOrigin(n + mx[p], m + my[p]);
+          LoadHalfQuartPelWindow(_Win, _pExtRefOver);
+        }//end else...
+
+        for (x = 0; x < MEH264IP_MOTION_SUB_POS_LENGTH; x++)
+        {
+          int qOffX = 2 * MEH264IP_SubPosX[x];
+          int qOffY = 2 * MEH264IP_SubPosY[x];
+
+          /// Read the half grid pels into temp.
+          if (_pel8)
+          {
+            QuarterRead(_pMBlkOver8, _Win, qOffX, qOffY);
+            if (!PartitionDistortionLessThan(_pInOver8, _pMBlkOver8, partDist, minDiff))
+              continue;
+          }//end if _pel8...
+          else
+          {
+            QuarterRead(_pMBlkOver, _Win, qOffX, qOffY);
+            if (!PartitionDistortionLessThan(_pInOver, _pMBlkOver, partDist, minDiff))
+              continue;
+          }//end else...
+
+          for (q = p; q < NumPartitions; q++)
+          {
+            if (refined[q] || (mx[q] != mx[p]) || (my[q] != my[p])) continue;
+            if (partDist[q] < minDiff[q])
+            {
+              minDiff[q] = partDist[q];
+              hmx[q] = qOffX;
+              hmy[q] = qOffY;
+            }//end if partDist...
+          }//end for q...
+        }//end for x...
+
+        for (q = p; q < NumPartitions; q++)
+        {
+          qmx[q] = hmx[q];
+          qmy[q] = hmy[q];
+        }//end for q...
+
+        /// Each distinct winning 1/2 pel position in the group. Filling the 1/4 pel positions 
+        /// around one 1/2 pel position does not overwrite the 1/2 pel values for the others.
+        for (int r = p; r < NumPartitions; r++)
+        {
+          if (refined[r] || (mx[r] != mx[p]) || (my[r] != my[p])) continue;
+
+          LoadQuartPelWindow(_Win, hmx[r], hmy[r]);
+
+          for (x = 0; x < MEH264IP_MOTION_SUB_POS_LENGTH; x++)
+          {
+            int qOffX = hmx[r] + MEH264IP_SubPosX[x];
+            int qOffY = hmy[r] + MEH264IP_SubPosY[x];
+
+            /// Read the quarter grid pels into temp.
+            if (_pel8)
+            {
+              QuarterRead(_pMBlkOver8, _Win, qOffX, qOffY);
+              if (!PartitionDistortionLessThan(_pInOver8, _pMBlkOver8, partDist, minDiff))
+                continue;
+            }//end if _pel8...
+            else
+            {
+              QuarterRead(_pMBlkOver, _Win, qOffX, qOffY);
+              if (!PartitionDistortionLessThan(_pInOver, _pMBlkOver, partDist, minDiff))
+                continue;
+            }//end else...
+
+            for (q = r; q < NumPartitions; q++)
+            {
+              if (refined[q] || (mx[q] != mx[p]) || (my[q] != my[p]) || (hmx[q] != hmx[r]) || (hmy[q] != hmy[r])) continue;
+              if (partDist[q] < minDiff[q])
+              {
+                minDiff[q] = partDist[q];
+                qmx[q] = qOffX;
+                qmy[q] = qOffY;
+              }//end if partDist...
+            }//end for q...
+          }//end for x...
+
+          /// Mark this 1/2 pel group as done.
+          int hx = hmx[r];
+          int hy = hmy[r];
+          for (q = r; q < NumPartitions; q++)
+          {
+            if ((mx[q] == mx[p]) && (my[q] == my[p]) && (hmx[q] == hx) && (hmy[q] == hy))
+              refined[q] = true;
+          }//end for q...
+        }//end for r...
+
+      }//end for p...
+
+      ///----------------------- Partition mode decision ----------------------------------------
+      int modeCost[4];
+      modeCost[MacroBlockH264::Inter_16x16] = minDiff[Part16x16];
+      modeCost[MacroBlockH264::Inter_16x8]  = minDiff[Part16x8] + minDiff[Part16x8 + 1] + MEH264IP_PARTITION_PENALTY;
+      modeCost[MacroBlockH264::Inter_8x16]  = minDiff[Part8x16] + minDiff[Part8x16 + 1] + MEH264IP_PARTITION_PENALTY;
+      modeCost[MacroBlockH264::Inter_8x8]   = minDiff[Part8x8] + minDiff[Part8x8 + 1] + minDiff[Part8x8 + 2] + 
+                                              minDiff[Part8x8 + 3] + (3 * MEH264IP_PARTITION_PENALTY);
+      int mode = MacroBlockH264::Inter_16x16;
+      for (x = MacroBlockH264::Inter_16x8; x <= MacroBlockH264::Inter_8x8; x++)
+      {
+        if (modeCost[x] < modeCost[mode])
+          mode = x;
+      }//end for x...
+
+      /// Check for inclusion in the distortion calculation. The penalty is not a distortion.
+      if ((_pDistortionIncluded != NULL) && _pDistortionIncluded[vecPos])
+      {
+        included++;
+        if (mode == MacroBlockH264::Inter_16x16)
+          totalDifference += modeCost[mode];
+        else if (mode == MacroBlockH264::Inter_8x8)
+          totalDifference += modeCost[mode] - (3 * MEH264IP_PARTITION_PENALTY);
+        else
+          totalDifference += modeCost[mode] - MEH264IP_PARTITION_PENALTY;
+      }//end if _pDistortionIncluded...
+
+      /// Load all partition vectors in 1/4 pel units.
+      if (vecPos < maxLength)
+      {
+        VCL_COMPLEX_2D_TYPE* pStruct = (VCL_COMPLEX_2D_TYPE *)_pMotionVectorStruct->GetStructPtr(vecPos);
+        pStruct->pattern = mode;
+        pStruct->numVectors = NumPartitions;
+        for (p = 0; p < NumPartitions; p++)
+        {
+          pStruct->vec[p].x = (short)((mx[p] << 2) + qmx[p]);
+          pStruct->vec[p].y = (short)((my[p] << 2) + qmy[p]);
+          _pPartDist[(vecPos * NumPartitions) + p] = minDiff[p];
+        }//end for p...
+        /// Set macroblock vector for future predictions.
+        _pMVPred->Set16x16MotionVector(vecPos, pStruct->vec[Part16x16].x, pStruct->vec[Part16x16].y);
+        vecPos++;
+      }//end if vecPos...
+
+    }//end for m & n...
+
+  if (included)	///< Prevent divide by zero error.
+    *avgDistortion = totalDifference / included;
+  else
+    *avgDistortion = 0;
+  return((void *)_pMotionVectorStruct);
+
+}//end Estimate.
+
+/*
+--------------------------------------------------------------------------
+  Private methods. 
+--------------------------------------------------------------------------
+*/
+
+/** Measure the partition distortions between two 16x16 blocks.
+The sixteen 4x4 block distortions are measured once in raster order and then 
+summed into the 8x8 quadrants from which the 16x8, 8x16 and 16x16 partition 
+costs follow. The block origins of both overlays are used. After every second
+pel row the partial partition sums are lower bounds and the measure exits 
+early once every partition is strictly greater than its limit.
+@param pIn			: Input block overlay.
+@param pRef			: Reference block overlay.
+@param partDist	: Returned NumPartitions distortions in partition order.
+@param limit		: NumPartitions distortions to improve on. NULL = no early exit.
+@return					: 1 = all partitions measured, 0 = early exit and partDist is incomplete.
+*/
+int MotionEstimatorH264ImplPartition::PartitionDistortionLessThan(OverlayMem2Dv2* pIn, OverlayMem2Dv2* pRef, int* partDist, int* limit)
+{
+  return(PartitionGridLessThan<short>(pIn->Get2DSrcPtr(), pIn->GetOriginX(), pIn->GetOriginY(), 
+                                      pRef->Get2DSrcPtr(), pRef->GetOriginX(), pRef->GetOriginY(), partDist, limit));
+}//end PartitionDistortionLessThan.
+
+int MotionEstimatorH264ImplPartition::PartitionDistortionLessThan(OverlayMem2Dv2u8* pIn, OverlayMem2Dv2u8* pRef, int* partDist, int* limit)
+{
+  return(PartitionGridLessThan<unsigned char>(pIn->Get2DSrcPtr(), pIn->GetOriginX(), pIn->GetOriginY(), 
+                                              pRef->Get2DSrcPtr(), pRef->GetOriginX(), pRef->GetOriginY(), partDist, limit));
+}//end PartitionDistortionLessThan.
+
+template<typename T> int MotionEstimatorH264ImplPartition::PartitionGridLessThan(T** in, int inX, int inY, T** ref, int refX, int refY, int* partDist, int* limit)
+{
+  int grid[16];
+
+#ifdef OM2DV2_COUNT_EVALUATIONS
+  OverlayMem2Dv2::CountEvaluation();
+#endif
+  memset((void *)grid, 0, 16 * sizeof(int));
+  for (int row = 0; row < 16; row++)
+  {
+    T*   pI = &(in[inY + row][inX]);
+    T*   pR = &(ref[refY + row][refX]);
+    int*   pG = &(grid[(row >> 2) << 2]);
+    for (int col = 0; col < 16; col++)
+    {
+      int d = (int)pI[col] - (int)pR[col];
+#ifdef MEH264IP_ABS_DIFF
+      pG[col >> 2] += (d < 0) ? -d : d;
+#else
+      pG[col >> 2] += d * d;
+#endif
+    }//end for col...
+
+    /// The unmeasured rows are still zero in the grid so the partial sums bound every partition from below.
+    if ((limit != NULL) && (row & 1) && (row < 15))
+    {
+      PartitionSum(grid, partDist);
+      int p;
+      for (p = 0; p < NumPartitions; p++)
+      {
+        if (partDist[p] <= limit[p])
+          break;
+      }//end for p...
+      if (p == NumPartitions)
+        return(0);
+    }//end if limit...
+  }//end for row...
+
+  PartitionSum(grid, partDist);
+  return(1);
+}//end PartitionGridLessThan.
+
+/** Sum a 4x4 distortion grid into the partition distortions.
+@param grid			: Sixteen 4x4 block distortions in raster order.
+@param partDist	: Returned NumPartitions distortions in partition order.
+@return					: none.
+*/
+void MotionEstimatorH264ImplPartition::PartitionSum(int* grid, int* partDist)
+{
+  /// 8x8 quadrants in raster order.
+  int q0 = grid[0] + grid[1] + grid[4] + grid[5];
+  int q1 = grid[2] + grid[3] + grid[6] + grid[7];
+  int q2 = grid[8] + grid[9] + grid[12] + grid[13];
+  int q3 = grid[10] + grid[11] + grid[14] + grid[15];
+
+  partDist[Part8x8]       = q0;
+  partDist[Part8x8 + 1]   = q1;
+  partDist[Part8x8 + 2]   = q2;
+  partDist[Part8x8 + 3]   = q3;
+  partDist[Part16x8]      = q0 + q1;
+  partDist[Part16x8 + 1]  = q2 + q3;
+  partDist[Part8x16]      = q0 + q2;
+  partDist[Part8x16 + 1]  = q1 + q3;
+  partDist[Part16x16]     = q0 + q1 + q2 + q3;
+
+}//end PartitionSum.
+
+void MotionEstimatorH264ImplPartition::Destroy(void)
+{
+	_ready = 0;
+
+	if(_Win != NULL)
+		delete _Win;
+	_Win = NULL;
+	if(_pWin != NULL)
+		delete[] _pWin;
+	_pWin = NULL;
+
+	if(_pInOver != NULL)
+		delete _pInOver;
+	_pInOver = NULL;
+
+	if(_pRefOver != NULL)
+		delete _pRefOver;
+	_pRefOver	= NULL;
+
+	if(_pExtRef != NULL)
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
+	_pExtRef = NULL;
+
+	if(_pExtRefOver != NULL)
+		delete _pExtRefOver;
+	_pExtRefOver = NULL;
+
+	if(_pInOver8 != NULL)
+		delete _pInOver8;
+	_pInOver8 = NULL;
+	if(_pRefOver8 != NULL)
+		delete _pRefOver8;
+	_pRefOver8 = NULL;
+	if(_pExtRefOver8 != NULL)
+		delete _pExtRefOver8;
+	_pExtRefOver8 = NULL;
+	if(_pExtRef8 != NULL)
+		PlanePool::Shared()->Release(_pExtRef8);
+	_pExtRef8 = NULL;
+
+	if(_pMBlk != NULL)
+		delete[] _pMBlk;
+	_pMBlk = NULL;
+
+	if(_pMBlkOver != NULL)
+		delete _pMBlkOver;
+	_pMBlkOver = NULL;
+	if(_pMBlkOver8 != NULL)
+		delete _pMBlkOver8;
+	_pMBlkOver8 = NULL;
+	if(_pMBlk8 != NULL)
+		delete[] _pMBlk8;
+	_pMBlk8 = NULL;
+
+	if(_pMotionVectorStruct != NULL)
+		delete _pMotionVectorStruct;
+	_pMotionVectorStruct = NULL;
+
+	if(_pPartDist != NULL)
+		delete[] _pPartDist;
+	_pPartDist = NULL;
+
+}//end Destroy.
+
+/** Get the allowed motion range for this block.
+The search area for unrestricted H.264 is within the bounds of the extended image
+dimensions. The range is limited at the corners and edges of the extended
+images. The range is further checked to ensure that the motion vector is within 
+its defined max range. The returned values are offset limits from the (xpos+xoff,ypos+yoff) 
+image coordinates.
+@param xpos			: X coord of block in the image.
+@param ypos			: Y coord of block in the image.
+@param xoff			: Current offset (vector) from xpos.
+@param yoff			: Current offset (vector) from ypos.
+@param xlr			: Returned allowed left range offset from xpos+xoff.
+@param xrr			: Returned allowed right range offset from xpos+xoff.
+@param yur			: Returned allowed up range offset from ypos+yoff.
+@param ydr			: Returned allowed down range offset from ypos+yoff.
+@param range		: Desired range of motion.
+@return					: none.
+*/
+void MotionEstimatorH264ImplPartition::GetMotionRange(	int  xpos,	int  ypos,
+																									int	 xoff,	int  yoff,
+																									int* xlr,		int* xrr, 
+																									int* yur,		int* ydr,
+																									int	 range)
+{
+	int x = xpos + xoff;
+	int y = ypos + yoff;
+
+	int xLRange, xRRange, yURange, yDRange;
+
+	int boundary	= _extBoundary - MEH264IP_PADDING;
+	int	width			= _imgWidth;
+	int	height		= _imgHeight;
+	int	vecRange	= _motionRange/4;	///< Convert 1/4 pel range to full pel units.
+
+	/// Limit the range of the motion vector.
+	if( (xoff - range) > -vecRange )
+		xLRange = range;
+	else
+		xLRange = (vecRange-1) + xoff;
+	if( (xoff + range) < vecRange )
+		xRRange = range;
+	else
+		xRRange = (vecRange-1) - xoff;
+	if( (yoff - range) > -vecRange )
+		yURange = range;
+	else
+		yURange = (vecRange-1) + yoff;
+	if( (yoff + range) < vecRange )
+		yDRange = range;
+	else
+		yDRange = (vecRange-1) - yoff;
+
+	if( (x - xLRange) >= -boundary )	///< Ok and within left extended boundary.
+		*xlr = -xLRange;
+	else ///< Bring it into the extended boundary edge.
+		*xlr = -(x + boundary);
+	if( (x + xRRange) < width )	///< Rest of block extends into the bounday region.
+		*xrr = xRRange;
+	else
+		*xrr = width - x;
+
+	if( (y - yURange) >= -boundary )	///< Ok and within upper extended boundary.
+		*yur = -yURange;
+	else ///< Bring it into the extended boundary edge.
+		*yur = -(y + boundary);
+	if( (y + yDRange) < height )	///< Rest of block extends into the bounday region.
+		*ydr = yDRange;
+	else
+		*ydr = height - y;
+
+}//end GetMotionRange.
+
+/** Load a 1/4 pel window with 1/2 pel values.
+The 1/4 pel window must be the macroblock size with a boundary of 3 extra pels on all sides. Only the inner
+macroblock size plus 1 extra pel boundary are filled with valid values. This window is used in a cascading 
+approach to motion estimation where the best 1/2 pel search around a winning full pel is done first followed 
+by the best 1/4 pel around the winning 1/2 pel position. This window is used for the input for the first stage
+and therefore only the 1/2 pel positions are valid. This method must be followed by the LoadQuartPelWindow()
+method to complete the 1/4 pel values around a winning 1/2 pel position. The reference origin position is 
+aligned onto the full pel (3,3) position of the 1/4 pel window.
+@param qPelWin	: Window of size (4 * (_macroBlkHeight+6)) x (4 * (_macroBlkWidth+6))
+@param ref			: Row addresses of the 16-bit or 8-bit reference to derive the 1/4 pel window from.
+@param refXPos	: Reference origin X in mem coords.
+@param refYPos	: Reference origin Y in mem coords.
+@return					: none.
+*/
+template<typename T> void MotionEstimatorH264ImplPartition::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, T** ref, int refXPos, int refYPos)
+{
+	int fullRow, fullCol, quartRow, quartCol, refRow, refCol;
+
+	int			width		= qPelWin->GetWidth()/4;	///< Convert to full pel units.
+	int			height	= qPelWin->GetHeight()/4;
+	short** window	= qPelWin->Get2DSrcPtr();
+
+	/// Set all the "h" half pel values in the window only at the positions that will be required for the other calcs. No
+	/// scaling or clipping is performed until "j" half pel values are completed.
+	for(fullRow = 2, quartRow = 10, refRow = refYPos - 1; fullRow < (_macroBlkHeight + 3); fullRow++, quartRow += 4, refRow++)
+	{
+		for(fullCol = 0, quartCol = 0, refCol = refXPos - 3; fullCol < width; fullCol++, quartCol += 4, refCol++)
+		{
+			int h =     (int)ref[refRow-2][refCol] -  5*(int)ref[refRow-1][refCol] + 
+							 20*(int)ref[refRow][refCol]   + 20*(int)ref[refRow+1][refCol] - 
+							  5*(int)ref[refRow+2][refCol] +    (int)ref[refRow+3][refCol];
+
+			window[quartRow][quartCol] = (short)(h);
+		}//end for fullCol...
+	}//end fullRow...
+	
+	/// Set all the "b" half pel values in the window only at the positions that will be required for the other calcs. No
+	/// scaling or clipping is performed until "j" half pel values are completed.
+	for(fullRow = 0, quartRow = 0, refRow	= refYPos - 3; fullRow < height; fullRow++, quartRow += 4, refRow++)
+	{
+		for(fullCol = 2, quartCol = 10, refCol = refXPos - 1; fullCol < (_macroBlkWidth + 3); fullCol++, quartCol += 4, refCol++)
+		{
+			int b =     (int)ref[refRow][refCol-2] -  5*(int)ref[refRow][refCol-1] + 
+							 20*(int)ref[refRow][refCol]   + 20*(int)ref[refRow][refCol+1] - 
+							  5*(int)ref[refRow][refCol+2] +    (int)ref[refRow][refCol+3];
+
+			window[quartRow][quartCol] = (short)(b);
+		}//end for fullCol...
+	}//end fullRow...
+
+	/// For the "j" half pel values, use the previously calculated "h" and "b" values only in the positions
+	/// surrounding the centre of the reference image origin. Now scaling is included for j.
+	for(fullRow = 2, quartRow = 10; fullRow < (_macroBlkHeight + 3); fullRow++, quartRow += 4)
+	{
+		for(fullCol = 2, quartCol = 10; fullCol < (_macroBlkWidth + 3); fullCol++, quartCol += 4)
+		{
+			int j = (   (int)window[quartRow][quartCol-10] -  5*(int)window[quartRow][quartCol-6] + 
+							 20*(int)window[quartRow][quartCol-2]  + 20*(int)window[quartRow][quartCol+2] - 
+							  5*(int)window[quartRow][quartCol+6]  +    (int)window[quartRow][quartCol+10] + 512) >> 10;
+
+			window[quartRow][quartCol] = (short)(MEH264IP_CLIP255(j));
+		}//end for fullCol...
+	}//end fullRow...
+
+	/// Scale and clip the useful "h" and "b" half pel values in place.
+	for(fullRow = 2, refRow	= refYPos - 1, quartRow = 8; fullRow < (_macroBlkHeight + 3); fullRow++, refRow++, quartRow += 4)
+	{
+		for(fullCol = 2, refCol = refXPos - 1, quartCol = 8; fullCol < (_macroBlkWidth + 3); fullCol++, refCol++, quartCol += 4)
+		{
+			/// "h"
+			window[quartRow+2][quartCol] = MEH264IP_CLIP255((window[quartRow+2][quartCol] + 16) >> 5);
+			/// "b"
+			window[quartRow][quartCol+2] = MEH264IP_CLIP255((window[quartRow][quartCol+2] + 16) >> 5);
+			/// Copy full pel "G"
+			window[quartRow][quartCol] = ref[refRow][refCol];
+		}//end for fullCol...
+
+    /// One further "h" and "G" col at the end of the row.
+		/// "h"
+		window[quartRow+2][quartCol] = MEH264IP_CLIP255((window[quartRow+2][quartCol] + 16) >> 5);
+		/// Copy full pel "G"
+		window[quartRow][quartCol] = ref[refRow][refCol];
+
+	}//end fullRow...
+
+   /// One further "b" and "G" row at the end.
+	for(fullCol = 2, refCol = refXPos - 1, quartCol = 8; fullCol < (_macroBlkWidth + 3); fullCol++, refCol++, quartCol += 4)
+	{
+		/// "b"
+		window[quartRow][quartCol+2] = MEH264IP_CLIP255((window[quartRow][quartCol+2] + 16) >> 5);
+		/// Copy full pel "G"
+		window[quartRow][quartCol] = ref[refRow][refCol];
+	}//end for fullCol...
+
+  /// ...and one final "G" full pel at the bottom right edge.
+	window[quartRow][quartCol] = ref[refRow][refCol];
+
+}//end LoadHalfQuartPelWindow.
+
+void MotionEstimatorH264ImplPartition::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2* extRef)
+{
+	LoadHalfQuartPelWindow(qPelWin, extRef->Get2DSrcPtr(), extRef->GetOriginX(), extRef->GetOriginY());
+}//end LoadHalfQuartPelWindow.
+
+void MotionEstimatorH264ImplPartition::LoadHalfQuartPelWindow(OverlayMem2Dv2* qPelWin, OverlayMem2Dv2u8* extRef)
+{
+	LoadHalfQuartPelWindow(qPelWin, extRef->Get2DSrcPtr(), extRef->GetOriginX(), extRef->GetOriginY());
+}//end LoadHalfQuartPelWindow.
+
+/** Load a 1/4 pel window with 1/4 pel values not in 1/2 pel positions.
+The 1/4 pel window must be the macroblock size with a boundary of 3 extra pels on all sides. Only the inner
+macroblock size plus 1 extra pel boundary are filled with valid values. This window is used in a cascading 
+approach to motion estimation where the best 1/2 pel search around a winning full pel is done first followed 
+by the best 1/4 pel around the winning 1/2 pel position. This window is used for the input for the second stage
+and therefore the 1/2 pel positions are valid from a previous (first stage) call to the LoadHalfQuartPelWindow() 
+method. This method will complete the 1/4 pel values around a winning 1/2 pel position. The reference origin 
+position is aligned onto the full pel (3,3) position of the 1/4 pel window. The 1/4 pel values are processed
+from the values already in the window.
+@param qPelWin		: Window of size (4 * (_macroBlkHeight+6)) x (4 * (_macroBlkWidth+6))
+@param hPelColOff	: The winning 1/2 pel X offset from the (3,3) window position in 1/4 pel units.
+@param hPelRowOff	: The winning 1/2 pel Y offset from the (3,3) window position in 1/4 pel units.
+@return						: none.
+*/
+void MotionEstimatorH264ImplPartition::LoadQuartPelWindow(OverlayMem2Dv2* qPelWin, int hPelColOff, int hPelRowOff)
+{
+	int fullRow, fullCol, quartRow, quartCol;
+
+	/// The 1/4 pels are to calculated for the 8 positions surrounding the 1/2 location at (hPelRowOff,hPelColOff). Note
+	/// that hPelRowOff and hPelColOff are still in 1/4 pel units i.e. = range [-2,0,2][-2,0,2].
+
+	short** window	= qPelWin->Get2DSrcPtr();
+
+	for(fullRow = 0, quartRow = (12 + hPelRowOff); fullRow < _macroBlkHeight; fullRow++, quartRow += 4)
+	{
+		for(fullCol = 0, quartCol = (12 + hPelColOff); fullCol < _macroBlkWidth; fullCol++, quartCol += 4)
+		{
+			window[quartRow-1][quartCol-1]	= (window[quartRow-2][quartCol-2] + window[quartRow][quartCol] + 1) >> 1;
+			window[quartRow-1][quartCol]		= (window[quartRow-2][quartCol]		+ window[quartRow][quartCol] + 1) >> 1;
+			window[quartRow-1][quartCol+1]	= (window[quartRow-2][quartCol]		+ window[quartRow][quartCol+2] + 1) >> 1;
+			window[quartRow][quartCol-1]		= (window[quartRow][quartCol-2]		+ window[quartRow][quartCol] + 1) >> 1;
+			window[quartRow][quartCol+1]		= (window[quartRow][quartCol+2]		+ window[quartRow][quartCol] + 1) >> 1;
+			window[quartRow+1][quartCol-1]	= (window[quartRow][quartCol-2]		+ window[quartRow+2][quartCol] + 1) >> 1;
+			window[quartRow+1][quartCol]		= (window[quartRow+2][quartCol]		+ window[quartRow][quartCol] + 1) >> 1;
+			window[quartRow+1][quartCol+1]	= (window[quartRow+2][quartCol]		+ window[quartRow][quartCol+2] + 1) >> 1;
+		}//end for fullCol...
+	}//end fullRow...
+
+}//end LoadQuartPelWindow.
+
+/** Read 1/4 pels from window.
+The 1/4 pel window must be the macroblock size with a boundary of 3 extra pels on all sides. Only the inner
+macroblock size plus 1 extra pel boundary are filled with valid values. Read a block from the window centred
+on the (3,3) position with a 1/4 pel offset given by the input params into the destination block.
+@param dstBlock		: Destination block.
+@param qPelWin		: Window of size (4 * (_macroBlkHeight+6)) x (4 * (_macroBlkWidth+6))
+@param qPelColOff	: The 1/4 pel X offset from the (3,3) window position in 1/4 pel units.
+@param qPelRowOff	: The 1/4 pel Y offset from the (3,3) window position in 1/4 pel units.
+@return						: none.
+*/
+void MotionEstimatorH264ImplPartition::QuarterRead(OverlayMem2Dv2* dstBlock, OverlayMem2Dv2* qPelWin, int qPelColOff, int qPelRowOff)
+{
+	int fullRow, fullCol, quartRow, quartCol, dstX;
+
+	short** window	= qPelWin->Get2DSrcPtr();	/// The origin of the window is around full pel position (3,3).
+
+	short** dst			= dstBlock->Get2DSrcPtr();
+	int			width		= dstBlock->GetWidth();
+	int			height	= dstBlock->GetHeight();
+	int			dstXPos = dstBlock->GetOriginX();
+	int			dstYPos = dstBlock->GetOriginY();
+
+	/// 1/4 pel rows and cols increment in quarter pel units with (3,3) full pel offset + input offset. As
+	/// in: quartRow	= ((fullRow + 3) * 4) + qPelRowOff; and quartCol	= ((fullCol + 3) * 4) + qPelColOff;
+
+	for(fullRow = 0, quartRow = (12 + qPelRowOff); fullRow < height; fullRow++, dstYPos++, quartRow += 4)
+	{
+		for(fullCol = 0, quartCol = (12 + qPelColOff), dstX = dstXPos; fullCol < width; fullCol++, quartCol += 4, dstX++)
+			dst[dstYPos][dstX] = window[quartRow][quartCol];
+	}//end fullRow...
+
+}//end QuarterRead.
+
+/// The window values are clipped to [0..255] and are read into an 8-bit block.
+void MotionEstimatorH264ImplPartition::QuarterRead(OverlayMem2Dv2u8* dstBlock, OverlayMem2Dv2* qPelWin, int qPelColOff, int qPelRowOff)
+{
+	int fullRow, fullCol, quartRow, quartCol, dstX;
+
+	short**					window	= qPelWin->Get2DSrcPtr();
+	unsigned char**	dst			= dstBlock->Get2DSrcPtr();
+	int							width		= dstBlock->GetWidth();
+	int							height	= dstBlock->GetHeight();
+	int							dstXPos = dstBlock->GetOriginX();
+	int							dstYPos = dstBlock->GetOriginY();
+
+	for(fullRow = 0, quartRow = (12 + qPelRowOff); fullRow < height; fullRow++, dstYPos++, quartRow += 4)
+	{
+		for(fullCol = 0, quartCol = (12 + qPelColOff), dstX = dstXPos; fullCol < width; fullCol++, quartCol += 4, dstX++)
+			dst[dstYPos][dstX] = (unsigned char)window[quartRow][quartCol];
+	}//end fullRow...
+
+}//end QuarterRead.
+
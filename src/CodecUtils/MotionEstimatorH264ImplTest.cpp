@@ -158,6 +158,8 @@ void MotionEstimatorH264ImplTest::ResetMembers(void)
 	_extHeight				= 0;
 	_extBoundary			= 0;
 	_pExtRefOver			= NULL;			///< Extended ref overlay with motion block dim.
+	/// Successive elimination is exact and therefore on by default.
+	_successiveElimination = true;
   /// A 1/4 pel refinement window.
 	_pWin							= NULL;
 	_Win							= NULL;
@@ -222,7 +224,7 @@ int MotionEstimatorH264ImplTest::Create(void)
 	_extBoundary = _macroBlkWidth + MEH264IT_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH264IT_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																				_imgWidth,						
 																				_imgHeight, 
 																				_extBoundary,	///< Extend left and right by...
@@ -250,6 +252,13 @@ int MotionEstimatorH264ImplTest::Create(void)
 	  return(0);
   }//end if !_pExtRefOver...
 
+	/// Block sum table over the extended ref for successive elimination.
+	if(!_extRefSum.Create(_extWidth, _extHeight))
+  {
+		Destroy();
+	  return(0);
+  }//end if !Create...
+
 	/// --------------- Configure temp overlays --------------------------------
 	/// Alloc some temp mem and overlay it to use for half/quarter pel motion 
   /// estimation and compensation. The block size is the same as the mem size.
@@ -347,6 +356,10 @@ void* MotionEstimatorH264ImplTest::Estimate(long* avgDistortion)
 	_pExtRefOver->FillBoundaryProxy();
 	_pExtRefOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
 
+	/// Block sums of the extended ref for successive elimination.
+	if(_successiveElimination)
+		_extRefSum.Load(_pExtRefOver->Get2DSrcPtr());
+
 	/// Gather the motion vector absolute differnce/square error data and choose the vector.
 	/// m,n step level 0 vec dim = _macroBlkHeight, _macroBlkWidth.
   for(m = 0; m < _imgHeight; m += _macroBlkHeight)
@@ -385,6 +398,15 @@ void* MotionEstimatorH264ImplTest::Estimate(long* avgDistortion)
 		_pInOver->SetOrigin(n,m);
 		_pExtRefOver->SetOrigin(n,m);
 
+		/// The 8x8 quadrant sums of the input mb for successive elimination.
+		if(_successiveElimination)
+		{
+			_inQuadSum[0] = _inQuadSum[1] = _inQuadSum[2] = _inQuadSum[3] = 0;
+			for(k = 0; k < _macroBlkHeight; k++)
+				for(l = 0; l < _macroBlkWidth; l++)
+					_inQuadSum[((k >> 3) << 1) + (l >> 3)] += _pInOver->Read(l, k);
+		}//end if _successiveElimination...
+
 		/// The (0,0) vector is the one to beat with Absolute/Square diff comparison method.
 //#ifdef MEH264IT_ABS_DIFF
 //		int zeroVecDiff = _pInOver->Tad16x16(*_pExtRefOver);
@@ -417,6 +439,20 @@ void* MotionEstimatorH264ImplTest::Estimate(long* avgDistortion)
 				/// Set the block to the [j,i] motion vector around the [n,m] reference location.
 				_pExtRefOver->SetOrigin(n+j, m+i);
 
+				/// Successive elimination: Tsd of a 64 pel quadrant >= (quadrant sum diff)^2 / 64
+				/// so a bound strictly greater than minDiff cannot win or tie.
+				if(_successiveElimination)
+				{
+					int x		= _pExtRefOver->GetOriginX();
+					int y		= _pExtRefOver->GetOriginY();
+					int d0	= _inQuadSum[0] - _extRefSum.BlockSum(x, y, 8, 8);
+					int d1	= _inQuadSum[1] - _extRefSum.BlockSum(x + 8, y, 8, 8);
+					int d2	= _inQuadSum[2] - _extRefSum.BlockSum(x, y + 8, 8, 8);
+					int d3	= _inQuadSum[3] - _extRefSum.BlockSum(x + 8, y + 8, 8, 8);
+					if( ((d0*d0) + (d1*d1) + (d2*d2) + (d3*d3)) > (minDiff << 6) )
+						goto MEH264IT_FULL_BREAK;
+				}//end if _successiveElimination...
+
         /// Total square diff between input and ref mb pels at mv position [j,i].
         blkDiff = 0;
         for(k = 0; k < _macroBlkHeight; k++)
@@ -764,13 +800,15 @@ void MotionEstimatorH264ImplTest::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
 		delete _pExtRefOver;
 	_pExtRefOver = NULL;
 
+	_extRefSum.Destroy();
+
 	if(_pMBlk != NULL)
 		delete[] _pMBlk;
 	_pMBlk = NULL;
@@ -77,6 +77,15 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 /// Choose between sqr err distortion or abs diff metric.
 #undef MEH264IUMHS_ABS_DIFF
 
+/// Bounds on the adaptive early termination threshold for the seed candidates.
+#define MEH264IUMHS_SEED_THRESHOLD_MIN              1000
+#define MEH264IUMHS_SEED_THRESHOLD_MAX              4000
+
+/// Fixed early termination thresholds for the pattern searches when not learned.
+#define MEH264IUMHS_THRESHOLD_LOW                   1000
+#define MEH264IUMHS_THRESHOLD_MID                   2000
+#define MEH264IUMHS_THRESHOLD_HIGH                  4000
+
 /// Search range coord offsets for 5x5 pattern search ordered from inner to outer.
 #define MEH264IUMHS_MOTION_5X5_POS_LENGTH 	24
 MEH264IUMHS_COORD MEH264IUMHS_5x5Pos[MEH264IUMHS_MOTION_5X5_POS_LENGTH] =
@@ -250,6 +259,7 @@ MotionEstimatorH264ImplUMHS::MotionEstimatorH264ImplUMHS( const void*
   _pMVPred = pMVPred;
   _pDistortionIncluded = (bool *)pDistortionIncluded;
   _pPrevFrmMBlk = pPrevFrmMBlk;
+  _seeding = (pPrevFrmMBlk != NULL);
 }//end constructor.
 
 
@@ -276,6 +286,9 @@ void MotionEstimatorH264ImplUMHS::ResetMembers(void)
 	_extHeight				= 0;
 	_extBoundary			= 0;
 	_pExtRefOver			= NULL;			///< Extended ref overlay with motion block dim.
+	/// Static macroblock pre-pass is off by default.
+	_staticMbSkip			= false;
+	_staticMbQP				= 26;
   /// A 1/4 pel refinement window.
 	_pWin							= NULL;
 	_Win							= NULL;
@@ -298,6 +311,12 @@ void MotionEstimatorH264ImplUMHS::ResetMembers(void)
   /// Number of locations to test for partial sums along a path.
   _pathLength = 256;
 
+  /// Seeding is only possible with a previous frame motion field.
+  _seeding = false;
+
+  /// Fixed early termination thresholds by default.
+  _adaptive = false;
+
 }//end ResetMembers.
 
 MotionEstimatorH264ImplUMHS::~MotionEstimatorH264ImplUMHS(void)
@@ -342,7 +361,7 @@ int MotionEstimatorH264ImplUMHS::Create(void)
 	_extBoundary = _macroBlkWidth + MEH264IUMHS_PADDING;
 	if(_macroBlkHeight > _macroBlkWidth)
 		_extBoundary = _macroBlkHeight + MEH264IUMHS_PADDING;
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																				_imgWidth,						
 																				_imgHeight, 
 																				_extBoundary,	///< Extend left and right by...
@@ -370,6 +389,13 @@ int MotionEstimatorH264ImplUMHS::Create(void)
 	  return(0);
   }//end if !_pExtRefOver...
 
+	/// Static macroblock classification for the pre-pass.
+	if(!_staticMb.Create(_imgWidth, _imgHeight))
+  {
+		Destroy();
+	  return(0);
+  }//end if !Create...
+
 	/// --------------- Configure temp overlays --------------------------------
 	/// Alloc some temp mem and overlay it to use for half/quarter pel motion 
   /// estimation and compensation. The block size is the same as the mem size.
@@ -413,6 +439,25 @@ int MotionEstimatorH264ImplUMHS::Create(void)
 	  return(0);
   }//end if !_pWin...
 
+	/// --------------- Seed candidates ---------------------------------------
+	/// The motion field history is one entry per macroblock and is only required
+	/// when the previous frame macroblocks are available.
+	if(_pPrevFrmMBlk != NULL)
+	{
+		if(!_seeder.Create(_imgWidth/_macroBlkWidth, _imgHeight/_macroBlkHeight))
+		{
+			Destroy();
+			return(0);
+		}//end if !Create...
+	}//end if _pPrevFrmMBlk...
+
+	/// --------------- Search statistics -------------------------------------
+	if(!_searchStats.Create(_imgWidth/_macroBlkWidth, _imgHeight/_macroBlkHeight))
+	{
+		Destroy();
+		return(0);
+	}//end if !Create...
+
   /// --------------- Measurements -------------------------------------------
 #ifdef MEH264IUMHS_TAKE_MEASUREMENTS
   _mtLen = 290;
@@ -461,14 +506,45 @@ void* MotionEstimatorH264ImplUMHS::Estimate(long* avgDistortion)
 	_pExtRefOver->FillBoundaryProxy();
 	_pExtRefOver->SetOverlayDim(_macroBlkWidth, _macroBlkHeight);
 
+	/// Classify the static macroblocks that bypass the search.
+	if(_staticMbSkip)
+		_staticMb.Classify((const short *)_pInput, (const short *)_pRef, _staticMbQP);
+
   /// _motionRange is in 1/4 pel units and must be converted to full pel units.
   int mRng = _motionRange / 4;  
 
+  /// Roll the temporal motion field history for the seed candidates.
+  if (_seeding)
+    _seeder.Update(_pPrevFrmMBlk);
+
+  /// The learned thresholds are bounded by the frame QP.
+  if (_adaptive)
+    _searchStats.SetQP(_staticMbQP);
+
   /// Gather the motion vector absolute differnce/square error data and choose the vector.
 	/// m,n step level 0 vec dim = _macroBlkHeight, _macroBlkWidth.
   for(m = 0; m < _imgHeight; m += _macroBlkHeight)
 		for(n = 0; n < _imgWidth; n += _macroBlkWidth)
   {
+		/// Static macroblocks from the pre-pass take the zero vector without a search.
+		if(_staticMbSkip && _staticMb.IsStatic(vecPos))
+		{
+			int zeroVecDiff = _staticMb.GetZeroVecDistortion(vecPos);
+			if( (_pDistortionIncluded != NULL) && _pDistortionIncluded[vecPos] )
+			{
+				included++;
+				totalDifference += zeroVecDiff;
+			}//end if _pDistortionIncluded...
+			if(vecPos < maxLength)
+			{
+				_pMotionVectorStruct->SetSimpleElement(vecPos, 0, 0);
+				_pMotionVectorStruct->SetSimpleElement(vecPos, 1, 0);
+				_pMVPred->Set16x16MotionVector(vecPos, 0, 0, zeroVecDiff);
+				vecPos++;
+			}//end if vecPos...
+			continue;
+		}//end if _staticMbSkip...
+
 		int mx	= 0;	///< Full pel grid.
 		int my	= 0;
 		int hmx	= 0;	///< 1/2 pel on 1/4 pel grid.
@@ -548,9 +624,41 @@ void* MotionEstimatorH264ImplUMHS::Estimate(long* avgDistortion)
     int strrmx; 
     int strrmy;
     int priorMinDiff;
+    int thrLow, thrMid, thrHigh;  ///< Early termination thresholds for a short, medium and wide search.
+    ///--------------------------- Spatial and temporal seed candidates ----------------------------------------
+    /// Test the neighbourhood mvs of the current and previous frames, including the accelerated co-located mv,
+    /// and skip the pattern searches if the best seed is already below the adaptive threshold.
+    if (_seeding)
+    {
+      H264MVS_COORD seeds[H264MotionVectorSeeder::MaxCandidates];
+      int numSeeds = _seeder.GetCandidates(vecPos, _pMotionVectorStruct, predX0, predY0, seeds);
+      for (int s = 0; s < numSeeds; s++)
+      {
+        j = seeds[s].x;
+        i = seeds[s].y;
+        if ((i >= yuRng) && (i <= ydRng) && (j >= xlRng) && (j <= xrRng))
+        {
+          _pExtRefOver->SetOrigin(n + j, m + i);
+#ifdef MEH264IUMHS_ABS_DIFF
+          int blkDiff = _pInOver->Tad16x16LessThan(*_pExtRefOver, minDiff);
+#else
+          int blkDiff = _pInOver->Tsd16x16LessThan(*_pExtRefOver, minDiff);
+#endif
+          if (blkDiff <= minDiff)  ///< Better candidate mv.
+          {
+            int seedCost = MEH264IUMHS_COST(blkDiff, j, i, predX0, predY0);
+            if (seedCost < minCost)
+            { minDiff = blkDiff; minCost = seedCost; mx = j; my = i; }//end if seedCost...
+          }//end if blkDiff...
+        }//end if i...
+      }//end for s...
+
+      if (minDiff < _seeder.GetThreshold(vecPos, predD, MEH264IUMHS_SEED_THRESHOLD_MIN, MEH264IUMHS_SEED_THRESHOLD_MAX))
+        goto MEH264IUMHS_EXTENDED_DIAMOND_SEARCH;
+    }//end if _seeding...
     /// Search on the aligned mb previous frame mv if it is not zero or equal to the pred mv. Ignore prev
     /// intra encoded mbs. 
-    if (!_pPrevFrmMBlk[vecPos]._intraFlag)
+    else if ((_pPrevFrmMBlk != NULL) && !_pPrevFrmMBlk[vecPos]._intraFlag)
     {
       int prevX0 = _pPrevFrmMBlk[vecPos]._mvX[0] / 4; ///< Convert from 1/4 pel res to full pel res.
       int prevY0 = _pPrevFrmMBlk[vecPos]._mvY[0] / 4;
@@ -574,8 +682,17 @@ void* MotionEstimatorH264ImplUMHS::Estimate(long* avgDistortion)
     /// Absolute thresholding used. In addition, if the predicted mv is the best initial mv and if its distortion
     /// is within 20% of the predicted distortion (i.e. the prediction is accurate) then assume the pred mv is
     /// the most likley mv and jump to the local refinement.
-    if(minDiff < 1000)  goto MEH264IUMHS_EXTENDED_DIAMOND_SEARCH;
-    else if ((minDiff < 4000) || ((minDiff == predVecDiff) && (minDiff < (predD * 12 / 10)) && (minDiff >(predD * 8 / 10))))
+    thrLow  = MEH264IUMHS_THRESHOLD_LOW;
+    thrMid  = MEH264IUMHS_THRESHOLD_MID;
+    thrHigh = MEH264IUMHS_THRESHOLD_HIGH;
+    if (_adaptive)
+    {
+      thrLow  = _searchStats.GetThreshold(vecPos, 0, thrLow);
+      thrMid  = _searchStats.GetThreshold(vecPos, 1, thrMid);
+      thrHigh = _searchStats.GetThreshold(vecPos, 2, thrHigh);
+    }//end if _adaptive...
+    if(minDiff < thrLow)  goto MEH264IUMHS_EXTENDED_DIAMOND_SEARCH;
+    else if ((minDiff < thrHigh) || ((minDiff == predVecDiff) && (minDiff < (predD * 12 / 10)) && (minDiff >(predD * 8 / 10))))
       goto MEH264IUMHS_EXTENDED_HEX_SEARCH;      /// Go to hexigon & diamond search
 
     ///--------------------------- Full pel unsymmetrical cross search ------------------------------------------
@@ -618,8 +735,8 @@ void* MotionEstimatorH264ImplUMHS::Estimate(long* avgDistortion)
     ///------------ 2nd unsymmetrical cross Early Termination exit test to full pel local refinement searchs ---
     /// For a successful cross search improvement mv by at least 10% and it is close to the initial mv then local refinement will
     /// find the same as the 5x5 and a wider multi-hexagon search is not necessary. An absolute base threshold is also used.
-    if (minDiff < 1000) goto MEH264IUMHS_EXTENDED_DIAMOND_SEARCH;
-    else if ((minDiff < 2000) || ((minDiff < (priorMinDiff * 9 / 10)) && (rmx || rmy) && (abs(rmx) <= 3) && (abs(rmy) <= 3)))
+    if (minDiff < thrLow) goto MEH264IUMHS_EXTENDED_DIAMOND_SEARCH;
+    else if ((minDiff < thrMid) || ((minDiff < (priorMinDiff * 9 / 10)) && (rmx || rmy) && (abs(rmx) <= 3) && (abs(rmy) <= 3)))
       goto MEH264IUMHS_EXTENDED_HEX_SEARCH; /// Go to hexigon & diamond search
 
     ///--------------------------- Full pel 5x5 rectangular full search ----------------------------------------
@@ -659,7 +776,7 @@ void* MotionEstimatorH264ImplUMHS::Estimate(long* avgDistortion)
     /// required then it continues from the best unsymmetrical cross search [mx,my] mv and not the 5x5 
     /// best offset.
     ///------------ 3rd 5x5 Early Termination exit test to full pel local refinement searchs ---------------------
-    if (minDiff < 1000) goto MEH264IUMHS_EXTENDED_DIAMOND_SEARCH;
+    if (minDiff < thrLow) goto MEH264IUMHS_EXTENDED_DIAMOND_SEARCH;
 
     ///--------------------------- Full pel uneven multi-hexagon grid search -------------------------------------
 
@@ -693,7 +810,7 @@ void* MotionEstimatorH264ImplUMHS::Estimate(long* avgDistortion)
       }//end for x...
 
       /// 4th early termination is tested after each scaled 16-point hexagon pattern.
-      if ((rmx || rmy) && ((minDiff < 2000) || (minDiff < (priorMinDiff/5))))
+      if ((rmx || rmy) && ((minDiff < thrMid) || (minDiff < (priorMinDiff/5))))
         break; ///< Effectively = goto MEH264IUMHS_EXTENDED_HEX_SEARCH; /// Go to hexigon & diamond search.
 
     }//end for w...
@@ -907,6 +1024,10 @@ void* MotionEstimatorH264ImplUMHS::Estimate(long* avgDistortion)
       mvy = reconstructPredY;
     }//end if predVecDiff...
 
+    /// Record the search result for the learned thresholds.
+    if (_adaptive)
+      _searchStats.Add(vecPos, minDiff, mvx, mvy);
+
     /// Check for inclusion in the distortion calculation.
     if (_pDistortionIncluded != NULL)
     {
@@ -929,6 +1050,10 @@ void* MotionEstimatorH264ImplUMHS::Estimate(long* avgDistortion)
 
   }//end for m & n...
 
+  /// Fold the frame into the learned thresholds.
+  if (_adaptive)
+    _searchStats.Update();
+
 	/// In this context avg distortion is actually avg difference.
 //	*avgDistortion = totalDifference/maxLength;
 	if(included)	///< Prevent divide by zero error.
@@ -949,6 +1074,9 @@ void MotionEstimatorH264ImplUMHS::Destroy(void)
 {
 	_ready = 0;
 
+	_seeder.Destroy();
+	_searchStats.Destroy();
+
 #ifdef MEH264IUMHS_TAKE_MEASUREMENTS
   if(_mtPos > 0)
     _mt.Save("C:/Users/KFerguson/Google Drive/PC/Excel/MotionEvaluation/experiment.csv", ",", 1);
@@ -970,13 +1098,15 @@ void MotionEstimatorH264ImplUMHS::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOver != NULL)
 		delete _pExtRefOver;
 	_pExtRefOver = NULL;
 
+	_staticMb.Destroy();
+
 	if(_pMBlk != NULL)
 		delete[] _pMBlk;
 	_pMBlk = NULL;
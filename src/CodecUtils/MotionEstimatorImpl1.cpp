@@ -184,7 +184,7 @@ int MotionEstimatorImpl1::Create(void)
 	  return(0);
   }//end if !_pRefOver...
 
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																			_imgWidth,						
 																			_imgHeight, 
 																			_motionRange + 1, // Extend left and right by...
@@ -427,7 +427,7 @@ void MotionEstimatorImpl1::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOverAll != NULL)
@@ -280,7 +280,7 @@ int MotionEstimatorImpl2::Create(void)
 	  return(0);
   }//end if !_pRefOver...
 
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRef, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRef, 
 																			_imgWidth,						
 																			_imgHeight, 
 																			_motionRange + 1, // Extend left and right by...
@@ -337,7 +337,7 @@ int MotionEstimatorImpl2::Create(void)
 	}//end else...
 
 	// Level 1: Extended ref mem _pExtRefL1 created by ExtendBoundary() call.
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL1, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL1, 
 																			_l1Width,						
 																			_l1Height, 
 																			_l1MotionRange + 1,
@@ -393,7 +393,7 @@ int MotionEstimatorImpl2::Create(void)
 	}//end else...
 
 	// Level 2: Extended ref mem _pExtRefL2 created by ExtendBoundary() call.
-	if(!OverlayExtMem2Dv2::ExtendBoundary((void *)_pRefL2, 
+	if(!OverlayExtMem2Dv2::AcquireBoundary((void *)_pRefL2, 
 																			_l2Width,						
 																			_l2Height, 
 																			_l2MotionRange + 1,
@@ -853,7 +853,7 @@ void MotionEstimatorImpl2::Destroy(void)
 	_pRefOver	= NULL;
 
 	if(_pExtRef != NULL)
-		delete[] _pExtRef;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRef);
 	_pExtRef = NULL;
 
 	if(_pExtRefOverAll != NULL)
@@ -873,7 +873,7 @@ void MotionEstimatorImpl2::Destroy(void)
 	_pRefL1Over	= NULL;
 
 	if(_pExtRefL1 != NULL)
-		delete[] _pExtRefL1;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL1);
 	_pExtRefL1 = NULL;
 
 	if(_pExtRefL1OverAll != NULL)
@@ -893,7 +893,7 @@ void MotionEstimatorImpl2::Destroy(void)
 	_pRefL2Over	= NULL;
 
 	if(_pExtRefL2 != NULL)
-		delete[] _pExtRefL2;
+		OverlayExtMem2Dv2::ReleaseBoundary(_pExtRefL2);
 	_pExtRefL2 = NULL;
 
 	if(_pExtRefL2OverAll != NULL)
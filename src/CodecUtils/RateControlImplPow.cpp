@@ -61,6 +61,8 @@ Constants
 */
 #define RCIP_NUM_SHORT_TERM_SAMPLES 4
 #define RCIP_NUM_RATE_BUFF_LENGTHS  1
+/// Limit of the lookahead complexity scaling of the target rate (and its inverse).
+#define RCIP_MAX_COMPLEXITY_RATIO   2.0
 
 /*
 ---------------------------------------------------------------------------
@@ -96,6 +98,7 @@ int RateControlImplPow::Create(int numOfFrames)
   _R2_s   = 1.0;
 
   _mseSignal = 0.0;
+  _complexitySignal = 1.0;
 
   _RCTableLen = 0;
   _RCTablePos = 0;
@@ -302,6 +305,19 @@ int RateControlImplPow::PredictDistortion(double targetAvgRate, double rateLimit
 
   }//end if ValidData...
 
+  /// Lookahead bit allocation: Frames more complex than their neighbours take a larger share
+  /// of the rate and the buffer averaging model recovers the difference over the next frames.
+  if(_complexitySignal != 1.0)
+  {
+    double ratio = _complexitySignal;
+    if(ratio > RCIP_MAX_COMPLEXITY_RATIO)
+      ratio = RCIP_MAX_COMPLEXITY_RATIO;
+    else if(ratio < (1.0/RCIP_MAX_COMPLEXITY_RATIO))
+      ratio = 1.0/RCIP_MAX_COMPLEXITY_RATIO;
+    targetRate *= ratio;
+    _complexitySignal = 1.0;  ///< Clear the signal.
+  }//end if _complexitySignal...
+
   /// Keep the target rate within the upper rate limit.
   if(targetRate > targetRateLimit)
     targetRate = targetRateLimit;
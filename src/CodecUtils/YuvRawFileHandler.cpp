@@ -49,6 +49,7 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include <fstream>
 
 #include "YuvRawFileHandler.h"
+#include "PlanePool.h"
 
 /*
 ---------------------------------------------------------------------------
@@ -60,6 +61,7 @@ YuvRawFileHandler::YuvRawFileHandler(void): RawFileHandlerBase()
   _pBuff16  = NULL;
   _pBuff8   = NULL;
   _buffLen  = 0;
+  _frameLen = 0;
   _inType   = YUV4208P;
   _outType  = YUV42016P;
   _width    = 352;
@@ -83,11 +85,34 @@ int YuvRawFileHandler::Open(const char* filename, int rw)
  if(!RawFileHandlerBase::Open(filename, rw))
     return(0);
 
-  /// Buffer for 1 frame of planar YUV. 
+  /// Buffer for 1 frame of planar YUV borrowed from the shared pool. 
   _buffLen  = (_width * _height) + ((_width * _height)/2); ///< YUV 4:2:0
+  _frameLen = _buffLen;
+  if((_inType == YUV422YUY2)||(_inType == YUV422UYVY))
+  {
+    if(_outType != YUV42016P) ///< Packed types are only unpacked to 16-bit planes.
+    {
+      Close();
+      return(0);
+    }//end if _outType...
+    _frameLen = 2 * _width * _height;
+  }//end if YUV422YUY2...
+
+  /// The file byte values are kept in the planes with no chr offset.
+  int ingestType = YUVIC_I420;
+  if(_inType == YUV420NV12)
+    ingestType = YUVIC_NV12;
+  else if(_inType == YUV422YUY2)
+    ingestType = YUVIC_YUY2;
+  else if(_inType == YUV422UYVY)
+    ingestType = YUVIC_UYVY;
+  _ingest.SetDimensions(_width, _height);
+  _ingest.SetFormat(ingestType);
+  _ingest.SetChrominanceOffset(128);
+
   if(_outType == YUV42016P)
   {
-    _pBuff16 = new short[_buffLen];
+    _pBuff16 = (short *)PlanePool::Shared()->Acquire(_buffLen, 1, sizeof(short), 0);
     if(_pBuff16 == NULL)
     {
       Close();
@@ -96,7 +121,7 @@ int YuvRawFileHandler::Open(const char* filename, int rw)
   }//end if _outType...
   else
   {
-    _pBuff8 = new unsigned char[_buffLen];
+    _pBuff8 = (unsigned char *)PlanePool::Shared()->Acquire(_buffLen, 1, sizeof(unsigned char), 0);
     if(_pBuff8 == NULL)
     {
       Close();
@@ -110,14 +135,15 @@ int YuvRawFileHandler::Open(const char* filename, int rw)
 void YuvRawFileHandler::Close(void)
 {
   if(_pBuff16 != NULL)
-    delete[] _pBuff16;
+    PlanePool::Shared()->Release(_pBuff16);
   _pBuff16    = NULL;
 
   if(_pBuff8 != NULL)
-    delete[] _pBuff8;
+    PlanePool::Shared()->Release(_pBuff8);
   _pBuff8    = NULL;
 
   _buffLen  = 0;
+  _frameLen = 0;
 
   RawFileHandlerBase::Close();
 }//end Close.
@@ -141,6 +167,17 @@ void* YuvRawFileHandler::GetNextUnit(int* unitLen)
   if(_currPos >= (_length-1)) ///< Wrap around the end.
     _currPos = 0;
 
+  /// A full frame to 16-bit planes is converted directly into the buffer. Partial
+  /// frames at the end of the file fall through to the pel loops below.
+  if((_outType == YUV42016P)&&((_currPos + _frameLen) <= _length))
+  {
+    int lumLen = _width * _height;
+    _ingest.Convert(&(((unsigned char *)_pFile)[_currPos]), _pBuff16, &(_pBuff16[lumLen]), &(_pBuff16[lumLen + lumLen/4]));
+    _currPos += _frameLen;
+    *unitLen = _buffLen;
+    return((void*)( _pBuff16 ));
+  }//end if _outType...
+
   /// From the current pos typecast and copy one full frame of YUV 4:2:0 pels to the buffer.
   if(_inType == YUV4208P)
   {
@@ -175,6 +212,11 @@ void* YuvRawFileHandler::GetNextUnit(int* unitLen)
       cnt += chrLen;
     }//end if _outType = YUV42016P...
   }//end if YUV420NV12...
+  else if((_inType == YUV422YUY2)||(_inType == YUV422UYVY))
+  {
+    /// A partial packed frame is dropped and the next call wraps around.
+    _currPos = _length;
+  }//end else if YUV422YUY2...
 
   *unitLen = cnt;
   if(_outType == YUV4208P)
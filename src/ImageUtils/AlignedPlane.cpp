@@ -0,0 +1,89 @@
+/** @file
+
+MODULE				: AlignedPlane
+
+TAG						: AP
+
+FILE NAME			: AlignedPlane.cpp
+
+DESCRIPTION		: Static utility to allocate 2-D image planes aligned to
+								a cache line with a padded row stride.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <stdlib.h>
+#include "AlignedPlane.h"
+
+/// Row strides that are multiples of this alias onto the same cache sets.
+#define AP_ALIAS_BYTES	1024
+
+int AlignedPlane::Stride(int width, int elemSize)
+{
+	int bytes = ((width * elemSize) + (AP_ALIGNMENT - 1)) & ~(AP_ALIGNMENT - 1);
+	if( (bytes % AP_ALIAS_BYTES) == 0 )
+		bytes += AP_ALIGNMENT;
+	return(bytes / elemSize);
+}//end Stride.
+
+void* AlignedPlane::Alloc(int stride, int height, int elemSize)
+{
+	size_t size = (size_t)stride * (size_t)height * (size_t)elemSize;
+	if(size == 0)
+		return(NULL);
+#ifdef _WINDOWS
+	return(_aligned_malloc(size, AP_ALIGNMENT));
+#else
+	void* ptr = NULL;
+	if(posix_memalign(&ptr, AP_ALIGNMENT, size) != 0)
+		return(NULL);
+	return(ptr);
+#endif
+}//end Alloc.
+
+void AlignedPlane::Free(void* ptr)
+{
+	if(ptr == NULL)
+		return;
+#ifdef _WINDOWS
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}//end Free.
+
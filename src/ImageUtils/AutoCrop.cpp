@@ -49,6 +49,21 @@ AutoCrop::AutoCrop()
 	_pTopBottomAcc	= NULL;
 
 	_multiple				= 1;
+
+	// Streaming mode defaults.
+	_hysteresis			= 8;
+	_rescanPeriod		= 250;
+	_window					= 8;
+	_samples				= 8;
+	_sceneCutLevel	= 32;
+	_streamValid		= 0;
+	_changed				= 0;
+	_frames					= 0;
+	_pendingCount		= 0;
+	_colBlack				= 0;
+	_rowBlack				= 0;
+	for(VICS_INT i = 0; i < (AC_GRID * AC_GRID); i++)
+		_grid[i] = 0;
 }//end constructor.
 
 AutoCrop::~AutoCrop()
@@ -124,6 +139,9 @@ void AutoCrop::Destroy(void)
 	_marginTop	 	= 0;
 	_marginBottom	= 0;
 
+	_streamValid	= 0;
+	_pendingCount	= 0;
+
 }//end Destroy.
 
 /*
@@ -157,107 +175,105 @@ member of pels in both dimensions.
 */
 VICS_INT AutoCrop::ProcessImage(BITMAPINFOHEADER *pBmih)
 {
-	DWORD bitmapBitsOffset = pBmih->biSize + pBmih->biClrUsed * sizeof(RGBQUAD);
+	VICS_PBYTE	bmptr;
+	VICS_INT		normWidthSize;
+	if(!LocateImage(pBmih,&bmptr,&normWidthSize))
+		return(0);
 
-	// Only accept uncompressed RGB formats.
-	if( (pBmih->biCompression != BI_RGB) &&	(pBmih->biCompression != BI_BITFIELDS))
-	{
-	  return(0);
-	}//end if biCompression...
+	Accumulate(bmptr,normWidthSize);
 
-	//	Determine the palette colour size.
-	VICS_INT paletteSize;
-	if(pBmih->biCompression == BI_RGB)
-	{
-		if((pBmih->biClrUsed == 0)&&(pBmih->biBitCount <= 8))
-			paletteSize = (VICS_INT)((1 << pBmih->biBitCount) * sizeof(RGBQUAD));
-		else
-			paletteSize = (VICS_INT)(pBmih->biClrUsed * sizeof(RGBQUAD));
-	}
-	else //if pBmih->biCompression == BI_BITFIELDS
-	{
-		paletteSize = (VICS_INT)(3 * sizeof(DWORD));
-	}//end else...
+	SetMargins(Find1stEdge(_pLeftRightAcc,_width),FindLastEdge(_pLeftRightAcc,_width),
+						 Find1stEdge(_pTopBottomAcc,_height),FindLastEdge(_pTopBottomAcc,_height));
 
-	// Ensure the image size in bytes is valid. Cater for scan line DWORD multiples.
-	if(pBmih->biSizeImage == 0)
-	{
-		pBmih->biSizeImage = (DWORD)(((((pBmih->biWidth * pBmih->biBitCount) + 31)/32) * 4) * abs(pBmih->biHeight));
-	}//end if biSizeImage...
+	return(1);
+}//end ProcessImage.
 
-	// Locate the image pel data.
-	VICS_PBYTE bmptr = (VICS_PBYTE)((VICS_PBYTE)pBmih + pBmih->biSize + paletteSize);
+/** Approximate the boundary locations of a live video frame.
+Only a few sample pels of the lines within the search window either side of 
+the previously detected boundaries are tested for darkness against the levels 
+of the last full scan. A full scan of the frame alone replaces the tracking on
+the first frame, on a scene cut, after the rescan period and when a boundary 
+moves out of its search window. A detected change is only reported in the 
+margins after it persists for the hysteresis frames and HasChanged() is then
+set for that frame. Note: The input image must be in RGB24 format.
 
-	// Decide here on what image formats are valid.
-	if(pBmih->biBitCount != 24)
-		return(0);
+@param pBmih	: Input image pointer in bmp format. 
 
-	VICS_INT lclWidth		= (VICS_INT)(pBmih->biWidth);
-	VICS_INT lclHeight	= (VICS_INT)(abs(pBmih->biHeight));
+@return 			: 0 = failure, 1 = success.
+*/
+VICS_INT AutoCrop::ProcessStream(BITMAPINFOHEADER *pBmih)
+{
+	VICS_PBYTE	bmptr;
+	VICS_INT		stride;
+	if(!LocateImage(pBmih,&bmptr,&stride))
+		return(0);
 
-	// Create if the dimensions do not match.
-	if( (lclWidth != _width)||(lclHeight != _height) )
+	VICS_INT i;
+	VICS_INT bound[4];
+	VICS_INT cut		= SceneCut(bmptr,stride);
+	VICS_INT rescan	= (!_streamValid)||cut||(_frames >= _rescanPeriod);
+	for(i = 0; (i < 4)&&(!rescan); i++)
 	{
-		if(!Create(lclWidth,lclHeight))
-		{
-			Destroy();
-			return(0);
-		}//end if !Create...
-	}//end if lclWidth...
-
-	// Main loop of squaring the lum value and accumulating.
-	VICS_INT row,col;
-	VICS_INT normWidthSize = ((((lclWidth * pBmih->biBitCount) + 31)/32) * 4);
-	for(row = 0; row < _height; row++)
+		if(!TrackEdge(bmptr,stride,i,&(bound[i])))
+			rescan = 1;
+	}//end for i...
+	if(rescan)
 	{
-		VICS_PBYTE bmpRow = &(bmptr[normWidthSize * row]);
-		for(col = 0; col < _width; col++)
-		{
-			VICS_DOUBLE b = (VICS_DOUBLE)(*bmpRow++);
-			VICS_DOUBLE g = (VICS_DOUBLE)(*bmpRow++);
-			VICS_DOUBLE r = (VICS_DOUBLE)(*bmpRow++);
-			VICS_INT32 y = (VICS_INT32)((b * 0.114) + (g * 0.587) + (r * 0.299) + 0.5);
+		Rescan(bmptr,stride,bound);
+		_frames = 0;
+	}//end if rescan...
+	_frames++;
 
-			_pLeftRightAcc[col] += (y * y);
-			_pTopBottomAcc[row] += (y * y);
-		}//end for col...
-	}//end for row...
-
-	_marginLeft		= Find1stEdge(_pLeftRightAcc,_width);
-	_marginRight	= (_width - 1) - FindLastEdge(_pLeftRightAcc,_width);
-	_marginBottom = Find1stEdge(_pTopBottomAcc,_height);
-	_marginTop		= (_height - 1) - FindLastEdge(_pTopBottomAcc,_height);
-
-	// Adjust the cropping to ensure multiples of _multiple pels.
-	VICS_INT newWidth		= _width  - (_marginLeft	 + _marginRight);
-	VICS_INT newHeight	= _height - (_marginBottom + _marginTop);
+	for(i = 0; i < 4; i++)
+		_track[i] = bound[i];
 
-	VICS_INT extra = newWidth % _multiple;
-	if(extra)
+	_changed = 0;
+	if(!_streamValid)
 	{
-		_marginLeft		+= (extra/2); 
-		_marginRight	+= (extra - (extra/2));
-	}//end if extra...
-
-	// For top and bottom all but 2 rows are to be cropped from the bottom. Image
-	// scene information is largely in the top 1/3 of most sequences.
-	extra = newHeight % _multiple;
-	if(extra)
+		// Report the 1st frame immediately.
+		for(i = 0; i < 4; i++)
+			_report[i] = bound[i];
+		_pendingCount = 0;
+		_streamValid	= 1;
+		_changed			= 1;
+	}//end if !_streamValid...
+	else
 	{
-		if(extra > 4)
+		VICS_INT same = 1;
+		VICS_INT held = 1;
+		for(i = 0; i < 4; i++)
 		{
-			_marginTop		+= 2; 
-			_marginBottom	+= (extra - 2);
-		}//end if extra...
+			if(abs(bound[i] - _report[i]) > AC_TOLERANCE)
+				same = 0;
+			if(abs(bound[i] - _pending[i]) > AC_TOLERANCE)
+				held = 0;
+		}//end for i...
+
+		if(same)
+			_pendingCount = 0;
+		else if(held && _pendingCount)
+			_pendingCount++;
 		else
 		{
-			_marginTop		+= (extra/2); 
-			_marginBottom	+= (extra - (extra/2));
+			for(i = 0; i < 4; i++)
+				_pending[i] = bound[i];
+			_pendingCount = 1;
 		}//end else...
-	}//end if extra...
+
+		if(_pendingCount >= _hysteresis)
+		{
+			for(i = 0; i < 4; i++)
+				_report[i] = bound[i];
+			_pendingCount = 0;
+			_changed			= 1;
+		}//end if _pendingCount...
+	}//end else...
+
+	if(_changed)
+		SetMargins(_report[0],_report[1],_report[2],_report[3]);
 
 	return(1);
-}//end ProcessImage.
+}//end ProcessStream.
 
 /*
 ---------------------------------------------------------------------------
@@ -367,6 +383,273 @@ VICS_INT AutoCrop::FindLastEdge(VICS_PINT32 x,VICS_INT len)
 	return(edgePos);
 }//end FindLastEdge.
 
+/** Locate the pels of an RGB24 bmp image.
+The accumulators are re-created if the image dimensions change.
+
+@param pBmih		: Input image pointer in bmp format.
+
+@param ppBmp		: Returned pointer to the 1st pel.
+
+@param pStride	: Returned DWORD aligned bytes per row.
+
+@return 				: 0 = failure, 1 = success.
+*/
+VICS_INT AutoCrop::LocateImage(BITMAPINFOHEADER *pBmih,VICS_PBYTE *ppBmp,VICS_INT *pStride)
+{
+	DWORD bitmapBitsOffset = pBmih->biSize + pBmih->biClrUsed * sizeof(RGBQUAD);
+
+	// Only accept uncompressed RGB formats.
+	if( (pBmih->biCompression != BI_RGB) &&	(pBmih->biCompression != BI_BITFIELDS))
+	{
+	  return(0);
+	}//end if biCompression...
+
+	//	Determine the palette colour size.
+	VICS_INT paletteSize;
+	if(pBmih->biCompression == BI_RGB)
+	{
+		if((pBmih->biClrUsed == 0)&&(pBmih->biBitCount <= 8))
+			paletteSize = (VICS_INT)((1 << pBmih->biBitCount) * sizeof(RGBQUAD));
+		else
+			paletteSize = (VICS_INT)(pBmih->biClrUsed * sizeof(RGBQUAD));
+	}
+	else //if pBmih->biCompression == BI_BITFIELDS
+	{
+		paletteSize = (VICS_INT)(3 * sizeof(DWORD));
+	}//end else...
+
+	// Ensure the image size in bytes is valid. Cater for scan line DWORD multiples.
+	if(pBmih->biSizeImage == 0)
+	{
+		pBmih->biSizeImage = (DWORD)(((((pBmih->biWidth * pBmih->biBitCount) + 31)/32) * 4) * abs(pBmih->biHeight));
+	}//end if biSizeImage...
+
+	// Locate the image pel data.
+	*ppBmp = (VICS_PBYTE)((VICS_PBYTE)pBmih + pBmih->biSize + paletteSize);
+
+	// Decide here on what image formats are valid.
+	if(pBmih->biBitCount != 24)
+		return(0);
+
+	VICS_INT lclWidth		= (VICS_INT)(pBmih->biWidth);
+	VICS_INT lclHeight	= (VICS_INT)(abs(pBmih->biHeight));
+
+	// Create if the dimensions do not match.
+	if( (lclWidth != _width)||(lclHeight != _height) )
+	{
+		if(!Create(lclWidth,lclHeight))
+		{
+			Destroy();
+			return(0);
+		}//end if !Create...
+	}//end if lclWidth...
+
+	*pStride = ((((lclWidth * pBmih->biBitCount) + 31)/32) * 4);
+	return(1);
+}//end LocateImage.
+
+/** Add the squared lum projections of an image to the accumulators.
+
+@param bmptr	: 1st image pel.
+
+@param stride	: Bytes per row.
+
+@return 			: none.
+*/
+void AutoCrop::Accumulate(VICS_PBYTE bmptr,VICS_INT stride)
+{
+	// Main loop of squaring the lum value and accumulating.
+	VICS_INT row,col;
+	for(row = 0; row < _height; row++)
+	{
+		VICS_PBYTE bmpRow = &(bmptr[stride * row]);
+		for(col = 0; col < _width; col++)
+		{
+			VICS_DOUBLE b = (VICS_DOUBLE)(*bmpRow++);
+			VICS_DOUBLE g = (VICS_DOUBLE)(*bmpRow++);
+			VICS_DOUBLE r = (VICS_DOUBLE)(*bmpRow++);
+			VICS_INT32 y = (VICS_INT32)((b * 0.114) + (g * 0.587) + (r * 0.299) + 0.5);
+
+			_pLeftRightAcc[col] += (y * y);
+			_pTopBottomAcc[row] += (y * y);
+		}//end for col...
+	}//end for row...
+}//end Accumulate.
+
+/** Set the margins from the content bounds.
+The crop is adjusted to ensure multiples of the _multiple member of pels in 
+both dimensions.
 
+@return 			: none.
+*/
+void AutoCrop::SetMargins(VICS_INT firstCol,VICS_INT lastCol,VICS_INT firstRow,VICS_INT lastRow)
+{
+	_marginLeft		= firstCol;
+	_marginRight	= (_width - 1) - lastCol;
+	_marginBottom = firstRow;
+	_marginTop		= (_height - 1) - lastRow;
 
+	// Adjust the cropping to ensure multiples of _multiple pels.
+	VICS_INT newWidth		= _width  - (_marginLeft	 + _marginRight);
+	VICS_INT newHeight	= _height - (_marginBottom + _marginTop);
 
+	VICS_INT extra = newWidth % _multiple;
+	if(extra)
+	{
+		_marginLeft		+= (extra/2); 
+		_marginRight	+= (extra - (extra/2));
+	}//end if extra...
+
+	// For top and bottom all but 2 rows are to be cropped from the bottom. Image
+	// scene information is largely in the top 1/3 of most sequences.
+	extra = newHeight % _multiple;
+	if(extra)
+	{
+		if(extra > 4)
+		{
+			_marginTop		+= 2; 
+			_marginBottom	+= (extra - 2);
+		}//end if extra...
+		else
+		{
+			_marginTop		+= (extra/2); 
+			_marginBottom	+= (extra - (extra/2));
+		}//end else...
+	}//end if extra...
+}//end SetMargins.
+
+/** Integer lum of a pel.
+
+@return 			: Lum.
+*/
+VICS_INT AutoCrop::Lum(VICS_PBYTE bmptr,VICS_INT stride,VICS_INT col,VICS_INT row)
+{
+	VICS_PBYTE p = &(bmptr[(stride * row) + (3 * col)]);
+	return( ((114 * (VICS_INT)p[0]) + (587 * (VICS_INT)p[1]) + (299 * (VICS_INT)p[2]) + 500)/1000 );
+}//end Lum.
+
+/** Test a line for darkness from a few sample pels.
+The pels are spread along the line within the current content bounds.
+
+@param edge		: 0 = first col, 1 = last col, 2 = first row, 3 = last row.
+
+@param pos		: Col or row of the line.
+
+@return 			: 1 = dark.
+*/
+VICS_INT AutoCrop::IsDark(VICS_PBYTE bmptr,VICS_INT stride,VICS_INT edge,VICS_INT pos)
+{
+	VICS_INT	 cols = (edge < 2);
+	VICS_INT	 from = cols ? _track[2] : _track[0];
+	VICS_INT	 span = (cols ? _track[3] : _track[1]) - from + 1;
+	VICS_INT32 acc	= 0;
+	for(VICS_INT i = 0; i < _samples; i++)
+	{
+		VICS_INT at = from + (((2 * i) + 1) * span)/(2 * _samples);
+		VICS_INT32 y = cols ? Lum(bmptr,stride,pos,at) : Lum(bmptr,stride,at,pos);
+		acc += (y * y);
+	}//end for i...
+
+	return( (acc/_samples) <= (cols ? _colBlack : _rowBlack) );
+}//end IsDark.
+
+/** Track a boundary within its search window.
+The lines are tested from outside the window inwards to the 1st non-dark line.
+
+@param edge		: 0 = first col, 1 = last col, 2 = first row, 3 = last row.
+
+@param pPos		: Returned boundary.
+
+@return 			: 0 = the boundary is not within the window, 1 = tracked.
+*/
+VICS_INT AutoCrop::TrackEdge(VICS_PBYTE bmptr,VICS_INT stride,VICS_INT edge,VICS_INT *pPos)
+{
+	VICS_INT len	= (edge < 2) ? _width : _height;
+	VICS_INT dir	= (edge & 1) ? -1 : 1;
+	VICS_INT from	= _track[edge] - (dir * _window);
+	VICS_INT to		= _track[edge] + (dir * _window);
+	if(from < 0) from = 0;
+	else if(from >= len) from = len - 1;
+	if(to < 0) to = 0;
+	else if(to >= len) to = len - 1;
+
+	for(VICS_INT pos = from; pos != (to + dir); pos += dir)
+	{
+		if(!IsDark(bmptr,stride,edge,pos))
+		{
+			// Content at the outer end of the window may extend beyond it.
+			if( (pos == from)&&(pos != ((dir > 0) ? 0 : (len - 1))) )
+				return(0);
+			*pPos = pos;
+			return(1);
+		}//end if !IsDark...
+	}//end for pos...
+
+	return(0);
+}//end TrackEdge.
+
+/** Full scan of a frame.
+The accumulators are loaded with this frame alone and the dark levels of the 
+tracking are set from the same 1/12 of max levels used by the edge finding.
+
+@param pBound	: Returned bounds.
+
+@return 			: none.
+*/
+void AutoCrop::Rescan(VICS_PBYTE bmptr,VICS_INT stride,VICS_INT *pBound)
+{
+	VICS_INT i;
+	for(i = 0; i < _width; i++)
+		_pLeftRightAcc[i] = 0;
+	for(i = 0; i < _height; i++)
+		_pTopBottomAcc[i] = 0;
+	Accumulate(bmptr,stride);
+
+	pBound[0] = Find1stEdge(_pLeftRightAcc,_width);
+	pBound[1] = FindLastEdge(_pLeftRightAcc,_width);
+	pBound[2] = Find1stEdge(_pTopBottomAcc,_height);
+	pBound[3] = FindLastEdge(_pTopBottomAcc,_height);
+	// Blank frames have no content bounds.
+	if( (pBound[1] < pBound[0])||(pBound[3] < pBound[2]) )
+	{
+		pBound[0] = 0;
+		pBound[1] = _width - 1;
+		pBound[2] = 0;
+		pBound[3] = _height - 1;
+	}//end if pBound...
+
+	VICS_INT32 maxCol = 0;
+	VICS_INT32 maxRow = 0;
+	for(i = 0; i < _width; i++)
+		if(_pLeftRightAcc[i] > maxCol)
+			maxCol = _pLeftRightAcc[i];
+	for(i = 0; i < _height; i++)
+		if(_pTopBottomAcc[i] > maxRow)
+			maxRow = _pTopBottomAcc[i];
+	_colBlack = maxCol/(12 * _height);
+	_rowBlack = maxRow/(12 * _width);
+}//end Rescan.
+
+/** Detect a scene cut.
+The mean absolute lum difference of a sparse grid of pels to the previous 
+frame is compared to the scene cut level. The grid is updated.
+
+@return 			: 1 = scene cut.
+*/
+VICS_INT AutoCrop::SceneCut(VICS_PBYTE bmptr,VICS_INT stride)
+{
+	VICS_INT diff = 0;
+	for(VICS_INT j = 0; j < AC_GRID; j++)
+	{
+		VICS_INT row = (((2 * j) + 1) * _height)/(2 * AC_GRID);
+		for(VICS_INT i = 0; i < AC_GRID; i++)
+		{
+			VICS_INT col	= (((2 * i) + 1) * _width)/(2 * AC_GRID);
+			VICS_INT y		= Lum(bmptr,stride,col,row);
+			diff += abs(y - _grid[(j * AC_GRID) + i]);
+			_grid[(j * AC_GRID) + i] = y;
+		}//end for i...
+	}//end for j...
+
+	return( _streamValid && ((diff/(AC_GRID * AC_GRID)) > _sceneCutLevel) );
+}//end SceneCut.
@@ -0,0 +1,417 @@
+/** @file
+
+MODULE				: FastAvx2RGB24toYUV420Converter
+
+TAG						: FAVX2RGBYUVC
+
+FILE NAME			: FastAvx2RGB24toYUV420Converter.cpp
+
+DESCRIPTION		: Fixed point AVX2 RGB 24 bit to YUV420 colour conversion derived
+								from the RGBtoYUV420Converter base class. The 32 pel inner loop
+								deinterleaves the packed pels with byte shuffles and averages the
+								2x2 chr in register. Output to 16 bit or 8 bit planes. The result
+								is identical to FastFixedPointRGB24toYUV420Converter.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "FastAvx2RGB24toYUV420Converter.h"
+
+/*
+===========================================================================
+	Constants.
+===========================================================================
+*/
+/// Same fixed point coefficients as FastFixedPointRGB24toYUV420Converter.
+#define FAVX2RGBYUVC_PRECISION	13
+#define FAVX2RGBYUVC_COEFF(x)		(static_cast<int>(0.5 + (x) * (1 << FAVX2RGBYUVC_PRECISION)))
+
+const int FAVX2RGBYUVC_00 = FAVX2RGBYUVC_COEFF( 0.299);
+const int FAVX2RGBYUVC_01 = FAVX2RGBYUVC_COEFF( 0.587);
+const int FAVX2RGBYUVC_02 = FAVX2RGBYUVC_COEFF( 0.114);
+const int FAVX2RGBYUVC_10 = FAVX2RGBYUVC_COEFF(-0.147);
+const int FAVX2RGBYUVC_11 = FAVX2RGBYUVC_COEFF(-0.289);
+const int FAVX2RGBYUVC_12 = FAVX2RGBYUVC_COEFF( 0.436);
+const int FAVX2RGBYUVC_20 = FAVX2RGBYUVC_COEFF( 0.615);
+const int FAVX2RGBYUVC_21 = FAVX2RGBYUVC_COEFF(-0.515);
+const int FAVX2RGBYUVC_22 = FAVX2RGBYUVC_COEFF(-0.100);
+
+#define FAVX2RGBYUVC_RANGECHECK_0TO255(x) ( (((x) <= 255)&&((x) >= 0))?((x)):( ((x) > 255)?(255):(0) ) )
+#define FAVX2RGBYUVC_RANGECHECK_N128TO127(x) ( (((x) <= 127)&&((x) >= -128))?((x)):( ((x) > 127)?(127):(-128) ) )
+
+/*
+---------------------------------------------------------------------------
+	Scalar 2x2 block conversion.
+---------------------------------------------------------------------------
+*/
+static inline void FAVX2RGBYUVC_Store(yuvType* p, int x)				{ *p = (yuvType)x; }
+static inline void FAVX2RGBYUVC_Store(unsigned char* p, int x)	{ *p = (unsigned char)FAVX2RGBYUVC_RANGECHECK_0TO255(x); }
+
+/// Convert the 2x2 block with top left pels at t0 (top row) and t1 (bottom row).
+template<int PelBytes, typename T>
+static inline void FAVX2RGBYUVC_Block(const unsigned char* t0, const unsigned char* t1, T* py0, T* py1, T* pu, T* pv, int chrOff)
+{
+	int u = 0;
+	int v = 0;
+	const unsigned char* t[4] = { t0, t0 + PelBytes, t1, t1 + PelBytes };
+	T* py[4] = { py0, py0 + 1, py1, py1 + 1 };
+	for(int i = 0; i < 4; i++)
+	{
+		int b = (int)t[i][0];
+		int g = (int)t[i][1];
+		int r = (int)t[i][2];
+		int y = (FAVX2RGBYUVC_00*r + FAVX2RGBYUVC_01*g + FAVX2RGBYUVC_02*b) >> FAVX2RGBYUVC_PRECISION;
+		FAVX2RGBYUVC_Store(py[i], FAVX2RGBYUVC_RANGECHECK_0TO255(y));
+		u += FAVX2RGBYUVC_10*r + FAVX2RGBYUVC_11*g + FAVX2RGBYUVC_12*b;
+		v += FAVX2RGBYUVC_20*r + FAVX2RGBYUVC_21*g + FAVX2RGBYUVC_22*b;
+	}//end for i...
+
+	/// Average the 4 chr values.
+	int iu = u >> FAVX2RGBYUVC_PRECISION;
+	int iv = v >> FAVX2RGBYUVC_PRECISION;
+	iu += (iu < 0) ? -2 : 2;	///< Rounding.
+	iv += (iv < 0) ? -2 : 2;
+	FAVX2RGBYUVC_Store(pu, chrOff + FAVX2RGBYUVC_RANGECHECK_N128TO127(iu >> 2));
+	FAVX2RGBYUVC_Store(pv, chrOff + FAVX2RGBYUVC_RANGECHECK_N128TO127(iv >> 2));
+}//end FAVX2RGBYUVC_Block.
+
+/*
+---------------------------------------------------------------------------
+	Cpu feature detection and AVX2 code generation. The kernels are compiled
+	for AVX2 with a target attribute and selected at run time so that the
+	translation unit needs no AVX2 build flags.
+---------------------------------------------------------------------------
+*/
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FAVX2RGBYUVC_AVX2
+#define FAVX2RGBYUVC_AVX2_TARGET	__attribute__((target("avx2")))
+#include <immintrin.h>
+static int FAVX2RGBYUVC_CpuHasAvx2(void) { __builtin_cpu_init(); return(__builtin_cpu_supports("avx2") ? 1 : 0); }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define FAVX2RGBYUVC_AVX2
+#define FAVX2RGBYUVC_AVX2_TARGET
+#include <intrin.h>
+#include <immintrin.h>
+static int FAVX2RGBYUVC_CpuHasAvx2(void)
+{
+	int info[4];
+	__cpuid(info, 0);
+	if(info[0] < 7)
+		return(0);
+	__cpuid(info, 1);
+	/// OSXSAVE and AVX with the ymm state enabled by the OS.
+	if( ((info[2] & (1 << 27)) == 0)||((info[2] & (1 << 28)) == 0) )
+		return(0);
+	if((_xgetbv(0) & 6) != 6)
+		return(0);
+	__cpuidex(info, 7, 0);
+	return( (info[1] & (1 << 5)) ? 1 : 0 );
+}//end FAVX2RGBYUVC_CpuHasAvx2.
+#endif
+
+/*
+---------------------------------------------------------------------------
+	AVX2 32 pel kernels.
+---------------------------------------------------------------------------
+*/
+#ifdef FAVX2RGBYUVC_AVX2
+
+#define FAVX2RGBYUVC_Z	(char)0x80	///< Shuffle to zero.
+/// Byte shuffle of pel j from a lane offset o into a 16 bit (r,g) pair or a (b,0) pair.
+#define FAVX2RGBYUVC_RG(s,o,j)	(char)((o)+(s)*(j)+2), FAVX2RGBYUVC_Z, (char)((o)+(s)*(j)+1), FAVX2RGBYUVC_Z
+#define FAVX2RGBYUVC_B(s,o,j)		(char)((o)+(s)*(j)), FAVX2RGBYUVC_Z, FAVX2RGBYUVC_Z, FAVX2RGBYUVC_Z
+
+/// Two 16 bit coefficients in each 32 bit lane for use with madd.
+FAVX2RGBYUVC_AVX2_TARGET
+static inline __m256i FAVX2RGBYUVC_Pair(int lo, int hi)
+{
+	return(_mm256_set1_epi32( (int)( ((unsigned int)(hi & 0xFFFF) << 16)|(unsigned int)(lo & 0xFFFF) ) ));
+}//end FAVX2RGBYUVC_Pair.
+
+/** Load 8 consecutive pels into a register with pels 0..3 in the low lane and
+pels 4..7 in the high lane. RGB24 loads bytes [0..15] and [8..23] so that
+there is no read beyond the 8th pel. The high lane pels then start at byte 4. */
+template<int PelBytes>
+FAVX2RGBYUVC_AVX2_TARGET
+static inline __m256i FAVX2RGBYUVC_Load8(const unsigned char* p);
+template<>
+FAVX2RGBYUVC_AVX2_TARGET
+inline __m256i FAVX2RGBYUVC_Load8<3>(const unsigned char* p)
+{
+	return(_mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)), _mm_loadu_si128((const __m128i *)(p + 8)), 1));
+}//end FAVX2RGBYUVC_Load8<3>.
+template<>
+FAVX2RGBYUVC_AVX2_TARGET
+inline __m256i FAVX2RGBYUVC_Load8<4>(const unsigned char* p)
+{
+	return(_mm256_loadu_si256((const __m256i *)p));
+}//end FAVX2RGBYUVC_Load8<4>.
+
+/// Kernel constants held in registers across the row loops.
+typedef struct _FAVX2RGBYUVC_K
+{
+	__m256i	rgMask, bMask;
+	__m256i	yRg, yB, uRg, uB, vRg, vB;
+	__m256i	two, chrMin, chrMax, chrOff, lumMax, chrPerm;
+} FAVX2RGBYUVC_K;
+
+template<int PelBytes>
+FAVX2RGBYUVC_AVX2_TARGET
+static inline void FAVX2RGBYUVC_Init(FAVX2RGBYUVC_K* k, int chrOff)
+{
+	const int s		= PelBytes;
+	const int o1	= (PelBytes == 3) ? 4 : 0;	///< High lane pel offset.
+	k->rgMask	= _mm256_setr_epi8(FAVX2RGBYUVC_RG(s,0,0), FAVX2RGBYUVC_RG(s,0,1), FAVX2RGBYUVC_RG(s,0,2), FAVX2RGBYUVC_RG(s,0,3),
+															 FAVX2RGBYUVC_RG(s,o1,0), FAVX2RGBYUVC_RG(s,o1,1), FAVX2RGBYUVC_RG(s,o1,2), FAVX2RGBYUVC_RG(s,o1,3));
+	k->bMask	= _mm256_setr_epi8(FAVX2RGBYUVC_B(s,0,0), FAVX2RGBYUVC_B(s,0,1), FAVX2RGBYUVC_B(s,0,2), FAVX2RGBYUVC_B(s,0,3),
+															 FAVX2RGBYUVC_B(s,o1,0), FAVX2RGBYUVC_B(s,o1,1), FAVX2RGBYUVC_B(s,o1,2), FAVX2RGBYUVC_B(s,o1,3));
+	k->yRg		= FAVX2RGBYUVC_Pair(FAVX2RGBYUVC_00, FAVX2RGBYUVC_01);
+	k->yB			= FAVX2RGBYUVC_Pair(FAVX2RGBYUVC_02, 0);
+	k->uRg		= FAVX2RGBYUVC_Pair(FAVX2RGBYUVC_10, FAVX2RGBYUVC_11);
+	k->uB			= FAVX2RGBYUVC_Pair(FAVX2RGBYUVC_12, 0);
+	k->vRg		= FAVX2RGBYUVC_Pair(FAVX2RGBYUVC_20, FAVX2RGBYUVC_21);
+	k->vB			= FAVX2RGBYUVC_Pair(FAVX2RGBYUVC_22, 0);
+	k->two		= _mm256_set1_epi32(2);
+	k->chrMin	= _mm256_set1_epi32(-128);
+	k->chrMax	= _mm256_set1_epi32(127);
+	k->chrOff	= _mm256_set1_epi32(chrOff);
+	k->lumMax	= _mm256_set1_epi16(255);
+	k->chrPerm	= _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+}//end FAVX2RGBYUVC_Init.
+
+/** Convert 8 pels of a row pair. The lum of each row is returned as 8 x 32 bit
+values in pel order and the 4 chr sums of the 2x2 blocks are returned as
+[u0 u1 v0 v1 | u2 u3 v2 v3]. */
+template<int PelBytes>
+FAVX2RGBYUVC_AVX2_TARGET
+static inline __m256i FAVX2RGBYUVC_Pels8(const FAVX2RGBYUVC_K* k, const unsigned char* t0, const unsigned char* t1, __m256i* y0, __m256i* y1)
+{
+	__m256i x		= FAVX2RGBYUVC_Load8<PelBytes>(t0);
+	__m256i rg	= _mm256_shuffle_epi8(x, k->rgMask);
+	__m256i b		= _mm256_shuffle_epi8(x, k->bMask);
+	*y0					= _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(rg, k->yRg), _mm256_madd_epi16(b, k->yB)), FAVX2RGBYUVC_PRECISION);
+	__m256i u		= _mm256_add_epi32(_mm256_madd_epi16(rg, k->uRg), _mm256_madd_epi16(b, k->uB));
+	__m256i v		= _mm256_add_epi32(_mm256_madd_epi16(rg, k->vRg), _mm256_madd_epi16(b, k->vB));
+
+	x						= FAVX2RGBYUVC_Load8<PelBytes>(t1);
+	rg					= _mm256_shuffle_epi8(x, k->rgMask);
+	b						= _mm256_shuffle_epi8(x, k->bMask);
+	*y1					= _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(rg, k->yRg), _mm256_madd_epi16(b, k->yB)), FAVX2RGBYUVC_PRECISION);
+	u						= _mm256_add_epi32(u, _mm256_add_epi32(_mm256_madd_epi16(rg, k->uRg), _mm256_madd_epi16(b, k->uB)));
+	v						= _mm256_add_epi32(v, _mm256_add_epi32(_mm256_madd_epi16(rg, k->vRg), _mm256_madd_epi16(b, k->vB)));
+
+	/// Horizontal pel pairs complete the 2x2 sums.
+	__m256i uv	= _mm256_hadd_epi32(u, v);
+
+	/// Average with the same rounding as the scalar path.
+	uv = _mm256_srai_epi32(uv, FAVX2RGBYUVC_PRECISION);
+	uv = _mm256_add_epi32(uv, _mm256_add_epi32(k->two, _mm256_slli_epi32(_mm256_srai_epi32(uv, 31), 2)));
+	uv = _mm256_max_epi32(_mm256_min_epi32(_mm256_srai_epi32(uv, 2), k->chrMax), k->chrMin);
+	uv = _mm256_add_epi32(uv, k->chrOff);
+	return(_mm256_permutevar8x32_epi32(uv, k->chrPerm));	///< [u0 u1 u2 u3 v0 v1 v2 v3]
+}//end FAVX2RGBYUVC_Pels8.
+
+/// 16 x 32 bit values in two registers packed to 16 x 16 bit in order.
+FAVX2RGBYUVC_AVX2_TARGET
+static inline __m256i FAVX2RGBYUVC_Pack16(__m256i a, __m256i b)
+{
+	return(_mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+}//end FAVX2RGBYUVC_Pack16.
+
+FAVX2RGBYUVC_AVX2_TARGET
+static inline void FAVX2RGBYUVC_Store32(yuvType* p, __m256i a, __m256i b)
+{
+	_mm256_storeu_si256((__m256i *)p, a);
+	_mm256_storeu_si256((__m256i *)(p + 16), b);
+}//end FAVX2RGBYUVC_Store32.
+FAVX2RGBYUVC_AVX2_TARGET
+static inline void FAVX2RGBYUVC_Store32(unsigned char* p, __m256i a, __m256i b)
+{
+	_mm256_storeu_si256((__m256i *)p, _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+}//end FAVX2RGBYUVC_Store32.
+FAVX2RGBYUVC_AVX2_TARGET
+static inline void FAVX2RGBYUVC_Store16(yuvType* p, __m256i a)
+{
+	_mm256_storeu_si256((__m256i *)p, a);
+}//end FAVX2RGBYUVC_Store16.
+FAVX2RGBYUVC_AVX2_TARGET
+static inline void FAVX2RGBYUVC_Store16(unsigned char* p, __m256i a)
+{
+	_mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi16(a, a), _MM_SHUFFLE(3, 1, 2, 0))));
+}//end FAVX2RGBYUVC_Store16.
+
+/// Convert 32 pels of a row pair into 2 x 32 lum and 16 u and v values.
+template<int PelBytes, typename T>
+FAVX2RGBYUVC_AVX2_TARGET
+static inline void FAVX2RGBYUVC_Pels32(const FAVX2RGBYUVC_K* k, const unsigned char* t0, const unsigned char* t1, T* py0, T* py1, T* pu, T* pv)
+{
+	__m256i y0[4], y1[4], uv[4];
+	for(int g = 0; g < 4; g++)
+		uv[g] = FAVX2RGBYUVC_Pels8<PelBytes>(k, t0 + g*8*PelBytes, t1 + g*8*PelBytes, &(y0[g]), &(y1[g]));
+
+	/// Lum is in [0..255] by construction and the clamp is for safety only.
+	__m256i zero = _mm256_setzero_si256();
+	__m256i a, b;
+	a = _mm256_max_epi16(_mm256_min_epi16(FAVX2RGBYUVC_Pack16(y0[0], y0[1]), k->lumMax), zero);
+	b = _mm256_max_epi16(_mm256_min_epi16(FAVX2RGBYUVC_Pack16(y0[2], y0[3]), k->lumMax), zero);
+	FAVX2RGBYUVC_Store32(py0, a, b);
+	a = _mm256_max_epi16(_mm256_min_epi16(FAVX2RGBYUVC_Pack16(y1[0], y1[1]), k->lumMax), zero);
+	b = _mm256_max_epi16(_mm256_min_epi16(FAVX2RGBYUVC_Pack16(y1[2], y1[3]), k->lumMax), zero);
+	FAVX2RGBYUVC_Store32(py1, a, b);
+
+	/// Gather the u and v halves of the 4 groups.
+	__m256i u = FAVX2RGBYUVC_Pack16(_mm256_permute2x128_si256(uv[0], uv[1], 0x20), _mm256_permute2x128_si256(uv[2], uv[3], 0x20));
+	__m256i v = FAVX2RGBYUVC_Pack16(_mm256_permute2x128_si256(uv[0], uv[1], 0x31), _mm256_permute2x128_si256(uv[2], uv[3], 0x31));
+	FAVX2RGBYUVC_Store16(pu, u);
+	FAVX2RGBYUVC_Store16(pv, v);
+}//end FAVX2RGBYUVC_Pels32.
+
+/// Row pair in 16 block (32 pel) steps. Returns the num of 2x2 blocks converted.
+template<int PelBytes, typename T>
+FAVX2RGBYUVC_AVX2_TARGET
+static int FAVX2RGBYUVC_RowAvx2(const unsigned char* t0, const unsigned char* t1, T* py0, T* py1, T* pu0, T* pv0, int xBlks, int chrOff)
+{
+	FAVX2RGBYUVC_K k;
+	FAVX2RGBYUVC_Init<PelBytes>(&k, chrOff);
+	int xb = 0;
+	for(; (xb + 16) <= xBlks; xb += 16)
+	{
+		int x = xb << 1;
+		FAVX2RGBYUVC_Pels32<PelBytes, T>(&k, t0 + x*PelBytes, t1 + x*PelBytes, py0 + x, py1 + x, pu0 + xb, pv0 + xb);
+	}//end for xb...
+	return(xb);
+}//end FAVX2RGBYUVC_RowAvx2.
+
+#endif // FAVX2RGBYUVC_AVX2
+
+/*
+---------------------------------------------------------------------------
+	Frame conversion.
+---------------------------------------------------------------------------
+*/
+template<int PelBytes, typename T>
+static void FAVX2RGBYUVC_Convert(const unsigned char* src, T* py, T* pu, T* pv, int width, int height, int chrOff, bool flip, int avx2)
+{
+	int xBlks		= width >> 1;
+	int yBlks		= height >> 1;
+	int rowLen	= width * PelBytes;
+
+	for(int yb = 0; yb < yBlks; yb++)
+	{
+		int row = yb << 1;
+		/// Flipped input is read bottom up.
+		const unsigned char* t0 = src + (flip ? (height - row - 1) : row) * rowLen;
+		const unsigned char* t1 = flip ? (t0 - rowLen) : (t0 + rowLen);
+		T* py0 = py + row * width;
+		T* py1 = py0 + width;
+		T* pu0 = pu + yb * xBlks;
+		T* pv0 = pv + yb * xBlks;
+
+		int xb = 0;
+#ifdef FAVX2RGBYUVC_AVX2
+		if(avx2)
+			xb = FAVX2RGBYUVC_RowAvx2<PelBytes, T>(t0, t1, py0, py1, pu0, pv0, xBlks, chrOff);
+#endif
+		for(; xb < xBlks; xb++)
+		{
+			int x = xb << 1;
+			FAVX2RGBYUVC_Block<PelBytes, T>(t0 + x*PelBytes, t1 + x*PelBytes, py0 + x, py1 + x, pu0 + xb, pv0 + xb, chrOff);
+		}//end for xb...
+	}//end for yb...
+
+}//end FAVX2RGBYUVC_Convert.
+
+/*
+===========================================================================
+	Interface Methods.
+===========================================================================
+*/
+/** Fixed point conversion.
+The YUV output is represented with 8 bits per pel and the UV components are
+adjusted from their -128..127 range by the chr offset.
+@param pRgb	: Packed BGR 888 or BGRA 8888 format.
+@param pY		: Lum plane.
+@param pU		: Chr U plane.
+@param pV		: Chr V plane.
+@return			: none.
+*/
+void FastAvx2RGB24toYUV420Converter::Convert(void* pRgb, void* pY, void* pU, void* pV)
+{
+	const unsigned char* src = (const unsigned char *)pRgb;
+	const int avx2 = HasAvx2();
+
+	if(_byteOutput)
+	{
+		unsigned char* py = (unsigned char *)pY;
+		unsigned char* pu = (unsigned char *)pU;
+		unsigned char* pv = (unsigned char *)pV;
+		if(_pelBytes == 4)
+			FAVX2RGBYUVC_Convert<4, unsigned char>(src, py, pu, pv, _width, _height, _chrOff, _flip, avx2);
+		else
+			FAVX2RGBYUVC_Convert<3, unsigned char>(src, py, pu, pv, _width, _height, _chrOff, _flip, avx2);
+	}//end if _byteOutput...
+	else
+	{
+		yuvType* py = (yuvType *)pY;
+		yuvType* pu = (yuvType *)pU;
+		yuvType* pv = (yuvType *)pV;
+		if(_pelBytes == 4)
+			FAVX2RGBYUVC_Convert<4, yuvType>(src, py, pu, pv, _width, _height, _chrOff, _flip, avx2);
+		else
+			FAVX2RGBYUVC_Convert<3, yuvType>(src, py, pu, pv, _width, _height, _chrOff, _flip, avx2);
+	}//end else...
+
+}//end Convert.
+
+/** Does the cpu support the AVX2 kernel.
+The check is made once and cached.
+@return	: 1 = AVX2 kernel in use, 0 = scalar path.
+*/
+int FastAvx2RGB24toYUV420Converter::HasAvx2(void)
+{
+#ifdef FAVX2RGBYUVC_AVX2
+	static const int avx2 = FAVX2RGBYUVC_CpuHasAvx2();
+	return(avx2);
+#else
+	return(0);
+#endif
+}//end HasAvx2.
+
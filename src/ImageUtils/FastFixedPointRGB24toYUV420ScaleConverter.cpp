@@ -0,0 +1,355 @@
+/** @file
+
+MODULE				: FastFixedPointRGB24toYUV420ScaleConverter
+
+TAG						: FFPRGBYUVSC
+
+FILE NAME			: FastFixedPointRGB24toYUV420ScaleConverter.cpp
+
+DESCRIPTION		: Fused fixed point RGB 24 bit to YUV420 colour conversion and
+								scaling in a single pass. Each output row converts only the input
+								rows its 3x3 filter taps need into small row rings, replacing the
+								full size intermediate YUV frame of a separate converter and
+								PicScalerYUV420PImpl pass. The output is identical to
+								FastFixedPointRGB24toYUV420Converter followed by the
+								PicScalerYUV420PImpl filter.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "FastFixedPointRGB24toYUV420ScaleConverter.h"
+
+/*
+===========================================================================
+	Constants.
+===========================================================================
+*/
+/// Same fixed point coefficients as FastFixedPointRGB24toYUV420Converter.
+#define FFPRGBYUVSC_PRECISION	13
+#define FFPRGBYUVSC_COEFF(x)		(static_cast<int>(0.5 + (x) * (1 << FFPRGBYUVSC_PRECISION)))
+
+const int FFPRGBYUVSC_00 = FFPRGBYUVSC_COEFF( 0.299);
+const int FFPRGBYUVSC_01 = FFPRGBYUVSC_COEFF( 0.587);
+const int FFPRGBYUVSC_02 = FFPRGBYUVSC_COEFF( 0.114);
+const int FFPRGBYUVSC_10 = FFPRGBYUVSC_COEFF(-0.147);
+const int FFPRGBYUVSC_11 = FFPRGBYUVSC_COEFF(-0.289);
+const int FFPRGBYUVSC_12 = FFPRGBYUVSC_COEFF( 0.436);
+const int FFPRGBYUVSC_20 = FFPRGBYUVSC_COEFF( 0.615);
+const int FFPRGBYUVSC_21 = FFPRGBYUVSC_COEFF(-0.515);
+const int FFPRGBYUVSC_22 = FFPRGBYUVSC_COEFF(-0.100);
+
+#define FFPRGBYUVSC_RANGECHECK_0TO255(x) ( (((x) <= 255)&&((x) >= 0))?((x)):( ((x) > 255)?(255):(0) ) )
+#define FFPRGBYUVSC_RANGECHECK_N128TO127(x) ( (((x) <= 127)&&((x) >= -128))?((x)):( ((x) > 127)?(127):(-128) ) )
+#define FFPRGBYUVSC_CLAMP(x, hi) ( ((x) < 0) ? 0 : ( ((x) > (hi)) ? (hi) : (x) ) )
+
+/*
+===========================================================================
+	Private Methods.
+===========================================================================
+*/
+void FastFixedPointRGB24toYUV420ScaleConverter::ResetMembers(void)
+{
+	_createdWidth			= 0;
+	_createdHeight		= 0;
+	_createdWidthOut	= 0;
+	_createdHeightOut	= 0;
+
+	_pRowMem	= NULL;
+	for(int i = 0; i < FFPRGBYUVSC_RING_ROWS; i++)
+	{
+		_pLumRing[i]	= NULL;
+		_lumTag[i]		= -1;
+		_pURing[i]		= NULL;
+		_pVRing[i]		= NULL;
+		_chrTag[i]		= -1;
+	}//end for i...
+
+	_pTapMem	= NULL;
+	_pLumRow	= NULL;
+	_pLumCol	= NULL;
+	_pChrRow	= NULL;
+	_pChrCol	= NULL;
+}//end ResetMembers.
+
+/** Get a converted lum row.
+The row is converted into the ring slot for its index if it is not already
+there. The filter taps of consecutive output rows are non-decreasing so the
+3 rows of an output row never share a slot.
+@param pRgb	: Packed RGB 888 input image.
+@param row	: Input row.
+@return			: Lum row of the input width.
+*/
+yuvType* FastFixedPointRGB24toYUV420ScaleConverter::GetLumRow(unsigned char* pRgb, int row)
+{
+	int slot = row % FFPRGBYUVSC_RING_ROWS;
+	yuvType* py = _pLumRing[slot];
+	if(_lumTag[slot] == row)
+		return(py);
+
+	const unsigned char* t = RgbRow(pRgb, row);
+	int width = (_width >> 1) << 1;
+	for(int x = 0; x < width; x++, t += 3)
+	{
+		int b = (int)t[0];
+		int g = (int)t[1];
+		int r = (int)t[2];
+		py[x] = (yuvType)FFPRGBYUVSC_RANGECHECK_0TO255(((FFPRGBYUVSC_00*r + FFPRGBYUVSC_01*g + FFPRGBYUVSC_02*b) >> FFPRGBYUVSC_PRECISION));
+	}//end for x...
+	_lumTag[slot] = row;
+	return(py);
+}//end GetLumRow.
+
+/** Get a converted chr row pair.
+The chr of input rows 2*chrRow and 2*chrRow+1 are averaged over each 2x2 pel
+block with the same rounding as FastFixedPointRGB24toYUV420Converter.
+@param pRgb		: Packed RGB 888 input image.
+@param chrRow	: Input chr row.
+@param ppU		: Returned U row of half the input width.
+@param ppV		: Returned V row of half the input width.
+@return				: 1 = converted, 0 = from the ring.
+*/
+int FastFixedPointRGB24toYUV420ScaleConverter::GetChrRows(unsigned char* pRgb, int chrRow, yuvType** ppU, yuvType** ppV)
+{
+	int slot = chrRow % FFPRGBYUVSC_RING_ROWS;
+	yuvType* pu = _pURing[slot];
+	yuvType* pv = _pVRing[slot];
+	*ppU = pu;
+	*ppV = pv;
+	if(_chrTag[slot] == chrRow)
+		return(0);
+
+	const unsigned char* t0 = RgbRow(pRgb, 2*chrRow);
+	const unsigned char* t1 = RgbRow(pRgb, 2*chrRow + 1);
+	int xBlks = _width >> 1;
+	for(int xb = 0; xb < xBlks; xb++, t0 += 6, t1 += 6)
+	{
+		const unsigned char* t[4] = { t0, t0 + 3, t1, t1 + 3 };
+		int u = 0;
+		int v = 0;
+		for(int i = 0; i < 4; i++)
+		{
+			int b = (int)t[i][0];
+			int g = (int)t[i][1];
+			int r = (int)t[i][2];
+			u += FFPRGBYUVSC_10*r + FFPRGBYUVSC_11*g + FFPRGBYUVSC_12*b;
+			v += FFPRGBYUVSC_20*r + FFPRGBYUVSC_21*g + FFPRGBYUVSC_22*b;
+		}//end for i...
+
+		/// Average the 4 chr values.
+		int iu = u >> FFPRGBYUVSC_PRECISION;
+		int iv = v >> FFPRGBYUVSC_PRECISION;
+		iu += (iu < 0) ? -2 : 2;	///< Rounding.
+		iv += (iv < 0) ? -2 : 2;
+		pu[xb] = (yuvType)( _chrOff + FFPRGBYUVSC_RANGECHECK_N128TO127(iu >> 2) );
+		pv[xb] = (yuvType)( _chrOff + FFPRGBYUVSC_RANGECHECK_N128TO127(iv >> 2) );
+	}//end for xb...
+	_chrTag[slot] = chrRow;
+	return(1);
+}//end GetChrRows.
+
+/*
+===========================================================================
+	Public Methods.
+===========================================================================
+*/
+/** Allocate the rings and tap tables.
+The input positions are the nearest neighbours of the PicScalerYUV420PImpl
+scaler with the filter taps clamped to the image boundaries.
+@return	: 1 = success, 0 = failed.
+*/
+int FastFixedPointRGB24toYUV420ScaleConverter::Create(void)
+{
+	Destroy();
+
+	if( (_width < 2)||(_height < 2)||(_widthOut < 2)||(_heightOut < 2) )
+		return(0);
+
+	int chrWidthIn		= _width/2;
+	int chrHeightIn		= _height/2;
+	int chrWidthOut		= _widthOut/2;
+	int chrHeightOut	= _heightOut/2;
+
+	/// Row rings.
+	int ringLen = FFPRGBYUVSC_RING_ROWS * (_width + 2*chrWidthIn);
+	_pRowMem = new yuvType[ringLen];
+	if(_pRowMem == NULL)
+		return(0);
+	yuvType* p = _pRowMem;
+	for(int i = 0; i < FFPRGBYUVSC_RING_ROWS; i++)
+	{
+		_pLumRing[i]	= p;	p += _width;
+		_pURing[i]		= p;	p += chrWidthIn;
+		_pVRing[i]		= p;	p += chrWidthIn;
+	}//end for i...
+
+	/// Tap tables.
+	int tapLen = _heightOut + 3*_widthOut + chrHeightOut + 3*chrWidthOut;
+	_pTapMem = new int[tapLen];
+	if(_pTapMem == NULL)
+	{
+		Destroy();
+		return(0);
+	}//end if !_pTapMem...
+	_pLumRow	= _pTapMem;
+	_pLumCol	= _pLumRow + _heightOut;
+	_pChrRow	= _pLumCol + 3*_widthOut;
+	_pChrCol	= _pChrRow + chrHeightOut;
+
+	double scalex = ((double)_width)/((double)_widthOut);
+	double scaley = ((double)_height)/((double)_heightOut);
+	int x, y, j;
+	for(y = 0; y < _heightOut; y++)
+		_pLumRow[y] = FFPRGBYUVSC_CLAMP((int)((scaley * (double)y) + 0.5), _height - 1);
+	for(x = 0; x < _widthOut; x++)
+	{
+		int posx = FFPRGBYUVSC_CLAMP((int)((scalex * (double)x) + 0.5), _width - 1);
+		for(j = -1; j <= 1; j++)
+			_pLumCol[3*x + j + 1] = FFPRGBYUVSC_CLAMP(posx + j, _width - 1);
+	}//end for x...
+	for(y = 0; y < chrHeightOut; y++)
+		_pChrRow[y] = FFPRGBYUVSC_CLAMP((int)((scaley * (double)y) + 0.5), chrHeightIn - 1);
+	for(x = 0; x < chrWidthOut; x++)
+	{
+		int posx = FFPRGBYUVSC_CLAMP((int)((scalex * (double)x) + 0.5), chrWidthIn - 1);
+		for(j = -1; j <= 1; j++)
+			_pChrCol[3*x + j + 1] = FFPRGBYUVSC_CLAMP(posx + j, chrWidthIn - 1);
+	}//end for x...
+
+	_createdWidth			= _width;
+	_createdHeight		= _height;
+	_createdWidthOut	= _widthOut;
+	_createdHeightOut	= _heightOut;
+	return(1);
+}//end Create.
+
+void FastFixedPointRGB24toYUV420ScaleConverter::Destroy(void)
+{
+	if(_pRowMem != NULL)
+		delete[] _pRowMem;
+	if(_pTapMem != NULL)
+		delete[] _pTapMem;
+	ResetMembers();
+}//end Destroy.
+
+/*
+===========================================================================
+	Interface Methods.
+===========================================================================
+*/
+/** Convert and scale.
+Each output pel is the weighted 3x3 FIR filter of PicScalerYUV420PImpl
+(centre weight 8, neighbours 1) around its nearest input pel.
+@param pRgb	: Packed RGB 888 input image of the input dimensions.
+@param pY		: Lum plane of the output dimensions.
+@param pU		: Chr U plane of the output dimensions.
+@param pV		: Chr V plane of the output dimensions.
+@return			: none.
+*/
+void FastFixedPointRGB24toYUV420ScaleConverter::Convert(void* pRgb, void* pY, void* pU, void* pV)
+{
+	if( (_createdWidth != _width)||(_createdHeight != _height)||(_createdWidthOut != _widthOut)||(_createdHeightOut != _heightOut) )
+	{
+		if(!Create())
+			return;
+	}//end if dimensions...
+
+	unsigned char*	src	= (unsigned char *)pRgb;
+	yuvType*				py	= (yuvType *)pY;
+	yuvType*				pu	= (yuvType *)pU;
+	yuvType*				pv	= (yuvType *)pV;
+	int x, y, i;
+
+	/// The ring contents belong to the previous frame.
+	for(i = 0; i < FFPRGBYUVSC_RING_ROWS; i++)
+	{
+		_lumTag[i] = -1;
+		_chrTag[i] = -1;
+	}//end for i...
+
+	/// Lum.
+	for(y = 0; y < _heightOut; y++)
+	{
+		int posy = _pLumRow[y];
+		const yuvType* r[3];
+		for(i = -1; i <= 1; i++)
+			r[i + 1] = GetLumRow(src, FFPRGBYUVSC_CLAMP(posy + i, _height - 1));
+
+		yuvType* out = py + y*_widthOut;
+		const int* col = _pLumCol;
+		for(x = 0; x < _widthOut; x++, col += 3)
+		{
+			int lum = 8*(int)r[1][col[1]] + (int)r[1][col[0]] + (int)r[1][col[2]] +
+								(int)r[0][col[0]] + (int)r[0][col[1]] + (int)r[0][col[2]] +
+								(int)r[2][col[0]] + (int)r[2][col[1]] + (int)r[2][col[2]];
+			out[x] = (yuvType)((lum + 8) >> 4);
+		}//end for x...
+	}//end for y...
+
+	/// Chr U and V.
+	int chrHeightIn		= _height/2;
+	int chrWidthOut		= _widthOut/2;
+	int chrHeightOut	= _heightOut/2;
+	for(y = 0; y < chrHeightOut; y++)
+	{
+		int posy = _pChrRow[y];
+		yuvType* ru[3];
+		yuvType* rv[3];
+		for(i = -1; i <= 1; i++)
+			GetChrRows(src, FFPRGBYUVSC_CLAMP(posy + i, chrHeightIn - 1), &(ru[i + 1]), &(rv[i + 1]));
+
+		yuvType* outU = pu + y*chrWidthOut;
+		yuvType* outV = pv + y*chrWidthOut;
+		const int* col = _pChrCol;
+		for(x = 0; x < chrWidthOut; x++, col += 3)
+		{
+			int chrU = 8*(int)ru[1][col[1]] + (int)ru[1][col[0]] + (int)ru[1][col[2]] +
+								 (int)ru[0][col[0]] + (int)ru[0][col[1]] + (int)ru[0][col[2]] +
+								 (int)ru[2][col[0]] + (int)ru[2][col[1]] + (int)ru[2][col[2]];
+			int chrV = 8*(int)rv[1][col[1]] + (int)rv[1][col[0]] + (int)rv[1][col[2]] +
+								 (int)rv[0][col[0]] + (int)rv[0][col[1]] + (int)rv[0][col[2]] +
+								 (int)rv[2][col[0]] + (int)rv[2][col[1]] + (int)rv[2][col[2]];
+			outU[x] = (yuvType)((chrU + 8) >> 4);
+			outV[x] = (yuvType)((chrV + 8) >> 4);
+		}//end for x...
+	}//end for y...
+
+}//end Convert.
+
@@ -0,0 +1,525 @@
+/** @file
+
+MODULE				: FastSimdYUV420toRGBConverter
+
+TAG						: FSYUVRGBC
+
+FILE NAME			: FastSimdYUV420toRGBConverter.cpp
+
+DESCRIPTION		: SIMD YUV420 to RGB24, RGB32 and RGB16 colour conversion derived
+								from the YUV420toRGBConverter base class. The SSE2 or AVX2 row
+								kernels are selected at run time from the cpu features and an
+								equivalent scalar path handles rotation and the row tails. The
+								inverted (bottom up) and byte write layouts are thin derived
+								classes of the same implementation.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "FastSimdYUV420toRGBConverter.h"
+
+/*
+===========================================================================
+	Constants.
+===========================================================================
+*/
+/// RealYUV420toRGB24ConverterImpl2 coefficients in 13 bit fixed point. The
+/// chr terms are reduced to 6 fractional bits so that the per pel sums fit
+/// 16 bit arithmetic.
+#define FSYUVRGBC_COEFF(x)	(static_cast<int>((x) * 8192.0 + (((x) < 0.0) ? -0.5 : 0.5)))
+
+const int FSYUVRGBC_U0 = FSYUVRGBC_COEFF( 2.032);	///< B
+const int FSYUVRGBC_U1 = FSYUVRGBC_COEFF(-0.394);	///< G
+const int FSYUVRGBC_V1 = FSYUVRGBC_COEFF(-0.581);	///< G
+const int FSYUVRGBC_V0 = FSYUVRGBC_COEFF( 1.140);	///< R
+
+#define FSYUVRGBC_RANGECHECK_0TO255(x) ( (((x) <= 255)&&((x) >= 0))?((x)):( ((x) > 255)?(255):(0) ) )
+
+/// Chr term with 6 fractional bits and the final 0.5 rounding built in.
+#define FSYUVRGBC_CHR(m)	((((m) + 64) >> 7) + 32)
+
+/// Bytes per output pel.
+#define FSYUVRGBC_PELBYTES(fmt)	( ((fmt) == FSYUVRGBC_RGB24) ? 3 : ( ((fmt) == FSYUVRGBC_RGB32) ? 4 : 2 ) )
+
+/*
+---------------------------------------------------------------------------
+	Cpu feature detection and AVX2 code generation.
+---------------------------------------------------------------------------
+*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define FSYUVRGBC_HAVE_SSE2
+#include <emmintrin.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FSYUVRGBC_HAVE_AVX2
+#define FSYUVRGBC_AVX2_TARGET	__attribute__((target("avx2")))
+#include <immintrin.h>
+static int FSYUVRGBC_CpuHasAvx2(void) { __builtin_cpu_init(); return(__builtin_cpu_supports("avx2") ? 1 : 0); }
+#elif defined(_MSC_VER)
+#define FSYUVRGBC_HAVE_AVX2
+#define FSYUVRGBC_AVX2_TARGET
+#include <intrin.h>
+#include <immintrin.h>
+static int FSYUVRGBC_CpuHasAvx2(void)
+{
+	int info[4];
+	__cpuid(info, 0);
+	if(info[0] < 7)
+		return(0);
+	__cpuid(info, 1);
+	/// OSXSAVE and AVX with the ymm state enabled by the OS.
+	if( ((info[2] & (1 << 27)) == 0)||((info[2] & (1 << 28)) == 0) )
+		return(0);
+	if((_xgetbv(0) & 6) != 6)
+		return(0);
+	__cpuidex(info, 7, 0);
+	return( (info[1] & (1 << 5)) ? 1 : 0 );
+}//end FSYUVRGBC_CpuHasAvx2.
+#endif
+
+#endif // SSE2
+
+/*
+---------------------------------------------------------------------------
+	Scalar pels.
+---------------------------------------------------------------------------
+*/
+template<int Fmt>
+static inline void FSYUVRGBC_Pel(unsigned char* o, int b, int g, int r)
+{
+	b = FSYUVRGBC_RANGECHECK_0TO255(b);
+	g = FSYUVRGBC_RANGECHECK_0TO255(g);
+	r = FSYUVRGBC_RANGECHECK_0TO255(r);
+	if(Fmt == FSYUVRGBC_RGB16)
+	{
+		unsigned short x = (unsigned short)( ((r & 0xF8) << 8)|((g & 0xFC) << 3)|(b >> 3) );
+		memcpy(o, &x, 2);
+	}//end if RGB16...
+	else
+	{
+		o[0] = (unsigned char)b;
+		o[1] = (unsigned char)g;
+		o[2] = (unsigned char)r;
+		if(Fmt == FSYUVRGBC_RGB32)
+			o[3] = 0;
+	}//end else...
+}//end FSYUVRGBC_Pel.
+
+/// Convert the 2x2 block of pels sharing chr u,v. The output pels are at o00, o00+step and o10, o10+step.
+template<int Fmt>
+static inline void FSYUVRGBC_Block(int l00, int l01, int l10, int l11, int u, int v, unsigned char* o00, unsigned char* o10, int step)
+{
+	u -= 128;
+	v -= 128;
+	int cb = FSYUVRGBC_CHR(FSYUVRGBC_U0*u);
+	int cg = FSYUVRGBC_CHR(FSYUVRGBC_U1*u + FSYUVRGBC_V1*v);
+	int cr = FSYUVRGBC_CHR(FSYUVRGBC_V0*v);
+	l00 <<= 6; l01 <<= 6; l10 <<= 6; l11 <<= 6;
+	FSYUVRGBC_Pel<Fmt>(o00,				(l00 + cb) >> 6, (l00 + cg) >> 6, (l00 + cr) >> 6);
+	FSYUVRGBC_Pel<Fmt>(o00 + step,	(l01 + cb) >> 6, (l01 + cg) >> 6, (l01 + cr) >> 6);
+	FSYUVRGBC_Pel<Fmt>(o10,				(l10 + cb) >> 6, (l10 + cg) >> 6, (l10 + cr) >> 6);
+	FSYUVRGBC_Pel<Fmt>(o10 + step,	(l11 + cb) >> 6, (l11 + cg) >> 6, (l11 + cr) >> 6);
+}//end FSYUVRGBC_Block.
+
+/// Scalar row pair from pel x onwards.
+template<int Fmt>
+static void FSYUVRGBC_RowScalar(const yuvType* y0, const yuvType* y1, const yuvType* u, const yuvType* v, unsigned char* o0, unsigned char* o1, int x, int pels)
+{
+	const int s = FSYUVRGBC_PELBYTES(Fmt);
+	for(; x < pels; x += 2)
+		FSYUVRGBC_Block<Fmt>(y0[x], y0[x+1], y1[x], y1[x+1], u[x>>1], v[x>>1], o0 + x*s, o1 + x*s, s);
+}//end FSYUVRGBC_RowScalar.
+
+/*
+---------------------------------------------------------------------------
+	SSE2 16 pel kernels.
+---------------------------------------------------------------------------
+*/
+#ifdef FSYUVRGBC_HAVE_SSE2
+
+static inline __m128i FSYUVRGBC_Pair128(int lo, int hi)
+{
+	return(_mm_set1_epi32( (int)( ((unsigned int)(hi & 0xFFFF) << 16)|(unsigned int)(lo & 0xFFFF) ) ));
+}//end FSYUVRGBC_Pair128.
+
+/// 8 chr terms from 4+4 interleaved (u,v) pairs.
+static inline __m128i FSYUVRGBC_Chr128(__m128i uvLo, __m128i uvHi, __m128i k)
+{
+	const __m128i r = _mm_set1_epi32(64);
+	__m128i lo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(uvLo, k), r), 7);
+	__m128i hi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(uvHi, k), r), 7);
+	return(_mm_add_epi16(_mm_packs_epi32(lo, hi), _mm_set1_epi16(32)));
+}//end FSYUVRGBC_Chr128.
+
+/// Pack the lower 3 bytes of each of 4 x 32 bit pels into the lower 12 bytes.
+static inline __m128i FSYUVRGBC_Pack12(__m128i x)
+{
+	const __m128i m0 = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+	const __m128i m1 = _mm_set_epi32(0x0000FFFF, 0xFF000000, 0x0000FFFF, 0xFF000000);
+	const __m128i m2 = _mm_set_epi32(0, 0, 0x0000FFFF, 0xFFFFFFFF);
+	x = _mm_or_si128(_mm_and_si128(x, m0), _mm_and_si128(_mm_srli_epi64(x, 8), m1));	///< 6 bytes per 64 bits.
+	return(_mm_or_si128(_mm_and_si128(x, m2), _mm_andnot_si128(m2, _mm_srli_si128(x, 2))));
+}//end FSYUVRGBC_Pack12.
+
+/// Store 16 pels held as 4 x (4 x 32 bit B,G,R,0) registers.
+template<int Fmt>
+static inline void FSYUVRGBC_Store16Pels(unsigned char* o, __m128i p0, __m128i p1, __m128i p2, __m128i p3)
+{
+	if(Fmt == FSYUVRGBC_RGB32)
+	{
+		_mm_storeu_si128((__m128i *)o, p0);
+		_mm_storeu_si128((__m128i *)(o + 16), p1);
+		_mm_storeu_si128((__m128i *)(o + 32), p2);
+		_mm_storeu_si128((__m128i *)(o + 48), p3);
+	}//end if RGB32...
+	else
+	{
+		p0 = FSYUVRGBC_Pack12(p0);
+		p1 = FSYUVRGBC_Pack12(p1);
+		p2 = FSYUVRGBC_Pack12(p2);
+		p3 = FSYUVRGBC_Pack12(p3);
+		_mm_storeu_si128((__m128i *)o,				_mm_or_si128(p0, _mm_slli_si128(p1, 12)));
+		_mm_storeu_si128((__m128i *)(o + 16), _mm_or_si128(_mm_srli_si128(p1, 4), _mm_slli_si128(p2, 8)));
+		_mm_storeu_si128((__m128i *)(o + 32), _mm_or_si128(_mm_srli_si128(p2, 8), _mm_slli_si128(p3, 4)));
+	}//end else...
+}//end FSYUVRGBC_Store16Pels.
+
+/// 8 pels of 5-6-5 from 16 bit B, G and R.
+static inline __m128i FSYUVRGBC_Rgb565(__m128i b, __m128i g, __m128i r)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i max	= _mm_set1_epi16(255);
+	b = _mm_min_epi16(_mm_max_epi16(b, zero), max);
+	g = _mm_min_epi16(_mm_max_epi16(g, zero), max);
+	r = _mm_min_epi16(_mm_max_epi16(r, zero), max);
+	return(_mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_and_si128(r, _mm_set1_epi16(0xF8)), 8), 
+																		_mm_slli_epi16(_mm_and_si128(g, _mm_set1_epi16(0xFC)), 3)), _mm_srli_epi16(b, 3)));
+}//end FSYUVRGBC_Rgb565.
+
+/// One row of 16 pels from the 16 bit lum and the duplicated chr terms.
+template<int Fmt>
+static inline void FSYUVRGBC_Row16(const yuvType* y, __m128i cbl, __m128i cbh, __m128i cgl, __m128i cgh, __m128i crl, __m128i crh, unsigned char* o)
+{
+	__m128i ll = _mm_slli_epi16(_mm_loadu_si128((const __m128i *)y), 6);
+	__m128i lh = _mm_slli_epi16(_mm_loadu_si128((const __m128i *)(y + 8)), 6);
+	__m128i bl = _mm_srai_epi16(_mm_adds_epi16(ll, cbl), 6);
+	__m128i bh = _mm_srai_epi16(_mm_adds_epi16(lh, cbh), 6);
+	__m128i gl = _mm_srai_epi16(_mm_adds_epi16(ll, cgl), 6);
+	__m128i gh = _mm_srai_epi16(_mm_adds_epi16(lh, cgh), 6);
+	__m128i rl = _mm_srai_epi16(_mm_adds_epi16(ll, crl), 6);
+	__m128i rh = _mm_srai_epi16(_mm_adds_epi16(lh, crh), 6);
+
+	if(Fmt == FSYUVRGBC_RGB16)
+	{
+		_mm_storeu_si128((__m128i *)o,				FSYUVRGBC_Rgb565(bl, gl, rl));
+		_mm_storeu_si128((__m128i *)(o + 16), FSYUVRGBC_Rgb565(bh, gh, rh));
+		return;
+	}//end if RGB16...
+
+	__m128i b8	= _mm_packus_epi16(bl, bh);
+	__m128i g8	= _mm_packus_epi16(gl, gh);
+	__m128i r8	= _mm_packus_epi16(rl, rh);
+	__m128i zero = _mm_setzero_si128();
+	__m128i bgl = _mm_unpacklo_epi8(b8, g8);
+	__m128i bgh = _mm_unpackhi_epi8(b8, g8);
+	__m128i r0l = _mm_unpacklo_epi8(r8, zero);
+	__m128i r0h = _mm_unpackhi_epi8(r8, zero);
+	FSYUVRGBC_Store16Pels<Fmt>(o, _mm_unpacklo_epi16(bgl, r0l), _mm_unpackhi_epi16(bgl, r0l), _mm_unpacklo_epi16(bgh, r0h), _mm_unpackhi_epi16(bgh, r0h));
+}//end FSYUVRGBC_Row16.
+
+/// Row pair in 16 pel steps. Returns the num of pels converted.
+template<int Fmt>
+static int FSYUVRGBC_RowSse2(const yuvType* y0, const yuvType* y1, const yuvType* u, const yuvType* v, unsigned char* o0, unsigned char* o1, int pels)
+{
+	const int			s		= FSYUVRGBC_PELBYTES(Fmt);
+	const __m128i off	= _mm_set1_epi16(128);
+	const __m128i kb	= FSYUVRGBC_Pair128(FSYUVRGBC_U0, 0);
+	const __m128i kg	= FSYUVRGBC_Pair128(FSYUVRGBC_U1, FSYUVRGBC_V1);
+	const __m128i kr	= FSYUVRGBC_Pair128(0, FSYUVRGBC_V0);
+	int x = 0;
+	for(; (x + 16) <= pels; x += 16)
+	{
+		__m128i cu	= _mm_sub_epi16(_mm_loadu_si128((const __m128i *)(u + (x >> 1))), off);
+		__m128i cv	= _mm_sub_epi16(_mm_loadu_si128((const __m128i *)(v + (x >> 1))), off);
+		__m128i uvl	= _mm_unpacklo_epi16(cu, cv);
+		__m128i uvh	= _mm_unpackhi_epi16(cu, cv);
+		__m128i cb	= FSYUVRGBC_Chr128(uvl, uvh, kb);
+		__m128i cg	= FSYUVRGBC_Chr128(uvl, uvh, kg);
+		__m128i cr	= FSYUVRGBC_Chr128(uvl, uvh, kr);
+		/// Each chr term is shared by 2 horizontal pels.
+		__m128i cbl = _mm_unpacklo_epi16(cb, cb), cbh = _mm_unpackhi_epi16(cb, cb);
+		__m128i cgl = _mm_unpacklo_epi16(cg, cg), cgh = _mm_unpackhi_epi16(cg, cg);
+		__m128i crl = _mm_unpacklo_epi16(cr, cr), crh = _mm_unpackhi_epi16(cr, cr);
+		FSYUVRGBC_Row16<Fmt>(y0 + x, cbl, cbh, cgl, cgh, crl, crh, o0 + x*s);
+		FSYUVRGBC_Row16<Fmt>(y1 + x, cbl, cbh, cgl, cgh, crl, crh, o1 + x*s);
+	}//end for x...
+	return(x);
+}//end FSYUVRGBC_RowSse2.
+
+#endif // FSYUVRGBC_HAVE_SSE2
+
+/*
+---------------------------------------------------------------------------
+	AVX2 32 pel kernels.
+---------------------------------------------------------------------------
+*/
+#ifdef FSYUVRGBC_HAVE_AVX2
+
+FSYUVRGBC_AVX2_TARGET
+static inline __m256i FSYUVRGBC_Chr256(__m256i uvLo, __m256i uvHi, __m256i k)
+{
+	const __m256i r = _mm256_set1_epi32(64);
+	__m256i lo = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(uvLo, k), r), 7);
+	__m256i hi = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(uvHi, k), r), 7);
+	/// The in lane unpack followed by the in lane pack restores the chr order.
+	return(_mm256_add_epi16(_mm256_packs_epi32(lo, hi), _mm256_set1_epi16(32)));
+}//end FSYUVRGBC_Chr256.
+
+FSYUVRGBC_AVX2_TARGET
+static inline __m256i FSYUVRGBC_Rgb565x16(__m256i b, __m256i g, __m256i r)
+{
+	const __m256i zero	= _mm256_setzero_si256();
+	const __m256i max		= _mm256_set1_epi16(255);
+	b = _mm256_min_epi16(_mm256_max_epi16(b, zero), max);
+	g = _mm256_min_epi16(_mm256_max_epi16(g, zero), max);
+	r = _mm256_min_epi16(_mm256_max_epi16(r, zero), max);
+	return(_mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(r, _mm256_set1_epi16(0xF8)), 8), 
+																				 _mm256_slli_epi16(_mm256_and_si256(g, _mm256_set1_epi16(0xFC)), 3)), _mm256_srli_epi16(b, 3)));
+}//end FSYUVRGBC_Rgb565x16.
+
+/// One row of 32 pels from the 16 bit lum and the duplicated chr terms in pel order.
+template<int Fmt>
+FSYUVRGBC_AVX2_TARGET
+static inline void FSYUVRGBC_Row32(const yuvType* y, __m256i cbl, __m256i cbh, __m256i cgl, __m256i cgh, __m256i crl, __m256i crh, unsigned char* o)
+{
+	__m256i ll = _mm256_slli_epi16(_mm256_loadu_si256((const __m256i *)y), 6);
+	__m256i lh = _mm256_slli_epi16(_mm256_loadu_si256((const __m256i *)(y + 16)), 6);
+	__m256i bl = _mm256_srai_epi16(_mm256_adds_epi16(ll, cbl), 6);
+	__m256i bh = _mm256_srai_epi16(_mm256_adds_epi16(lh, cbh), 6);
+	__m256i gl = _mm256_srai_epi16(_mm256_adds_epi16(ll, cgl), 6);
+	__m256i gh = _mm256_srai_epi16(_mm256_adds_epi16(lh, cgh), 6);
+	__m256i rl = _mm256_srai_epi16(_mm256_adds_epi16(ll, crl), 6);
+	__m256i rh = _mm256_srai_epi16(_mm256_adds_epi16(lh, crh), 6);
+
+	if(Fmt == FSYUVRGBC_RGB16)
+	{
+		_mm256_storeu_si256((__m256i *)o,				 FSYUVRGBC_Rgb565x16(bl, gl, rl));
+		_mm256_storeu_si256((__m256i *)(o + 32), FSYUVRGBC_Rgb565x16(bh, gh, rh));
+		return;
+	}//end if RGB16...
+
+	/// The bytes are in lane order [0..7 16..23 | 8..15 24..31] and the byte
+	/// unpacks then give pels [0..7 | 8..15] and [16..23 | 24..31].
+	__m256i b8	= _mm256_packus_epi16(bl, bh);
+	__m256i g8	= _mm256_packus_epi16(gl, gh);
+	__m256i r8	= _mm256_packus_epi16(rl, rh);
+	__m256i zero = _mm256_setzero_si256();
+	__m256i bgl = _mm256_unpacklo_epi8(b8, g8);
+	__m256i bgh = _mm256_unpackhi_epi8(b8, g8);
+	__m256i r0l = _mm256_unpacklo_epi8(r8, zero);
+	__m256i r0h = _mm256_unpackhi_epi8(r8, zero);
+	__m256i pa	= _mm256_unpacklo_epi16(bgl, r0l);	///< [0..3   | 8..11]
+	__m256i pb	= _mm256_unpackhi_epi16(bgl, r0l);	///< [4..7   | 12..15]
+	__m256i pc	= _mm256_unpacklo_epi16(bgh, r0h);	///< [16..19 | 24..27]
+	__m256i pd	= _mm256_unpackhi_epi16(bgh, r0h);	///< [20..23 | 28..31]
+
+	if(Fmt == FSYUVRGBC_RGB32)
+	{
+		_mm256_storeu_si256((__m256i *)o,				 _mm256_permute2x128_si256(pa, pb, 0x20));
+		_mm256_storeu_si256((__m256i *)(o + 32), _mm256_permute2x128_si256(pa, pb, 0x31));
+		_mm256_storeu_si256((__m256i *)(o + 64), _mm256_permute2x128_si256(pc, pd, 0x20));
+		_mm256_storeu_si256((__m256i *)(o + 96), _mm256_permute2x128_si256(pc, pd, 0x31));
+	}//end if RGB32...
+	else
+	{
+		FSYUVRGBC_Store16Pels<Fmt>(o,				_mm256_castsi256_si128(pa), _mm256_castsi256_si128(pb), _mm256_extracti128_si256(pa, 1), _mm256_extracti128_si256(pb, 1));
+		FSYUVRGBC_Store16Pels<Fmt>(o + 48,	_mm256_castsi256_si128(pc), _mm256_castsi256_si128(pd), _mm256_extracti128_si256(pc, 1), _mm256_extracti128_si256(pd, 1));
+	}//end else...
+}//end FSYUVRGBC_Row32.
+
+/// Row pair in 32 pel steps. Returns the num of pels converted.
+template<int Fmt>
+FSYUVRGBC_AVX2_TARGET
+static int FSYUVRGBC_RowAvx2(const yuvType* y0, const yuvType* y1, const yuvType* u, const yuvType* v, unsigned char* o0, unsigned char* o1, int pels)
+{
+	const int			s		= FSYUVRGBC_PELBYTES(Fmt);
+	const __m256i off	= _mm256_set1_epi16(128);
+	const __m256i kb	= _mm256_set1_epi32( (int)((unsigned int)FSYUVRGBC_U0 & 0xFFFF) );
+	const __m256i kg	= _mm256_set1_epi32( (int)( ((unsigned int)(FSYUVRGBC_V1 & 0xFFFF) << 16)|(unsigned int)(FSYUVRGBC_U1 & 0xFFFF) ) );
+	const __m256i kr	= _mm256_set1_epi32( (int)((unsigned int)(FSYUVRGBC_V0 & 0xFFFF) << 16) );
+	int x = 0;
+	for(; (x + 32) <= pels; x += 32)
+	{
+		__m256i cu	= _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)(u + (x >> 1))), off);
+		__m256i cv	= _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)(v + (x >> 1))), off);
+		__m256i uvl	= _mm256_unpacklo_epi16(cu, cv);
+		__m256i uvh	= _mm256_unpackhi_epi16(cu, cv);
+		/// Reorder the 64 bit quarters so that the in lane duplication is in pel order.
+		__m256i cb	= _mm256_permute4x64_epi64(FSYUVRGBC_Chr256(uvl, uvh, kb), 0xD8);
+		__m256i cg	= _mm256_permute4x64_epi64(FSYUVRGBC_Chr256(uvl, uvh, kg), 0xD8);
+		__m256i cr	= _mm256_permute4x64_epi64(FSYUVRGBC_Chr256(uvl, uvh, kr), 0xD8);
+		__m256i cbl = _mm256_unpacklo_epi16(cb, cb), cbh = _mm256_unpackhi_epi16(cb, cb);
+		__m256i cgl = _mm256_unpacklo_epi16(cg, cg), cgh = _mm256_unpackhi_epi16(cg, cg);
+		__m256i crl = _mm256_unpacklo_epi16(cr, cr), crh = _mm256_unpackhi_epi16(cr, cr);
+		FSYUVRGBC_Row32<Fmt>(y0 + x, cbl, cbh, cgl, cgh, crl, crh, o0 + x*s);
+		FSYUVRGBC_Row32<Fmt>(y1 + x, cbl, cbh, cgl, cgh, crl, crh, o1 + x*s);
+	}//end for x...
+	return(x);
+}//end FSYUVRGBC_RowAvx2.
+
+#endif // FSYUVRGBC_HAVE_AVX2
+
+/*
+---------------------------------------------------------------------------
+	Frame conversion.
+---------------------------------------------------------------------------
+*/
+template<int Fmt>
+static void FSYUVRGBC_Frame(const yuvType* py, const yuvType* pu, const yuvType* pv, unsigned char* pRgb, int width, int height, bool flip, int level)
+{
+	const int s				= FSYUVRGBC_PELBYTES(Fmt);
+	const int rowLen	= width * s;
+	const int pels		= width & ~1;
+	const int uvX			= width >> 1;
+
+	for(int y = 0; (y + 1) < height; y += 2)
+	{
+		const yuvType* y0 = py + y * width;
+		const yuvType* y1 = y0 + width;
+		const yuvType* u	= pu + (y >> 1) * uvX;
+		const yuvType* v	= pv + (y >> 1) * uvX;
+		/// Inverted output is written bottom up.
+		unsigned char* o0 = pRgb + (flip ? (height - y - 1) : y) * rowLen;
+		unsigned char* o1 = flip ? (o0 - rowLen) : (o0 + rowLen);
+
+		int x = 0;
+#ifdef FSYUVRGBC_HAVE_AVX2
+		if(level >= FSYUVRGBC_AVX2)
+			x = FSYUVRGBC_RowAvx2<Fmt>(y0, y1, u, v, o0, o1, pels);
+#endif
+#ifdef FSYUVRGBC_HAVE_SSE2
+		if(level >= FSYUVRGBC_SSE2)
+			x += FSYUVRGBC_RowSse2<Fmt>(y0 + x, y1 + x, u + (x >> 1), v + (x >> 1), o0 + x*s, o1 + x*s, pels - x);
+#endif
+		FSYUVRGBC_RowScalar<Fmt>(y0, y1, u, v, o0, o1, x, pels);
+	}//end for y...
+
+}//end FSYUVRGBC_Frame.
+
+/// Rotated output is the transpose of the image with the pels of a lum column along an rgb row.
+template<int Fmt>
+static void FSYUVRGBC_RotateFrame(const yuvType* py, const yuvType* pu, const yuvType* pv, unsigned char* pRgb, int width, int height)
+{
+	const int s		= FSYUVRGBC_PELBYTES(Fmt);
+	const int uvX	= width >> 1;
+	for(int y = 0; (y + 1) < height; y += 2)
+	{
+		const yuvType* y0 = py + y * width;
+		const yuvType* y1 = y0 + width;
+		for(int x = 0; (x + 1) < width; x += 2)
+		{
+			unsigned char* o = pRgb + (x * height + y) * s;
+			FSYUVRGBC_Block<Fmt>(y0[x], y0[x+1], y1[x], y1[x+1], pu[(y >> 1)*uvX + (x >> 1)], pv[(y >> 1)*uvX + (x >> 1)], o, o + s, height * s);
+		}//end for x...
+	}//end for y...
+}//end FSYUVRGBC_RotateFrame.
+
+/*
+===========================================================================
+	Interface Methods.
+===========================================================================
+*/
+/** Fixed point conversion.
+The flip (inverted) mode takes precedence over rotation as in the other
+YUV420toRGBConverter implementations.
+@param pY		: Lum plane.
+@param pU		: Chr U plane.
+@param pV		: Chr V plane.
+@param pRgb	: Output in the format of this converter.
+@return			: none.
+*/
+void FastSimdYUV420toRGBConverter::Convert(void* pY, void* pU, void* pV, void* pRgb)
+{
+	const yuvType* py		= (const yuvType *)pY;
+	const yuvType* pu		= (const yuvType *)pU;
+	const yuvType* pv		= (const yuvType *)pV;
+	unsigned char* optr	= (unsigned char *)pRgb;
+
+	if(_rotate && !_flip)
+	{
+		switch(_format)
+		{
+		case FSYUVRGBC_RGB24: FSYUVRGBC_RotateFrame<FSYUVRGBC_RGB24>(py, pu, pv, optr, _width, _height); break;
+		case FSYUVRGBC_RGB32: FSYUVRGBC_RotateFrame<FSYUVRGBC_RGB32>(py, pu, pv, optr, _width, _height); break;
+		case FSYUVRGBC_RGB16: FSYUVRGBC_RotateFrame<FSYUVRGBC_RGB16>(py, pu, pv, optr, _width, _height); break;
+		}//end switch _format...
+		return;
+	}//end if _rotate...
+
+	switch(_format)
+	{
+	case FSYUVRGBC_RGB24: FSYUVRGBC_Frame<FSYUVRGBC_RGB24>(py, pu, pv, optr, _width, _height, _flip, _simdLevel); break;
+	case FSYUVRGBC_RGB32: FSYUVRGBC_Frame<FSYUVRGBC_RGB32>(py, pu, pv, optr, _width, _height, _flip, _simdLevel); break;
+	case FSYUVRGBC_RGB16: FSYUVRGBC_Frame<FSYUVRGBC_RGB16>(py, pu, pv, optr, _width, _height, _flip, _simdLevel); break;
+	}//end switch _format...
+
+}//end Convert.
+
+int FastSimdYUV420toRGBConverter::SetSimdLevel(int level)
+{
+	if( (level < FSYUVRGBC_SCALAR)||(level > GetMaxSimdLevel()) )
+		return(0);
+	_simdLevel = level;
+	return(1);
+}//end SetSimdLevel.
+
+int FastSimdYUV420toRGBConverter::GetMaxSimdLevel(void)
+{
+#if defined(FSYUVRGBC_HAVE_AVX2)
+	static const int level = FSYUVRGBC_CpuHasAvx2() ? FSYUVRGBC_AVX2 : FSYUVRGBC_SSE2;
+	return(level);
+#elif defined(FSYUVRGBC_HAVE_SSE2)
+	return(FSYUVRGBC_SSE2);
+#else
+	return(FSYUVRGBC_SCALAR);
+#endif
+}//end GetMaxSimdLevel.
+
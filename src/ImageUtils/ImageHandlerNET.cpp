@@ -1095,37 +1095,26 @@ void ImageHandler::MirrorYUp(int PixPoint)
     return;
 	}//end if _extraColorType...
 
-  int i,j;
+  int i;
   int X,Y;
   //Do the Luminance.
   X = GetYWidth();
   Y = GetYHeight();
-  int *P;
-  for(j = 0; j < X; j++)
-  {
-    P = (int *)(_Y + PixPoint*X + j);
-    for(i = 0; (i <= PixPoint)&&((PixPoint+i)<Y); i++)
-      *(P + i*X) = *(P - i*X);
-  }//end for j...
+  /// Whole rows at a time.
+  for(i = 1; (i <= PixPoint)&&((PixPoint+i)<Y); i++)
+    memcpy((void *)(_Y + (PixPoint+i)*X), (const void *)(_Y + (PixPoint-i)*X), X*sizeof(int));
 
   //Do the Chrominance.
   X = GetUVWidth();
   Y = GetUVHeight();
-  int *P_U;
-  int *P_V;
   //NOTE: No allowance for odd width images.
   if(_extraColorType == YUV411)
     PixPoint = PixPoint/2;
-  for(j = 0; j < X; j++)
+  for(i = 1; (i <= PixPoint)&&((PixPoint+i)<Y); i++)
   {
-    P_U = (int *)(_U + PixPoint*X + j);
-    P_V = (int *)(_V + PixPoint*X + j);
-    for(i = 0; (i <= PixPoint)&&((PixPoint+i)<Y); i++)
-    {
-      *(P_U + i*X) = *(P_U - i*X);
-      *(P_V + i*X) = *(P_V - i*X);
-    }//end for i...
-  }//end for j...
+    memcpy((void *)(_U + (PixPoint+i)*X), (const void *)(_U + (PixPoint-i)*X), X*sizeof(int));
+    memcpy((void *)(_V + (PixPoint+i)*X), (const void *)(_V + (PixPoint-i)*X), X*sizeof(int));
+  }//end for i...
 
   UpdateBmp();
 }//end MirrorYUp.
@@ -1141,37 +1130,26 @@ void ImageHandler::MirrorYDown(int PixPoint)
     return;
 	}//end if _extraColorType...
 
-  int i,j;
+  int i;
   int X,Y;
   //Do the Luminance.
   X = GetYWidth();
   Y = GetYHeight();
-  int *P;
-  for(j = 0; j < X; j++)
-  {
-    P = (int *)(_Y + PixPoint*X + j);
-    for(i = 0; (i <= PixPoint)&&((PixPoint+i)<Y); i++)
-      *(P - i*X) = *(P + i*X);
-  }//end for j...
+  /// Whole rows at a time.
+  for(i = 1; (i <= PixPoint)&&((PixPoint+i)<Y); i++)
+    memcpy((void *)(_Y + (PixPoint-i)*X), (const void *)(_Y + (PixPoint+i)*X), X*sizeof(int));
 
   //Do the Chrominance.
   X = GetUVWidth();
   Y = GetUVHeight();
-  int *P_U;
-  int *P_V;
   //NOTE: No allowance for odd width images.
   if(_extraColorType == YUV411)
     PixPoint = PixPoint/2;
-  for(j = 0; j < X; j++)
+  for(i = 1; (i <= PixPoint)&&((PixPoint+i)<Y); i++)
   {
-    P_U = (int *)(_U + PixPoint*X + j);
-    P_V = (int *)(_V + PixPoint*X + j);
-    for(i = 0; (i <= PixPoint)&&((PixPoint+i)<Y); i++)
-    {
-      *(P_U - i*X) = *(P_U + i*X);
-      *(P_V - i*X) = *(P_V + i*X);
-    }//end for i...
-  }//end for j...
+    memcpy((void *)(_U + (PixPoint-i)*X), (const void *)(_U + (PixPoint+i)*X), X*sizeof(int));
+    memcpy((void *)(_V + (PixPoint-i)*X), (const void *)(_V + (PixPoint+i)*X), X*sizeof(int));
+  }//end for i...
 
   UpdateBmp();
 }//end MirrorYDown.
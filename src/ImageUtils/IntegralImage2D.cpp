@@ -0,0 +1,139 @@
+/** @file
+
+MODULE				: IntegralImage2D
+
+TAG						: II2D
+
+FILE NAME			: IntegralImage2D.cpp
+
+DESCRIPTION		: A summed area table over a 2-D short mem block. Used to get
+								the sum of any rectangular block in 4 lookups. The table
+								is held as unsigned int so that block sums remain exact
+								under modulo 2^32 arithmetic for large images.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+
+#include "IntegralImage2D.h"
+
+/*
+--------------------------------------------------------------------------
+  Construction. 
+--------------------------------------------------------------------------
+*/
+IntegralImage2D::IntegralImage2D(void)
+{
+	ResetMembers();
+}//end constructor.
+
+IntegralImage2D::~IntegralImage2D(void)
+{
+	Destroy();
+}//end destructor.
+
+void IntegralImage2D::ResetMembers(void)
+{
+	_width	= 0;
+	_height	= 0;
+	_stride	= 0;
+	_pTable	= NULL;
+}//end ResetMembers.
+
+int IntegralImage2D::Create(int width, int height)
+{
+	/// Clean out old mem.
+	Destroy();
+
+	if((width <= 0)||(height <= 0))
+		return(0);
+
+	_width	= width;
+	_height	= height;
+	_stride	= width + 1;
+	_pTable = new unsigned int[_stride * (height + 1)];
+	if(_pTable == NULL)
+	{
+		Destroy();
+		return(0);
+	}//end if !_pTable...
+
+	/// The top row and left column are never written by Load().
+	memset((void *)_pTable, 0, _stride * (height + 1) * sizeof(unsigned int));
+
+	return(1);
+}//end Create.
+
+void IntegralImage2D::Destroy(void)
+{
+	if(_pTable != NULL)
+		delete[] _pTable;
+	ResetMembers();
+}//end Destroy.
+
+/*
+--------------------------------------------------------------------------
+  Interface. 
+--------------------------------------------------------------------------
+*/
+template<typename T> void IntegralImage2D::LoadRows(T** pSrc)
+{
+	for(int y = 0; y < _height; y++)
+	{
+		T*						pS		= pSrc[y];
+		unsigned int* pUp		= &(_pTable[y * _stride]);
+		unsigned int* pRow	= pUp + _stride;
+		unsigned int	rowSum	= 0;
+		for(int x = 0; x < _width; x++)
+		{
+			rowSum += (unsigned int)pS[x];
+			pRow[x + 1] = pUp[x + 1] + rowSum;
+		}//end for x...
+	}//end for y...
+}//end LoadRows.
+
+void IntegralImage2D::Load(short** pSrc)
+{
+	LoadRows(pSrc);
+}//end Load.
+
+void IntegralImage2D::Load(unsigned char** pSrc)
+{
+	LoadRows(pSrc);
+}//end Load.
+
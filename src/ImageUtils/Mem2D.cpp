@@ -32,6 +32,7 @@ RESTRICTIONS			:
 
 
 #include	"Mem2D.h"
+#include	"AlignedPlane.h"
 
 /*
 ---------------------------------------------------------------------------
@@ -53,6 +54,7 @@ void Mem2D::ResetMembers(void)
 {
 	_width						= 0;
 	_height						= 0;
+	_stride						= 0;
 	_pMem							= NULL;
 	_pBlock						= NULL;
 }//end ResetMembers.
@@ -85,7 +87,7 @@ void Mem2D::Destroy(void)
 	_pBlock = NULL;
 
 	if(_pMem != NULL)
-		delete[] _pMem;
+		AlignedPlane::Free(_pMem);
 	_pMem = NULL;
 
 }//end Destroy.
@@ -97,9 +99,11 @@ int Mem2D::Create(int width, int height)
 		Destroy();
 	_width  = 0;
 	_height = 0;
+	_stride = 0;
 
-	// Alloc the mem block.
-	_pMem = new M2D_TYPE[width * height];
+	// Alloc the mem block with cache aligned padded rows.
+	int stride = AlignedPlane::Stride(width, sizeof(M2D_TYPE));
+	_pMem = (M2D_TYPE *)AlignedPlane::Alloc(stride, height, sizeof(M2D_TYPE));
 	if(_pMem == NULL)
 		return(0);
 
@@ -114,10 +118,11 @@ int Mem2D::Create(int width, int height)
 	// Successful alloc.
 	_width	= width;
 	_height	= height;
+	_stride	= stride;
 
 	// Fill the row addresses.
 	for(int row = 0; row < height; row++)
-		_pBlock[row] = &(_pMem[width * row]);
+		_pBlock[row] = &(_pMem[stride * row]);
 
 	return(1);
 }//end Create.
@@ -139,7 +144,16 @@ result leaves this block completely filled.
 */
 int Mem2D::Set(Mem2D& srcBlock)
 {
-	return( Mem2D::Set(srcBlock._pMem, srcBlock._width, srcBlock._height) );
+	// Create the mem if it doesn't exist already.
+	if( (_width != srcBlock._width) || (_height != srcBlock._height) )
+		Destroy();
+	if(_pMem == NULL)
+	{
+		if(!Create(srcBlock._width, srcBlock._height))
+			return(0);
+	}//end if _pMem...
+
+	return( Write(srcBlock) );
 }//end Set.
 
 /** Set this block by filling it from the larger input source.
@@ -372,9 +386,8 @@ int Mem2D::Write(Mem2D& srcBlock)
 	if( (_width != srcBlock._width)||(_height != srcBlock._height) )
 		return(0);
 
-	memcpy( (void *)_pMem, 
-					(const void *)srcBlock._pMem, 
-					_width * _height * sizeof(M2D_TYPE) );
+	for(int row = 0; row < _height; row++)
+		memcpy( (void *)_pBlock[row], (const void *)srcBlock._pBlock[row], _width * sizeof(M2D_TYPE) );
 
 	return(1);
 }//end Write.
@@ -588,9 +601,8 @@ int Mem2D::Read(Mem2D& dstBlock)
 	if( (_width != dstBlock._width)||(_height != dstBlock._height) )
 		return(0);
 
-	memcpy( (void *)dstBlock._pMem,
-					(const void *)_pMem,
-					_width * _height * sizeof(M2D_TYPE));
+	for(int row = 0; row < _height; row++)
+		memcpy( (void *)dstBlock._pBlock[row], (const void *)_pBlock[row], _width * sizeof(M2D_TYPE) );
 
 	return(1);
 }//end Read.
@@ -608,7 +620,9 @@ Fast value zero-ing function.
 */
 void Mem2D::Clear(void)
 {
-	memset((void *)_pMem, 0, _width * _height * sizeof(M2D_TYPE));
+	// The row padding is cleared as well.
+	if(_pMem != NULL)
+		memset((void *)_pMem, 0, _stride * _height * sizeof(M2D_TYPE));
 }//end Clear.
 
 /** Subtract the input block from this.
@@ -622,9 +636,13 @@ int Mem2D::Sub(Mem2D& b)
 	if( (_width != b._width)||(_height != b._height) )
 		return(0);
 	// Subtraction.
-	int len = _width * _height;
-	for(int i = 0; i < len; i++)
-		_pMem[i] -= b._pMem[i];
+	for(int row = 0; row < _height; row++)
+	{
+		M2D_PTYPE	p		= _pBlock[row];
+		M2D_PTYPE	pB	= b._pBlock[row];
+		for(int col = 0; col < _width; col++)
+			p[col] -= pB[col];
+	}//end for row...
 
 	return(1);
 }//end Sub.
@@ -640,9 +658,13 @@ int Mem2D::Add(Mem2D& b)
 	if( (_width != b._width)||(_height != b._height) )
 		return(0);
 	// Addition.
-	int len = _width * _height;
-	for(int i = 0; i < len; i++)
-		_pMem[i] += b._pMem[i];
+	for(int row = 0; row < _height; row++)
+	{
+		M2D_PTYPE	p		= _pBlock[row];
+		M2D_PTYPE	pB	= b._pBlock[row];
+		for(int col = 0; col < _width; col++)
+			p[col] += pB[col];
+	}//end for row...
 
 	return(1);
 }//end Add.
@@ -658,13 +680,17 @@ int Mem2D::Tse(Mem2D& b)
 	if( (_width != b._width)||(_height != b._height) )
 		return(10000000);
 
-	int len = _width * _height;
 	int acc = 0;
-	for(int i = 0; i < len; i++)
+	for(int row = 0; row < _height; row++)
 	{
-		int diff = (_pMem[i] - b._pMem[i]);
-		acc += (diff * diff);
-	}//end for i...
+		M2D_PTYPE	p		= _pBlock[row];
+		M2D_PTYPE	pB	= b._pBlock[row];
+		for(int col = 0; col < _width; col++)
+		{
+			int diff = (p[col] - pB[col]);
+			acc += (diff * diff);
+		}//end for col...
+	}//end for row...
 
 	return(acc);
 }//end Tse.
@@ -683,15 +709,19 @@ int Mem2D::TseLessThan(Mem2D& b, int min)
 	if( (_width != b._width)||(_height != b._height) )
 		return(min + 10000000);
 
-	int len = _width * _height;
 	int acc = 0;
-	for(int i = 0; i < len; i++)
+	for(int row = 0; row < _height; row++)
 	{
-		int diff = (_pMem[i] - b._pMem[i]);
-		acc += (diff * diff);
-		if(acc > min)
-			return(acc);
-	}//end for i...
+		M2D_PTYPE	p		= _pBlock[row];
+		M2D_PTYPE	pB	= b._pBlock[row];
+		for(int col = 0; col < _width; col++)
+		{
+			int diff = (p[col] - pB[col]);
+			acc += (diff * diff);
+			if(acc > min)
+				return(acc);
+		}//end for col...
+	}//end for row...
 
 	return(acc);
 }//end TseLessThan.
@@ -707,16 +737,20 @@ int Mem2D::Tae(Mem2D& b)
 	if( (_width != b._width)||(_height != b._height) )
 		return(10000000);
 
-	int len = _width * _height;
 	int acc = 0;
-	for(int i = 0; i < len; i++)
+	for(int row = 0; row < _height; row++)
 	{
-		int diff = (_pMem[i] - b._pMem[i]);
-		if(diff >= 0)
-			acc += diff;
-		else
-			acc -= diff;
-	}//end for i...
+		M2D_PTYPE	p		= _pBlock[row];
+		M2D_PTYPE	pB	= b._pBlock[row];
+		for(int col = 0; col < _width; col++)
+		{
+			int diff = (p[col] - pB[col]);
+			if(diff >= 0)
+				acc += diff;
+			else
+				acc -= diff;
+		}//end for col...
+	}//end for row...
 
 	return(acc);
 }//end Tae.
@@ -735,18 +769,22 @@ int Mem2D::TaeLessThan(Mem2D& b, int min)
 	if( (_width != b._width)||(_height != b._height) )
 		return(min + 10000000);
 
-	int len = _width * _height;
 	int acc = 0;
-	for(int i = 0; i < len; i++)
+	for(int row = 0; row < _height; row++)
 	{
-		int diff = (_pMem[i] - b._pMem[i]);
-		if(diff >= 0)
-			acc += diff;
-		else
-			acc -= diff;
-		if(acc > min)
-			return(acc);
-	}//end for i...
+		M2D_PTYPE	p		= _pBlock[row];
+		M2D_PTYPE	pB	= b._pBlock[row];
+		for(int col = 0; col < _width; col++)
+		{
+			int diff = (p[col] - pB[col]);
+			if(diff >= 0)
+				acc += diff;
+			else
+				acc -= diff;
+			if(acc > min)
+				return(acc);
+		}//end for col...
+	}//end for row...
 
 	return(acc);
 }//end TaeLessThan.
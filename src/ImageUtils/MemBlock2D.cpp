@@ -33,6 +33,7 @@ RESTRICTIONS			: The information/data/code contained within this file is
 
 
 #include	"MemBlock2D.h"
+#include	"AlignedPlane.h"
 #include	"EncMotionVector.h"
 
 /*
@@ -55,6 +56,7 @@ void MemBlock2D::ResetMembers(void)
 {
 	_width						= 0;
 	_height						= 0;
+	_stride						= 0;
 	_pMem							= NULL;
 	_pBlock						= NULL;
 	_candidateLength	= 0;
@@ -88,7 +90,7 @@ void MemBlock2D::Destroy(void)
 	_pBlock = NULL;
 
 	if(_pMem != NULL)
-		delete[] _pMem;
+		AlignedPlane::Free(_pMem);
 	_pMem = NULL;
 
 }//end Destroy.
@@ -100,9 +102,11 @@ VICS_INT MemBlock2D::Create(VICS_INT width, VICS_INT height)
 		Destroy();
 	_width  = 0;
 	_height = 0;
+	_stride = 0;
 
-	// Alloc the mem block.
-	_pMem = new MB2D_TYPE[width * height];
+	// Alloc the mem block with cache aligned padded rows.
+	VICS_INT stride = AlignedPlane::Stride(width, sizeof(MB2D_TYPE));
+	_pMem = (MB2D_TYPE *)AlignedPlane::Alloc(stride, height, sizeof(MB2D_TYPE));
 	if(_pMem == NULL)
 		return(0);
 
@@ -117,10 +121,11 @@ VICS_INT MemBlock2D::Create(VICS_INT width, VICS_INT height)
 	// Successful alloc.
 	_width	= width;
 	_height	= height;
+	_stride	= stride;
 
 	// Fill the row addresses.
 	for(VICS_INT row = 0; row < height; row++)
-		_pBlock[row] = &(_pMem[width * row]);
+		_pBlock[row] = &(_pMem[stride * row]);
 
 	return(1);
 }//end Create.
@@ -2,12 +2,15 @@
 
 MODULE				: MtRGB24toYUV420Converter
 
+TAG						: MTRGB24YUVC
+
 FILE NAME			: MtRGB24toYUV420Converter.cpp
 
-DESCRIPTION			: Double precision floating point RGB 24 bit to YUV420 colour 
-					convertion derived from the RGBtoYUV420Converter base class.
-					YUV is represented with 8 bpp. Use this implementation as 
-					the reference.
+DESCRIPTION		: Multithreaded double precision floating point RGB 24 bit to 
+								YUV420 colour convertion. The frame is split into row stripes
+								aligned to the 2 row chr pairs and the stripes are converted 
+								on a persistent pool of std::thread workers. The output is 
+								identical to RealRGB24toYUV420ConverterImpl2.
 
 LICENSE: Software License Agreement (BSD License)
 
@@ -47,54 +50,135 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "MtRGB24toYUV420Converter.h"
 
-#ifdef USE_MULTI_THREADED
-
-#include <boost/bind.hpp>
 /*
 ===========================================================================
-	Constants.
+	Private Methods.
 ===========================================================================
 */
-#define RRGB24YUVCI2_00		 0.299
-#define RRGB24YUVCI2_01		 0.587
-#define RRGB24YUVCI2_02		 0.114
-#define RRGB24YUVCI2_10		-0.147
-#define RRGB24YUVCI2_11		-0.289
-#define RRGB24YUVCI2_12		 0.436
-#define RRGB24YUVCI2_20		 0.615
-#define RRGB24YUVCI2_21		-0.515
-#define RRGB24YUVCI2_22		-0.100
-
-const int iPrecision = 12;
-const int iRRGB24YUVCI2_00 = static_cast<int>(0.299 * (2 << iPrecision));
-const int iRRGB24YUVCI2_01 = static_cast<int>(0.587 * (2 << iPrecision));
-const int iRRGB24YUVCI2_02 = static_cast<int>(0.114 * (2 << iPrecision));
-const int iRRGB24YUVCI2_10 = static_cast<int>(-0.147 * (2 << iPrecision));
-const int iRRGB24YUVCI2_11 = static_cast<int>(-0.289 * (2 << iPrecision));
-const int iRRGB24YUVCI2_12 = static_cast<int>(0.436 * (2 << iPrecision));
-const int iRRGB24YUVCI2_20 = static_cast<int>(0.615 * (2 << iPrecision));
-const int iRRGB24YUVCI2_21 = static_cast<int>(-0.515 * (2 << iPrecision));
-const int iRRGB24YUVCI2_22 = static_cast<int>(-0.100 * (2 << iPrecision));
-
-
-#define RRGB24YUVCI2_RANGECHECK_0TO255(x) ( (((x) <= 255)&&((x) >= 0))?((x)):( ((x) > 255)?(255):(0) ) )
-#define RRGB24YUVCI2_RANGECHECK_N128TO127(x) ( (((x) <= 127)&&((x) >= -128))?((x)):( ((x) > 127)?(127):(-128) ) )
-
-void MtRGB24toYUV420Converter::init()
+void MtRGB24toYUV420Converter::ResetMembers(void)
+{
+	int hw = (int)std::thread::hardware_concurrency();
+	if(hw < 1)
+		hw = 1;
+	else if(hw > MTRGB24YUVC_MAX_THREADS)
+		hw = MTRGB24YUVC_MAX_THREADS;
+	_threads					= hw;
+	_stripesPerThread	= MTRGB24YUVC_STRIPES_PER_THREAD;
+
+	for(int i = 0; i < MTRGB24YUVC_MAX_THREADS; i++)
+		_pWorker[i] = NULL;
+	_workers			= 0;
+
+	_generation		= 0;
+	_stop					= 0;
+	_pRgb					= NULL;
+	_pY						= NULL;
+	_pU						= NULL;
+	_pV						= NULL;
+	_yBlks				= 0;
+	_stripes			= 0;
+	_nextStripe		= 0;
+	_doneStripes	= 0;
+}//end ResetMembers.
+
+int MtRGB24toYUV420Converter::StartWorkers(int workers)
+{
+	StopWorkers();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stop = 0;
+	for(int i = 0; i < workers; i++)
+	{
+		_pWorker[i] = new std::thread(&MtRGB24toYUV420Converter::Worker, this, _generation);
+		if(_pWorker[i] == NULL)
+			break;
+		_workers++;
+	}//end for i...
+
+	return(_workers == workers);
+}//end StartWorkers.
+
+void MtRGB24toYUV420Converter::StopWorkers(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = 1;
+	}
+	_startCond.notify_all();
+
+	for(int i = 0; i < _workers; i++)
+	{
+		_pWorker[i]->join();
+		delete _pWorker[i];
+		_pWorker[i] = NULL;
+	}//end for i...
+	_workers = 0;
+}//end StopWorkers.
+
+/// Worker thread loop. Each new generation is a frame to help convert.
+void MtRGB24toYUV420Converter::Worker(unsigned int generation)
 {
-  for (std::size_t i = 0; i < 2; ++i)
-    threads.create_thread(boost::bind(&boost::asio::io_service::run, boost::ref(io_service)));
-}
+	std::unique_lock<std::mutex> lock(_mutex);
+	while(1)
+	{
+		_startCond.wait(lock, [&] { return( _stop || (_generation != generation) ); });
+		if(_stop)
+			break;
+		generation = _generation;
+
+		lock.unlock();
+		RunStripes();
+		lock.lock();
+	}//end while...
+}//end Worker.
+
+void MtRGB24toYUV420Converter::RunStripes(void)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while(_nextStripe < _stripes)
+	{
+		int stripe = _nextStripe++;
+		/// The stripe boundaries are in 2x2 block rows so chr pairs are never split.
+		int ybStart = (stripe * _yBlks) / _stripes;
+		int ybEnd		= ((stripe + 1) * _yBlks) / _stripes;
+		void* pRgb = _pRgb; void* pY = _pY; void* pU = _pU; void* pV = _pV;
+
+		lock.unlock();
+		ConvertRows(pRgb, pY, pU, pV, ybStart, ybEnd);
+		lock.lock();
+
+		_doneStripes++;
+		if(_doneStripes == _stripes)
+			_doneCond.notify_all();
+	}//end while _nextStripe...
+}//end RunStripes.
 
 /*
 ===========================================================================
 	Interface Methods.
 ===========================================================================
 */
-/** Double precision reference implementation.
-The full real matix equation is used. The YUV output is represented with
-8 bits per pel and the UV components are adjusted from their -128..127 range
-to 0..255.
+int MtRGB24toYUV420Converter::SetThreads(int threads)
+{
+	if( (threads < 1)||(threads > MTRGB24YUVC_MAX_THREADS) )
+		return(0);
+	if(threads != _threads)
+		StopWorkers();
+	_threads = threads;
+	return(1);
+}//end SetThreads.
+
+int MtRGB24toYUV420Converter::SetStripesPerThread(int stripes)
+{
+	if(stripes < 1)
+		return(0);
+	_stripesPerThread = stripes;
+	return(1);
+}//end SetStripesPerThread.
+
+/** Double precision reference implementation over multiple threads.
+The frame is divided into row stripes that are claimed by the calling
+thread and the workers. The call returns after all stripes are complete.
 @param pRgb	: Packed RGB 888 format.
 @param pY		: Lum plane.
 @param pU		: Chr U plane.
@@ -103,307 +187,47 @@ to 0..255.
 */
 void MtRGB24toYUV420Converter::Convert(void* pRgb, void* pY, void* pU, void* pV)
 {
-  boost::unique_lock<boost::mutex> lock(mutex);
-  
-  // post work to io_services
-  unsigned uiPixels = _width * _height;
-  unsigned uiYuvSize = uiPixels >> 2;
-
-  unsigned uiRgbOffset = (_width * _height * 3) >> 1;
-
-  yuvType*	py = (yuvType *)pY;
-  yuvType*	pu = (yuvType *)pU;
-  yuvType*	pv = (yuvType *)pV;
-  unsigned char* src = (unsigned char *)pRgb;
-
-  finished1 = false;
-  finished2 = false;
-  io_service.post(boost::bind(&MtRGB24toYUV420Converter::doConvert, this, src, py, pu, pv, 0));
-  io_service.post(boost::bind(&MtRGB24toYUV420Converter::doConvert, this, src + ((uiPixels*3)>> 1), py + (uiPixels>>1), pu + (uiYuvSize>>1), pv+ (uiYuvSize>>1), 1));
-
-  //while(!finished1 && !finished2)
-  //{
-  //  condvar.wait(lock);
-  //}
-  while(!finished1 || !finished2)
-  {
-    condvar.wait(lock);
-  }
-
-  if (uiConverted1 != uiConverted2)
-  {
-    int t = 0;
-  }
-}//end Convert.
-
-void MtRGB24toYUV420Converter::doConvert(unsigned char* pRgb, yuvType* pY, yuvType* pU, yuvType* pV, unsigned uiId)
-{
-  if (uiId == 0)
-  {
-    {
-      boost::lock_guard<boost::mutex> lock(mutex);
-      finished1 = false;
-    }
-  }
-  else
-  {
-    {
-      boost::lock_guard<boost::mutex> lock(mutex);
-      finished2 = false;
-    }
-  }
-
-//#define USE_INTEGER_ARITHMETIC
-//#define USE_LOOKUP_TABLE
-#define USE_ORIGINAL
-
-#ifdef USE_LOOKUP_TABLE
-  yuvType*	py = (yuvType *)pY;
-  yuvType*	pu = (yuvType *)pU;
-  yuvType*	pv = (yuvType *)pV;
-  unsigned char* src = (unsigned char *)pRgb;
-
-  /// Y have range 0..255, U & V have range -128..127.
-  double	u,v;
-  int	r,g,b;
-
-  /// Step in 2x2 pel blocks. (4 pels per block).
-  int xBlks = _width >> 1;
-  int yBlks = _height >> 2; // FOR MT
-  for(int yb = 0; yb < yBlks; ++yb)
-    for(int xb = 0; xb < xBlks; ++xb)
-    {
-      int							chrOff	= yb*xBlks + xb;
-      int							lumOff	= (yb*_width + xb) << 1;
-      unsigned char*	t				= src + lumOff*3;
-
-      /// Top left pel.
-      b = (*t++);
-      g = (*t++);
-      r = (*t++);
-      py[lumOff] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255(/*(int)*/(0.5 + m_RRGB24YUVCI2_00[r] + m_RRGB24YUVCI2_01[g] + m_RRGB24YUVCI2_02[b]));
-
-      u = m_RRGB24YUVCI2_10[r] + m_RRGB24YUVCI2_11[g] + m_RRGB24YUVCI2_12[b];
-      v = m_RRGB24YUVCI2_20[r] + m_RRGB24YUVCI2_21[g] + m_RRGB24YUVCI2_22[b];
-
-      /// Top right pel.
-      b = (*t++);
-      g = (*t++);
-      r = (*t++);
-      py[lumOff+1] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255(/*(int)*/(0.5 + m_RRGB24YUVCI2_00[r] + m_RRGB24YUVCI2_01[g] + m_RRGB24YUVCI2_02[b]));
-
-      u += m_RRGB24YUVCI2_10[r] + m_RRGB24YUVCI2_11[g] + m_RRGB24YUVCI2_12[b];
-      v += m_RRGB24YUVCI2_20[r] + m_RRGB24YUVCI2_21[g] + m_RRGB24YUVCI2_22[b];
-
-      lumOff += _width;
-      t = t + _width*3 - 6;
-      /// Bottom left pel.
-      b = (*t++);
-      g = (*t++);
-      r = (*t++);
-      py[lumOff] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255(/*(int)*/(0.5 + m_RRGB24YUVCI2_00[r] + m_RRGB24YUVCI2_01[g] + m_RRGB24YUVCI2_02[b]));
-
-      u += m_RRGB24YUVCI2_10[r] + m_RRGB24YUVCI2_11[g] + m_RRGB24YUVCI2_12[b];
-      v += m_RRGB24YUVCI2_20[r] + m_RRGB24YUVCI2_21[g] + m_RRGB24YUVCI2_22[b];
-
-      /// Bottom right pel.
-      b = (*t++);
-      g = (*t++);
-      r = (*t++);
-      py[lumOff+1] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255(/*(int)*/(0.5 + m_RRGB24YUVCI2_00[r] + m_RRGB24YUVCI2_01[g] + m_RRGB24YUVCI2_02[b]));
-      //py[lumOff+1] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255((int)(0.5 + RRGB24YUVCI2_00*r + RRGB24YUVCI2_01*g + RRGB24YUVCI2_02*b));
-
-      u += m_RRGB24YUVCI2_10[r] + m_RRGB24YUVCI2_11[g] + m_RRGB24YUVCI2_12[b];
-      v += m_RRGB24YUVCI2_20[r] + m_RRGB24YUVCI2_21[g] + m_RRGB24YUVCI2_22[b];
-
-      /// Average the 4 chr values.
-      int iu = (int)u;
-      int iv = (int)v;
-      if(iu < 0)	///< Rounding.
-        iu -= 2;
-      else
-        iu += 2;
-      if(iv < 0)	///< Rounding.
-        iv -= 2;
-      else
-        iv += 2;
-
-      pu[chrOff] = (yuvType)( _chrOff + RRGB24YUVCI2_RANGECHECK_N128TO127(iu >> 2) );
-      pv[chrOff] = (yuvType)( _chrOff + RRGB24YUVCI2_RANGECHECK_N128TO127(iv >> 2) );
-    }//end for xb & yb...
-#endif
-
-
-#ifdef USE_INTEGER_ARITHMETIC
-    yuvType*	py = (yuvType *)pY;
-    yuvType*	pu = (yuvType *)pU;
-    yuvType*	pv = (yuvType *)pV;
-    unsigned char* src = (unsigned char *)pRgb;
-
-    /// Y have range 0..255, U & V have range -128..127.
-    int	u,v;
-    int	r,g,b;
-
-    /// Step in 2x2 pel blocks. (4 pels per block).
-    int xBlks = _width >> 1;
-    int yBlks = _height >> 2; // FOR MT
-    for(int yb = 0; yb < yBlks; yb++)
-      for(int xb = 0; xb < xBlks; xb++)
-      {
-        int							chrOff	= yb*xBlks + xb;
-        int							lumOff	= (yb*_width + xb) << 1;
-        unsigned char*	t				= src + lumOff*3;
-
-        /// Top left pel.
-        b = (int)(*t++);
-        g = (int)(*t++);
-        r = (int)(*t++);
-        py[lumOff] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255(((iRRGB24YUVCI2_00*r + iRRGB24YUVCI2_01*g + iRRGB24YUVCI2_02*b)>> (iPrecision + 1)));
-
-        u = iRRGB24YUVCI2_10*r + iRRGB24YUVCI2_11*g + iRRGB24YUVCI2_12*b;
-        v = iRRGB24YUVCI2_20*r + iRRGB24YUVCI2_21*g + iRRGB24YUVCI2_22*b;
-
-        /// Top right pel.
-        b = (int)(*t++);
-        g = (int)(*t++);
-        r = (int)(*t++);
-        py[lumOff+1] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255(((iRRGB24YUVCI2_00*r + iRRGB24YUVCI2_01*g + iRRGB24YUVCI2_02*b)>> (iPrecision + 1)));
-
-        u += iRRGB24YUVCI2_10*r + iRRGB24YUVCI2_11*g + iRRGB24YUVCI2_12*b;
-        v += iRRGB24YUVCI2_20*r + iRRGB24YUVCI2_21*g + iRRGB24YUVCI2_22*b;
-
-        lumOff += _width;
-        t = t + _width*3 - 6;
-        /// Bottom left pel.
-        b = (int)(*t++);
-        g = (int)(*t++);
-        r = (int)(*t++);
-        py[lumOff] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255(((iRRGB24YUVCI2_00*r + iRRGB24YUVCI2_01*g + iRRGB24YUVCI2_02*b)>> (iPrecision + 1)));
-
-        u += iRRGB24YUVCI2_10*r + iRRGB24YUVCI2_11*g + iRRGB24YUVCI2_12*b;
-        v += iRRGB24YUVCI2_20*r + iRRGB24YUVCI2_21*g + iRRGB24YUVCI2_22*b;
-
-        /// Bottom right pel.
-        b = (int)(*t++);
-        g = (int)(*t++);
-        r = (int)(*t++);
-        py[lumOff+1] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255(((iRRGB24YUVCI2_00*r + iRRGB24YUVCI2_01*g + iRRGB24YUVCI2_02*b)>> (iPrecision + 1)));
-
-        u += iRRGB24YUVCI2_10*r + iRRGB24YUVCI2_11*g + iRRGB24YUVCI2_12*b;
-        v += iRRGB24YUVCI2_20*r + iRRGB24YUVCI2_21*g + iRRGB24YUVCI2_22*b;
-
-        /// Average the 4 chr values.
-        int iu = u >> (iPrecision + 1);
-        int iv = v >> (iPrecision + 1);
-        if(iu < 0)	///< Rounding.
-          iu -= 2;
-        else
-          iu += 2;
-        if(iv < 0)	///< Rounding.
-          iv -= 2;
-        else
-          iv += 2;
-
-        pu[chrOff] = (yuvType)( _chrOff + RRGB24YUVCI2_RANGECHECK_N128TO127(iu >> 2) );
-        pv[chrOff] = (yuvType)( _chrOff + RRGB24YUVCI2_RANGECHECK_N128TO127(iv >> 2) );
-      }//end for xb & yb...
-#endif
-
-#ifdef USE_ORIGINAL
-      yuvType*	py = (yuvType *)pY;
-      yuvType*	pu = (yuvType *)pU;
-      yuvType*	pv = (yuvType *)pV;
-      unsigned char* src = (unsigned char *)pRgb;
-
-      /// Y have range 0..255, U & V have range -128..127.
-      double	u,v;
-      double	r,g,b;
-
-      /// Step in 2x2 pel blocks. (4 pels per block).
-      int xBlks = _width >> 1;
-      int yBlks = _height >> 2; // shift 2 since we're letting each thread only do half the work
-      for(int yb = 0; yb < yBlks; yb++)
-        for(int xb = 0; xb < xBlks; xb++)
-        {
-          int							chrOff	= yb*xBlks + xb;
-          int							lumOff	= (yb*_width + xb) << 1;
-          unsigned char*	t				= src + lumOff*3;
-
-          /// Top left pel.
-          b = (double)(*t++);
-          g = (double)(*t++);
-          r = (double)(*t++);
-          py[lumOff] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255((int)(0.5 + RRGB24YUVCI2_00*r + RRGB24YUVCI2_01*g + RRGB24YUVCI2_02*b));
-
-          u = RRGB24YUVCI2_10*r + RRGB24YUVCI2_11*g + RRGB24YUVCI2_12*b;
-          v = RRGB24YUVCI2_20*r + RRGB24YUVCI2_21*g + RRGB24YUVCI2_22*b;
-
-          /// Top right pel.
-          b = (double)(*t++);
-          g = (double)(*t++);
-          r = (double)(*t++);
-          py[lumOff+1] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255((int)(0.5 + RRGB24YUVCI2_00*r + RRGB24YUVCI2_01*g + RRGB24YUVCI2_02*b));
-
-          u += RRGB24YUVCI2_10*r + RRGB24YUVCI2_11*g + RRGB24YUVCI2_12*b;
-          v += RRGB24YUVCI2_20*r + RRGB24YUVCI2_21*g + RRGB24YUVCI2_22*b;
-
-          lumOff += _width;
-          t = t + _width*3 - 6;
-          /// Bottom left pel.
-          b = (double)(*t++);
-          g = (double)(*t++);
-          r = (double)(*t++);
-          py[lumOff] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255((int)(0.5 + RRGB24YUVCI2_00*r + RRGB24YUVCI2_01*g + RRGB24YUVCI2_02*b));
-
-          u += RRGB24YUVCI2_10*r + RRGB24YUVCI2_11*g + RRGB24YUVCI2_12*b;
-          v += RRGB24YUVCI2_20*r + RRGB24YUVCI2_21*g + RRGB24YUVCI2_22*b;
-
-          /// Bottom right pel.
-          b = (double)(*t++);
-          g = (double)(*t++);
-          r = (double)(*t++);
-          py[lumOff+1] = (yuvType)RRGB24YUVCI2_RANGECHECK_0TO255((int)(0.5 + RRGB24YUVCI2_00*r + RRGB24YUVCI2_01*g + RRGB24YUVCI2_02*b));
-
-          u += RRGB24YUVCI2_10*r + RRGB24YUVCI2_11*g + RRGB24YUVCI2_12*b;
-          v += RRGB24YUVCI2_20*r + RRGB24YUVCI2_21*g + RRGB24YUVCI2_22*b;
-
-          /// Average the 4 chr values.
-          int iu = (int)u;
-          int iv = (int)v;
-          if(iu < 0)	///< Rounding.
-            iu -= 2;
-          else
-            iu += 2;
-          if(iv < 0)	///< Rounding.
-            iv -= 2;
-          else
-            iv += 2;
-
-          pu[chrOff] = (yuvType)( _chrOff + RRGB24YUVCI2_RANGECHECK_N128TO127(iu/4) );
-          pv[chrOff] = (yuvType)( _chrOff + RRGB24YUVCI2_RANGECHECK_N128TO127(iv/4) );
-        }//end for xb & yb...
-#endif
-
-
-  if (uiId == 0)
-  {
-    {
-      boost::lock_guard<boost::mutex> lock(mutex);
-      ++uiConverted1;
-      finished1 = true;
-    }
-    condvar.notify_one();
-  }
-  else
-  {
-    {
-      boost::lock_guard<boost::mutex> lock(mutex);
-      ++uiConverted2;
-      finished2 = true;
-    }
-    condvar.notify_one();
-  }
+	int yBlks		= _height >> 1;
+	int stripes	= _threads * _stripesPerThread;
+	if(stripes > yBlks)
+		stripes = yBlks;
+
+	/// Single thread or too small to split.
+	if( (_threads == 1)||(stripes < 2) )
+	{
+		ConvertRows(pRgb, pY, pU, pV, 0, yBlks);
+		return;
+	}//end if _threads...
+
+	if(_workers != (_threads - 1))
+	{
+		if(!StartWorkers(_threads - 1))
+		{
+			StopWorkers();
+			ConvertRows(pRgb, pY, pU, pV, 0, yBlks);
+			return;
+		}//end if !StartWorkers...
+	}//end if _workers...
+
+	/// Post the frame and release the workers.
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_pRgb					= pRgb;
+		_pY						= pY;
+		_pU						= pU;
+		_pV						= pV;
+		_yBlks				= yBlks;
+		_stripes			= stripes;
+		_nextStripe		= 0;
+		_doneStripes	= 0;
+		_generation++;
+	}
+	_startCond.notify_all();
+
+	/// The caller shares the work and then waits at the completion barrier.
+	RunStripes();
+	std::unique_lock<std::mutex> lock(_mutex);
+	_doneCond.wait(lock, [&] { return(_doneStripes == _stripes); });
 
 }//end Convert.
 
-#endif
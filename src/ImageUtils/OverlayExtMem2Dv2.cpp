@@ -52,8 +52,10 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
+#include <assert.h>
 
 #include	"OverlayExtMem2Dv2.h"
+#include	"PlanePool.h"
 
 /*
 ---------------------------------------------------------------------------
@@ -63,8 +65,9 @@ RESTRICTIONS	: Redistribution and use in source and binary forms, with or withou
 
 OverlayExtMem2Dv2::OverlayExtMem2Dv2(void* srcPtr,	int srcWidth, int srcHeight, 
 																										int width,		int height,
-																										int bWidth,		int bHeight):
-		OverlayMem2Dv2(srcPtr, srcWidth, srcHeight, width, height)
+																										int bWidth,		int bHeight,
+																										int srcStride):
+		OverlayMem2Dv2(srcPtr, srcWidth, srcHeight, width, height, srcStride)
 {
 	_bWidth		= bWidth;
 	_bHeight	= bHeight;
@@ -114,6 +117,18 @@ void OverlayExtMem2Dv2::SetOrigin(int x, int y)
 ---------------------------------------------------------------------------
 */
 
+/// Copy the src into the centre section of the contiguous extended mem and fill the boundary.
+static void OEM2DV2_CopyExtend(short* srcPtr, int srcWidth, int srcHeight, int widthBy, int heightBy, short* newPtr)
+{
+	int width		= srcWidth + 2*widthBy;
+	int height	= srcHeight + 2*heightBy;
+	for(int y = 0; y < srcHeight; y++)
+		memcpy((void *)(&(newPtr[(heightBy + y)*width + widthBy])),
+					 (void *)(&(srcPtr[y * srcWidth])),
+					 srcWidth * sizeof(short));
+	OverlayExtMem2Dv2::FillBoundary(newPtr, width, height, widthBy, heightBy);
+}//end OEM2DV2_CopyExtend.
+
 /// Extend the boundary by alloc new mem. This static method must
 /// be called from the thread that owns the src mem to ensure it is
 /// thread safe.
@@ -125,33 +140,55 @@ int OverlayExtMem2Dv2::ExtendBoundary(void* srcPtr,
 	if(srcPtr == NULL)	///< Nothing to extend.
 		return(0);
 
-	int			y;
-	short*	lclPtr	= (short *)(srcPtr);
-	int			width		= srcWidth + 2*widthBy;
-	int			height	= srcHeight + 2*heightBy;
-
 	/// Create a new mem block to copy into.
-	short*	newPtr = new short[width * height];
+	short*	newPtr = new short[(srcWidth + 2*widthBy) * (srcHeight + 2*heightBy)];
 	if(newPtr == NULL)
 		return(0);
 
-	/// Copy the src into the centre section of the new mem.
-	for(y = 0; y < srcHeight; y++)
-		memcpy((void *)(&(newPtr[(heightBy + y)*width + widthBy])),
-					 (void *)(&(lclPtr[y * srcWidth])),
-					 srcWidth * sizeof(short));
+	OEM2DV2_CopyExtend((short *)srcPtr, srcWidth, srcHeight, widthBy, heightBy, newPtr);
+	*dstPtr = (void *)newPtr;
+
+	return(1);
+}//end ExtendBoundary.
+
+/// Extend the boundary into mem borrowed from the shared PlanePool. The 
+/// mem is returned with ReleaseBoundary().
+int OverlayExtMem2Dv2::AcquireBoundary(void* srcPtr,
+																			 int srcWidth,	int srcHeight, 
+																			 int widthBy,	int heightBy,
+																			 void** dstPtr)
+{
+	if(srcPtr == NULL)	///< Nothing to extend.
+		return(0);
 
-	/// Copy the boundary.
-	FillBoundary(newPtr, width, height, widthBy, heightBy);
+	/// Borrow a contiguous mem block to copy into.
+	short*	newPtr = (short *)PlanePool::Shared()->Acquire(srcWidth + 2*widthBy, srcHeight + 2*heightBy, sizeof(short), 0);
+	if(newPtr == NULL)
+		return(0);
 
+	OEM2DV2_CopyExtend((short *)srcPtr, srcWidth, srcHeight, widthBy, heightBy, newPtr);
 	*dstPtr = (void *)newPtr;
 
 	return(1);
-}//end ExtendBoundary.
+}//end AcquireBoundary.
 
-/// The inner block is valid and requires re-filling the boundary.
+/// Return the mem created by AcquireBoundary() to the pool. NULL is ignored. Mem
+/// that is not from the pool is a caller error that is caught in debug builds
+/// and is otherwise treated as ExtendBoundary() mem.
+void OverlayExtMem2Dv2::ReleaseBoundary(void* extPtr)
+{
+	if(!PlanePool::Shared()->Release(extPtr))
+	{
+		assert(0 && "ReleaseBoundary() of mem not from AcquireBoundary()");
+		delete[] (short *)extPtr;
+	}//end if !Release...
+}//end ReleaseBoundary.
+
+/// The inner block is valid and requires re-filling the boundary. The rows
+/// are srcStride apart when the mem is padded.
 void OverlayExtMem2Dv2::FillBoundary(void* srcPtr,	int srcWidth,	int srcHeight, 
-																										int widthBy,	int heightBy)
+																										int widthBy,	int heightBy,
+																										int srcStride)
 {
 	int	x,y;
 	short* lclPtr = (short *)srcPtr;
@@ -161,8 +198,10 @@ void OverlayExtMem2Dv2::FillBoundary(void* srcPtr,	int srcWidth,	int srcHeight,
 	if(block == NULL)
 		return;
 	/// Fill the row addresses.
+	if(srcStride < srcWidth)
+		srcStride = srcWidth;
 	for(y = 0; y < srcHeight; y++)
-		block[y] = &(lclPtr[srcWidth * y]);
+		block[y] = &(lclPtr[srcStride * y]);
 
 	/// Top left.
 	for(y = 0; y < heightBy; y++)
@@ -213,7 +252,7 @@ void OverlayExtMem2Dv2::FillBoundary(void* srcPtr,	int srcWidth,	int srcHeight,
 
 void OverlayExtMem2Dv2::FillBoundaryProxy(void)
 {
-	FillBoundary(_pMem, _srcWidth, _srcHeight, _bWidth, _bHeight);
+	FillBoundary(_pMem, _srcWidth, _srcHeight, _bWidth, _bHeight, _stride);
 }//end FillBoundaryProxy.
 
 
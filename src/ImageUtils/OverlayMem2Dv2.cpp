@@ -76,6 +76,25 @@ typedef struct _OM2DV2_COORD
 */
 #define OM2DV2_UNROLL_INNER_LOOP
 
+/// Block metric evaluations are counted for benchmarking when built with 
+/// OM2DV2_COUNT_EVALUATIONS defined. The counter is not thread safe.
+#ifdef OM2DV2_COUNT_EVALUATIONS
+#define OM2DV2_COUNT_EVALUATION (OverlayMem2Dv2::_evaluations++)
+#else
+#define OM2DV2_COUNT_EVALUATION
+#endif
+
+long long OverlayMem2Dv2::_evaluations = 0;
+
+int OverlayMem2Dv2::CountsEvaluations(void)
+{
+#ifdef OM2DV2_COUNT_EVALUATIONS
+	return(1);
+#else
+	return(0);
+#endif
+}//end CountsEvaluations.
+
 int OverlayMem2Dv2::OM2DV2_Sp[17] = {0, 0, 2, 2, 0, 1, 3, 3, 1, 1, 3, 0, 2, 3, 1, 2, 0};
 int OverlayMem2Dv2::OM2DV2_Tp[17] = {0, 0, 2, 0, 2, 1, 3, 1, 3, 0, 2, 1, 3, 0, 2, 1, 3};
 
@@ -97,6 +116,177 @@ int OverlayMem2Dv2::OM2DV2_Tp[17] = {0, 0, 2, 0, 2, 1, 3, 1, 3, 0, 2, 1, 3, 0, 2
 #define OM2DV2_GET_B(ptr, x, y)   ((OM2DV2_HORIZ_6TAP((ptr),(x),(y)) + 16) >> 5)
 #define OM2DV2_GET_H(ptr, x, y)   ((OM2DV2_VERT_6TAP((ptr),(x),(y)) + 16) >> 5)
 
+/*
+---------------------------------------------------------------------------
+	SSE2 interpolation.
+---------------------------------------------------------------------------
+*/
+/// SSE2 is part of every x64 target. Otherwise only the scalar implementation is used.
+/// The vector paths assume 8-bit pel values [0..255] held in shorts such that the 
+/// 6-tap intermediates fit into 16 bits. They are bit exact with the scalar paths.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define OM2DV2_SSE2
+#include <emmintrin.h>
+
+/// Unrounded 6-tap (1,-5,20,20,-5,1) of 8 pels in 16 bits.
+static inline __m128i OM2DV2_Tap6x8(__m128i m3, __m128i m2, __m128i m1, __m128i p1, __m128i p2, __m128i p3)
+{
+	__m128i sum = _mm_add_epi16(m3, p3);
+	sum = _mm_sub_epi16(sum, _mm_mullo_epi16(_mm_add_epi16(m2, p2), _mm_set1_epi16(5)));
+	return(_mm_add_epi16(sum, _mm_mullo_epi16(_mm_add_epi16(m1, p1), _mm_set1_epi16(20))));
+}//end OM2DV2_Tap6x8.
+
+/// Round the 1/2 pel 6-tap sum by 5 bits and clip to [0..255].
+static inline __m128i OM2DV2_RoundHalfx8(__m128i sum)
+{
+	__m128i x = _mm_srai_epi16(_mm_add_epi16(sum, _mm_set1_epi16(16)), 5);
+	return(_mm_min_epi16(_mm_max_epi16(x, _mm_setzero_si128()), _mm_set1_epi16(255)));
+}//end OM2DV2_RoundHalfx8.
+
+/// Unrounded vertical 6-tap for 8 cols from (x,y) where the taps are rows y-2 to y+3.
+static inline __m128i OM2DV2_Vert6Tapx8(short** ptr, int x, int y)
+{
+	return(OM2DV2_Tap6x8(_mm_loadu_si128((const __m128i *)&(ptr[y-2][x])), _mm_loadu_si128((const __m128i *)&(ptr[y-1][x])),
+											 _mm_loadu_si128((const __m128i *)&(ptr[y][x])),   _mm_loadu_si128((const __m128i *)&(ptr[y+1][x])),
+											 _mm_loadu_si128((const __m128i *)&(ptr[y+2][x])), _mm_loadu_si128((const __m128i *)&(ptr[y+3][x]))));
+}//end OM2DV2_Vert6Tapx8.
+
+/// 8 horizontal 1/2 pel "b" values from (x,y).
+static inline __m128i OM2DV2_GetBx8(short** ptr, int x, int y)
+{
+	const short* p = &(ptr[y][x]);
+	return(OM2DV2_RoundHalfx8(OM2DV2_Tap6x8(_mm_loadu_si128((const __m128i *)(p-2)), _mm_loadu_si128((const __m128i *)(p-1)),
+																					_mm_loadu_si128((const __m128i *)p),		 _mm_loadu_si128((const __m128i *)(p+1)),
+																					_mm_loadu_si128((const __m128i *)(p+2)), _mm_loadu_si128((const __m128i *)(p+3)))));
+}//end OM2DV2_GetBx8.
+
+/// 8 vertical 1/2 pel "h" values from (x,y).
+static inline __m128i OM2DV2_GetHx8(short** ptr, int x, int y)
+{
+	return(OM2DV2_RoundHalfx8(OM2DV2_Vert6Tapx8(ptr, x, y)));
+}//end OM2DV2_GetHx8.
+
+/// 8 centre 1/2 pel "j" values from (x,y). The unrounded vertical intermediates are
+/// held in 16 bits and the horizontal 6-tap over them is accumulated in 32 bits.
+static inline __m128i OM2DV2_GetJx8(short** ptr, int x, int y)
+{
+	short tmp[16];
+	_mm_storeu_si128((__m128i *)tmp,			OM2DV2_Vert6Tapx8(ptr, x-2, y));
+	_mm_storeu_si128((__m128i *)(tmp+8),	OM2DV2_Vert6Tapx8(ptr, x+6, y));
+
+	__m128i t0 = _mm_loadu_si128((const __m128i *)tmp);
+	__m128i t1 = _mm_loadu_si128((const __m128i *)(tmp+1));
+	__m128i t2 = _mm_loadu_si128((const __m128i *)(tmp+2));
+	__m128i t3 = _mm_loadu_si128((const __m128i *)(tmp+3));
+	__m128i t4 = _mm_loadu_si128((const __m128i *)(tmp+4));
+	__m128i t5 = _mm_loadu_si128((const __m128i *)(tmp+5));
+	__m128i c01 = _mm_set_epi16(-5, 1, -5, 1, -5, 1, -5, 1);
+	__m128i c23 = _mm_set1_epi16(20);
+	__m128i c45 = _mm_set_epi16(1, -5, 1, -5, 1, -5, 1, -5);
+	__m128i rnd = _mm_set1_epi32(512);
+
+	__m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(t0, t1), c01), _mm_madd_epi16(_mm_unpacklo_epi16(t2, t3), c23));
+	lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(t4, t5), c45));
+	lo = _mm_srai_epi32(_mm_add_epi32(lo, rnd), 10);
+	__m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(t0, t1), c01), _mm_madd_epi16(_mm_unpackhi_epi16(t2, t3), c23));
+	hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(t4, t5), c45));
+	hi = _mm_srai_epi32(_mm_add_epi32(hi, rnd), 10);
+
+	__m128i j = _mm_packs_epi32(lo, hi);
+	return(_mm_min_epi16(_mm_max_epi16(j, _mm_setzero_si128()), _mm_set1_epi16(255)));
+}//end OM2DV2_GetJx8.
+
+/// 8 full pels from (x,y).
+static inline __m128i OM2DV2_GetGx8(short** ptr, int x, int y)
+{
+	return(_mm_loadu_si128((const __m128i *)&(ptr[y][x])));
+}//end OM2DV2_GetGx8.
+
+/** Read a 1/4 pel block for widths that are multiples of 8.
+The selection and its letter naming follow the QuarterRead() scalar cases 
+where (x,y) is the full pel position to the top left of the 1/4 location.
+@param src				: Source rows.
+@param x					: Full pel top left position in the source.
+@param y					:
+@param dst				: Destination rows.
+@param dstX				: Destination top left position.
+@param dstY				:
+@param width			: Multiple of 8.
+@param height			:
+@param selection	: (xFrac | (yFrac << 2)) in the range [1..15].
+@return						: none.
+*/
+static void OM2DV2_QuarterReadx8(short** src, int x, int y, short** dst, int dstX, int dstY, int width, int height, int selection)
+{
+	for(int row = 0; row < height; row++)
+	{
+		for(int col = 0; col < width; col += 8)
+		{
+			int sx = x + col;
+			int sy = y + row;
+			__m128i z;
+			switch(selection)
+			{
+				case 1:		z = _mm_avg_epu16(OM2DV2_GetGx8(src, sx, sy),		OM2DV2_GetBx8(src, sx, sy));			break;	///< a.
+				case 2:		z = OM2DV2_GetBx8(src, sx, sy);																										break;	///< b.
+				case 3:		z = _mm_avg_epu16(OM2DV2_GetGx8(src, sx+1, sy),	OM2DV2_GetBx8(src, sx, sy));			break;	///< c.
+				case 4:		z = _mm_avg_epu16(OM2DV2_GetGx8(src, sx, sy),		OM2DV2_GetHx8(src, sx, sy));			break;	///< d.
+				case 5:		z = _mm_avg_epu16(OM2DV2_GetBx8(src, sx, sy),		OM2DV2_GetHx8(src, sx, sy));			break;	///< e.
+				case 6:		z = _mm_avg_epu16(OM2DV2_GetJx8(src, sx, sy),		OM2DV2_GetBx8(src, sx, sy));			break;	///< f.
+				case 7:		z = _mm_avg_epu16(OM2DV2_GetBx8(src, sx, sy),		OM2DV2_GetHx8(src, sx+1, sy));		break;	///< g.
+				case 8:		z = OM2DV2_GetHx8(src, sx, sy);																										break;	///< h.
+				case 9:		z = _mm_avg_epu16(OM2DV2_GetJx8(src, sx, sy),		OM2DV2_GetHx8(src, sx, sy));			break;	///< i.
+				case 10:	z = OM2DV2_GetJx8(src, sx, sy);																										break;	///< j.
+				case 11:	z = _mm_avg_epu16(OM2DV2_GetJx8(src, sx, sy),		OM2DV2_GetHx8(src, sx+1, sy));		break;	///< k.
+				case 12:	z = _mm_avg_epu16(OM2DV2_GetGx8(src, sx, sy+1),	OM2DV2_GetHx8(src, sx, sy));			break;	///< n.
+				case 13:	z = _mm_avg_epu16(OM2DV2_GetHx8(src, sx, sy),		OM2DV2_GetBx8(src, sx, sy+1));		break;	///< p.
+				case 14:	z = _mm_avg_epu16(OM2DV2_GetJx8(src, sx, sy),		OM2DV2_GetBx8(src, sx, sy+1));		break;	///< q.
+				case 15:	z = _mm_avg_epu16(OM2DV2_GetHx8(src, sx+1, sy),	OM2DV2_GetBx8(src, sx, sy+1));		break;	///< r.
+				default:	z = OM2DV2_GetGx8(src, sx, sy);																										break;
+			}//end switch selection...
+			_mm_storeu_si128((__m128i *)&(dst[dstY + row][dstX + col]), z);
+		}//end for col...
+	}//end for row...
+}//end OM2DV2_QuarterReadx8.
+
+/** Read a bilinear 1/8 pel chroma block for widths that are multiples of 8.
+@param src		: Source rows.
+@param x			: Full pel top left position in the source.
+@param y			:
+@param dst		: Destination rows.
+@param dstX		: Destination top left position.
+@param dstY		:
+@param width	: Multiple of 8.
+@param height	:
+@param xFrac	: 1/8 fractions in the range [0..7].
+@param yFrac	:
+@return				: none.
+*/
+static void OM2DV2_EighthReadx8(short** src, int x, int y, short** dst, int dstX, int dstY, int width, int height, int xFrac, int yFrac)
+{
+	__m128i wA	= _mm_set1_epi16((short)((8 - xFrac) * (8 - yFrac)));
+	__m128i wB	= _mm_set1_epi16((short)(xFrac * (8 - yFrac)));
+	__m128i wC	= _mm_set1_epi16((short)((8 - xFrac) * yFrac));
+	__m128i wD	= _mm_set1_epi16((short)(xFrac * yFrac));
+	__m128i rnd	= _mm_set1_epi16(32);
+	for(int row = 0; row < height; row++)
+	{
+		const short* p0 = &(src[y + row][x]);
+		const short* p1 = &(src[y + row + 1][x]);
+		for(int col = 0; col < width; col += 8)
+		{
+			__m128i z = _mm_add_epi16(_mm_mullo_epi16(_mm_loadu_si128((const __m128i *)(p0 + col)), wA), 
+																_mm_mullo_epi16(_mm_loadu_si128((const __m128i *)(p0 + col + 1)), wB));
+			z = _mm_add_epi16(z, _mm_mullo_epi16(_mm_loadu_si128((const __m128i *)(p1 + col)), wC));
+			z = _mm_add_epi16(z, _mm_mullo_epi16(_mm_loadu_si128((const __m128i *)(p1 + col + 1)), wD));
+			z = _mm_srai_epi16(_mm_add_epi16(z, rnd), 6);
+			_mm_storeu_si128((__m128i *)&(dst[dstY + row][dstX + col]), z);
+		}//end for col...
+	}//end for row...
+}//end OM2DV2_EighthReadx8.
+
+#endif
+
 /*
 ---------------------------------------------------------------------------
 	Construction, initialisation and destruction.
@@ -108,6 +298,7 @@ void OverlayMem2Dv2::ResetMembers(void)
 	_width						= 0;
 	_height						= 0;
 	_srcWidth					= 0;
+	_stride						= 0;
 	_srcHeight				= 0;
 	_pMem							= NULL;
 	_xPos							= 0;
@@ -122,9 +313,10 @@ Set the overlay on top of a contiguous block of mem.
 @param srcHeight: Height of source.
 @param width		: Width of the block to work with.
 @param height		: Height of block.
+@param srcStride: Row stride of the source when padded. 0 = srcWidth.
 @return					: none.
 */
-OverlayMem2Dv2::OverlayMem2Dv2(void* srcPtr, int srcWidth, int srcHeight, int width, int height)
+OverlayMem2Dv2::OverlayMem2Dv2(void* srcPtr, int srcWidth, int srcHeight, int width, int height, int srcStride)
 {
 	ResetMembers();
 
@@ -135,6 +327,7 @@ OverlayMem2Dv2::OverlayMem2Dv2(void* srcPtr, int srcWidth, int srcHeight, int wi
 	_height			= height;
 	_srcWidth		= srcWidth;
 	_srcHeight	= srcHeight;
+	_stride			= (srcStride > srcWidth) ? srcStride : srcWidth;
 	_pMem				= (short *)srcPtr;
 
 	/// Potentially dangerous to alloc mem in a constructor as there is no way 
@@ -147,7 +340,7 @@ OverlayMem2Dv2::OverlayMem2Dv2(void* srcPtr, int srcWidth, int srcHeight, int wi
 
 	/// Fill the row addresses.
 	for(int row = 0; row < srcHeight; row++)
-		_pBlock[row] = &(_pMem[srcWidth * row]);
+		_pBlock[row] = &(_pMem[_stride * row]);
 
 }//end alt constructor.
 
@@ -171,15 +364,17 @@ must be recreated. The overlay block parameters are unchanged.
 @param srcPtr			: New source pointer. 
 @param srcWidth		: Source width.
 @param srcHeight	: Source height.
+@param srcStride	: Row stride of the source when padded. 0 = srcWidth.
 @return 					: 0 = failure, 1 = success.
 */
-int OverlayMem2Dv2::SetMem(void* srcPtr, int srcWidth, int srcHeight)
+int OverlayMem2Dv2::SetMem(void* srcPtr, int srcWidth, int srcHeight, int srcStride)
 {
 	if(srcPtr == NULL)
 		return(0);
 
 	_srcWidth		= srcWidth;
 	_srcHeight	= srcHeight;
+	_stride			= (srcStride > srcWidth) ? srcStride : srcWidth;
 	_pMem				= (short *)srcPtr;
 
 	// 2-Dim ptr must be recreated.
@@ -194,7 +389,7 @@ int OverlayMem2Dv2::SetMem(void* srcPtr, int srcWidth, int srcHeight)
 
 	// Fill the row addresses.
 	for(int row = 0; row < srcHeight; row++)
-		_pBlock[row] = &(_pMem[srcWidth * row]);
+		_pBlock[row] = &(_pMem[_stride * row]);
 
 	return(1);
 }//end SetMem.
@@ -611,6 +806,17 @@ void OverlayMem2Dv2::HalfReadv2(OverlayMem2Dv2& me, OverlayMem2Dv2& dstBlock, in
 
 	/// Half location calc has 3 cases: 1 x [0,0], 4 x Diag. (square) and 4 x Linear (cross).
 
+#ifdef OM2DV2_SSE2
+	/// The half locations are the b, h and j cases of the 1/4 pel read.
+	if( (halfColOff || halfRowOff) && !(me._width & 7) )
+	{
+		int selection = (halfColOff ? 2 : 0) | (halfRowOff ? 8 : 0);
+		OM2DV2_QuarterReadx8(me._pBlock, me._xPos + ((halfColOff < 0) ? -1 : 0), me._yPos + ((halfRowOff < 0) ? -1 : 0), 
+												 pLcl, dstBlock._xPos, dstBlock._yPos, me._width, me._height, selection);
+		return;
+	}//end if halfColOff...
+#endif
+
 	if(halfColOff && halfRowOff)			///< Diagonal case.
 	{
 		int offsetX = halfColOff; ///< Either a -1 or +1.
@@ -726,6 +932,14 @@ void OverlayMem2Dv2::QuarterRead(OverlayMem2Dv2& me, OverlayMem2Dv2& dstBlock, i
 	/// The quarter fractions are in the range [0..3] and for every frac value pair there is a unique calculation. The
 	/// half pel positions are required first before the 1/4 and 3/4 positions can be calculated.
 	int selection = (xFrac & 3) | ((yFrac << 2) & 12);
+#ifdef OM2DV2_SSE2
+	if( selection && !(me._width & 7) )
+	{
+		OM2DV2_QuarterReadx8(me._pBlock, me._xPos + fullOffX, me._yPos + fullOffY, pLcl, dstBlock._xPos, dstBlock._yPos, 
+												 me._width, me._height, selection);
+		return;
+	}//end if selection...
+#endif
 	switch(selection)
 	{
 		case 2:	///< = b.
@@ -1082,6 +1296,14 @@ void OverlayMem2Dv2::EighthRead(OverlayMem2Dv2& me, OverlayMem2Dv2& dstBlock, in
 		yFracC			= 8 + eighthRowOff;	 
 	}//end if eighthRowOff...
 
+#ifdef OM2DV2_SSE2
+	if( (xFracC || yFracC) && !(me._width & 7) )
+	{
+		OM2DV2_EighthReadx8(me._pBlock, me._xPos + fullOffX, me._yPos + fullOffY, pLcl, dstBlock._xPos, dstBlock._yPos, 
+												me._width, me._height, xFracC, yFracC);
+		return;
+	}//end if xFracC...
+#endif
 	if(xFracC || yFracC)
 	{
 		for(row = 0, srcRow = me._yPos, dstRow = dstBlock._yPos; row < me._height; row++, srcRow++, dstRow++)
@@ -1113,6 +1335,66 @@ void OverlayMem2Dv2::EighthRead(OverlayMem2Dv2& me, OverlayMem2Dv2& dstBlock, in
 
 }//end EighthRead.
 
+/** Read a block with edge emulation.
+Read a block of the destination dimensions from the mem position (fromCol, 
+fromRow) where the position is relative to the top left of the mem and not 
+the overlay origin. Positions outside of the mem take the value of the nearest
+edge pel as if the mem had an extended boundary. This allows border crossing 
+blocks to be fetched into a small scratch block instead of extending the whole
+mem.
+@param dstBlock	: Destination to read to.
+@param fromCol	: Mem col of the top left of the block. May be -ve.
+@param fromRow	: Mem row of the top left of the block. May be -ve.
+@return 				: None.
+*/
+void OverlayMem2Dv2::EdgeRead(OverlayMem2Dv2& me, OverlayMem2Dv2& dstBlock, int fromCol, int fromRow)
+{
+	short**	pLcl		= dstBlock.Get2DSrcPtr();
+	int			width		= dstBlock._width;
+	int			height	= dstBlock._height;
+
+	/// Split the cols into left replicated, inside and right replicated spans.
+	int left	= -fromCol;
+	if(left < 0)			left = 0;
+	if(left > width)	left = width;
+	int right = (fromCol + width) - me._srcWidth;
+	if(right < 0)					right = 0;
+	if(right > width)			right = width;
+	int inside = width - left - right;
+	if(inside < 0)	///< The block is wider than the mem.
+		inside = 0;
+
+	for(int row = 0; row < height; row++)
+	{
+		int srcRow = fromRow + row;
+		if(srcRow < 0)
+			srcRow = 0;
+		else if(srcRow >= me._srcHeight)
+			srcRow = me._srcHeight - 1;
+		short* pS = me._pBlock[srcRow];
+		short* pD = &(pLcl[dstBlock._yPos + row][dstBlock._xPos]);
+
+		int col = 0;
+		for(; col < left; col++)
+			pD[col] = pS[0];
+		if(inside)
+		{
+			memcpy((void *)&(pD[col]), (const void *)&(pS[fromCol + col]), inside * sizeof(short));
+			col += inside;
+		}//end if inside...
+		for(; col < width; col++)
+		{
+			int srcCol = fromCol + col;
+			if(srcCol < 0)
+				srcCol = 0;
+			else if(srcCol >= me._srcWidth)
+				srcCol = me._srcWidth - 1;
+			pD[col] = pS[srcCol];
+		}//end for col...
+	}//end for row...
+
+}//end EdgeRead.
+
 /*
 ---------------------------------------------------------------------------
 	Public block operations interface.
@@ -1492,6 +1774,7 @@ The block dimensions must match else return INF.
 */
 int OverlayMem2Dv2::Tsd(OverlayMem2Dv2& me, OverlayMem2Dv2& b)
 {
+	OM2DV2_COUNT_EVALUATION;
 	if( (me._width != b._width)||(me._height != b._height) )
 		return(10000000);
 
@@ -1522,6 +1805,7 @@ so use with caution.
 */
 int OverlayMem2Dv2::Tsd4x4(OverlayMem2Dv2& me, OverlayMem2Dv2& b)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -1566,6 +1850,7 @@ so use with caution.
 */
 int OverlayMem2Dv2::Tsd8x8(OverlayMem2Dv2& me, OverlayMem2Dv2& b)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -1622,6 +1907,7 @@ so use with caution.
 */
 int OverlayMem2Dv2::Tsd16x16(OverlayMem2Dv2& me, OverlayMem2Dv2& b)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -1704,6 +1990,7 @@ match else return INF.
 */
 int OverlayMem2Dv2::TsdLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	if( (me._width != b._width)||(me._height != b._height) )
 		return(min + 10000000);
 
@@ -1738,6 +2025,7 @@ with caution for speed with unrolled inner loop.
 */
 int OverlayMem2Dv2::Tsd4x4LessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -1789,6 +2077,7 @@ with caution for speed with unrolled inner loop.
 */
 int OverlayMem2Dv2::Tsd4x4PartialLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -1826,6 +2115,7 @@ with caution for speed with unrolled inner loop.
 */
 int OverlayMem2Dv2::Tsd8x8LessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -1885,6 +2175,7 @@ int OverlayMem2Dv2::Tsd8x8LessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int mi
 
 int OverlayMem2Dv2::Tsd8x8PartialLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	int Dp = 0;	/// Accumulated partial sqare error.
 
@@ -1922,6 +2213,7 @@ with caution for speed with unrolled inner loop.
 */
 int OverlayMem2Dv2::Tsd16x16LessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -1992,6 +2284,7 @@ with caution for speed with unrolled inner loop.
 */
 int OverlayMem2Dv2::Tsd16x16PartialLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	int Dp = 0;	/// Accumulated partial square error.
 
@@ -2031,6 +2324,7 @@ int OverlayMem2Dv2::Tsd16x16PartialLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2&
  */
 int OverlayMem2Dv2::Tsd16x16PartialPathLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, void* path, int len, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
   short**	bPtr = b.Get2DSrcPtr();
   OM2DV2_COORD* pPath = (OM2DV2_COORD *)path;
 
@@ -2069,6 +2363,7 @@ The block dimensions must be 16x16 and no checking is done. Use with caution for
 */
 int OverlayMem2Dv2::Tsd16x16OptimalPathLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, void* path, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
   OM2DV2_COORD* pPath = (OM2DV2_COORD *)path;
   short**	bPtr        = b.Get2DSrcPtr();
   int meY = me._yPos; int meX = me._xPos;
@@ -2118,6 +2413,7 @@ done. Use with caution for speed.
 */
 int OverlayMem2Dv2::Tsd16x16OptimalPathLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
   short**	bPtr = b.Get2DSrcPtr();
   int meY = me._yPos; int meX = me._xPos;
   int bY  = b._yPos;  int bX  = b._xPos;
@@ -2448,6 +2744,7 @@ int OverlayMem2Dv2::Tsd16x16OptimalPathLessThan(OverlayMem2Dv2& me, OverlayMem2D
 
 int OverlayMem2Dv2::Tsd16x16PartialPathLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, void* path, int len, int min, int batchlen)
 {
+	OM2DV2_COUNT_EVALUATION;
   short**	bPtr = b.Get2DSrcPtr();
   OM2DV2_COORD* pPath = (OM2DV2_COORD *)path;
 
@@ -2494,6 +2791,7 @@ int OverlayMem2Dv2::Tsd16x16PartialPathLessThan(OverlayMem2Dv2& me, OverlayMem2D
 
 int OverlayMem2Dv2::Tsd16x16PartialPath(OverlayMem2Dv2& me, OverlayMem2Dv2& b, void* path, int len)
 {
+	OM2DV2_COUNT_EVALUATION;
   short**	bPtr = b.Get2DSrcPtr();
   OM2DV2_COORD* pPath = (OM2DV2_COORD *)path;
 
@@ -2524,6 +2822,7 @@ The block dimensions must match else return INF.
 */
 int OverlayMem2Dv2::Tad(OverlayMem2Dv2& me, OverlayMem2Dv2& b)
 {
+	OM2DV2_COUNT_EVALUATION;
 	if( (me._width != b._width)||(me._height != b._height) )
 		return(10000000);
 
@@ -2554,6 +2853,7 @@ so use with caution.
 */
 int OverlayMem2Dv2::Tad4x4(OverlayMem2Dv2& me, OverlayMem2Dv2& b)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -2598,6 +2898,7 @@ so use with caution.
 */
 int OverlayMem2Dv2::Tad8x8(OverlayMem2Dv2& me, OverlayMem2Dv2& b)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -2654,6 +2955,7 @@ so use with caution.
 */
 int OverlayMem2Dv2::Tad16x16(OverlayMem2Dv2& me, OverlayMem2Dv2& b)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -2736,6 +3038,7 @@ match else return INF.
 */
 int OverlayMem2Dv2::TadLessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	if( (me._width != b._width)||(me._height != b._height) )
 		return(min + 10000000);
 
@@ -2770,6 +3073,7 @@ with caution for speed with unrolled inner loop.
 */
 int OverlayMem2Dv2::Tad4x4LessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -2821,6 +3125,7 @@ with caution for speed with unrolled inner loop.
 */
 int OverlayMem2Dv2::Tad8x8LessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -2888,6 +3193,7 @@ with caution for speed with unrolled inner loop.
 */
 int OverlayMem2Dv2::Tad16x16LessThan(OverlayMem2Dv2& me, OverlayMem2Dv2& b, int min)
 {
+	OM2DV2_COUNT_EVALUATION;
 	short**	bPtr	= b.Get2DSrcPtr();
 	short*	pP;
 	short*	pI;
@@ -0,0 +1,1067 @@
+/** @file
+
+MODULE				: OverlayMem2Dv2u8
+
+TAG						: OM2DV2U8
+
+FILE NAME			: OverlayMem2Dv2u8.cpp
+
+DESCRIPTION		: A class to overlay a two-dimensional mem structure onto
+								a contiguous block (usually larger) of memory and provide
+								several operations on 2-D blocks where the data type is
+								unsigned char (8-bit pels). The interpolation reads are bit
+								exact with OverlayMem2Dv2 and the block metrics use SSE2 
+								where available.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "OverlayMem2Dv2u8.h"
+
+/*
+---------------------------------------------------------------------------
+	Constants.
+---------------------------------------------------------------------------
+*/
+/// Block metric evaluations are counted with the 16-bit type counter.
+#ifdef OM2DV2_COUNT_EVALUATIONS
+#define OM2DV2U8_COUNT_EVALUATION (OverlayMem2Dv2::CountEvaluation())
+#else
+#define OM2DV2U8_COUNT_EVALUATION
+#endif
+
+/// Max block width for the separable j interpolation work area. Wider blocks use
+/// the direct 2-D filter.
+#define OM2DV2U8_MAX_J_WIDTH	64
+
+/*
+---------------------------------------------------------------------------
+	Macros.
+---------------------------------------------------------------------------
+*/
+#define OM2DV2U8_FAST_ABS32(x) ( ((x)^((x)>>31))-((x)>>31) )
+
+#define OM2DV2U8_CLIP255(x)	( (((x) <= 255)&&((x) >= 0))? (x) : ( ((x) < 0)? 0:255 ) )
+
+#define OM2DV2U8_6TAP(minus3, minus2, minus1, plus1, plus2, plus3) ( (minus3) - 5*(minus2) + 20*(minus1) + 20*(plus1) - 5*(plus2) + (plus3) )
+#define OM2DV2U8_VERT_6TAP(ptr, x, y)  ( OM2DV2U8_6TAP((int)((ptr)[(y)-2][(x)]), (int)((ptr)[(y)-1][(x)]), (int)((ptr)[(y)][(x)]), (int)((ptr)[(y)+1][(x)]), (int)((ptr)[(y)+2][(x)]), (int)((ptr)[(y)+3][(x)])) )
+#define OM2DV2U8_HORIZ_6TAP(ptr, x, y) ( OM2DV2U8_6TAP((int)((ptr)[(y)][(x)-2]), (int)((ptr)[(y)][(x)-1]), (int)((ptr)[(y)][(x)]), (int)((ptr)[(y)][(x)+1]), (int)((ptr)[(y)][(x)+2]), (int)((ptr)[(y)][(x)+3])) )
+
+#define OM2DV2U8_GET_J(ptr, x, y) ((OM2DV2U8_6TAP(OM2DV2U8_VERT_6TAP((ptr),(x)-2,(y)), OM2DV2U8_VERT_6TAP((ptr),(x)-1,(y)), OM2DV2U8_VERT_6TAP((ptr),(x),(y)), OM2DV2U8_VERT_6TAP((ptr),(x)+1,(y)), OM2DV2U8_VERT_6TAP((ptr),(x)+2,(y)), OM2DV2U8_VERT_6TAP((ptr),(x)+3,(y))) + 512) >> 10)
+#define OM2DV2U8_GET_B(ptr, x, y)   ((OM2DV2U8_HORIZ_6TAP((ptr),(x),(y)) + 16) >> 5)
+#define OM2DV2U8_GET_H(ptr, x, y)   ((OM2DV2U8_VERT_6TAP((ptr),(x),(y)) + 16) >> 5)
+
+/// Clipped half pel values at integer position (x,y) of the quarter pel grid.
+#define OM2DV2U8_B(x, y)	OM2DV2U8_CLIP255(OM2DV2U8_GET_B(p, (x), (y)))
+#define OM2DV2U8_H(x, y)	OM2DV2U8_CLIP255(OM2DV2U8_GET_H(p, (x), (y)))
+
+/// Loop over the block where x and y are the full pel src positions of the dst pel
+/// and the expression is its interpolated value.
+#define OM2DV2U8_QLOOP(expr) \
+	for(row = 0; row < me._height; row++) \
+	{ \
+		int y = me._yPos + fullOffY + row; \
+		unsigned char* pD = &(pLcl[dstBlock._yPos + row][dstBlock._xPos]); \
+		for(col = 0; col < me._width; col++) \
+		{ \
+			int x = me._xPos + fullOffX + col; \
+			pD[col] = (unsigned char)(expr); \
+		} \
+	}
+
+/// The j expression in the loop is read from the separable work area.
+#define OM2DV2U8_J(x, y)	((int)pJ[(((y) - (me._yPos + fullOffY)) * me._width) + ((x) - (me._xPos + fullOffX))])
+
+/*
+---------------------------------------------------------------------------
+	SSE2 block metrics.
+---------------------------------------------------------------------------
+*/
+/// SSE2 is part of every x64 target. Otherwise only the scalar implementation is used.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define OM2DV2U8_SSE2
+#include <emmintrin.h>
+
+/// Horizontal sum of 4 x 32-bit.
+static inline int OM2DV2U8_Sum32x4(__m128i v)
+{
+	v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+	v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+	return(_mm_cvtsi128_si32(v));
+}//end OM2DV2U8_Sum32x4.
+
+/// Square differences of 16 pels accumulated into 4 x 32-bit.
+static inline __m128i OM2DV2U8_Sdx16(__m128i acc, __m128i a, __m128i b)
+{
+	__m128i zero	= _mm_setzero_si128();
+	__m128i lo		= _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+	__m128i hi		= _mm_sub_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+	acc = _mm_add_epi32(acc, _mm_madd_epi16(lo, lo));
+	return(_mm_add_epi32(acc, _mm_madd_epi16(hi, hi)));
+}//end OM2DV2U8_Sdx16.
+
+/// Square differences of 8 pels accumulated into 4 x 32-bit.
+static inline __m128i OM2DV2U8_Sdx8(__m128i acc, __m128i a, __m128i b)
+{
+	__m128i zero	= _mm_setzero_si128();
+	__m128i lo		= _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+	return(_mm_add_epi32(acc, _mm_madd_epi16(lo, lo)));
+}//end OM2DV2U8_Sdx8.
+
+/// Sum of the two 64-bit halves of a _mm_sad_epu8 result.
+static inline int OM2DV2U8_SadSum(__m128i v)
+{
+	return(_mm_cvtsi128_si32(_mm_add_epi32(v, _mm_srli_si128(v, 8))));
+}//end OM2DV2U8_SadSum.
+
+#endif
+
+/*
+---------------------------------------------------------------------------
+	Construction, initialisation and destruction.
+---------------------------------------------------------------------------
+*/
+
+void OverlayMem2Dv2u8::ResetMembers(void)
+{
+	_width			= 0;
+	_height			= 0;
+	_srcWidth		= 0;
+	_srcHeight	= 0;
+	_stride			= 0;
+	_pMem				= NULL;
+	_pBlock			= NULL;
+	_xPos				= 0;
+	_yPos				= 0;
+	_bWidth			= 0;
+	_bHeight		= 0;
+	_pWin				= NULL;
+	_pWinOver		= NULL;
+	_pBlk				= NULL;
+	_pBlkOver		= NULL;
+}//end ResetMembers.
+
+/** Constuctor with mem.
+The source mem is not owned by this object. With a boundary the mem must 
+already include it and the origin is offset to the top left of the mem
+inside the boundary.
+@param srcPtr		: Top left pointer of the source mem.
+@param srcWidth	: Width of source as a stride.
+@param srcHeight: Height of source.
+@param width		: Width of the block to work with.
+@param height		: Height of block.
+@param bWidth		: Boundary width on the left and right of the mem.
+@param bHeight	: Boundary height on the top and bottom of the mem.
+@param srcStride: Row stride of the source when padded. 0 = srcWidth.
+@return					: none.
+*/
+OverlayMem2Dv2u8::OverlayMem2Dv2u8(void* srcPtr, int srcWidth, int srcHeight, int width, int height, int bWidth, int bHeight, int srcStride)
+{
+	ResetMembers();
+
+	if(srcPtr == NULL)
+		return;
+
+	_width		= width;
+	_height		= height;
+	_bWidth		= bWidth;
+	_bHeight	= bHeight;
+
+	/// Potentially dangerous to alloc mem in a constructor as there is no way 
+	/// of determining failure.
+	if(!SetMem(srcPtr, srcWidth, srcHeight, srcStride))
+		return;
+	SetOrigin(0, 0);
+
+}//end alt constructor.
+
+OverlayMem2Dv2u8::~OverlayMem2Dv2u8()
+{
+	// Ensure no mem is left alloc.
+	Destroy();
+}//end destructor.
+
+void OverlayMem2Dv2u8::Destroy(void)
+{
+	if(_pBlock != NULL)
+		delete[] _pBlock;
+	_pBlock = NULL;
+
+	if(_pWinOver != NULL)
+		delete _pWinOver;
+	_pWinOver = NULL;
+	if(_pWin != NULL)
+		delete[] _pWin;
+	_pWin = NULL;
+	if(_pBlkOver != NULL)
+		delete _pBlkOver;
+	_pBlkOver = NULL;
+	if(_pBlk != NULL)
+		delete[] _pBlk;
+	_pBlk = NULL;
+
+}//end Destroy.
+
+/** Create the 16-bit interpolation work blocks on first use.
+The window holds the widened filter support of a block up to the max size.
+@return	: 1 = success, 0 = failure.
+*/
+int OverlayMem2Dv2u8::CreateWork(void)
+{
+	if(_pWinOver != NULL)
+		return(1);
+
+	int winDim	= OM2DV2U8_MAX_J_WIDTH + 5;
+	_pWin				= new short[winDim * winDim];
+	_pBlk				= new short[OM2DV2U8_MAX_J_WIDTH * OM2DV2U8_MAX_J_WIDTH];
+	if( (_pWin == NULL)||(_pBlk == NULL) )
+		return(0);
+	_pBlkOver		= new OverlayMem2Dv2(_pBlk, OM2DV2U8_MAX_J_WIDTH, OM2DV2U8_MAX_J_WIDTH, OM2DV2U8_MAX_J_WIDTH, OM2DV2U8_MAX_J_WIDTH);
+	if(_pBlkOver == NULL)
+		return(0);
+	_pWinOver		= new OverlayMem2Dv2(_pWin, winDim, winDim, OM2DV2U8_MAX_J_WIDTH, OM2DV2U8_MAX_J_WIDTH);
+	if(_pWinOver == NULL)
+		return(0);
+	return(1);
+}//end CreateWork.
+
+/** Reset the overlayed mem to a different source.
+This object does not own the mem but does own the 2-dim ptr that
+must be recreated. The overlay block and boundary parameters are unchanged.
+@param srcPtr			: New source pointer. 
+@param srcWidth		: Source width.
+@param srcHeight	: Source height.
+@param srcStride	: Row stride of the source when padded. 0 = srcWidth.
+@return 					: 0 = failure, 1 = success.
+*/
+int OverlayMem2Dv2u8::SetMem(void* srcPtr, int srcWidth, int srcHeight, int srcStride)
+{
+	if(srcPtr == NULL)
+		return(0);
+
+	_srcWidth		= srcWidth;
+	_srcHeight	= srcHeight;
+	_stride			= (srcStride > srcWidth) ? srcStride : srcWidth;
+	_pMem				= (unsigned char *)srcPtr;
+
+	// 2-Dim ptr must be recreated.
+	if(_pBlock != NULL)
+		delete[] _pBlock;
+	_pBlock = NULL;
+
+	// Alloc the mem block row addresses.
+	_pBlock = new unsigned char *[srcHeight];
+	if(_pBlock == NULL)
+		return(0);
+
+	// Fill the row addresses.
+	for(int row = 0; row < srcHeight; row++)
+		_pBlock[row] = &(_pMem[_stride * row]);
+
+	return(1);
+}//end SetMem.
+
+/** Set the top left origin of the block.
+This can be in the boundary signified by neg input values. The max input
+must be checked against the size of the block.
+@param x	: x loc.
+@param y	: y loc.
+@return		: none.
+*/
+void OverlayMem2Dv2u8::SetOrigin(int x, int y)
+{
+	x += _bWidth;
+	if(x < 0)
+		x = 0;
+	else if(x > (_srcWidth - _width))
+		x = _srcWidth - _width;
+	_xPos = x;
+
+	y += _bHeight;
+	if(y < 0)
+		y = 0;
+	else if(y > (_srcHeight - _height))
+		y = _srcHeight - _height;
+	_yPos = y;
+
+}//end SetOrigin.
+
+/*
+---------------------------------------------------------------------------
+	Public input/output interface.
+---------------------------------------------------------------------------
+*/
+
+/** Copy all of the source block into this block.
+The source and this block must have equal dimensions.
+@param srcBlock	: The block to copy.
+@return					: None.
+*/
+void OverlayMem2Dv2u8::Write(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& srcBlock)
+{
+	unsigned char** pS = srcBlock.Get2DSrcPtr();
+	for(int row = 0; row < me._height; row++)
+		memcpy((void *)(&(me._pBlock[me._yPos + row][me._xPos])), (const void *)(&(pS[srcBlock._yPos + row][srcBlock._xPos])), me._width);
+}//end Write.
+
+/** Copy all of the 16-bit source block into this block.
+The source and this block must have equal dimensions. Values are clipped
+to [0..255].
+@param srcBlock	: The block to copy.
+@return					: None.
+*/
+void OverlayMem2Dv2u8::Write(OverlayMem2Dv2u8& me, OverlayMem2Dv2& srcBlock)
+{
+	short** pS = srcBlock.Get2DSrcPtr();
+	for(int row = 0; row < me._height; row++)
+		Narrow(&(pS[srcBlock.GetOriginY() + row][srcBlock.GetOriginX()]), &(me._pBlock[me._yPos + row][me._xPos]), me._width);
+}//end Write.
+
+/** Copy all of this block into the destination block.
+The destination and this block must have equal dimensions.
+@param dstBlock	: The block to copy to.
+@return					: None.
+*/
+void OverlayMem2Dv2u8::Read(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& dstBlock)
+{
+	Write(dstBlock, me);
+}//end Read.
+
+/** Copy all of this block into the 16-bit destination block.
+The destination and this block must have equal dimensions.
+@param dstBlock	: The block to copy to.
+@return					: None.
+*/
+void OverlayMem2Dv2u8::Read(OverlayMem2Dv2u8& me, OverlayMem2Dv2& dstBlock)
+{
+	short** pD = dstBlock.Get2DSrcPtr();
+	for(int row = 0; row < me._height; row++)
+		Widen(&(me._pBlock[me._yPos + row][me._xPos]), &(pD[dstBlock.GetOriginY() + row][dstBlock.GetOriginX()]), me._width);
+}//end Read.
+
+/** Read from an 1/4 location offset around this block to a destination block.
+No mem column or row overflow checking is done during the read process. Use
+this method with caution. Note that values outside of the _width and _height
+need to be valid for the 1/4 calculation. The result is identical to
+OverlayMem2Dv2::QuarterRead().
+@param dstBlock				: Destination to read to.
+@param quarterColOff	: 1/4 location offset from fromCol.
+@param quarterRowOff	: 1/4 location offset from fromRow.
+@return 							: None.
+*/
+void OverlayMem2Dv2u8::QuarterRead(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& dstBlock, int quarterColOff, int quarterRowOff)
+{
+	unsigned char**	pLcl	= dstBlock.Get2DSrcPtr();
+	unsigned char**	p			= me._pBlock;
+	int	row, col;
+
+	/// Offsets are only positive numbers from the top left position so all -ve offsets are reflected
+	/// to full pel locations to the left or above the current block position.
+	int fullOffX	= 0;
+	int xFrac			= quarterColOff;
+	if(quarterColOff < 0)
+	{
+		fullOffX	= -1;
+		xFrac			= 4 + quarterColOff;
+	}//end if quarterColOff...
+	int fullOffY	= 0;
+	int yFrac			= quarterRowOff;
+	if(quarterRowOff < 0)
+	{
+		fullOffY	= -1;
+		yFrac			= 4 + quarterRowOff;	 
+	}//end if quarterRowOff...
+	int selection = (xFrac & 3) | ((yFrac << 2) & 12);
+
+#ifdef OM2DV2U8_SSE2
+	/// Widen the filter window and use the vectorised 16-bit interpolation.
+	if( selection && !(me._width & 7)&&(me._width <= OM2DV2U8_MAX_J_WIDTH)&&(me._height <= OM2DV2U8_MAX_J_WIDTH) )
+	{
+		if(me.CreateWork())
+		{
+			short** pWin	= me._pWinOver->Get2DSrcPtr();
+			short** pBlk	= me._pBlkOver->Get2DSrcPtr();
+			int x0				= me._xPos + fullOffX - 2;	///< 2 left and 3 right for the 6-tap.
+			int y0				= me._yPos + fullOffY - 2;
+			for(row = 0; row < (me._height + 5); row++)
+				Widen(&(p[y0 + row][x0]), pWin[row], me._width + 5);
+			me._pWinOver->SetOverlayDim(me._width, me._height);
+			me._pWinOver->SetOrigin(2 - fullOffX, 2 - fullOffY);
+			me._pBlkOver->SetOverlayDim(me._width, me._height);
+			me._pWinOver->QuarterRead(*(me._pBlkOver), quarterColOff, quarterRowOff);
+			for(row = 0; row < me._height; row++)
+				Narrow(pBlk[row], &(pLcl[dstBlock._yPos + row][dstBlock._xPos]), me._width);
+			return;
+		}//end if CreateWork...
+	}//end if selection...
+#endif
+
+	/// The centre half pel j is required for selections 6, 9, 10, 11 and 14. It is 
+	/// calculated separably into a work area of vertical 6-tap intermediates.
+	unsigned char	pJ[OM2DV2U8_MAX_J_WIDTH * OM2DV2U8_MAX_J_WIDTH];
+	if( (selection == 6)||(selection == 9)||(selection == 10)||(selection == 11)||(selection == 14) )
+	{
+		if( (me._width > OM2DV2U8_MAX_J_WIDTH)||(me._height > OM2DV2U8_MAX_J_WIDTH) )
+		{
+			/// Direct 2-D filter for large blocks.
+			for(row = 0; row < me._height; row++)
+				for(col = 0; col < me._width; col++)
+				{
+					int x = me._xPos + fullOffX + col;
+					int y = me._yPos + fullOffY + row;
+					int j = OM2DV2U8_GET_J(p, x, y);
+					int v = OM2DV2U8_CLIP255(j);
+					int s;
+					switch(selection)
+					{
+						case 6:		s = (v + OM2DV2U8_B(x, y) + 1) >> 1;			break;
+						case 9:		s = (v + OM2DV2U8_H(x, y) + 1) >> 1;			break;
+						case 11:	s = (v + OM2DV2U8_H(x + 1, y) + 1) >> 1;	break;
+						case 14:	s = (v + OM2DV2U8_B(x, y + 1) + 1) >> 1;	break;
+						default:	s = v;																		break;
+					}//end switch selection...
+					pLcl[dstBlock._yPos + row][dstBlock._xPos + col] = (unsigned char)s;
+				}//end for row & col...
+			return;
+		}//end if _width...
+
+		int vTap[OM2DV2U8_MAX_J_WIDTH + 5];
+		for(row = 0; row < me._height; row++)
+		{
+			int y		= me._yPos + fullOffY + row;
+			int x0	= me._xPos + fullOffX - 2;
+			for(col = 0; col < (me._width + 5); col++)
+				vTap[col] = OM2DV2U8_VERT_6TAP(p, x0 + col, y);
+			unsigned char* pJRow = &(pJ[row * me._width]);
+			for(col = 0; col < me._width; col++)
+			{
+				int j = (OM2DV2U8_6TAP(vTap[col], vTap[col+1], vTap[col+2], vTap[col+3], vTap[col+4], vTap[col+5]) + 512) >> 10;
+				pJRow[col] = (unsigned char)OM2DV2U8_CLIP255(j);
+			}//end for col...
+		}//end for row...
+	}//end if selection...
+
+	switch(selection)
+	{
+		case 2:		///< = b.
+			OM2DV2U8_QLOOP(OM2DV2U8_B(x, y))
+			break;
+		case 8:		///< = h.
+			OM2DV2U8_QLOOP(OM2DV2U8_H(x, y))
+			break;
+		case 10:	///< = j.
+			OM2DV2U8_QLOOP(OM2DV2U8_J(x, y))
+			break;
+		case 1:		///< = a.
+			OM2DV2U8_QLOOP(((int)p[y][x] + OM2DV2U8_B(x, y) + 1) >> 1)
+			break;
+		case 3:		///< = c.
+			OM2DV2U8_QLOOP(((int)p[y][x+1] + OM2DV2U8_B(x, y) + 1) >> 1)
+			break;
+		case 4:		///< = d.
+			OM2DV2U8_QLOOP(((int)p[y][x] + OM2DV2U8_H(x, y) + 1) >> 1)
+			break;
+		case 12:	///< = n.
+			OM2DV2U8_QLOOP(((int)p[y+1][x] + OM2DV2U8_H(x, y) + 1) >> 1)
+			break;
+		case 6:		///< = f.
+			OM2DV2U8_QLOOP((OM2DV2U8_J(x, y) + OM2DV2U8_B(x, y) + 1) >> 1)
+			break;
+		case 14:	///< = q. "s" is a "b" for the row below.
+			OM2DV2U8_QLOOP((OM2DV2U8_J(x, y) + OM2DV2U8_B(x, y + 1) + 1) >> 1)
+			break;
+		case 9:		///< = i.
+			OM2DV2U8_QLOOP((OM2DV2U8_J(x, y) + OM2DV2U8_H(x, y) + 1) >> 1)
+			break;
+		case 11:	///< = k. "m" is an "h" in the next col.
+			OM2DV2U8_QLOOP((OM2DV2U8_J(x, y) + OM2DV2U8_H(x + 1, y) + 1) >> 1)
+			break;
+		case 5:		///< = e.
+			OM2DV2U8_QLOOP((OM2DV2U8_B(x, y) + OM2DV2U8_H(x, y) + 1) >> 1)
+			break;
+		case 7:		///< = g.
+			OM2DV2U8_QLOOP((OM2DV2U8_B(x, y) + OM2DV2U8_H(x + 1, y) + 1) >> 1)
+			break;
+		case 13:	///< = p.
+			OM2DV2U8_QLOOP((OM2DV2U8_H(x, y) + OM2DV2U8_B(x, y + 1) + 1) >> 1)
+			break;
+		case 15:	///< = r.
+			OM2DV2U8_QLOOP((OM2DV2U8_H(x + 1, y) + OM2DV2U8_B(x, y + 1) + 1) >> 1)
+			break;
+		case 0:		///< Origin case (Shouldn't ever be used).
+		default:
+			Write(dstBlock, me);
+			break;
+	}//end switch selection...
+
+}//end QuarterRead.
+
+/** Read from an 1/8th location offset around this block to a destination block.
+No mem column or row overflow checking is done during the read process. Use
+this method with caution. Note that values outside of the _width and _height
+need to be valid for the 1/8th calculation. The result is identical to
+OverlayMem2Dv2::EighthRead().
+@param dstBlock			: Destination to read to.
+@param eighthColOff	: 1/8th location offset from fromCol.
+@param eighthRowOff	: 1/8th location offset from fromRow.
+@return 						: None.
+*/
+void OverlayMem2Dv2u8::EighthRead(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& dstBlock, int eighthColOff, int eighthRowOff)
+{
+	unsigned char**	pLcl = dstBlock.Get2DSrcPtr();
+	int	row, col;
+
+	int fullOffX	= 0;
+	int xFracC		= eighthColOff;
+	if(eighthColOff < 0)
+	{
+		fullOffX	= -1;
+		xFracC		= 8 + eighthColOff;
+	}//end if eighthColOff...
+	int fullOffY	= 0;
+	int yFracC		= eighthRowOff;
+	if(eighthRowOff < 0)
+	{
+		fullOffY	= -1;
+		yFracC		= 8 + eighthRowOff;	 
+	}//end if eighthRowOff...
+
+	if(!xFracC && !yFracC)	///< Origin case (Shouldn't ever be used).
+	{
+		Write(dstBlock, me);
+		return;
+	}//end if !xFracC...
+
+#ifdef OM2DV2U8_SSE2
+	/// Widen the filter window and use the vectorised 16-bit interpolation.
+	if( !(me._width & 7)&&(me._width <= OM2DV2U8_MAX_J_WIDTH)&&(me._height <= OM2DV2U8_MAX_J_WIDTH) )
+	{
+		if(me.CreateWork())
+		{
+			short** pWin	= me._pWinOver->Get2DSrcPtr();
+			short** pBlk	= me._pBlkOver->Get2DSrcPtr();
+			int x0				= me._xPos + fullOffX;
+			int y0				= me._yPos + fullOffY;
+			for(row = 0; row < (me._height + 1); row++)
+				Widen(&(me._pBlock[y0 + row][x0]), pWin[row], me._width + 1);
+			me._pWinOver->SetOverlayDim(me._width, me._height);
+			me._pWinOver->SetOrigin(-fullOffX, -fullOffY);
+			me._pBlkOver->SetOverlayDim(me._width, me._height);
+			me._pWinOver->EighthRead(*(me._pBlkOver), eighthColOff, eighthRowOff);
+			for(row = 0; row < me._height; row++)
+				Narrow(pBlk[row], &(pLcl[dstBlock._yPos + row][dstBlock._xPos]), me._width);
+			return;
+		}//end if CreateWork...
+	}//end if _width...
+#endif
+
+	/// Bilinear weights.
+	int wA = (8 - xFracC)*(8 - yFracC);
+	int wB = xFracC*(8 - yFracC);
+	int wC = (8 - xFracC)*yFracC;
+	int wD = xFracC*yFracC;
+	for(row = 0; row < me._height; row++)
+	{
+		unsigned char* pS0 = &(me._pBlock[me._yPos + fullOffY + row][me._xPos + fullOffX]);
+		unsigned char* pS1 = &(me._pBlock[me._yPos + fullOffY + row + 1][me._xPos + fullOffX]);
+		unsigned char* pD	 = &(pLcl[dstBlock._yPos + row][dstBlock._xPos]);
+		for(col = 0; col < me._width; col++)
+			pD[col] = (unsigned char)((wA*(int)pS0[col] + wB*(int)pS0[col+1] + wC*(int)pS1[col] + wD*(int)pS1[col+1] + 32) >> 6);
+	}//end for row...
+
+}//end EighthRead.
+
+/** Read a block with edge emulation.
+Read a block of the destination dimensions from the mem position (fromCol, 
+fromRow) where the position is relative to the top left of the mem and not 
+the overlay origin. Positions outside of the mem take the value of the nearest
+edge pel.
+@param dstBlock	: Destination to read to.
+@param fromCol	: Mem col of the top left of the block. May be -ve.
+@param fromRow	: Mem row of the top left of the block. May be -ve.
+@return 				: None.
+*/
+void OverlayMem2Dv2u8::EdgeRead(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& dstBlock, int fromCol, int fromRow)
+{
+	unsigned char**	pLcl		= dstBlock.Get2DSrcPtr();
+	int							width		= dstBlock._width;
+	int							height	= dstBlock._height;
+
+	/// Split the cols into left replicated, inside and right replicated spans.
+	int left	= -fromCol;
+	if(left < 0)			left = 0;
+	if(left > width)	left = width;
+	int right = (fromCol + width) - me._srcWidth;
+	if(right < 0)			right = 0;
+	if(right > width)	right = width;
+	int inside = width - left - right;
+	if(inside < 0)	///< The block is wider than the mem.
+		inside = 0;
+
+	for(int row = 0; row < height; row++)
+	{
+		int srcRow = fromRow + row;
+		if(srcRow < 0)
+			srcRow = 0;
+		else if(srcRow >= me._srcHeight)
+			srcRow = me._srcHeight - 1;
+		unsigned char* pS = me._pBlock[srcRow];
+		unsigned char* pD = &(pLcl[dstBlock._yPos + row][dstBlock._xPos]);
+
+		int col = 0;
+		if(left)
+		{
+			memset((void *)pD, pS[0], left);
+			col = left;
+		}//end if left...
+		if(inside)
+		{
+			memcpy((void *)&(pD[col]), (const void *)&(pS[fromCol + col]), inside);
+			col += inside;
+		}//end if inside...
+		for(; col < width; col++)
+		{
+			int srcCol = fromCol + col;
+			if(srcCol < 0)
+				srcCol = 0;
+			else if(srcCol >= me._srcWidth)
+				srcCol = me._srcWidth - 1;
+			pD[col] = pS[srcCol];
+		}//end for col...
+	}//end for row...
+
+}//end EdgeRead.
+
+/*
+---------------------------------------------------------------------------
+	Public block operations interface.
+---------------------------------------------------------------------------
+*/
+
+void OverlayMem2Dv2u8::Fill(OverlayMem2Dv2u8& me, int value)
+{
+	for(int row = 0; row < me._height; row++)
+		memset((void *)(&(me._pBlock[me._yPos + row][me._xPos])), (unsigned char)value, me._width);
+}//end Fill.
+
+/** Calc the total square difference with the input block.
+The block dimensions must match.
+@param b	: Input block.
+@return		: The total square difference.
+*/
+int OverlayMem2Dv2u8::Tsd(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b)
+{
+	if( (me._width == 16)&&(me._height == 16) )
+		return(Tsd16x16(me, b));
+	if( (me._width == 8)&&(me._height == 8) )
+		return(Tsd8x8(me, b));
+
+	OM2DV2U8_COUNT_EVALUATION;
+	unsigned char** bPtr = b.Get2DSrcPtr();
+	int acc = 0;
+	for(int row = 0; row < me._height; row++)
+	{
+		unsigned char* pP = &(me._pBlock[me._yPos + row][me._xPos]);
+		unsigned char* pI = &(bPtr[b._yPos + row][b._xPos]);
+		for(int col = 0; col < me._width; col++)
+		{
+			int diff = (int)pP[col] - (int)pI[col];
+			acc += diff * diff;
+		}//end for col...
+	}//end for row...
+	return(acc);
+}//end Tsd.
+
+int OverlayMem2Dv2u8::Tsd8x8(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b)
+{
+	return(Tsd8x8LessThan(me, b, 0x7FFFFFFF));
+}//end Tsd8x8.
+
+int OverlayMem2Dv2u8::Tsd16x16(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b)
+{
+	return(Tsd16x16LessThan(me, b, 0x7FFFFFFF));
+}//end Tsd16x16.
+
+/** Calc the total square difference with early exit.
+The accumulation stops once it exceeds min and the partial total is returned.
+@param b		: Input block.
+@param min	: Value to improve on.
+@return			: The total square difference or a partial value > min.
+*/
+int OverlayMem2Dv2u8::Tsd8x8LessThan(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b, int min)
+{
+	OM2DV2U8_COUNT_EVALUATION;
+	unsigned char** bPtr = b.Get2DSrcPtr();
+	int row;
+#ifdef OM2DV2U8_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for(row = 0; row < 8; row++)
+	{
+		__m128i vP = _mm_loadl_epi64((const __m128i *)(&(me._pBlock[me._yPos + row][me._xPos])));
+		__m128i vI = _mm_loadl_epi64((const __m128i *)(&(bPtr[b._yPos + row][b._xPos])));
+		acc = OM2DV2U8_Sdx8(acc, vP, vI);
+		if(row == 3)
+		{
+			int part = OM2DV2U8_Sum32x4(acc);
+			if(part > min)	return(part);	///< Early exit because exceeded min.
+		}//end if row...
+	}//end for row...
+	return(OM2DV2U8_Sum32x4(acc));
+#else
+	int acc = 0;
+	for(row = 0; row < 8; row++)
+	{
+		unsigned char* pP = &(me._pBlock[me._yPos + row][me._xPos]);
+		unsigned char* pI = &(bPtr[b._yPos + row][b._xPos]);
+		for(int col = 0; col < 8; col++)
+		{
+			int diff = (int)pP[col] - (int)pI[col];
+			acc += diff * diff;
+		}//end for col...
+		if(acc > min)	return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+	return(acc);
+#endif
+}//end Tsd8x8LessThan.
+
+int OverlayMem2Dv2u8::Tsd16x16LessThan(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b, int min)
+{
+	OM2DV2U8_COUNT_EVALUATION;
+	unsigned char** bPtr = b.Get2DSrcPtr();
+	int row;
+#ifdef OM2DV2U8_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for(row = 0; row < 16; row++)
+	{
+		__m128i vP = _mm_loadu_si128((const __m128i *)(&(me._pBlock[me._yPos + row][me._xPos])));
+		__m128i vI = _mm_loadu_si128((const __m128i *)(&(bPtr[b._yPos + row][b._xPos])));
+		acc = OM2DV2U8_Sdx16(acc, vP, vI);
+		if((row & 3) == 3)
+		{
+			int part = OM2DV2U8_Sum32x4(acc);
+			if(part > min)	return(part);	///< Early exit every 4 rows because exceeded min.
+		}//end if row...
+	}//end for row...
+	return(OM2DV2U8_Sum32x4(acc));
+#else
+	int acc = 0;
+	for(row = 0; row < 16; row++)
+	{
+		unsigned char* pP = &(me._pBlock[me._yPos + row][me._xPos]);
+		unsigned char* pI = &(bPtr[b._yPos + row][b._xPos]);
+		for(int col = 0; col < 16; col++)
+		{
+			int diff = (int)pP[col] - (int)pI[col];
+			acc += diff * diff;
+		}//end for col...
+		if(acc > min)	return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+	return(acc);
+#endif
+}//end Tsd16x16LessThan.
+
+/** Calc the total absolute difference with the input block.
+The block dimensions must match.
+@param b	: Input block.
+@return		: The total absolute difference.
+*/
+int OverlayMem2Dv2u8::Tad(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b)
+{
+	if( (me._width == 16)&&(me._height == 16) )
+		return(Tad16x16(me, b));
+	if( (me._width == 8)&&(me._height == 8) )
+		return(Tad8x8(me, b));
+	if( (me._width == 4)&&(me._height == 4) )
+		return(Tad4x4(me, b));
+
+	OM2DV2U8_COUNT_EVALUATION;
+	unsigned char** bPtr = b.Get2DSrcPtr();
+	int acc = 0;
+	for(int row = 0; row < me._height; row++)
+	{
+		unsigned char* pP = &(me._pBlock[me._yPos + row][me._xPos]);
+		unsigned char* pI = &(bPtr[b._yPos + row][b._xPos]);
+		for(int col = 0; col < me._width; col++)
+		{
+			int diff = (int)pP[col] - (int)pI[col];
+			acc += OM2DV2U8_FAST_ABS32(diff);
+		}//end for col...
+	}//end for row...
+	return(acc);
+}//end Tad.
+
+int OverlayMem2Dv2u8::Tad4x4(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b)
+{
+	OM2DV2U8_COUNT_EVALUATION;
+	unsigned char** bPtr = b.Get2DSrcPtr();
+	int acc = 0;
+	for(int row = 0; row < 4; row++)
+	{
+		unsigned char* pP = &(me._pBlock[me._yPos + row][me._xPos]);
+		unsigned char* pI = &(bPtr[b._yPos + row][b._xPos]);
+		int d0 = (int)pP[0] - (int)pI[0];
+		int d1 = (int)pP[1] - (int)pI[1];
+		int d2 = (int)pP[2] - (int)pI[2];
+		int d3 = (int)pP[3] - (int)pI[3];
+		acc += OM2DV2U8_FAST_ABS32(d0) + OM2DV2U8_FAST_ABS32(d1) + OM2DV2U8_FAST_ABS32(d2) + OM2DV2U8_FAST_ABS32(d3);
+	}//end for row...
+	return(acc);
+}//end Tad4x4.
+
+int OverlayMem2Dv2u8::Tad8x8(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b)
+{
+	return(Tad8x8LessThan(me, b, 0x7FFFFFFF));
+}//end Tad8x8.
+
+int OverlayMem2Dv2u8::Tad16x16(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b)
+{
+	return(Tad16x16LessThan(me, b, 0x7FFFFFFF));
+}//end Tad16x16.
+
+/** Calc the total absolute difference with early exit.
+The accumulation stops once it exceeds min and the partial total is returned.
+@param b		: Input block.
+@param min	: Value to improve on.
+@return			: The total absolute difference or a partial value > min.
+*/
+int OverlayMem2Dv2u8::Tad8x8LessThan(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b, int min)
+{
+	OM2DV2U8_COUNT_EVALUATION;
+	unsigned char** bPtr = b.Get2DSrcPtr();
+	int row;
+#ifdef OM2DV2U8_SSE2
+	/// Two rows per sad.
+	__m128i acc = _mm_setzero_si128();
+	for(row = 0; row < 8; row += 2)
+	{
+		__m128i vP = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(&(me._pBlock[me._yPos + row][me._xPos]))),
+																		_mm_loadl_epi64((const __m128i *)(&(me._pBlock[me._yPos + row + 1][me._xPos]))));
+		__m128i vI = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(&(bPtr[b._yPos + row][b._xPos]))),
+																		_mm_loadl_epi64((const __m128i *)(&(bPtr[b._yPos + row + 1][b._xPos]))));
+		acc = _mm_add_epi32(acc, _mm_sad_epu8(vP, vI));
+		if(row == 2)
+		{
+			int part = OM2DV2U8_SadSum(acc);
+			if(part > min)	return(part);	///< Early exit because exceeded min.
+		}//end if row...
+	}//end for row...
+	return(OM2DV2U8_SadSum(acc));
+#else
+	int acc = 0;
+	for(row = 0; row < 8; row++)
+	{
+		unsigned char* pP = &(me._pBlock[me._yPos + row][me._xPos]);
+		unsigned char* pI = &(bPtr[b._yPos + row][b._xPos]);
+		for(int col = 0; col < 8; col++)
+		{
+			int diff = (int)pP[col] - (int)pI[col];
+			acc += OM2DV2U8_FAST_ABS32(diff);
+		}//end for col...
+		if(acc > min)	return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+	return(acc);
+#endif
+}//end Tad8x8LessThan.
+
+int OverlayMem2Dv2u8::Tad16x16LessThan(OverlayMem2Dv2u8& me, OverlayMem2Dv2u8& b, int min)
+{
+	OM2DV2U8_COUNT_EVALUATION;
+	unsigned char** bPtr = b.Get2DSrcPtr();
+	int row;
+#ifdef OM2DV2U8_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for(row = 0; row < 16; row++)
+	{
+		__m128i vP = _mm_loadu_si128((const __m128i *)(&(me._pBlock[me._yPos + row][me._xPos])));
+		__m128i vI = _mm_loadu_si128((const __m128i *)(&(bPtr[b._yPos + row][b._xPos])));
+		acc = _mm_add_epi32(acc, _mm_sad_epu8(vP, vI));
+		if((row & 3) == 3)
+		{
+			int part = OM2DV2U8_SadSum(acc);
+			if(part > min)	return(part);	///< Early exit every 4 rows because exceeded min.
+		}//end if row...
+	}//end for row...
+	return(OM2DV2U8_SadSum(acc));
+#else
+	int acc = 0;
+	for(row = 0; row < 16; row++)
+	{
+		unsigned char* pP = &(me._pBlock[me._yPos + row][me._xPos]);
+		unsigned char* pI = &(bPtr[b._yPos + row][b._xPos]);
+		for(int col = 0; col < 16; col++)
+		{
+			int diff = (int)pP[col] - (int)pI[col];
+			acc += OM2DV2U8_FAST_ABS32(diff);
+		}//end for col...
+		if(acc > min)	return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+	return(acc);
+#endif
+}//end Tad16x16LessThan.
+
+/*
+---------------------------------------------------------------------------
+	Static utility methods.
+---------------------------------------------------------------------------
+*/
+
+/** Fill the boundary from the inner block.
+The inner block is valid and its edge pels are replicated into the boundary.
+@param srcPtr		: Mem including the boundary.
+@param srcWidth	: Mem width including the boundary.
+@param srcHeight: Mem height including the boundary.
+@param widthBy	: Boundary width.
+@param heightBy	: Boundary height.
+@param srcStride: Row stride of the mem when padded. 0 = srcWidth.
+@return					: None.
+*/
+void OverlayMem2Dv2u8::FillBoundary(void* srcPtr, int srcWidth, int srcHeight, int widthBy, int heightBy, int srcStride)
+{
+	unsigned char* lclPtr = (unsigned char *)srcPtr;
+	int y;
+	if(srcStride < srcWidth)
+		srcStride = srcWidth;
+
+	/// Left and right of the inner rows.
+	for(y = heightBy; y < (srcHeight - heightBy); y++)
+	{
+		unsigned char* pRow = &(lclPtr[srcStride * y]);
+		memset((void *)pRow, pRow[widthBy], widthBy);
+		memset((void *)(&(pRow[srcWidth - widthBy])), pRow[srcWidth - widthBy - 1], widthBy);
+	}//end for y...
+
+	/// Top and bottom are copies of the first and last extended inner rows.
+	for(y = 0; y < heightBy; y++)
+		memcpy((void *)(&(lclPtr[srcStride * y])), (const void *)(&(lclPtr[srcStride * heightBy])), srcWidth);
+	for(y = (srcHeight - heightBy); y < srcHeight; y++)
+		memcpy((void *)(&(lclPtr[srcStride * y])), (const void *)(&(lclPtr[srcStride * (srcHeight - heightBy - 1)])), srcWidth);
+
+}//end FillBoundary.
+
+/** Sub sample the src by half into another 2D mem block with possible offset.
+The dst must be large enough to accommodate the offset plus src/2 dims.
+@param srcPtr		: Addressable as srcPtr[][].
+@param srcWidth	: Src width.
+@param srcHeight: Src height.
+@param dstPtr		: 2D addressable dstPtr[srcHeight/2 + heightOff][srcWidth/2 + widthOff].
+@param widthOff	: X offset into dst.
+@param heightOff: Y offset into dst.
+@return					: none.
+*/
+void OverlayMem2Dv2u8::Half(void** srcPtr, int srcWidth, int srcHeight, 
+													void** dstPtr, int widthOff, int heightOff)
+{
+	unsigned char** ppS = (unsigned char **)(srcPtr);
+	unsigned char** ppD = (unsigned char **)(dstPtr);
+
+	int m,n,x,y;
+  for(m = 0, y = heightOff; m < srcHeight; m += 2, y++)
+		for(n = 0, x = widthOff; n < srcWidth; n += 2, x++)
+  {
+		ppD[y][x] = (unsigned char)(((int)ppS[m][n] + (int)ppS[m][n+1] + (int)ppS[m+1][n] + (int)ppS[m+1][n+1] + 2) >> 2);
+	}//end for m & n...
+
+}//end Half.
+
+/** Narrow contiguous 16-bit pels to 8-bit.
+@param srcPtr	: 16-bit src.
+@param dstPtr	: 8-bit dst.
+@param len		: Num of pels.
+@return				: None.
+*/
+void OverlayMem2Dv2u8::Narrow(const short* srcPtr, unsigned char* dstPtr, int len)
+{
+	int i = 0;
+#ifdef OM2DV2U8_SSE2
+	for(; i <= (len - 16); i += 16)
+	{
+		__m128i lo = _mm_loadu_si128((const __m128i *)(&(srcPtr[i])));
+		__m128i hi = _mm_loadu_si128((const __m128i *)(&(srcPtr[i + 8])));
+		_mm_storeu_si128((__m128i *)(&(dstPtr[i])), _mm_packus_epi16(lo, hi));
+	}//end for i...
+	/// The tail overlaps the last full vector.
+	if( (i < len)&&(len >= 16) )
+	{
+		i = len - 16;
+		__m128i lo = _mm_loadu_si128((const __m128i *)(&(srcPtr[i])));
+		__m128i hi = _mm_loadu_si128((const __m128i *)(&(srcPtr[i + 8])));
+		_mm_storeu_si128((__m128i *)(&(dstPtr[i])), _mm_packus_epi16(lo, hi));
+		return;
+	}//end if i...
+#endif
+	for(; i < len; i++)
+	{
+		int x = srcPtr[i];
+		dstPtr[i] = (unsigned char)OM2DV2U8_CLIP255(x);
+	}//end for i...
+}//end Narrow.
+
+/** Widen contiguous 8-bit pels to 16-bit.
+@param srcPtr	: 8-bit src.
+@param dstPtr	: 16-bit dst.
+@param len		: Num of pels.
+@return				: None.
+*/
+void OverlayMem2Dv2u8::Widen(const unsigned char* srcPtr, short* dstPtr, int len)
+{
+	int i = 0;
+#ifdef OM2DV2U8_SSE2
+	__m128i zero = _mm_setzero_si128();
+	for(; i <= (len - 16); i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i *)(&(srcPtr[i])));
+		_mm_storeu_si128((__m128i *)(&(dstPtr[i])), _mm_unpacklo_epi8(v, zero));
+		_mm_storeu_si128((__m128i *)(&(dstPtr[i + 8])), _mm_unpackhi_epi8(v, zero));
+	}//end for i...
+	/// The tail overlaps the last full vector.
+	if( (i < len)&&(len >= 16) )
+	{
+		i = len - 16;
+		__m128i v = _mm_loadu_si128((const __m128i *)(&(srcPtr[i])));
+		_mm_storeu_si128((__m128i *)(&(dstPtr[i])), _mm_unpacklo_epi8(v, zero));
+		_mm_storeu_si128((__m128i *)(&(dstPtr[i + 8])), _mm_unpackhi_epi8(v, zero));
+		return;
+	}//end if i...
+#endif
+	for(; i < len; i++)
+		dstPtr[i] = (short)srcPtr[i];
+}//end Widen.
+
@@ -0,0 +1,409 @@
+/** @file
+
+MODULE				: PicMosaicBase
+
+TAG						: PMOS
+
+FILE NAME			: PicMosaicBase.cpp
+
+DESCRIPTION		: Base class of a multi-input mosaic compositor. Input
+								frames are optionally scaled to their layout regions
+								and the dirty regions are written to the canvas in one
+								pass of bands shared between threads.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "PicMosaicBase.h"
+#include "PicScalerPolyphaseImpl.h"
+
+/// Compose phases run by the threads.
+#define PMOS_PHASE_SCALE	0
+#define PMOS_PHASE_BANDS	1
+
+/*
+===========================================================================
+	Construction and Destruction.
+===========================================================================
+*/
+PicMosaicBase::PicMosaicBase(void)
+{
+	/// Single plane of 1 byte pels until the derived class describes its format.
+	_planes				= 1;
+	_maxShift			= 0;
+	_scaleFormat	= PSPOLY_YUV420P;
+	_chrOff				= 128;
+	for(int p = 0; p < PMOS_MAX_PLANES; p++)
+	{
+		_pelBytes[p] = 1;
+		_shift[p]		= 0;
+		memset(_fill[p], 0, 4);
+	}//end for p...
+
+	_threads		= 1;
+	_bandHeight	= PMOS_BAND_HEIGHT;
+	_filter			= PSPOLY_BILINEAR;
+	_regions		= 0;
+	ResetMembers();
+}//end constructor.
+
+PicMosaicBase::~PicMosaicBase(void)
+{
+	Destroy();
+}//end destructor.
+
+void PicMosaicBase::ResetMembers(void)
+{
+	_width				= 0;
+	_height				= 0;
+	_full					= 1;
+	_pLastCanvas	= NULL;
+	_pCanvas			= NULL;
+	_dirtyRects		= 0;
+	_scales				= 0;
+	_next					= 0;
+}//end ResetMembers.
+
+/*
+===========================================================================
+	Public Methods.
+===========================================================================
+*/
+int PicMosaicBase::Create(int width, int height)
+{
+	Destroy();
+	if( (width < 1)||(height < 1)||(width % Alignment())||(height % Alignment()) )
+		return(0);
+	_width	= width;
+	_height	= height;
+	return(1);
+}//end Create.
+
+void PicMosaicBase::Destroy(void)
+{
+	ClearRegions();
+	ResetMembers();
+}//end Destroy.
+
+int PicMosaicBase::AddRegion(int srcWidth, int srcHeight, int x, int y, int width, int height)
+{
+	int a = Alignment();
+	if( (_regions >= PMOS_MAX_REGIONS)||(srcWidth < a)||(srcHeight < a)||(width < a)||(height < a) )
+		return(-1);
+	if( (x < 0)||(y < 0)||((x + width) > _width)||((y + height) > _height) )
+		return(-1);
+	if( (srcWidth % a)||(srcHeight % a)||(x % a)||(y % a)||(width % a)||(height % a) )
+		return(-1);
+
+	PMOS_REGION* r = &(_region[_regions]);
+	r->srcWidth		= srcWidth;
+	r->srcHeight	= srcHeight;
+	r->x					= x;
+	r->y					= y;
+	r->width			= width;
+	r->height			= height;
+	r->pImg				= NULL;
+	r->dirty			= 0;
+	r->pScaler		= NULL;
+	r->pScaled		= NULL;
+
+	if( (srcWidth != width)||(srcHeight != height) )
+	{
+		r->pScaler = new PicScalerPolyphaseImpl(width, height, srcWidth, srcHeight, _scaleFormat, _filter);
+		r->pScaled = new unsigned char[PlaneOffset(_planes, width, height)];
+		if(r->pScaler != NULL)
+			r->pScaler->SetChrominanceOffset(_chrOff);
+		if( (r->pScaler == NULL)||(r->pScaled == NULL)||!r->pScaler->Create() )
+		{
+			if(r->pScaler != NULL)
+				delete r->pScaler;
+			if(r->pScaled != NULL)
+				delete[] r->pScaled;
+			return(-1);
+		}//end if pScaler...
+	}//end if srcWidth...
+
+	_full = 1;
+	return(_regions++);
+}//end AddRegion.
+
+int PicMosaicBase::AddGrid(int cols, int rows, int srcWidth, int srcHeight, int gap)
+{
+	if( (cols < 1)||(rows < 1)||(gap < 0)||((_regions + cols*rows) > PMOS_MAX_REGIONS) )
+		return(0);
+
+	/// Equal cells rounded down to the format alignment.
+	int a = Alignment();
+	int cellWidth		= ((_width - (cols - 1)*gap)/cols) & ~(a - 1);
+	int cellHeight	= ((_height - (rows - 1)*gap)/rows) & ~(a - 1);
+	int first = _regions;
+	for(int j = 0; j < rows; j++)
+		for(int i = 0; i < cols; i++)
+		{
+			if(AddRegion(srcWidth, srcHeight, i*(cellWidth + gap), j*(cellHeight + gap), cellWidth, cellHeight) < 0)
+			{
+				/// Remove the partial grid.
+				while(_regions > first)
+				{
+					_regions--;
+					if(_region[_regions].pScaler != NULL)
+						delete _region[_regions].pScaler;
+					if(_region[_regions].pScaled != NULL)
+						delete[] _region[_regions].pScaled;
+				}//end while _regions...
+				return(0);
+			}//end if AddRegion...
+		}//end for j & i...
+
+	return(1);
+}//end AddGrid.
+
+void PicMosaicBase::ClearRegions(void)
+{
+	for(int i = 0; i < _regions; i++)
+	{
+		if(_region[i].pScaler != NULL)
+			delete _region[i].pScaler;
+		if(_region[i].pScaled != NULL)
+			delete[] _region[i].pScaled;
+		_region[i].pScaler = NULL;
+		_region[i].pScaled = NULL;
+	}//end for i...
+	_regions	= 0;
+	_full			= 1;
+}//end ClearRegions.
+
+/** Set the current frame of a region.
+The frame pointer is held until replaced and is read by later composes even
+when the region is not dirty, so the caller keeps the frame alive.
+@param region	: Region index.
+@param pImg		: Frame of the region src dimensions.
+@return				: 1 = success, 0 = invalid region or frame.
+*/
+int PicMosaicBase::SetInput(int region, const void* pImg)
+{
+	if( (region < 0)||(region >= _regions)||(pImg == NULL) )
+		return(0);
+	_region[region].pImg	= pImg;
+	_region[region].dirty	= 1;
+	return(1);
+}//end SetInput.
+
+int PicMosaicBase::SetThreads(int threads)
+{
+	if( (threads < 1)||(threads > PMOS_MAX_THREADS) )
+		return(0);
+	_threads = threads;
+	return(1);
+}//end SetThreads.
+
+int PicMosaicBase::SetBandHeight(int height)
+{
+	if( (height < 1)||(height % Alignment()) )
+		return(0);
+	_bandHeight = height;
+	return(1);
+}//end SetBandHeight.
+
+/** Write the dirty regions into the canvas.
+The canvas planes are of the Create() dimensions and are contiguous.
+@param pCanvas	: Canvas image.
+@return					: 1 = success, 0 = no canvas.
+*/
+int PicMosaicBase::Compose(void* pCanvas)
+{
+	if( (pCanvas == NULL)||(_width == 0) )
+		return(0);
+
+	int i;
+	if(pCanvas != _pLastCanvas)
+		_full = 1;
+	_pCanvas = (unsigned char *)pCanvas;
+
+	/// Dirty inputs to scale and the canvas rects to rewrite.
+	_scales			= 0;
+	_dirtyRects	= 0;
+	if(_full)
+	{
+		_dirtyRect[0][0] = 0;
+		_dirtyRect[0][1] = 0;
+		_dirtyRect[0][2] = _width;
+		_dirtyRect[0][3] = _height;
+		_dirtyRects = 1;
+	}//end if _full...
+	for(i = 0; i < _regions; i++)
+	{
+		PMOS_REGION* r = &(_region[i]);
+		if( (r->pImg == NULL)||(!r->dirty && !_full) )
+			continue;
+		if(r->pScaler != NULL)
+			_scaleList[_scales++] = i;
+		if(!_full)
+		{
+			_dirtyRect[_dirtyRects][0] = r->x;
+			_dirtyRect[_dirtyRects][1] = r->y;
+			_dirtyRect[_dirtyRects][2] = r->x + r->width;
+			_dirtyRect[_dirtyRects][3] = r->y + r->height;
+			_dirtyRects++;
+		}//end if !_full...
+	}//end for i...
+
+	if(_scales)
+		Parallel(PMOS_PHASE_SCALE, _scales);
+	if(_dirtyRects)
+		Parallel(PMOS_PHASE_BANDS, (_height + _bandHeight - 1)/_bandHeight);
+
+	for(i = 0; i < _regions; i++)
+		_region[i].dirty = 0;
+	_full					= 0;
+	_pLastCanvas	= pCanvas;
+	return(1);
+}//end Compose.
+
+/*
+===========================================================================
+	Private Methods.
+===========================================================================
+*/
+int PicMosaicBase::PlaneOffset(int plane, int width, int height)
+{
+	int offset = 0;
+	for(int p = 0; p < plane; p++)
+		offset += (width >> _shift[p]) * (height >> _shift[p]) * _pelBytes[p];
+	return(offset);
+}//end PlaneOffset.
+
+/// Run the jobs of a phase on the calling thread and the workers.
+void PicMosaicBase::Parallel(int phase, int jobs)
+{
+	_next = 0;
+	int workers = ((_threads < jobs) ? _threads : jobs) - 1;
+	std::thread* pWorker[PMOS_MAX_THREADS];
+	int i;
+	for(i = 0; i < workers; i++)
+		pWorker[i] = new std::thread(&PicMosaicBase::Work, this, phase);
+	Work(phase);
+	for(i = 0; i < workers; i++)
+	{
+		pWorker[i]->join();
+		delete pWorker[i];
+	}//end for i...
+}//end Parallel.
+
+void PicMosaicBase::Work(int phase)
+{
+	if(phase == PMOS_PHASE_SCALE)
+	{
+		for(int j = _next++; j < _scales; j = _next++)
+			ScaleRegion(_scaleList[j]);
+	}//end if phase...
+	else
+	{
+		int bands = (_height + _bandHeight - 1)/_bandHeight;
+		for(int b = _next++; b < bands; b = _next++)
+			ComposeBand(b);
+	}//end else...
+}//end Work.
+
+void PicMosaicBase::ScaleRegion(int region)
+{
+	PMOS_REGION* r = &(_region[region]);
+	r->pScaler->Scale(r->pScaled, (void *)r->pImg);
+}//end ScaleRegion.
+
+/** Rewrite the dirty rects within a band.
+The background is filled on a full redraw and then every region is drawn in
+layout order over its intersection with each dirty rect.
+*/
+void PicMosaicBase::ComposeBand(int band)
+{
+	int y0 = band * _bandHeight;
+	int y1 = ((y0 + _bandHeight) < _height) ? (y0 + _bandHeight) : _height;
+
+	for(int p = 0; p < _planes; p++)
+	{
+		int s						= _shift[p];
+		int bytes				= _pelBytes[p];
+		int canvasRow		= (_width >> s) * bytes;
+		unsigned char* pPlane = _pCanvas + PlaneOffset(p, _width, _height);
+
+		if(_full)
+		{
+			/// Fill the first band row and copy it to the others.
+			unsigned char* pFirst = pPlane + (y0 >> s)*canvasRow;
+			unsigned char* d = pFirst;
+			for(int x = 0; x < (_width >> s); x++, d += bytes)
+				memcpy(d, _fill[p], bytes);
+			for(int y = (y0 >> s) + 1; y < (y1 >> s); y++)
+				memcpy(pPlane + y*canvasRow, pFirst, canvasRow);
+		}//end if _full...
+
+		for(int i = 0; i < _regions; i++)
+		{
+			PMOS_REGION* r = &(_region[i]);
+			if(r->pImg == NULL)
+				continue;
+			const unsigned char* pSrc = (r->pScaler != NULL) ? r->pScaled : (const unsigned char *)r->pImg;
+			pSrc += PlaneOffset(p, r->width, r->height);
+			int srcRow = (r->width >> s) * bytes;
+
+			for(int k = 0; k < _dirtyRects; k++)
+			{
+				/// Region intersect dirty rect intersect band.
+				int ax0 = (r->x > _dirtyRect[k][0]) ? r->x : _dirtyRect[k][0];
+				int ax1 = ((r->x + r->width) < _dirtyRect[k][2]) ? (r->x + r->width) : _dirtyRect[k][2];
+				int ay0 = (r->y > _dirtyRect[k][1]) ? r->y : _dirtyRect[k][1];
+				int ay1 = ((r->y + r->height) < _dirtyRect[k][3]) ? (r->y + r->height) : _dirtyRect[k][3];
+				if(ay0 < y0) ay0 = y0;
+				if(ay1 > y1) ay1 = y1;
+				if( (ax1 <= ax0)||(ay1 <= ay0) )
+					continue;
+
+				int len = ((ax1 - ax0) >> s) * bytes;
+				const unsigned char* sp = pSrc + ((ay0 - r->y) >> s)*srcRow + ((ax0 - r->x) >> s)*bytes;
+				unsigned char* dp = pPlane + (ay0 >> s)*canvasRow + (ax0 >> s)*bytes;
+				for(int y = (ay0 >> s); y < (ay1 >> s); y++, sp += srcRow, dp += canvasRow)
+					memcpy(dp, sp, len);
+			}//end for k...
+		}//end for i...
+	}//end for p...
+}//end ComposeBand.
+
@@ -0,0 +1,702 @@
+/** @file
+
+MODULE				: PicPipelineRGB24
+
+TAG						: PPRGB24
+
+FILE NAME			: PicPipelineRGB24.cpp
+
+DESCRIPTION		: A tiled RGB 24 bit image operation pipeline. Crop, rotate, scale,
+								pic-in-pic and concat stages with the semantics of the PicCropper,
+								PicRotate, PicScaler, PicInPic and PicConcat RGB24 implementations
+								are chained and the output is produced tile by tile in a single
+								traversal, pulling only the region of each stage input that a
+								tile needs. The final stage writes RGB24 or fixed point YUV420
+								and the tiles are shared between threads.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "PicPipelineRGB24.h"
+#include "FastFixedPointRGB24toYUV420Converter.h"
+
+/*
+===========================================================================
+	Constants.
+===========================================================================
+*/
+/// Scratch slot of the output sink. The stages use the slots below it.
+#define PPRGB24_SINK_SLOT				(PPRGB24_MAX_STAGES - 1)
+/// PicInPicRGB24Impl border.
+#define PPRGB24_BORDER_WIDTH		5
+
+#define PPRGB24_CLAMP(x, hi) ( ((x) < 0) ? 0 : ( ((x) > (hi)) ? (hi) : (x) ) )
+
+/// Grow a scratch slot of a thread context.
+static unsigned char* PPRGB24_Scratch(PPRGB24_CTX* pCtx, int slot, int len)
+{
+	if(pCtx->scratchLen[slot] < len)
+	{
+		if(pCtx->pScratch[slot] != NULL)
+			delete[] pCtx->pScratch[slot];
+		pCtx->pScratch[slot]		= new unsigned char[len];
+		pCtx->scratchLen[slot]	= len;
+	}//end if scratchLen...
+	return(pCtx->pScratch[slot]);
+}//end PPRGB24_Scratch.
+
+/// Intersect rect a with [x, x+w) x [y, y+h). Returns 0 if empty.
+static int PPRGB24_Intersect(const PPRGB24_RECT& a, int x, int y, int w, int h, PPRGB24_RECT* pOut)
+{
+	int x0 = (a.x > x) ? a.x : x;
+	int y0 = (a.y > y) ? a.y : y;
+	int x1 = ((a.x + a.width) < (x + w)) ? (a.x + a.width) : (x + w);
+	int y1 = ((a.y + a.height) < (y + h)) ? (a.y + a.height) : (y + h);
+	if( (x1 <= x0)||(y1 <= y0) )
+		return(0);
+	pOut->x				= x0;
+	pOut->y				= y0;
+	pOut->width		= x1 - x0;
+	pOut->height	= y1 - y0;
+	return(1);
+}//end PPRGB24_Intersect.
+
+/*
+===========================================================================
+	Stages.
+===========================================================================
+*/
+/**
+ * A stage produces any rect of its output on request by pulling the rect of
+ * its upstream output that it needs. The returned pels are either in the
+ * stage scratch of the thread context or point directly into the upstream.
+ */
+class PicPipelineStageRGB24
+{
+public:
+	PicPipelineStageRGB24(PicPipelineStageRGB24* pUp) { _pUp = pUp; _slot = 0; _width = 0; _height = 0; }
+	virtual ~PicPipelineStageRGB24(void) {}
+
+	/** Produce a rect of the stage output.
+	@param pCtx		: Thread context.
+	@param r			: Rect within the stage output dimensions.
+	@param stride	: Returned row stride in bytes.
+	@return				: Top left pel of the rect.
+	*/
+	virtual const unsigned char* Produce(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r, int* stride) = 0;
+
+	int		GetWidth(void)				{ return(_width); }
+	int		GetHeight(void)				{ return(_height); }
+	void	SetSlot(int slot)			{ _slot = slot; }
+
+protected:
+	PicPipelineStageRGB24*	_pUp;
+	int											_slot;
+	int											_width;
+	int											_height;
+};//end PicPipelineStageRGB24.
+
+/// The source image. Rects are returned in place.
+class PicPipelineSourceRGB24: public PicPipelineStageRGB24
+{
+public:
+	PicPipelineSourceRGB24(int width, int height): PicPipelineStageRGB24(NULL) { _width = width; _height = height; _pImg = NULL; }
+	void SetImage(const void* pImg) { _pImg = (const unsigned char *)pImg; }
+
+	const unsigned char* Produce(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r, int* stride)
+	{
+		*stride = 3*_width;
+		return(_pImg + 3*((r.y * _width) + r.x));
+	}//end Produce.
+
+protected:
+	const unsigned char* _pImg;
+};//end PicPipelineSourceRGB24.
+
+/// Crop is an offset into the upstream and is returned in place.
+class PicPipelineCropRGB24: public PicPipelineStageRGB24
+{
+public:
+	PicPipelineCropRGB24(PicPipelineStageRGB24* pUp, int left, int top, int width, int height): PicPipelineStageRGB24(pUp)
+	{ _left = left; _top = top; _width = width; _height = height; }
+
+	const unsigned char* Produce(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r, int* stride)
+	{
+		PPRGB24_RECT in = { r.x + _left, r.y + _top, r.width, r.height };
+		return(_pUp->Produce(pCtx, in, stride));
+	}//end Produce.
+
+protected:
+	int _left;
+	int _top;
+};//end PicPipelineCropRGB24.
+
+/// Rotations and flips as pel coordinate maps from output to input.
+class PicPipelineRotateRGB24: public PicPipelineStageRGB24
+{
+public:
+	PicPipelineRotateRGB24(PicPipelineStageRGB24* pUp, ROTATE_MODE mode): PicPipelineStageRGB24(pUp)
+	{
+		_mode = mode;
+		_inWidth	= pUp->GetWidth();
+		_inHeight	= pUp->GetHeight();
+		int transpose = (mode == ROTATE_90_DEGREES_CLOCKWISE)||(mode == ROTATE_270_DEGREES_CLOCKWISE)||(mode == ROTATE_FLIP_DIAGONALLY);
+		_width	= transpose ? _inHeight : _inWidth;
+		_height	= transpose ? _inWidth : _inHeight;
+	}//end constructor.
+
+	/// Input pel of output pel (x,y).
+	void Map(int x, int y, int* px, int* py)
+	{
+		switch(_mode)
+		{
+		case ROTATE_90_DEGREES_CLOCKWISE:		*px = _inWidth - 1 - y;	*py = x;									break;
+		case ROTATE_180_DEGREES_CLOCKWISE:	*px = _inWidth - 1 - x;	*py = _inHeight - 1 - y;	break;
+		case ROTATE_270_DEGREES_CLOCKWISE:	*px = y;								*py = _inHeight - 1 - x;	break;
+		case ROTATE_FLIP_VERTICAL:					*px = x;								*py = _inHeight - 1 - y;	break;
+		case ROTATE_FLIP_HORIZONTAL:				*px = _inWidth - 1 - x;	*py = y;									break;
+		case ROTATE_FLIP_DIAGONALLY:				*px = _inWidth - 1 - y;	*py = _inHeight - 1 - x;	break;
+		default:														*px = x;								*py = y;									break;
+		}//end switch _mode...
+	}//end Map.
+
+	const unsigned char* Produce(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r, int* stride)
+	{
+		if(_mode == ROTATE_NONE)
+			return(_pUp->Produce(pCtx, r, stride));
+
+		/// Each input coord depends on one output coord so the corners bound the input rect.
+		int ax, ay, bx, by;
+		Map(r.x, r.y, &ax, &ay);
+		Map(r.x + r.width - 1, r.y + r.height - 1, &bx, &by);
+		PPRGB24_RECT in;
+		in.x			= (ax < bx) ? ax : bx;
+		in.y			= (ay < by) ? ay : by;
+		in.width	= abs(bx - ax) + 1;
+		in.height	= abs(by - ay) + 1;
+		int inStride;
+		const unsigned char* pIn = _pUp->Produce(pCtx, in, &inStride);
+
+		unsigned char* pOut = PPRGB24_Scratch(pCtx, _slot, 3*r.width*r.height);
+		unsigned char* d = pOut;
+		for(int y = 0; y < r.height; y++)
+			for(int x = 0; x < r.width; x++, d += 3)
+			{
+				int px, py;
+				Map(r.x + x, r.y + y, &px, &py);
+				const unsigned char* s = pIn + (py - in.y)*inStride + 3*(px - in.x);
+				d[0] = s[0];
+				d[1] = s[1];
+				d[2] = s[2];
+			}//end for y & x...
+
+		*stride = 3*r.width;
+		return(pOut);
+	}//end Produce.
+
+protected:
+	ROTATE_MODE	_mode;
+	int					_inWidth;
+	int					_inHeight;
+};//end PicPipelineRotateRGB24.
+
+/// Nearest position 3x3 weighted filter scaling.
+class PicPipelineScaleRGB24: public PicPipelineStageRGB24
+{
+public:
+	PicPipelineScaleRGB24(PicPipelineStageRGB24* pUp, int widthOut, int heightOut): PicPipelineStageRGB24(pUp)
+	{
+		_width		= widthOut;
+		_height		= heightOut;
+		_inWidth	= pUp->GetWidth();
+		_inHeight	= pUp->GetHeight();
+		_pPosX		= new int[widthOut + heightOut];
+		_pPosY		= _pPosX + widthOut;
+		double scalex = ((double)_inWidth)/((double)_width);
+		double scaley = ((double)_inHeight)/((double)_height);
+		for(int x = 0; x < _width; x++)
+			_pPosX[x] = PPRGB24_CLAMP((int)((scalex * (double)x) + 0.5), _inWidth - 1);
+		for(int y = 0; y < _height; y++)
+			_pPosY[y] = PPRGB24_CLAMP((int)((scaley * (double)y) + 0.5), _inHeight - 1);
+	}//end constructor.
+	virtual ~PicPipelineScaleRGB24(void) { delete[] _pPosX; }
+
+	const unsigned char* Produce(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r, int* stride)
+	{
+		/// The filter taps of the rect.
+		PPRGB24_RECT in;
+		in.x			= PPRGB24_CLAMP(_pPosX[r.x] - 1, _inWidth - 1);
+		in.y			= PPRGB24_CLAMP(_pPosY[r.y] - 1, _inHeight - 1);
+		in.width	= PPRGB24_CLAMP(_pPosX[r.x + r.width - 1] + 1, _inWidth - 1) - in.x + 1;
+		in.height	= PPRGB24_CLAMP(_pPosY[r.y + r.height - 1] + 1, _inHeight - 1) - in.y + 1;
+		int inStride;
+		const unsigned char* pIn = _pUp->Produce(pCtx, in, &inStride);
+
+		unsigned char* pOut = PPRGB24_Scratch(pCtx, _slot, 3*r.width*r.height);
+		unsigned char* d = pOut;
+		for(int y = 0; y < r.height; y++)
+		{
+			int posy = _pPosY[r.y + y];
+			const unsigned char* row[3];
+			for(int i = -1; i <= 1; i++)
+				row[i + 1] = pIn + (PPRGB24_CLAMP(posy + i, _inHeight - 1) - in.y)*inStride;
+
+			for(int x = 0; x < r.width; x++, d += 3)
+			{
+				int posx = _pPosX[r.x + x];
+				int col[3];
+				for(int j = -1; j <= 1; j++)
+					col[j + 1] = 3*(PPRGB24_CLAMP(posx + j, _inWidth - 1) - in.x);
+
+				/// Apply a weighted 3x3 FIR filter with a centre weight of 8.
+				for(int c = 0; c < 3; c++)
+				{
+					int acc = 7 * (int)row[1][col[1] + c];
+					for(int i = 0; i < 3; i++)
+						acc += (int)row[i][col[0] + c] + (int)row[i][col[1] + c] + (int)row[i][col[2] + c];
+					d[c] = (unsigned char)((acc + 8) >> 4);
+				}//end for c...
+			}//end for x...
+		}//end for y...
+
+		*stride = 3*r.width;
+		return(pOut);
+	}//end Produce.
+
+protected:
+	int		_inWidth;
+	int		_inHeight;
+	int*	_pPosX;
+	int*	_pPosY;
+};//end PicPipelineScaleRGB24.
+
+/** Composition of the chain image and a static image into a new output.
+This is pic-in-pic when the static image is on top of the chain image of the
+same dimensions and concat when the chain image is placed on top of the
+static image in a larger output. */
+class PicPipelineComposeRGB24: public PicPipelineStageRGB24
+{
+public:
+	PicPipelineComposeRGB24(PicPipelineStageRGB24* pUp, int width, int height, int upX, int upY, int upOnTop, 
+													const void* pImg, int imgWidth, int imgHeight, int imgX, int imgY, int border): PicPipelineStageRGB24(pUp)
+	{
+		_width			= width;
+		_height			= height;
+		_upX				= upX;
+		_upY				= upY;
+		_upOnTop		= upOnTop;
+		_pImg				= (const unsigned char *)pImg;
+		_imgWidth		= imgWidth;
+		_imgX				= imgX;
+		_imgY				= imgY;
+		_border			= border;
+		/// Clip to the output as PicInPicBase::SetActualSubDimensions().
+		_upWriteWidth		= ((upX + pUp->GetWidth()) > width) ? (width - upX) : pUp->GetWidth();
+		_upWriteHeight	= ((upY + pUp->GetHeight()) > height) ? (height - upY) : pUp->GetHeight();
+		_imgWriteWidth	= ((imgX + imgWidth) > width) ? (width - imgX) : imgWidth;
+		_imgWriteHeight	= ((imgY + imgHeight) > height) ? (height - imgY) : imgHeight;
+	}//end constructor.
+
+	const unsigned char* Produce(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r, int* stride)
+	{
+		unsigned char* pOut = PPRGB24_Scratch(pCtx, _slot, 3*r.width*r.height);
+		memset(pOut, 0, 3*r.width*r.height);
+		if(_upOnTop)
+		{
+			DrawImg(r, pOut);
+			DrawUp(pCtx, r, pOut);
+		}//end if _upOnTop...
+		else
+		{
+			DrawUp(pCtx, r, pOut);
+			DrawImg(r, pOut);
+		}//end else...
+		*stride = 3*r.width;
+		return(pOut);
+	}//end Produce.
+
+protected:
+	void DrawUp(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r, unsigned char* pOut)
+	{
+		PPRGB24_RECT a;
+		if(!PPRGB24_Intersect(r, _upX, _upY, _upWriteWidth, _upWriteHeight, &a))
+			return;
+		PPRGB24_RECT in = { a.x - _upX, a.y - _upY, a.width, a.height };
+		int inStride;
+		const unsigned char* pIn = _pUp->Produce(pCtx, in, &inStride);
+		unsigned char* d = pOut + 3*((a.y - r.y)*r.width + (a.x - r.x));
+		for(int y = 0; y < a.height; y++, d += 3*r.width, pIn += inStride)
+			memcpy(d, pIn, 3*a.width);
+	}//end DrawUp.
+
+	void DrawImg(const PPRGB24_RECT& r, unsigned char* pOut)
+	{
+		PPRGB24_RECT a;
+		if(!PPRGB24_Intersect(r, _imgX, _imgY, _imgWriteWidth, _imgWriteHeight, &a))
+			return;
+		for(int y = a.y; y < (a.y + a.height); y++)
+		{
+			int sy = y - _imgY;
+			unsigned char* d = pOut + 3*((y - r.y)*r.width + (a.x - r.x));
+			const unsigned char* s = _pImg + 3*(sy*_imgWidth + (a.x - _imgX));
+			memcpy(d, s, 3*a.width);
+			if(!_border)
+				continue;
+			/// Green border of PicInPicRGB24Impl::DoInsertWithBorder().
+			int rowBorder = (sy < PPRGB24_BORDER_WIDTH)||(sy >= (_imgWriteHeight - PPRGB24_BORDER_WIDTH));
+			for(int x = a.x; x < (a.x + a.width); x++, d += 3)
+			{
+				int sx = x - _imgX;
+				if( rowBorder||(sx < PPRGB24_BORDER_WIDTH)||(sx >= (_imgWriteWidth - PPRGB24_BORDER_WIDTH)) )
+				{
+					d[0] = 0;
+					d[1] = 255;
+					d[2] = 0;
+				}//end if border...
+			}//end for x...
+		}//end for y...
+	}//end DrawImg.
+
+protected:
+	int	_upX;
+	int	_upY;
+	int	_upOnTop;
+	int	_upWriteWidth;
+	int	_upWriteHeight;
+	const unsigned char* _pImg;
+	int	_imgWidth;
+	int	_imgX;
+	int	_imgY;
+	int	_imgWriteWidth;
+	int	_imgWriteHeight;
+	int	_border;
+};//end PicPipelineComposeRGB24.
+
+/*
+===========================================================================
+	Construction and Destruction.
+===========================================================================
+*/
+PicPipelineRGB24::PicPipelineRGB24(void)
+{
+	for(int i = 0; i < PPRGB24_MAX_THREADS; i++)
+		for(int j = 0; j < PPRGB24_MAX_STAGES; j++)
+		{
+			_ctx[i].pScratch[j]		= NULL;
+			_ctx[i].scratchLen[j]	= 0;
+		}//end for i & j...
+	_tileWidth	= PPRGB24_TILE_WIDTH;
+	_tileHeight	= PPRGB24_TILE_HEIGHT;
+	_threads		= 1;
+	_chrOff			= 0;
+	_stages			= 0;
+	ResetMembers();
+}//end constructor.
+
+PicPipelineRGB24::~PicPipelineRGB24(void)
+{
+	Destroy();
+	for(int i = 0; i < PPRGB24_MAX_THREADS; i++)
+		for(int j = 0; j < PPRGB24_MAX_STAGES; j++)
+		{
+			if(_ctx[i].pScratch[j] != NULL)
+				delete[] _ctx[i].pScratch[j];
+			_ctx[i].pScratch[j]		= NULL;
+			_ctx[i].scratchLen[j]	= 0;
+		}//end for i & j...
+}//end destructor.
+
+void PicPipelineRGB24::ResetMembers(void)
+{
+	for(int i = 0; i < PPRGB24_MAX_STAGES; i++)
+		_pStage[i] = NULL;
+	_stages		= 0;
+	_pDst			= NULL;
+	_pY				= NULL;
+	_pU				= NULL;
+	_pV				= NULL;
+	_tilesX		= 0;
+	_tiles		= 0;
+	_nextTile	= 0;
+}//end ResetMembers.
+
+/*
+===========================================================================
+	Public Methods.
+===========================================================================
+*/
+int PicPipelineRGB24::Create(int srcWidth, int srcHeight)
+{
+	Destroy();
+	if( (srcWidth < 1)||(srcHeight < 1) )
+		return(0);
+	return(AddStage(new PicPipelineSourceRGB24(srcWidth, srcHeight)));
+}//end Create.
+
+void PicPipelineRGB24::Destroy(void)
+{
+	for(int i = 0; i < _stages; i++)
+	{
+		if(_pStage[i] != NULL)
+			delete _pStage[i];
+	}//end for i...
+	ResetMembers();
+}//end Destroy.
+
+int PicPipelineRGB24::AddStage(PicPipelineStageRGB24* pStage)
+{
+	if(pStage == NULL)
+		return(0);
+	if(_stages >= PPRGB24_SINK_SLOT)
+	{
+		delete pStage;
+		return(0);
+	}//end if _stages...
+	pStage->SetSlot(_stages);
+	_pStage[_stages++] = pStage;
+	return(1);
+}//end AddStage.
+
+int PicPipelineRGB24::GetWidth(void)
+{
+	if(_stages == 0)
+		return(0);
+	return(_pStage[_stages - 1]->GetWidth());
+}//end GetWidth.
+
+int PicPipelineRGB24::GetHeight(void)
+{
+	if(_stages == 0)
+		return(0);
+	return(_pStage[_stages - 1]->GetHeight());
+}//end GetHeight.
+
+int PicPipelineRGB24::AddCrop(int left, int top, int width, int height)
+{
+	if( (_stages == 0)||(left < 0)||(top < 0)||(width < 1)||(height < 1)||((left + width) > GetWidth())||((top + height) > GetHeight()) )
+		return(0);
+	return(AddStage(new PicPipelineCropRGB24(_pStage[_stages - 1], left, top, width, height)));
+}//end AddCrop.
+
+int PicPipelineRGB24::AddRotate(ROTATE_MODE mode)
+{
+	if( (_stages == 0)||(mode < ROTATE_NONE)||(mode > ROTATE_FLIP_DIAGONALLY) )
+		return(0);
+	return(AddStage(new PicPipelineRotateRGB24(_pStage[_stages - 1], mode)));
+}//end AddRotate.
+
+int PicPipelineRGB24::AddScale(int widthOut, int heightOut)
+{
+	if( (_stages == 0)||(widthOut < 1)||(heightOut < 1) )
+		return(0);
+	return(AddStage(new PicPipelineScaleRGB24(_pStage[_stages - 1], widthOut, heightOut)));
+}//end AddScale.
+
+int PicPipelineRGB24::AddPicInPic(const void* pSubImg, int subWidth, int subHeight, int xPos, int yPos, int borderWidth)
+{
+	if( (_stages == 0)||(pSubImg == NULL)||(xPos < 0)||(yPos < 0)||(xPos >= GetWidth())||(yPos >= GetHeight()) )
+		return(0);
+	return(AddStage(new PicPipelineComposeRGB24(_pStage[_stages - 1], GetWidth(), GetHeight(), 0, 0, 0,
+																							pSubImg, subWidth, subHeight, xPos, yPos, borderWidth != 0)));
+}//end AddPicInPic.
+
+int PicPipelineRGB24::AddConcat(const void* pImg2nd, int width2nd, int height2nd, int width, int height, int orient)
+{
+	if( (_stages == 0)||(pImg2nd == NULL)||(width < 1)||(height < 1) )
+		return(0);
+
+	/// Positions of PicConcatRGB24Impl::Concat().
+	int width1st	= GetWidth();
+	int height1st	= GetHeight();
+	int posX1 = 0, posY1 = 0, posX2 = 0, posY2 = 0;
+	switch(orient)
+	{
+		case 0 :	///< TOP
+			posY2 = height - height2nd;
+			if(posY2 < 0) posY2 = 0;
+			break;
+		case 1 :	///< BOTTOM
+			posY1 = height - height1st;
+			if(posY1 < 0) posY1 = 0;
+			break;
+		case 2 :	///< LEFT
+			posX1 = width - width1st;
+			if(posX1 < 0) posX1 = 0;
+			break;
+		case 3 :	///< RIGHT
+			posX2 = width - width2nd;
+			if(posX2 < 0) posX2 = 0;
+			break;
+	}//end switch orient...
+
+	return(AddStage(new PicPipelineComposeRGB24(_pStage[_stages - 1], width, height, posX1, posY1, 1,
+																							pImg2nd, width2nd, height2nd, posX2, posY2, 0)));
+}//end AddConcat.
+
+int PicPipelineRGB24::SetTileSize(int width, int height)
+{
+	/// Even dimensions keep the YUV420 tiles on chr boundaries.
+	if( (width < 2)||(height < 2)||(width & 1)||(height & 1) )
+		return(0);
+	_tileWidth	= width;
+	_tileHeight	= height;
+	return(1);
+}//end SetTileSize.
+
+int PicPipelineRGB24::SetThreads(int threads)
+{
+	if( (threads < 1)||(threads > PPRGB24_MAX_THREADS) )
+		return(0);
+	_threads = threads;
+	return(1);
+}//end SetThreads.
+
+int PicPipelineRGB24::Run(const void* pSrc, void* pDst)
+{
+	if(pDst == NULL)
+		return(0);
+	return(Execute(pSrc, pDst, NULL, NULL, NULL));
+}//end Run.
+
+int PicPipelineRGB24::RunYUV420(const void* pSrc, void* pY, void* pU, void* pV)
+{
+	if( (pY == NULL)||(pU == NULL)||(pV == NULL)||(GetWidth() & 1)||(GetHeight() & 1) )
+		return(0);
+	return(Execute(pSrc, NULL, pY, pU, pV));
+}//end RunYUV420.
+
+/*
+===========================================================================
+	Private Methods.
+===========================================================================
+*/
+int PicPipelineRGB24::Execute(const void* pSrc, void* pDst, void* pY, void* pU, void* pV)
+{
+	if( (_stages == 0)||(pSrc == NULL) )
+		return(0);
+
+	((PicPipelineSourceRGB24 *)_pStage[0])->SetImage(pSrc);
+	_pDst	= pDst;
+	_pY		= pY;
+	_pU		= pU;
+	_pV		= pV;
+	_tilesX		= (GetWidth() + _tileWidth - 1)/_tileWidth;
+	_tiles		= _tilesX * ((GetHeight() + _tileHeight - 1)/_tileHeight);
+	_nextTile	= 0;
+
+	/// The calling thread takes tiles with the workers.
+	int workers = (_threads < _tiles) ? (_threads - 1) : (_tiles - 1);
+	std::thread* pWorker[PPRGB24_MAX_THREADS];
+	int i;
+	for(i = 0; i < workers; i++)
+		pWorker[i] = new std::thread(&PicPipelineRGB24::RunTiles, this, i + 1);
+	RunTiles(0);
+	for(i = 0; i < workers; i++)
+	{
+		pWorker[i]->join();
+		delete pWorker[i];
+	}//end for i...
+
+	return(1);
+}//end Execute.
+
+void PicPipelineRGB24::RunTiles(int ctx)
+{
+	int width		= GetWidth();
+	int height	= GetHeight();
+	for(int t = _nextTile++; t < _tiles; t = _nextTile++)
+	{
+		PPRGB24_RECT r;
+		r.x				= (t % _tilesX) * _tileWidth;
+		r.y				= (t / _tilesX) * _tileHeight;
+		r.width		= ((r.x + _tileWidth) > width) ? (width - r.x) : _tileWidth;
+		r.height	= ((r.y + _tileHeight) > height) ? (height - r.y) : _tileHeight;
+		Tile(&(_ctx[ctx]), r);
+	}//end for t...
+}//end RunTiles.
+
+/// Pull a tile through the chain and write it to the output.
+void PicPipelineRGB24::Tile(PPRGB24_CTX* pCtx, const PPRGB24_RECT& r)
+{
+	int width = GetWidth();
+	int stride;
+	const unsigned char* pTile = _pStage[_stages - 1]->Produce(pCtx, r, &stride);
+
+	if(_pDst != NULL)
+	{
+		unsigned char* d = (unsigned char *)_pDst + 3*(r.y*width + r.x);
+		for(int y = 0; y < r.height; y++, d += 3*width, pTile += stride)
+			memcpy(d, pTile, 3*r.width);
+		return;
+	}//end if _pDst...
+
+	/// YUV420 conversion of the tile by the fixed point converter into contiguous tile planes.
+	int rowLen	= 3*r.width;
+	int lumLen	= r.width*r.height;
+	int chrLen	= lumLen/4;
+	unsigned char* pMem = PPRGB24_Scratch(pCtx, PPRGB24_SINK_SLOT, lumLen*3 + (lumLen + 2*chrLen)*(int)sizeof(yuvType));
+	yuvType* ty = (yuvType *)(pMem + lumLen*3);
+	yuvType* tu = ty + lumLen;
+	yuvType* tv = tu + chrLen;
+	if(stride != rowLen)
+	{
+		for(int y = 0; y < r.height; y++)
+			memcpy(pMem + y*rowLen, pTile + y*stride, rowLen);
+		pTile = pMem;
+	}//end if stride...
+	FastFixedPointRGB24toYUV420Converter cvt(r.width, r.height, _chrOff);
+	cvt.Convert((void *)pTile, ty, tu, tv);
+
+	int y;
+	yuvType* d = (yuvType *)_pY + r.y*width + r.x;
+	for(y = 0; y < r.height; y++, d += width)
+		memcpy(d, ty + y*r.width, r.width*sizeof(yuvType));
+	int chrWidth = width/2;
+	int tileChrWidth = r.width/2;
+	yuvType* du = (yuvType *)_pU + (r.y/2)*chrWidth + r.x/2;
+	yuvType* dv = (yuvType *)_pV + (r.y/2)*chrWidth + r.x/2;
+	for(y = 0; y < r.height/2; y++, du += chrWidth, dv += chrWidth)
+	{
+		memcpy(du, tu + y*tileChrWidth, tileChrWidth*sizeof(yuvType));
+		memcpy(dv, tv + y*tileChrWidth, tileChrWidth*sizeof(yuvType));
+	}//end for y...
+}//end Tile.
+
@@ -0,0 +1,425 @@
+/** @file
+
+MODULE				: PicRotateBase
+
+TAG						: PRB
+
+FILE NAME			: PicRotateBase.cpp
+
+DESCRIPTION		: Plane rotation shared by the PicRotateBase derived
+								classes. The 90, 270 and diagonal transposes are
+								blocked into cache sized tiles of SSE2 register
+								transposed blocks, with run time selected SSSE3 
+								shuffles for 3 byte pels, and the mirrors reverse 
+								whole rows.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "PicRotateBase.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define PRB_HAVE_SSE2
+#include <emmintrin.h>
+
+/// The 24 bit pel block shuffles need SSSE3 and are selected at run time.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PRB_HAVE_SSSE3
+#define PRB_SSSE3_TARGET	__attribute__((target("ssse3")))
+#include <tmmintrin.h>
+static int PRB_CpuHasSsse3(void) { __builtin_cpu_init(); return(__builtin_cpu_supports("ssse3") ? 1 : 0); }
+#elif defined(_MSC_VER)
+#define PRB_HAVE_SSSE3
+#define PRB_SSSE3_TARGET
+#include <intrin.h>
+#include <tmmintrin.h>
+static int PRB_CpuHasSsse3(void)
+{
+	int info[4];
+	__cpuid(info, 1);
+	return( (info[2] & (1 << 9)) ? 1 : 0 );
+}//end PRB_CpuHasSsse3.
+#endif
+
+#endif // SSE2
+
+/*
+===========================================================================
+	Constants and pel types.
+===========================================================================
+*/
+/// Pels per side of the cache tiles of a transpose.
+#define PRB_TILE	32
+
+/// Packed 24 bit pel.
+typedef struct _PRB_PEL24
+{
+	unsigned char b[3];
+} PRB_PEL24;
+
+/*
+===========================================================================
+	Register block transposes.
+===========================================================================
+*/
+#ifdef PRB_HAVE_SSE2
+/// Transpose the B x B block of rows ppRow[] into the rows ppOut[] starting at col.
+/// Blocks that depend on a run time cpu feature are only used when Enabled().
+template<typename P> struct PRB_Block
+{
+	enum { B = 0 };
+	static int	Enabled(void) { return(0); }
+	static void Transpose(const P** ppRow, P** ppOut, int col) {}
+};
+
+template<> struct PRB_Block<unsigned char>
+{
+	enum { B = 8 };
+	static int	Enabled(void) { return(1); }
+	static void Transpose(const unsigned char** ppRow, unsigned char** ppOut, int col)
+	{
+		__m128i a0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ppRow[0]), _mm_loadl_epi64((const __m128i *)ppRow[1]));
+		__m128i a1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ppRow[2]), _mm_loadl_epi64((const __m128i *)ppRow[3]));
+		__m128i a2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ppRow[4]), _mm_loadl_epi64((const __m128i *)ppRow[5]));
+		__m128i a3 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ppRow[6]), _mm_loadl_epi64((const __m128i *)ppRow[7]));
+		__m128i b0 = _mm_unpacklo_epi16(a0, a1);
+		__m128i b1 = _mm_unpackhi_epi16(a0, a1);
+		__m128i b2 = _mm_unpacklo_epi16(a2, a3);
+		__m128i b3 = _mm_unpackhi_epi16(a2, a3);
+		__m128i c[4];
+		c[0] = _mm_unpacklo_epi32(b0, b2);
+		c[1] = _mm_unpackhi_epi32(b0, b2);
+		c[2] = _mm_unpacklo_epi32(b1, b3);
+		c[3] = _mm_unpackhi_epi32(b1, b3);
+		for(int i = 0; i < 4; i++)
+		{
+			_mm_storel_epi64((__m128i *)(ppOut[2*i] + col), c[i]);
+			_mm_storel_epi64((__m128i *)(ppOut[2*i + 1] + col), _mm_srli_si128(c[i], 8));
+		}//end for i...
+	}//end Transpose.
+};
+
+template<> struct PRB_Block<unsigned short>
+{
+	enum { B = 8 };
+	static int	Enabled(void) { return(1); }
+	static void Transpose(const unsigned short** ppRow, unsigned short** ppOut, int col)
+	{
+		__m128i a[8], b[8];
+		int i;
+		for(i = 0; i < 4; i++)
+		{
+			__m128i r0 = _mm_loadu_si128((const __m128i *)ppRow[2*i]);
+			__m128i r1 = _mm_loadu_si128((const __m128i *)ppRow[2*i + 1]);
+			a[2*i]			= _mm_unpacklo_epi16(r0, r1);
+			a[2*i + 1]	= _mm_unpackhi_epi16(r0, r1);
+		}//end for i...
+		for(i = 0; i < 2; i++)
+		{
+			b[4*i]			= _mm_unpacklo_epi32(a[4*i], a[4*i + 2]);
+			b[4*i + 1]	= _mm_unpackhi_epi32(a[4*i], a[4*i + 2]);
+			b[4*i + 2]	= _mm_unpacklo_epi32(a[4*i + 1], a[4*i + 3]);
+			b[4*i + 3]	= _mm_unpackhi_epi32(a[4*i + 1], a[4*i + 3]);
+		}//end for i...
+		for(i = 0; i < 4; i++)
+		{
+			_mm_storeu_si128((__m128i *)(ppOut[2*i] + col), _mm_unpacklo_epi64(b[i], b[i + 4]));
+			_mm_storeu_si128((__m128i *)(ppOut[2*i + 1] + col), _mm_unpackhi_epi64(b[i], b[i + 4]));
+		}//end for i...
+	}//end Transpose.
+};
+
+template<> struct PRB_Block<unsigned int>
+{
+	enum { B = 4 };
+	static int	Enabled(void) { return(1); }
+	static void Transpose(const unsigned int** ppRow, unsigned int** ppOut, int col)
+	{
+		__m128i r0 = _mm_loadu_si128((const __m128i *)ppRow[0]);
+		__m128i r1 = _mm_loadu_si128((const __m128i *)ppRow[1]);
+		__m128i r2 = _mm_loadu_si128((const __m128i *)ppRow[2]);
+		__m128i r3 = _mm_loadu_si128((const __m128i *)ppRow[3]);
+		__m128i a0 = _mm_unpacklo_epi32(r0, r1);
+		__m128i a1 = _mm_unpackhi_epi32(r0, r1);
+		__m128i a2 = _mm_unpacklo_epi32(r2, r3);
+		__m128i a3 = _mm_unpackhi_epi32(r2, r3);
+		_mm_storeu_si128((__m128i *)(ppOut[0] + col), _mm_unpacklo_epi64(a0, a2));
+		_mm_storeu_si128((__m128i *)(ppOut[1] + col), _mm_unpackhi_epi64(a0, a2));
+		_mm_storeu_si128((__m128i *)(ppOut[2] + col), _mm_unpacklo_epi64(a1, a3));
+		_mm_storeu_si128((__m128i *)(ppOut[3] + col), _mm_unpackhi_epi64(a1, a3));
+	}//end Transpose.
+};
+
+/// Transpose the whole B x B register blocks of the tile rows [by..yb) and cols [bx..xb).
+template<typename P> static void PRB_TransposeBlocks(const P* pIn, P* pOut, int width, int height, int by, int yb, int bx, int xb, int flipRows, int flipCols)
+{
+	const int B = PRB_Block<P>::B;
+	const P*	pRow[8];
+	P*				pOutRow[8];
+	for(int y0 = by; y0 < yb; y0 += B)
+	{
+		int k;
+		int col = flipCols ? (height - y0 - B) : y0;
+		for(int x0 = bx; x0 < xb; x0 += B)
+		{
+			for(k = 0; k < B; k++)
+			{
+				pRow[k]		= pIn + (flipCols ? (y0 + B - 1 - k) : (y0 + k))*width + x0;
+				pOutRow[k]	= pOut + (flipRows ? (width - 1 - x0 - k) : (x0 + k))*height;
+			}//end for k...
+			PRB_Block<P>::Transpose(pRow, pOutRow, col);
+		}//end for x0...
+	}//end for y0...
+}//end PRB_TransposeBlocks.
+
+#ifdef PRB_HAVE_SSSE3
+/// The 4 pels of 3 bytes in each row are spread to 32 bit lanes with a byte shuffle, 
+/// transposed as 4 x 4 ints and packed back to 3 bytes. Exactly 12 bytes of each row
+/// are loaded and stored.
+PRB_SSSE3_TARGET
+static inline void PRB_Transpose24Ssse3(const PRB_PEL24** ppRow, PRB_PEL24** ppOut, int col)
+{
+	const __m128i spread	= _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+	const __m128i pack		= _mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1);
+	__m128i r[4];
+	int i;
+	for(i = 0; i < 4; i++)
+	{
+		const unsigned char* p = (const unsigned char *)ppRow[i];
+		int tail;
+		memcpy(&tail, p + 8, 4);
+		r[i] = _mm_shuffle_epi8(_mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p), _mm_cvtsi32_si128(tail)), spread);
+	}//end for i...
+	__m128i a0 = _mm_unpacklo_epi32(r[0], r[1]);
+	__m128i a1 = _mm_unpackhi_epi32(r[0], r[1]);
+	__m128i a2 = _mm_unpacklo_epi32(r[2], r[3]);
+	__m128i a3 = _mm_unpackhi_epi32(r[2], r[3]);
+	r[0] = _mm_unpacklo_epi64(a0, a2);
+	r[1] = _mm_unpackhi_epi64(a0, a2);
+	r[2] = _mm_unpacklo_epi64(a1, a3);
+	r[3] = _mm_unpackhi_epi64(a1, a3);
+	for(i = 0; i < 4; i++)
+	{
+		unsigned char* p	= (unsigned char *)(ppOut[i] + col);
+		__m128i v					= _mm_shuffle_epi8(r[i], pack);
+		int tail					= _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+		_mm_storel_epi64((__m128i *)p, v);
+		memcpy(p + 8, &tail, 4);
+	}//end for i...
+}//end PRB_Transpose24Ssse3.
+
+template<> struct PRB_Block<PRB_PEL24>
+{
+	enum { B = 4 };
+	static int	Enabled(void) { static const int has = PRB_CpuHasSsse3(); return(has); }
+};
+
+/// The block loop of the 3 byte pels is compiled for SSSE3 so that the shuffles are inlined.
+PRB_SSSE3_TARGET
+static void PRB_TransposeBlocks(const PRB_PEL24* pIn, PRB_PEL24* pOut, int width, int height, int by, int yb, int bx, int xb, int flipRows, int flipCols)
+{
+	const PRB_PEL24*	pRow[4];
+	PRB_PEL24*				pOutRow[4];
+	for(int y0 = by; y0 < yb; y0 += 4)
+	{
+		int k;
+		int col = flipCols ? (height - y0 - 4) : y0;
+		for(int x0 = bx; x0 < xb; x0 += 4)
+		{
+			for(k = 0; k < 4; k++)
+			{
+				pRow[k]		= pIn + (flipCols ? (y0 + 3 - k) : (y0 + k))*width + x0;
+				pOutRow[k]	= pOut + (flipRows ? (width - 1 - x0 - k) : (x0 + k))*height;
+			}//end for k...
+			PRB_Transpose24Ssse3(pRow, pOutRow, col);
+		}//end for x0...
+	}//end for y0...
+}//end PRB_TransposeBlocks.
+#endif // SSSE3
+#endif
+
+/*
+===========================================================================
+	Plane kernels.
+===========================================================================
+*/
+/** Transpose with optional flips in tiles.
+The input pel (x,y) is written to output row (flipRows ? W-1-x : x) and col
+(flipCols ? H-1-y : y) of an output plane of width H. For flipped cols the
+input rows of a block are taken bottom up so that the transposed block rows
+are already in output order.
+*/
+template<typename P> static void PRB_Transpose(const P* pIn, P* pOut, int width, int height, int flipRows, int flipCols)
+{
+	for(int by = 0; by < height; by += PRB_TILE)
+	{
+		int ye = ((by + PRB_TILE) < height) ? (by + PRB_TILE) : height;
+		for(int bx = 0; bx < width; bx += PRB_TILE)
+		{
+			int xe = ((bx + PRB_TILE) < width) ? (bx + PRB_TILE) : width;
+			int yb = by;
+			int xb = bx;
+
+#ifdef PRB_HAVE_SSE2
+			const int B = PRB_Block<P>::Enabled() ? (int)PRB_Block<P>::B : 0;
+			if(B)
+			{
+				/// Whole register blocks of the tile.
+				yb = by + ((ye - by)/B)*B;
+				xb = bx + ((xe - bx)/B)*B;
+				PRB_TransposeBlocks(pIn, pOut, width, height, by, yb, bx, xb, flipRows, flipCols);
+			}//end if B...
+#endif
+
+			/// Pels outside the register blocks.
+			for(int y = by; y < ye; y++)
+			{
+				const P* s = pIn + y*width;
+				int col = flipCols ? (height - 1 - y) : y;
+				for(int x = (y < yb) ? xb : bx; x < xe; x++)
+					pOut[(flipRows ? (width - 1 - x) : x)*height + col] = s[x];
+			}//end for y...
+		}//end for bx...
+	}//end for by...
+}//end PRB_Transpose.
+
+/// Reverse the pel order of a row.
+template<typename P> static void PRB_Reverse(const P* pIn, P* pOut, int width)
+{
+	int x = 0;
+
+#ifdef PRB_HAVE_SSE2
+	/// 16 byte vectors from the row start to the end of the output row.
+	const int N = (int)(16/sizeof(P));
+	if(sizeof(P) != 3)
+	{
+		for(; (x + N) <= width; x += N)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i *)(pIn + x));
+			if(sizeof(P) == 1)
+				v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+			if(sizeof(P) <= 2)
+			{
+				v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3));
+				v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0,1,2,3));
+				v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2));
+			}//end if sizeof...
+			else
+				v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0,1,2,3));
+			_mm_storeu_si128((__m128i *)(pOut + width - x - N), v);
+		}//end for x...
+	}//end if sizeof...
+#endif
+
+	for(; x < width; x++)
+		pOut[width - 1 - x] = pIn[x];
+}//end PRB_Reverse.
+
+template<typename P> static bool PRB_Rotate(const P* pIn, P* pOut, int width, int height, ROTATE_MODE eMode)
+{
+	int y;
+	switch(eMode)
+	{
+	case ROTATE_NONE:
+		memcpy(pOut, pIn, width * height * sizeof(P));
+		return true;
+	case ROTATE_90_DEGREES_CLOCKWISE:
+		PRB_Transpose<P>(pIn, pOut, width, height, 1, 0);
+		return true;
+	case ROTATE_270_DEGREES_CLOCKWISE:
+		PRB_Transpose<P>(pIn, pOut, width, height, 0, 1);
+		return true;
+	case ROTATE_FLIP_DIAGONALLY:
+		PRB_Transpose<P>(pIn, pOut, width, height, 1, 1);
+		return true;
+	case ROTATE_180_DEGREES_CLOCKWISE:
+		for(y = 0; y < height; y++)
+			PRB_Reverse<P>(pIn + y*width, pOut + (height - 1 - y)*width, width);
+		return true;
+	case ROTATE_FLIP_HORIZONTAL:
+		for(y = 0; y < height; y++)
+			PRB_Reverse<P>(pIn + y*width, pOut + y*width, width);
+		return true;
+	case ROTATE_FLIP_VERTICAL:
+		for(y = 0; y < height; y++)
+			memcpy(pOut + (height - 1 - y)*width, pIn + y*width, width * sizeof(P));
+		return true;
+	default:
+		// Unimplemented
+		return false;
+	}//end switch eMode...
+}//end PRB_Rotate.
+
+/*
+===========================================================================
+	Public Methods.
+===========================================================================
+*/
+/** Rotate a plane.
+The input and output planes must not overlap. The output is of width nHeight 
+and height nWidth for the 90, 270 and diagonal modes.
+@param pInImg		: Input plane.
+@param pOutImg	: Output plane.
+@param nWidth		: Input width in pels.
+@param nHeight	: Input height in pels.
+@param pelBytes	: Bytes per pel = {1,2,3,4}.
+@param eMode		: Rotation mode.
+@return					: false for an unsupported mode or pel size.
+*/
+bool PicRotateBase::RotatePlane(const void* pInImg, void* pOutImg, int nWidth, int nHeight, int pelBytes, ROTATE_MODE eMode)
+{
+	if( (pInImg == NULL)||(pOutImg == NULL) )
+		return false;
+
+	switch(pelBytes)
+	{
+	case 1:
+		return PRB_Rotate<unsigned char>((const unsigned char *)pInImg, (unsigned char *)pOutImg, nWidth, nHeight, eMode);
+	case 2:
+		return PRB_Rotate<unsigned short>((const unsigned short *)pInImg, (unsigned short *)pOutImg, nWidth, nHeight, eMode);
+	case 3:
+		return PRB_Rotate<PRB_PEL24>((const PRB_PEL24 *)pInImg, (PRB_PEL24 *)pOutImg, nWidth, nHeight, eMode);
+	case 4:
+		return PRB_Rotate<unsigned int>((const unsigned int *)pInImg, (unsigned int *)pOutImg, nWidth, nHeight, eMode);
+	}//end switch pelBytes...
+
+	return false;
+}//end RotatePlane.
+
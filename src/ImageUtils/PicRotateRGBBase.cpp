@@ -52,120 +52,5 @@ bool PicRotateRGBBase::Rotate( void* pInImg, void* pOutImg )
 {
 	if (!pInImg || !pOutImg) return false;
 
-	int nBytesPerPixel = BytesPerPixel();
-	switch (m_eMode)
-	{
-	case ROTATE_NONE:
-		{
-			memcpy(pOutImg, pInImg, m_nWidth * m_nHeight * nBytesPerPixel);
-			return true;
-		}
-	case ROTATE_90_DEGREES_CLOCKWISE:
-		{
-			BYTE* pSrc = (BYTE*)pInImg;
-			BYTE* pDest = NULL;
-			BYTE* pSrcCol = NULL;
-			for (int i = 0; i < m_nWidth; ++i, pSrc += nBytesPerPixel)
-			{
-				int nNewRow = (m_nWidth - i);//Index Base 1
-				int nNewIndex = ((nNewRow - 1) * m_nHeight);// Base 1
-				pSrcCol = pSrc;
-				pDest = (BYTE*)pOutImg + (nNewIndex*nBytesPerPixel);
-				for (int j = 0; j < m_nHeight; ++j, pSrcCol += (nBytesPerPixel*m_nWidth), pDest += nBytesPerPixel)
-				{
-					memcpy(pDest, pSrcCol, nBytesPerPixel);
-				}
-				// Copy pixels in same column to their destinations
-			}
-			return true;
-		}
-	case ROTATE_180_DEGREES_CLOCKWISE:
-		{
-			BYTE* pSrc = (BYTE*)pInImg;
-			int nTotalPixels = m_nWidth * m_nHeight; 
-			int nLastIndex = (nTotalPixels - 1) * nBytesPerPixel;
-			BYTE* pDest = (BYTE*)pOutImg + nLastIndex;
-			for (int i = 0; i < nTotalPixels; ++i, pSrc += nBytesPerPixel, pDest -= nBytesPerPixel)
-			{
-				memcpy(pDest, pSrc, sizeof(BYTE) *nBytesPerPixel);
-			}
-			return true;
-		}
-
-	case ROTATE_270_DEGREES_CLOCKWISE:
-		{
-			int iTargetRowLength = m_nHeight * nBytesPerPixel;
-			BYTE* pSrc = (BYTE*)pInImg;
-			BYTE* pDest = (BYTE*)pOutImg + iTargetRowLength - nBytesPerPixel;
-
-			for ( int y = 0; y < m_nHeight; y++ )
-			{
-				BYTE* pDestPixel = pDest;
-				for (int x = 0; x < m_nWidth; ++x, pSrc += nBytesPerPixel, pDestPixel += iTargetRowLength)
-				{
-					memcpy(pDestPixel, pSrc, nBytesPerPixel);
-				}
-				pDest -= nBytesPerPixel;
-			}
-			return true;
-		}
-	case ROTATE_FLIP_VERTICAL:
-		{
-			// Code to flip image
-			int nRowLength = m_nWidth * nBytesPerPixel;
-			BYTE* pSrc = (BYTE*)pInImg;
-			//BYTE* pDest = (BYTE*)pOutImg + ((m_nHeight * nRowLength ) - nRowLength);
-			BYTE* pDest = (BYTE*)pOutImg + ((m_nHeight - 1) * nRowLength);
-			for (int i = 0; i < m_nHeight; ++i, pSrc += nRowLength, pDest -= nRowLength)
-			{
-				memcpy(pDest, pSrc, nRowLength);
-			}
-			return true;
-		}
-	case ROTATE_FLIP_HORIZONTAL:
-		{
-			int iRowLength = m_nWidth * nBytesPerPixel;
-			BYTE* pSrc = (BYTE*)pInImg;
-			BYTE* pDest = (BYTE*)pOutImg + iRowLength - nBytesPerPixel;
-
-            for ( int y = 0; y < m_nHeight; y++ )
-            {
-				BYTE* pDestPixel = pDest;
-                for ( int x = 0; x < m_nWidth; x++, pSrc += nBytesPerPixel, pDestPixel-=nBytesPerPixel )
-                {
-					memcpy(pDestPixel, pSrc, nBytesPerPixel);
-                }
-				pDest += iRowLength;
-            }
-			return true;
-		}
-	case ROTATE_FLIP_DIAGONALLY:
-		{
-			BYTE* pSrc = (BYTE*)pInImg;
-			BYTE* pDest = NULL;
-			BYTE* pSrcCol = NULL;
-			for (int i = 0; i < m_nWidth; ++i, pSrc += nBytesPerPixel)
-			{
-				int nNewRow = (m_nWidth - i);//Index Base 1
-				// Select target row to be one higher and subtract sizeof RGB block to be at last index of row
-				++nNewRow;
-				int nNewIndex = ((nNewRow - 1) * m_nHeight);// Base 1
-				// Adjust index to previous row
-				--nNewIndex;
-				pSrcCol = pSrc;
-				pDest = (BYTE*)pOutImg + (nNewIndex*nBytesPerPixel);
-				for (int j = 0; j < m_nHeight; ++j, pSrcCol += (nBytesPerPixel*m_nWidth), pDest -= nBytesPerPixel)
-				{
-					memcpy(pDest, pSrcCol, nBytesPerPixel);
-				}
-				// Copy pixels in same column to their destinations
-			}
-			return true;
-		}
-	default:
-		{
-			// Unimplemented
-			return false;
-		}
-	}
+	return RotatePlane(pInImg, pOutImg, m_nWidth, m_nHeight, BytesPerPixel(), m_eMode);
 }
@@ -0,0 +1,94 @@
+/** @file
+
+MODULE				: PicRotateYUV420PImpl
+
+TAG						: PRYUV
+
+FILE NAME			: PicRotateYUV420PImpl.cpp
+
+DESCRIPTION		: A YUV420P planar implementation derived from the
+								PicRotateBase() class. Rotate or flip the Y, U and V
+								planes of 8, 16 or 32 bit samples.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "PicRotateYUV420PImpl.h"
+
+/*
+===========================================================================
+	Interface Methods.
+===========================================================================
+*/
+/** Rotate a contiguous YUV420P image.
+No memory size checking is done and is delegated to the calling process.
+@param pInImg		: Input Y, U and V planes.
+@param pOutImg	: Output Y, U and V planes of the rotated dimensions.
+@return					: false for odd dimensions, an unsupported mode or sample size.
+*/
+bool PicRotateYUV420PImpl::Rotate(void* pInImg, void* pOutImg)
+{
+	if( (pInImg == NULL)||(pOutImg == NULL) )
+		return false;
+
+	int lumBytes = m_nWidth * m_nHeight * _sampleBytes;
+	int chrBytes = lumBytes/4;
+	unsigned char* pIn	= (unsigned char *)pInImg;
+	unsigned char* pOut	= (unsigned char *)pOutImg;
+	return Rotate(pIn, pIn + lumBytes, pIn + lumBytes + chrBytes, pOut, pOut + lumBytes, pOut + lumBytes + chrBytes);
+}//end Rotate.
+
+/** Rotate separate Y, U and V planes.
+@return	: false for odd dimensions, an unsupported mode or sample size.
+*/
+bool PicRotateYUV420PImpl::Rotate(void* pInY, void* pInU, void* pInV, void* pOutY, void* pOutU, void* pOutV)
+{
+	if( (m_nWidth < 2)||(m_nHeight < 2)||(m_nWidth & 1)||(m_nHeight & 1) )
+		return false;
+	if( (_sampleBytes != 1)&&(_sampleBytes != 2)&&(_sampleBytes != 4) )
+		return false;
+
+	if(!RotatePlane(pInY, pOutY, m_nWidth, m_nHeight, _sampleBytes, m_eMode))
+		return false;
+	if(!RotatePlane(pInU, pOutU, m_nWidth/2, m_nHeight/2, _sampleBytes, m_eMode))
+		return false;
+	return RotatePlane(pInV, pOutV, m_nWidth/2, m_nHeight/2, _sampleBytes, m_eMode);
+}//end Rotate.
+
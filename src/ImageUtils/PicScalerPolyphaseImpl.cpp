@@ -0,0 +1,503 @@
+/** @file
+
+MODULE				: PicScalerPolyphaseImpl
+
+TAG						: PSPOLY
+
+FILE NAME			: PicScalerPolyphaseImpl.cpp
+
+DESCRIPTION		: A separable polyphase implementation derived from the
+								general PicScalerBase() class. Scale YUV420P planar
+								or packed RGB24 images with bilinear, bicubic or area
+								filters from precomputed fixed point tap tables.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "PicScalerPolyphaseImpl.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define PSPOLY_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+===========================================================================
+	Constants.
+===========================================================================
+*/
+/// The intermediate rows hold (PSPOLY_COEFF_BITS - PSPOLY_HORZ_SHIFT) = 6 fractional
+/// bits that keep 8 bit range samples and the bicubic overshoot within 16 bits.
+#define PSPOLY_HORZ_SHIFT		8
+#define PSPOLY_VERT_SHIFT		(PSPOLY_COEFF_BITS + PSPOLY_COEFF_BITS - PSPOLY_HORZ_SHIFT)
+
+/*
+===========================================================================
+	Filter kernels.
+===========================================================================
+*/
+/// Catmull-Rom cubic (a = -0.5).
+static double PSPOLY_Cubic(double t)
+{
+	const double a = -0.5;
+	t = fabs(t);
+	if(t < 1.0)
+		return( ((a + 2.0)*t - (a + 3.0))*t*t + 1.0 );
+	if(t < 2.0)
+		return( ((a*t - 5.0*a)*t + 8.0*a)*t - 4.0*a );
+	return(0.0);
+}//end PSPOLY_Cubic.
+
+static double PSPOLY_Linear(double t)
+{
+	t = fabs(t);
+	return( (t < 1.0) ? (1.0 - t) : 0.0 );
+}//end PSPOLY_Linear.
+
+/*
+===========================================================================
+	Row filters.
+===========================================================================
+*/
+/// Horizontal filter of an input row of channels interleaved samples into an intermediate row.
+template<typename T> static void PSPOLY_HorzRow(const T* pIn, short* pOut, int widthIn, int widthOut, int channels, const PSPOLY_TABLE* pH, int simd)
+{
+	int x = 0;
+
+#ifdef PSPOLY_HAVE_SSE2
+	/// Single channel pels are filtered 8 taps at a time for 4 output pels while the padded taps
+	/// lie within the row. The 4 sums are transposed together.
+	if(simd && (channels == 1))
+	{
+		__m128i zero	= _mm_setzero_si128();
+		__m128i rnd		= _mm_set1_epi32(1 << (PSPOLY_HORZ_SHIFT - 1));
+		for(; ((x + 4) <= widthOut)&&((pH->pOffset[x + 3] + pH->stride) <= widthIn); x += 4)
+		{
+			__m128i acc[4];
+			for(int j = 0; j < 4; j++)
+			{
+				const T*			s = pIn + pH->pOffset[x + j];
+				const short*	c = pH->pCoeff + (x + j)*pH->stride;
+				acc[j] = _mm_setzero_si128();
+				for(int k = 0; k < pH->stride; k += 8)
+				{
+					__m128i v;
+					if(sizeof(T) == 1)
+						v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(s + k)), zero);
+					else
+						v = _mm_loadu_si128((const __m128i *)(s + k));
+					acc[j] = _mm_add_epi32(acc[j], _mm_madd_epi16(v, _mm_loadu_si128((const __m128i *)(c + k))));
+				}//end for k...
+			}//end for j...
+			__m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(acc[0], acc[1]), _mm_unpackhi_epi32(acc[0], acc[1]));
+			__m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(acc[2], acc[3]), _mm_unpackhi_epi32(acc[2], acc[3]));
+			__m128i sum = _mm_add_epi32(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+			sum = _mm_srai_epi32(_mm_add_epi32(sum, rnd), PSPOLY_HORZ_SHIFT);
+			_mm_storel_epi64((__m128i *)(pOut + x), _mm_packs_epi32(sum, sum));
+		}//end for x...
+	}//end if simd...
+#endif
+
+	for(; x < widthOut; x++)
+	{
+		const T*			s = pIn + pH->pOffset[x]*channels;
+		const short*	c = pH->pCoeff + x*pH->stride;
+		for(int ch = 0; ch < channels; ch++)
+		{
+			int acc = 0;
+			for(int k = 0; k < pH->taps; k++)
+				acc += (int)c[k] * (int)s[k*channels + ch];
+			acc = (acc + (1 << (PSPOLY_HORZ_SHIFT - 1))) >> PSPOLY_HORZ_SHIFT;
+			if(acc < -32768) acc = -32768;
+			else if(acc > 32767) acc = 32767;
+			pOut[x*channels + ch] = (short)acc;
+		}//end for ch...
+	}//end for x...
+}//end PSPOLY_HorzRow.
+
+/// Vertical filter of taps intermediate rows into an output row of len samples clamped to
+/// [lo..hi]. For odd taps the row pointer at [taps] must be valid and its coeff zero. The
+/// range of 8 bit samples is always [0..255].
+template<typename T> static void PSPOLY_VertRow(short** ppRow, const short* c, int taps, T* pOut, int len, int lo, int hi, int simd)
+{
+	int i = 0;
+
+#ifdef PSPOLY_HAVE_SSE2
+	if(simd)
+	{
+		__m128i rnd = _mm_set1_epi32(1 << (PSPOLY_VERT_SHIFT - 1));
+		__m128i vlo	= _mm_set1_epi16((short)lo);
+		__m128i vhi	= _mm_set1_epi16((short)hi);
+		for(; (i + 8) <= len; i += 8)
+		{
+			__m128i accLo = _mm_setzero_si128();
+			__m128i accHi = _mm_setzero_si128();
+			/// Rows are paired to multiply-add 2 taps per 32 bit lane.
+			for(int k = 0; k < taps; k += 2)
+			{
+				__m128i a		= _mm_loadu_si128((const __m128i *)(ppRow[k] + i));
+				__m128i b		= _mm_loadu_si128((const __m128i *)(ppRow[k + 1] + i));
+				__m128i cc	= _mm_set1_epi32( (int)(((unsigned int)(unsigned short)c[k + 1] << 16) | (unsigned int)(unsigned short)c[k]) );
+				accLo = _mm_add_epi32(accLo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), cc));
+				accHi = _mm_add_epi32(accHi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), cc));
+			}//end for k...
+			accLo = _mm_srai_epi32(_mm_add_epi32(accLo, rnd), PSPOLY_VERT_SHIFT);
+			accHi = _mm_srai_epi32(_mm_add_epi32(accHi, rnd), PSPOLY_VERT_SHIFT);
+			__m128i v = _mm_packs_epi32(accLo, accHi);
+			if(sizeof(T) == 1)
+				_mm_storel_epi64((__m128i *)(pOut + i), _mm_packus_epi16(v, v));
+			else
+				_mm_storeu_si128((__m128i *)(pOut + i), _mm_min_epi16(_mm_max_epi16(v, vlo), vhi));
+		}//end for i...
+	}//end if simd...
+#endif
+
+	for(; i < len; i++)
+	{
+		int acc = 0;
+		for(int k = 0; k < taps; k++)
+			acc += (int)c[k] * (int)ppRow[k][i];
+		acc = (acc + (1 << (PSPOLY_VERT_SHIFT - 1))) >> PSPOLY_VERT_SHIFT;
+		if(acc < lo) acc = lo;
+		else if(acc > hi) acc = hi;
+		pOut[i] = (T)acc;
+	}//end for i...
+}//end PSPOLY_VertRow.
+
+/*
+===========================================================================
+	Public Methods.
+===========================================================================
+*/
+/** Allocate the tap tables and the row ring.
+The tables are created for the current dimensions, format and filter.
+@return	: 1 = success, 0 = invalid settings or allocation failure.
+*/
+int PicScalerPolyphaseImpl::Create(void)
+{
+	Destroy();
+
+	if( (_widthIn < 1)||(_heightIn < 1)||(_widthOut < 1)||(_heightOut < 1) )
+		return(0);
+	if( (_format < PSPOLY_YUV420P)||(_format > PSPOLY_RGB24)||(_filter < PSPOLY_BILINEAR)||(_filter > PSPOLY_AREA) )
+		return(0);
+
+	int channels = (_format == PSPOLY_RGB24) ? 3 : 1;
+	if(!CreateTable(&_lumHorz, _widthIn, _widthOut) || !CreateTable(&_lumVert, _heightIn, _heightOut))
+	{
+		Destroy();
+		return(0);
+	}//end if !CreateTable...
+	_ringRows = _lumVert.taps;
+
+	if(_format != PSPOLY_RGB24)
+	{
+		if(!CreateTable(&_chrHorz, _widthIn/2, _widthOut/2) || !CreateTable(&_chrVert, _heightIn/2, _heightOut/2))
+		{
+			Destroy();
+			return(0);
+		}//end if !CreateTable...
+		if(_chrVert.taps > _ringRows)
+			_ringRows = _chrVert.taps;
+	}//end if _format...
+
+	/// The lum rows are the longest.
+	int len		= _widthOut * channels;
+	_pRingMem	= new short[_ringRows * len];
+	_pRing		= new short*[_ringRows];
+	_pRingTag	= new int[_ringRows];
+	_pTapRow	= new short*[_ringRows + 1];
+	if( (_pRingMem == NULL)||(_pRing == NULL)||(_pRingTag == NULL)||(_pTapRow == NULL) )
+	{
+		Destroy();
+		return(0);
+	}//end if _pRingMem...
+	for(int i = 0; i < _ringRows; i++)
+		_pRing[i] = _pRingMem + i*len;
+
+	_createdWidthIn		= _widthIn;
+	_createdHeightIn	= _heightIn;
+	_createdWidthOut	= _widthOut;
+	_createdHeightOut	= _heightOut;
+	_createdFormat		= _format;
+	_createdFilter		= _filter;
+	return(1);
+}//end Create.
+
+void PicScalerPolyphaseImpl::Destroy(void)
+{
+	DestroyTable(&_lumHorz);
+	DestroyTable(&_lumVert);
+	DestroyTable(&_chrHorz);
+	DestroyTable(&_chrVert);
+	if(_pRingMem != NULL)
+		delete[] _pRingMem;
+	if(_pRing != NULL)
+		delete[] _pRing;
+	if(_pRingTag != NULL)
+		delete[] _pRingTag;
+	if(_pTapRow != NULL)
+		delete[] _pTapRow;
+	ResetMembers();
+}//end Destroy.
+
+/** Scale the size of the input image.
+Scale the input image from its dimensions to that of the output image. For the
+YUV420P formats the lum Y pels are followed immediately by the U and then V 
+values. No memory size checking is done and is delegated to the calling process.
+@param pOutImg	: Output image of the format.
+@param pInImg		: Input image of the format.
+@return					: 0 = failed, 1 = success.
+*/
+int PicScalerPolyphaseImpl::Scale(void* pOutImg, void* pInImg)
+{
+	if( (pOutImg == NULL) || (pInImg == NULL) )
+		return(0);
+
+	if( (_pRingMem == NULL)||(_createdWidthIn != _widthIn)||(_createdHeightIn != _heightIn)||(_createdWidthOut != _widthOut)||
+			(_createdHeightOut != _heightOut)||(_createdFormat != _format)||(_createdFilter != _filter) )
+	{
+		if(!Create())
+			return(0);
+	}//end if _pRingMem...
+
+	if(_format == PSPOLY_RGB24)
+	{
+		ScalePlane(pInImg, pOutImg, _widthIn, _heightIn, _widthOut, _heightOut, 3, &_lumHorz, &_lumVert, 0, 255);
+		return(1);
+	}//end if _format...
+
+	int bytes = (_format == PSPOLY_YUV420P16) ? 2 : 1;
+	int lumIn		= _widthIn * _heightIn;
+	int lumOut	= _widthOut * _heightOut;
+	int chrIn		= (_widthIn/2) * (_heightIn/2);
+	int chrOut	= (_widthOut/2) * (_heightOut/2);
+	unsigned char* pIn	= (unsigned char *)pInImg;
+	unsigned char* pOut	= (unsigned char *)pOutImg;
+
+	/// The bicubic overshoot of the 16 bit samples is clamped to the lum and offset chr range.
+	int chrLo = (bytes == 2) ? (_chrOff - 128) : 0;
+	int chrHi = (bytes == 2) ? (_chrOff + 127) : 255;
+
+	ScalePlane(pIn, pOut, _widthIn, _heightIn, _widthOut, _heightOut, 1, &_lumHorz, &_lumVert, 0, 255);
+	ScalePlane(pIn + bytes*lumIn, pOut + bytes*lumOut, _widthIn/2, _heightIn/2, _widthOut/2, _heightOut/2, 1, &_chrHorz, &_chrVert, chrLo, chrHi);
+	ScalePlane(pIn + bytes*(lumIn + chrIn), pOut + bytes*(lumOut + chrOut), _widthIn/2, _heightIn/2, _widthOut/2, _heightOut/2, 1, &_chrHorz, &_chrVert, chrLo, chrHi);
+
+	return(1);
+}//end Scale.
+
+/*
+===========================================================================
+	Private Methods.
+===========================================================================
+*/
+void PicScalerPolyphaseImpl::ResetMembers(void)
+{
+	_createdWidthIn		= 0;
+	_createdHeightIn	= 0;
+	_createdWidthOut	= 0;
+	_createdHeightOut	= 0;
+	_createdFormat		= -1;
+	_createdFilter		= -1;
+
+	memset(&_lumHorz, 0, sizeof(PSPOLY_TABLE));
+	memset(&_lumVert, 0, sizeof(PSPOLY_TABLE));
+	memset(&_chrHorz, 0, sizeof(PSPOLY_TABLE));
+	memset(&_chrVert, 0, sizeof(PSPOLY_TABLE));
+
+	_pRingMem	= NULL;
+	_pRing		= NULL;
+	_pRingTag	= NULL;
+	_ringRows	= 0;
+	_pTapRow	= NULL;
+}//end ResetMembers.
+
+/** Fill the tap table of an axis.
+The kernel is centred on the input position of each output pel and is widened
+by the downscale ratio. Taps beyond the input edges are folded onto the edge
+pels so the hot loops need no clamping.
+@param pTable	: Table to fill.
+@param in			: Input pels.
+@param out		: Output pels.
+@return				: 1 = success, 0 = failure.
+*/
+int PicScalerPolyphaseImpl::CreateTable(PSPOLY_TABLE* pTable, int in, int out)
+{
+	if( (in < 1)||(out < 1) )
+		return(0);
+
+	double scale	= ((double)in)/((double)out);
+	double widen	= (scale > 1.0) ? scale : 1.0;
+	double radius	= (_filter == PSPOLY_BICUBIC) ? 2.0 : 1.0;
+	int taps;
+	if(_filter == PSPOLY_AREA)
+		taps = (int)ceil(scale) + 1;
+	else
+		taps = (int)ceil(2.0 * radius * widen);
+	int window = (taps > in) ? in : taps;
+
+	pTable->taps		= window;
+	pTable->stride	= (window + (window & 1) + 7) & ~7;	///< Room for a zero tap to pair odd taps.
+	pTable->pOffset	= new int[out];
+	pTable->pCoeff	= new short[out * pTable->stride];
+	double* pW			= new double[taps + window];
+	if( (pTable->pOffset == NULL)||(pTable->pCoeff == NULL)||(pW == NULL) )
+	{
+		if(pW != NULL)
+			delete[] pW;
+		return(0);
+	}//end if pOffset...
+	double* pFold = pW + taps;
+	memset(pTable->pCoeff, 0, out * pTable->stride * sizeof(short));
+
+	for(int o = 0; o < out; o++)
+	{
+		int start, k;
+		if(_filter == PSPOLY_AREA)
+		{
+			/// Overlap of the output pel span with each input pel span.
+			double lo = scale * (double)o;
+			double hi = scale * (double)(o + 1);
+			start = (int)floor(lo);
+			for(k = 0; k < taps; k++)
+			{
+				double p0 = (double)(start + k);
+				double w = ((hi < (p0 + 1.0)) ? hi : (p0 + 1.0)) - ((lo > p0) ? lo : p0);
+				pW[k] = (w > 0.0) ? w : 0.0;
+			}//end for k...
+		}//end if _filter...
+		else
+		{
+			double centre = scale * ((double)o + 0.5) - 0.5;
+			start = (int)floor(centre - radius * widen) + 1;
+			for(k = 0; k < taps; k++)
+			{
+				double t = ((double)(start + k) - centre)/widen;
+				pW[k] = (_filter == PSPOLY_BICUBIC) ? PSPOLY_Cubic(t) : PSPOLY_Linear(t);
+			}//end for k...
+		}//end else...
+
+		/// Fold the taps onto a window within the input.
+		int offset = start;
+		if(offset > (in - window)) offset = in - window;
+		if(offset < 0) offset = 0;
+		double sum = 0.0;
+		for(k = 0; k < window; k++)
+			pFold[k] = 0.0;
+		for(k = 0; k < taps; k++)
+		{
+			int p = start + k;
+			if(p < 0) p = 0;
+			else if(p >= in) p = in - 1;
+			pFold[p - offset] += pW[k];
+			sum += pW[k];
+		}//end for k...
+
+		/// Quantise with the rounding residue on the largest tap so that the coeffs sum to one.
+		short* c	= pTable->pCoeff + o*pTable->stride;
+		int total	= 0;
+		int big		= 0;
+		for(k = 0; k < window; k++)
+		{
+			c[k] = (short)floor((pFold[k] * (double)(1 << PSPOLY_COEFF_BITS))/sum + 0.5);
+			total += c[k];
+			if(fabs(pFold[k]) > fabs(pFold[big]))
+				big = k;
+		}//end for k...
+		c[big] = (short)(c[big] + ((1 << PSPOLY_COEFF_BITS) - total));
+		pTable->pOffset[o] = offset;
+	}//end for o...
+
+	delete[] pW;
+	return(1);
+}//end CreateTable.
+
+void PicScalerPolyphaseImpl::DestroyTable(PSPOLY_TABLE* pTable)
+{
+	if(pTable->pOffset != NULL)
+		delete[] pTable->pOffset;
+	if(pTable->pCoeff != NULL)
+		delete[] pTable->pCoeff;
+	memset(pTable, 0, sizeof(PSPOLY_TABLE));
+}//end DestroyTable.
+
+/** Scale a plane.
+Input rows are horizontally filtered into the ring once when first needed by
+the vertical taps of an output row. The tap rows are bounded by the input height.
+@param lo	: Min output sample.
+@param hi	: Max output sample.
+*/
+void PicScalerPolyphaseImpl::ScalePlane(const void* pIn, void* pOut, int widthIn, int heightIn, int widthOut, int heightOut, int channels, PSPOLY_TABLE* pHorz, PSPOLY_TABLE* pVert, int lo, int hi)
+{
+	int i, y;
+	int len		= widthOut * channels;
+	int taps	= pVert->taps;
+	for(i = 0; i < _ringRows; i++)
+		_pRingTag[i] = -1;
+
+	for(y = 0; y < heightOut; y++)
+	{
+		for(i = 0; i < taps; i++)
+		{
+			int row		= pVert->pOffset[y] + i;
+			if(row >= heightIn)
+				row = heightIn - 1;
+			int slot	= row % _ringRows;
+			if(_pRingTag[slot] != row)
+			{
+				if(_format == PSPOLY_YUV420P16)
+					PSPOLY_HorzRow<short>((const short *)pIn + row*widthIn*channels, _pRing[slot], widthIn, widthOut, channels, pHorz, _simd);
+				else
+					PSPOLY_HorzRow<unsigned char>((const unsigned char *)pIn + row*widthIn*channels, _pRing[slot], widthIn, widthOut, channels, pHorz, _simd);
+				_pRingTag[slot] = row;
+			}//end if _pRingTag...
+			_pTapRow[i] = _pRing[slot];
+		}//end for i...
+		_pTapRow[taps] = _pTapRow[taps - 1];	///< Zero coeff pair of odd taps.
+
+		const short* c = pVert->pCoeff + y*pVert->stride;
+		if(_format == PSPOLY_YUV420P16)
+			PSPOLY_VertRow<short>(_pTapRow, c, taps, (short *)pOut + y*len, len, lo, hi, _simd);
+		else
+			PSPOLY_VertRow<unsigned char>(_pTapRow, c, taps, (unsigned char *)pOut + y*len, len, 0, 255, _simd);
+	}//end for y...
+}//end ScalePlane.
+
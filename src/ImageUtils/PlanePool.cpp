@@ -0,0 +1,252 @@
+/** @file
+
+MODULE				: PlanePool
+
+TAG						: PP
+
+FILE NAME			: PlanePool.cpp
+
+DESCRIPTION		: A thread safe pool of AlignedPlane allocated image planes
+								keyed by width, height, element size and row stride. Released
+								planes are held idle and recycled by later requests with the
+								same key so that codec re-opens do not return to the heap. The
+								usage statistics expose the mem high water mark.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+#include <string.h>
+#include "PlanePool.h"
+
+/*
+---------------------------------------------------------------------------
+	Construction and destruction.
+---------------------------------------------------------------------------
+*/
+PlanePool::PlanePool(void)
+{
+	_pLive			= NULL;
+	_pIdle			= NULL;
+	_idleLimit	= PP_DEFAULT_IDLE_LIMIT;
+	memset((void *)&_stats, 0, sizeof(PP_STATS));
+}//end constructor.
+
+PlanePool::~PlanePool(void)
+{
+	/// Planes still on loan are abandoned to their owners.
+	Trim();
+	while(_pLive != NULL)
+	{
+		PP_BLOCK* pNext = _pLive->next;
+		delete _pLive;
+		_pLive = pNext;
+	}//end while _pLive...
+}//end destructor.
+
+/// The shared pool is never destroyed so that planes held by static objects
+/// may still be returned to it during process exit.
+PlanePool* PlanePool::Shared(void)
+{
+	static PlanePool* pPool = new PlanePool();
+	return(pPool);
+}//end Shared.
+
+/*
+---------------------------------------------------------------------------
+	Interface Methods.
+---------------------------------------------------------------------------
+*/
+void* PlanePool::Acquire(int width, int height, int elemSize, int padded, int* stride)
+{
+	if( (width <= 0)||(height <= 0)||(elemSize <= 0) )
+		return(NULL);
+	int s = padded ? AlignedPlane::Stride(width, elemSize) : width;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stats.acquires++;
+
+	/// Recycle the most recently released idle plane with this key.
+	PP_BLOCK* pPrev = NULL;
+	PP_BLOCK* pBlk	= _pIdle;
+	while(pBlk != NULL)
+	{
+		if( (pBlk->width == width)&&(pBlk->height == height)&&(pBlk->elemSize == elemSize)&&(pBlk->stride == s) )
+			break;
+		pPrev = pBlk;
+		pBlk	= pBlk->next;
+	}//end while pBlk...
+
+	if(pBlk != NULL)
+	{
+		if(pPrev != NULL)
+			pPrev->next = pBlk->next;
+		else
+			_pIdle = pBlk->next;
+		_stats.hits++;
+		_stats.idleBytes -= pBlk->bytes;
+		_stats.idleBlocks--;
+	}//end if pBlk...
+	else
+	{
+		pBlk = new PP_BLOCK;
+		if(pBlk == NULL)
+			return(NULL);
+		pBlk->ptr = AlignedPlane::Alloc(s, height, elemSize);
+		if(pBlk->ptr == NULL)
+		{
+			delete pBlk;
+			return(NULL);
+		}//end if !ptr...
+		pBlk->width			= width;
+		pBlk->height		= height;
+		pBlk->elemSize	= elemSize;
+		pBlk->stride		= s;
+		pBlk->bytes			= (long long)s * (long long)height * (long long)elemSize;
+		_stats.allocs++;
+	}//end else...
+
+	pBlk->next = _pLive;
+	_pLive		 = pBlk;
+	_stats.liveBytes += pBlk->bytes;
+	_stats.liveBlocks++;
+	if( (_stats.liveBytes + _stats.idleBytes) > _stats.peakBytes )
+		_stats.peakBytes = _stats.liveBytes + _stats.idleBytes;
+
+	if(stride != NULL)
+		*stride = s;
+	return(pBlk->ptr);
+}//end Acquire.
+
+int PlanePool::Release(void* ptr)
+{
+	if(ptr == NULL)
+		return(1);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	PP_BLOCK* pPrev = NULL;
+	PP_BLOCK* pBlk	= _pLive;
+	while( (pBlk != NULL)&&(pBlk->ptr != ptr) )
+	{
+		pPrev = pBlk;
+		pBlk	= pBlk->next;
+	}//end while pBlk...
+	if(pBlk == NULL)
+		return(0);
+
+	if(pPrev != NULL)
+		pPrev->next = pBlk->next;
+	else
+		_pLive = pBlk->next;
+	_stats.liveBytes -= pBlk->bytes;
+	_stats.liveBlocks--;
+
+	/// Hold it idle at the head and trim the oldest above the limit.
+	pBlk->next = _pIdle;
+	_pIdle		 = pBlk;
+	_stats.idleBytes += pBlk->bytes;
+	_stats.idleBlocks++;
+	EvictIdle(_idleLimit);
+
+	return(1);
+}//end Release.
+
+void PlanePool::Trim(void)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	EvictIdle(0);
+}//end Trim.
+
+void PlanePool::SetIdleLimit(long long bytes)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_idleLimit = (bytes > 0) ? bytes : 0;
+	EvictIdle(_idleLimit);
+}//end SetIdleLimit.
+
+void PlanePool::GetStats(PP_STATS* pStats)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	*pStats = _stats;
+}//end GetStats.
+
+void PlanePool::ResetStats(void)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stats.acquires = 0;
+	_stats.hits			= 0;
+	_stats.allocs		= 0;
+	_stats.frees		= 0;
+	_stats.peakBytes = _stats.liveBytes + _stats.idleBytes;
+}//end ResetStats.
+
+/*
+---------------------------------------------------------------------------
+	Private Methods.
+---------------------------------------------------------------------------
+*/
+/// Return idle planes from the least recently released end until the idle
+/// bytes are within the limit. The mutex must be held.
+void PlanePool::EvictIdle(long long limit)
+{
+	while( (_pIdle != NULL)&&(_stats.idleBytes > limit) )
+	{
+		/// The tail is the least recently released.
+		PP_BLOCK* pPrev = NULL;
+		PP_BLOCK* pBlk	= _pIdle;
+		while(pBlk->next != NULL)
+		{
+			pPrev = pBlk;
+			pBlk	= pBlk->next;
+		}//end while next...
+		if(pPrev != NULL)
+			pPrev->next = NULL;
+		else
+			_pIdle = NULL;
+		_stats.idleBytes -= pBlk->bytes;
+		_stats.idleBlocks--;
+		FreeBlock(pBlk);
+	}//end while _pIdle...
+}//end EvictIdle.
+
+void PlanePool::FreeBlock(PP_BLOCK* pBlk)
+{
+	AlignedPlane::Free(pBlk->ptr);
+	delete pBlk;
+	_stats.frees++;
+}//end FreeBlock.
+
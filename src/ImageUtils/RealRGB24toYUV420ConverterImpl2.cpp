@@ -102,14 +102,28 @@ to 0..255.
 @return			: none.
 */
 void RealRGB24toYUV420ConverterImpl2::Convert(void* pRgb, void* pY, void* pU, void* pV)
+{
+  ConvertRows(pRgb, pY, pU, pV, 0, _height >> 1);
+}//end Convert.
+
+/** Convert a range of 2x2 pel block rows.
+@param pRgb			: Packed RGB 888 format of the whole frame.
+@param pY				: Lum plane of the whole frame.
+@param pU				: Chr U plane.
+@param pV				: Chr V plane.
+@param ybStart	: First block row (2 pel rows) to convert.
+@param ybEnd		: One past the last block row.
+@return					: none.
+*/
+void RealRGB24toYUV420ConverterImpl2::ConvertRows(void* pRgb, void* pY, void* pU, void* pV, int ybStart, int ybEnd)
 {
   if (_flip)
-    FlipConvert(pRgb, pY, pU, pV);
+    FlipConvert(pRgb, pY, pU, pV, ybStart, ybEnd);
   else
-    NonFlipConvert(pRgb, pY, pU, pV);
-}//end Convert.
+    NonFlipConvert(pRgb, pY, pU, pV, ybStart, ybEnd);
+}//end ConvertRows.
 
-void RealRGB24toYUV420ConverterImpl2::FlipConvert( void* pRgb, void* pY, void* pU, void* pV )
+void RealRGB24toYUV420ConverterImpl2::FlipConvert( void* pRgb, void* pY, void* pU, void* pV, int ybStart, int ybEnd )
 {
   yuvType*	py = (yuvType *)pY;
   yuvType*	pu = (yuvType *)pU;
@@ -122,8 +136,7 @@ void RealRGB24toYUV420ConverterImpl2::FlipConvert( void* pRgb, void* pY, void* p
 
   /// Step in 2x2 pel blocks. (4 pels per block).
   int xBlks = _width >> 1;
-  int yBlks = _height >> 1;
-  for(int yb = 0; yb < yBlks; yb++)
+  for(int yb = ybStart; yb < ybEnd; yb++)
     for(int xb = 0; xb < xBlks; xb++)
     {
       int							chrOff	= yb*xBlks + xb;
@@ -186,7 +199,7 @@ void RealRGB24toYUV420ConverterImpl2::FlipConvert( void* pRgb, void* pY, void* p
     }//end for xb & yb...
 }
 
-void RealRGB24toYUV420ConverterImpl2::NonFlipConvert( void* pRgb, void* pY, void* pU, void* pV )
+void RealRGB24toYUV420ConverterImpl2::NonFlipConvert( void* pRgb, void* pY, void* pU, void* pV, int ybStart, int ybEnd )
 {
   yuvType*	py = (yuvType *)pY;
   yuvType*	pu = (yuvType *)pU;
@@ -199,8 +212,7 @@ void RealRGB24toYUV420ConverterImpl2::NonFlipConvert( void* pRgb, void* pY, void
 
   /// Step in 2x2 pel blocks. (4 pels per block).
   int xBlks = _width >> 1;
-  int yBlks = _height >> 1;
-  for(int yb = 0; yb < yBlks; yb++)
+  for(int yb = ybStart; yb < ybEnd; yb++)
     for(int xb = 0; xb < xBlks; xb++)
     {
       int							chrOff	= yb*xBlks + xb;
@@ -0,0 +1,476 @@
+/** @file
+
+MODULE				: ViewMem2Dv2
+
+TAG						: VM2DV2
+
+FILE NAME			: ViewMem2Dv2.cpp
+
+DESCRIPTION		: A light weight value type view onto a 2-D block of shorts
+								described by a top left ptr, width, height and row stride.
+								Views are constructed without mem alloc and give single
+								indirection block copy and distortion metric operations.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include <memory.h>
+#include <string.h>
+
+#include "ViewMem2Dv2.h"
+
+/*
+---------------------------------------------------------------------------
+	Macros.
+---------------------------------------------------------------------------
+*/
+#define VM2DV2_FAST_ABS32(x) ( ((x)^((x)>>31))-((x)>>31) )
+
+/// Metric evaluations are added to the OverlayMem2Dv2 benchmark counter.
+#ifdef OM2DV2_COUNT_EVALUATIONS
+#define VM2DV2_COUNT_EVALUATION (OverlayMem2Dv2::CountEvaluation())
+#else
+#define VM2DV2_COUNT_EVALUATION
+#endif
+
+/*
+---------------------------------------------------------------------------
+	SSE2 row kernels.
+---------------------------------------------------------------------------
+*/
+/// The 16 bit differences are exact for pel range values [0..255] and the
+/// pair wise 32 bit accumulations cannot overflow for 16 pel rows.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define VM2DV2_SSE2
+#include <emmintrin.h>
+
+/// Square diff of 8 pels accumulated into 4 x 32 bit lanes.
+static inline __m128i VM2DV2_Sdx8(const short* p, const short* q, __m128i acc)
+{
+	__m128i d = _mm_sub_epi16(_mm_loadu_si128((const __m128i *)p), _mm_loadu_si128((const __m128i *)q));
+	return(_mm_add_epi32(acc, _mm_madd_epi16(d, d)));
+}//end VM2DV2_Sdx8.
+
+/// Abs diff of 8 pels accumulated into 4 x 32 bit lanes.
+static inline __m128i VM2DV2_Adx8(const short* p, const short* q, __m128i acc)
+{
+	__m128i d = _mm_sub_epi16(_mm_loadu_si128((const __m128i *)p), _mm_loadu_si128((const __m128i *)q));
+	d = _mm_max_epi16(d, _mm_sub_epi16(_mm_setzero_si128(), d));
+	return(_mm_add_epi32(acc, _mm_madd_epi16(d, _mm_set1_epi16(1))));
+}//end VM2DV2_Adx8.
+
+/// Horizontal sum of the 4 x 32 bit lanes.
+static inline int VM2DV2_HSum(__m128i acc)
+{
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+	return(_mm_cvtsi128_si32(acc));
+}//end VM2DV2_HSum.
+#endif	// SSE2
+
+/*
+---------------------------------------------------------------------------
+	Public input/output interface.
+---------------------------------------------------------------------------
+*/
+
+/** Write the entire source block into this block.
+Return if the source does not have the same dimensions as this block.
+@param me		: Destination view.
+@param src	: The block to copy. 
+@return 		: 0 = failure, 1 = success.
+*/
+int ViewMem2Dv2::Write(const ViewMem2Dv2& me, const ViewMem2Dv2& src)
+{
+	if( (me._width != src._width)||(me._height != src._height) )
+		return(0);
+
+	short*				pD = me._pMem;
+	const short*	pS = src._pMem;
+	for(int row = 0; row < me._height; row++, pD += me._stride, pS += src._stride)
+		memcpy((void *)pD, (const void *)pS, me._width * sizeof(short));
+
+	return(1);
+}//end Write.
+
+/** Set all the block values to the input value.
+@param me			: View to fill.
+@param value	: Fill value.
+@return				: none.
+*/
+void ViewMem2Dv2::Fill(const ViewMem2Dv2& me, int value)
+{
+	short* pD = me._pMem;
+	for(int row = 0; row < me._height; row++, pD += me._stride)
+		for(int col = 0; col < me._width; col++)
+			pD[col] = (short)value;
+}//end Fill.
+
+/*
+---------------------------------------------------------------------------
+	Public distortion metric interface.
+---------------------------------------------------------------------------
+*/
+
+/** Calc the total square difference with the input block.
+The block dimensions must match else return INF.
+@param b	: Input block.
+@return		: Total square diff.	
+*/
+int ViewMem2Dv2::Tsd(const ViewMem2Dv2& me, const ViewMem2Dv2& b)
+{
+	VM2DV2_COUNT_EVALUATION;
+	if( (me._width != b._width)||(me._height != b._height) )
+		return(10000000);
+
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+	int acc = 0;
+	for(int row = 0; row < me._height; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < me._width; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += (diff * diff);
+		}//end for col...
+	}//end for row...
+
+	return(acc);
+}//end Tsd.
+
+/** Calc the total square difference with the 8x8 input block.
+No dimension checking is done so use with caution.
+@param b	: 8x8 input block.
+@return		: Total square diff.	
+*/
+int ViewMem2Dv2::Tsd8x8(const ViewMem2Dv2& me, const ViewMem2Dv2& b)
+{
+	VM2DV2_COUNT_EVALUATION;
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+#ifdef VM2DV2_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for(int row = 0; row < 8; row++, pP += me._stride, pI += b._stride)
+		acc = VM2DV2_Sdx8(pP, pI, acc);
+	return(VM2DV2_HSum(acc));
+#else
+	int acc = 0;
+	for(int row = 0; row < 8; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < 8; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += (diff * diff);
+		}//end for col...
+	}//end for row...
+	return(acc);
+#endif
+}//end Tsd8x8.
+
+/** Calc the total square difference with the 16x16 input block.
+No dimension checking is done so use with caution.
+@param b	: 16x16 input block.
+@return		: Total square diff.	
+*/
+int ViewMem2Dv2::Tsd16x16(const ViewMem2Dv2& me, const ViewMem2Dv2& b)
+{
+	VM2DV2_COUNT_EVALUATION;
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+#ifdef VM2DV2_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for(int row = 0; row < 16; row++, pP += me._stride, pI += b._stride)
+	{
+		acc = VM2DV2_Sdx8(pP, pI, acc);
+		acc = VM2DV2_Sdx8(pP + 8, pI + 8, acc);
+	}//end for row...
+	return(VM2DV2_HSum(acc));
+#else
+	int acc = 0;
+	for(int row = 0; row < 16; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < 16; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += (diff * diff);
+		}//end for col...
+	}//end for row...
+	return(acc);
+#endif
+}//end Tsd16x16.
+
+/** The total square difference with the input to improve on an input value.
+Exit early if the accumulated square difference becomes larger than the
+specified input value. The block dimensions must match else return INF.
+@param b		: Input block.
+@param min	:	The min value to improve on.
+@return			: Total square diff to the point of early exit.	
+*/
+int ViewMem2Dv2::TsdLessThan(const ViewMem2Dv2& me, const ViewMem2Dv2& b, int min)
+{
+	VM2DV2_COUNT_EVALUATION;
+	if( (me._width != b._width)||(me._height != b._height) )
+		return(min + 10000000);
+
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+	int acc = 0;
+	for(int row = 0; row < me._height; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < me._width; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += (diff * diff);
+		}//end for col...
+		if(acc > min)
+			return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+
+	return(acc);
+}//end TsdLessThan.
+
+/** The total square difference with the 16x16 input to improve on an input value.
+The early exit test is made after every row. No dimension checking is done so 
+use with caution.
+@param b		: 16x16 input block.
+@param min	:	The min value to improve on.
+@return			: Total square diff to the point of early exit.	
+*/
+int ViewMem2Dv2::Tsd16x16LessThan(const ViewMem2Dv2& me, const ViewMem2Dv2& b, int min)
+{
+	VM2DV2_COUNT_EVALUATION;
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+#ifdef VM2DV2_SSE2
+	int acc = 0;
+	for(int row = 0; row < 16; row++, pP += me._stride, pI += b._stride)
+	{
+		acc += VM2DV2_HSum(VM2DV2_Sdx8(pP + 8, pI + 8, VM2DV2_Sdx8(pP, pI, _mm_setzero_si128())));
+		if(acc > min)
+			return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+	return(acc);
+#else
+	int acc = 0;
+	for(int row = 0; row < 16; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < 16; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += (diff * diff);
+		}//end for col...
+		if(acc > min)
+			return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+	return(acc);
+#endif
+}//end Tsd16x16LessThan.
+
+/** Calc the total absolute difference with the input block.
+The block dimensions must match else return INF.
+@param b	: Input block.
+@return		: Total absolute diff.	
+*/
+int ViewMem2Dv2::Tad(const ViewMem2Dv2& me, const ViewMem2Dv2& b)
+{
+	VM2DV2_COUNT_EVALUATION;
+	if( (me._width != b._width)||(me._height != b._height) )
+		return(10000000);
+
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+	int acc = 0;
+	for(int row = 0; row < me._height; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < me._width; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += VM2DV2_FAST_ABS32(diff);
+		}//end for col...
+	}//end for row...
+
+	return(acc);
+}//end Tad.
+
+/** Calc the total absolute difference with the 8x8 input block.
+No dimension checking is done so use with caution.
+@param b	: 8x8 input block.
+@return		: Total absolute diff.	
+*/
+int ViewMem2Dv2::Tad8x8(const ViewMem2Dv2& me, const ViewMem2Dv2& b)
+{
+	VM2DV2_COUNT_EVALUATION;
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+#ifdef VM2DV2_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for(int row = 0; row < 8; row++, pP += me._stride, pI += b._stride)
+		acc = VM2DV2_Adx8(pP, pI, acc);
+	return(VM2DV2_HSum(acc));
+#else
+	int acc = 0;
+	for(int row = 0; row < 8; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < 8; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += VM2DV2_FAST_ABS32(diff);
+		}//end for col...
+	}//end for row...
+	return(acc);
+#endif
+}//end Tad8x8.
+
+/** Calc the total absolute difference with the 16x16 input block.
+No dimension checking is done so use with caution.
+@param b	: 16x16 input block.
+@return		: Total absolute diff.	
+*/
+int ViewMem2Dv2::Tad16x16(const ViewMem2Dv2& me, const ViewMem2Dv2& b)
+{
+	VM2DV2_COUNT_EVALUATION;
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+#ifdef VM2DV2_SSE2
+	__m128i acc = _mm_setzero_si128();
+	for(int row = 0; row < 16; row++, pP += me._stride, pI += b._stride)
+	{
+		acc = VM2DV2_Adx8(pP, pI, acc);
+		acc = VM2DV2_Adx8(pP + 8, pI + 8, acc);
+	}//end for row...
+	return(VM2DV2_HSum(acc));
+#else
+	int acc = 0;
+	for(int row = 0; row < 16; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < 16; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += VM2DV2_FAST_ABS32(diff);
+		}//end for col...
+	}//end for row...
+	return(acc);
+#endif
+}//end Tad16x16.
+
+/** The total absolute difference with the input to improve on an input value.
+Exit early if the accumulated absolute difference becomes larger than the
+specified input value. The block dimensions must match else return INF.
+@param b		: Input block.
+@param min	:	The min value to improve on.
+@return			: Total absolute diff to the point of early exit.	
+*/
+int ViewMem2Dv2::TadLessThan(const ViewMem2Dv2& me, const ViewMem2Dv2& b, int min)
+{
+	VM2DV2_COUNT_EVALUATION;
+	if( (me._width != b._width)||(me._height != b._height) )
+		return(min + 10000000);
+
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+	int acc = 0;
+	for(int row = 0; row < me._height; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < me._width; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += VM2DV2_FAST_ABS32(diff);
+		}//end for col...
+		if(acc > min)
+			return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+
+	return(acc);
+}//end TadLessThan.
+
+/** The total absolute difference with the 16x16 input to improve on an input value.
+The early exit test is made after every row. No dimension checking is done so 
+use with caution.
+@param b		: 16x16 input block.
+@param min	:	The min value to improve on.
+@return			: Total absolute diff to the point of early exit.	
+*/
+int ViewMem2Dv2::Tad16x16LessThan(const ViewMem2Dv2& me, const ViewMem2Dv2& b, int min)
+{
+	VM2DV2_COUNT_EVALUATION;
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+#ifdef VM2DV2_SSE2
+	int acc = 0;
+	for(int row = 0; row < 16; row++, pP += me._stride, pI += b._stride)
+	{
+		acc += VM2DV2_HSum(VM2DV2_Adx8(pP + 8, pI + 8, VM2DV2_Adx8(pP, pI, _mm_setzero_si128())));
+		if(acc > min)
+			return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+	return(acc);
+#else
+	int acc = 0;
+	for(int row = 0; row < 16; row++, pP += me._stride, pI += b._stride)
+	{
+		for(int col = 0; col < 16; col++)
+		{
+			int diff = pP[col] - pI[col];
+			acc += VM2DV2_FAST_ABS32(diff);
+		}//end for col...
+		if(acc > min)
+			return(acc);	///< Early exit because exceeded min.
+	}//end for row...
+	return(acc);
+#endif
+}//end Tad16x16LessThan.
+
+/** Test if the input block is equal to this block.
+@param b	: Input block.
+@return		: 1 = equal, 0 = not equal or the dimensions differ.
+*/
+int ViewMem2Dv2::Equals(const ViewMem2Dv2& me, const ViewMem2Dv2& b)
+{
+	if( (me._width != b._width)||(me._height != b._height) )
+		return(0);
+
+	const short* pP = me._pMem;
+	const short* pI = b._pMem;
+	for(int row = 0; row < me._height; row++, pP += me._stride, pI += b._stride)
+	{
+		if(memcmp((const void *)pP, (const void *)pI, me._width * sizeof(short)) != 0)
+			return(0);
+	}//end for row...
+
+	return(1);
+}//end Equals.
+
@@ -0,0 +1,362 @@
+/** @file
+
+MODULE				: YUV420IngestConverter
+
+TAG						: YUVIC
+
+FILE NAME			: YUV420IngestConverter.cpp
+
+DESCRIPTION		: Convert 8 bit I420, NV12, YUY2 and UYVY images directly
+								into the planar 16 bit YUV420 layout of the codecs and
+								export the planar 16 bit layout back to the 8 bit formats.
+
+COPYRIGHT			: (c)CSIR 2007-2019 all rights resevered
+
+LICENSE				: Software License Agreement (BSD License)
+
+RESTRICTIONS	: Redistribution and use in source and binary forms, with or without 
+								modification, are permitted provided that the following conditions 
+								are met:
+
+								* Redistributions of source code must retain the above copyright notice, 
+								this list of conditions and the following disclaimer.
+								* Redistributions in binary form must reproduce the above copyright notice, 
+								this list of conditions and the following disclaimer in the documentation 
+								and/or other materials provided with the distribution.
+								* Neither the name of the CSIR nor the names of its contributors may be used 
+								to endorse or promote products derived from this software without specific 
+								prior written permission.
+
+								THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+								"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+								LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+								A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+								CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+								EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+								PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+								PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+								LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+								NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+								SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+===========================================================================
+*/
+#ifdef _WINDOWS
+#define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#else
+#include <stdio.h>
+#endif
+
+#include "YUV420IngestConverter.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define YUVIC_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+===========================================================================
+	Row functions. The SSE2 loops take 16 pels at a time and the scalar
+	loops complete the row.
+===========================================================================
+*/
+static inline unsigned char YUVIC_Clip(int x)
+{
+	return( (unsigned char)((x < 0) ? 0 : ((x > 255) ? 255 : x)) );
+}//end YUVIC_Clip.
+
+/// 8 bit samples to 16 bit with an offset.
+static void YUVIC_WidenRow(const unsigned char* pIn, short* pOut, int len, int off, int simd)
+{
+	int x = 0;
+#ifdef YUVIC_HAVE_SSE2
+	if(simd)
+	{
+		__m128i zero	= _mm_setzero_si128();
+		__m128i o			= _mm_set1_epi16((short)off);
+		for(; x <= (len - 16); x += 16)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i *)(pIn + x));
+			_mm_storeu_si128((__m128i *)(pOut + x), _mm_add_epi16(_mm_unpacklo_epi8(a, zero), o));
+			_mm_storeu_si128((__m128i *)(pOut + x + 8), _mm_add_epi16(_mm_unpackhi_epi8(a, zero), o));
+		}//end for x...
+	}//end if simd...
+#endif
+	for(; x < len; x++)
+		pOut[x] = (short)(pIn[x] + off);
+}//end YUVIC_WidenRow.
+
+/// Interleaved NV12 UV samples to 16 bit U and V rows of len samples each.
+static void YUVIC_SplitRow(const unsigned char* pIn, short* pU, short* pV, int len, int off, int simd)
+{
+	int x = 0;
+#ifdef YUVIC_HAVE_SSE2
+	if(simd)
+	{
+		__m128i mask	= _mm_set1_epi16(0x00FF);
+		__m128i o			= _mm_set1_epi16((short)off);
+		for(; x <= (len - 16); x += 16)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i *)(pIn + 2*x));
+			__m128i b = _mm_loadu_si128((const __m128i *)(pIn + 2*x + 16));
+			_mm_storeu_si128((__m128i *)(pU + x), _mm_add_epi16(_mm_and_si128(a, mask), o));
+			_mm_storeu_si128((__m128i *)(pU + x + 8), _mm_add_epi16(_mm_and_si128(b, mask), o));
+			_mm_storeu_si128((__m128i *)(pV + x), _mm_add_epi16(_mm_srli_epi16(a, 8), o));
+			_mm_storeu_si128((__m128i *)(pV + x + 8), _mm_add_epi16(_mm_srli_epi16(b, 8), o));
+		}//end for x...
+	}//end if simd...
+#endif
+	for(; x < len; x++)
+	{
+		pU[x] = (short)(pIn[2*x] + off);
+		pV[x] = (short)(pIn[2*x + 1] + off);
+	}//end for x...
+}//end YUVIC_SplitRow.
+
+/// A pair of packed 4:2:2 rows of width pels to 2 lum rows and 1 row of each chr
+/// averaged over the 2 rows. The lum is the high byte of each pel pair for UYVY.
+static void YUVIC_UnpackRows(const unsigned char* p0, const unsigned char* p1, short* pY0, short* pY1, short* pU, short* pV, int width, int off, int uyvy, int simd)
+{
+	int x = 0;
+	int l = uyvy ? 1 : 0;
+	int c = 1 - l;
+#ifdef YUVIC_HAVE_SSE2
+	if(simd)
+	{
+		__m128i mask	= _mm_set1_epi16(0x00FF);
+		__m128i lo		= _mm_set1_epi32(0x0000FFFF);
+		__m128i o			= _mm_set1_epi16((short)off);
+		for(; x <= (width - 16); x += 16)
+		{
+			__m128i a0 = _mm_loadu_si128((const __m128i *)(p0 + 2*x));
+			__m128i a1 = _mm_loadu_si128((const __m128i *)(p0 + 2*x + 16));
+			__m128i b0 = _mm_loadu_si128((const __m128i *)(p1 + 2*x));
+			__m128i b1 = _mm_loadu_si128((const __m128i *)(p1 + 2*x + 16));
+			__m128i ya0, ya1, yb0, yb1, c0, c1;
+			if(uyvy)
+			{
+				ya0 = _mm_srli_epi16(a0, 8); ya1 = _mm_srli_epi16(a1, 8);
+				yb0 = _mm_srli_epi16(b0, 8); yb1 = _mm_srli_epi16(b1, 8);
+				c0	= _mm_avg_epu16(_mm_and_si128(a0, mask), _mm_and_si128(b0, mask));
+				c1	= _mm_avg_epu16(_mm_and_si128(a1, mask), _mm_and_si128(b1, mask));
+			}//end if uyvy...
+			else
+			{
+				ya0 = _mm_and_si128(a0, mask); ya1 = _mm_and_si128(a1, mask);
+				yb0 = _mm_and_si128(b0, mask); yb1 = _mm_and_si128(b1, mask);
+				c0	= _mm_avg_epu16(_mm_srli_epi16(a0, 8), _mm_srli_epi16(b0, 8));
+				c1	= _mm_avg_epu16(_mm_srli_epi16(a1, 8), _mm_srli_epi16(b1, 8));
+			}//end else...
+			_mm_storeu_si128((__m128i *)(pY0 + x), ya0);
+			_mm_storeu_si128((__m128i *)(pY0 + x + 8), ya1);
+			_mm_storeu_si128((__m128i *)(pY1 + x), yb0);
+			_mm_storeu_si128((__m128i *)(pY1 + x + 8), yb1);
+			/// The averaged chr words alternate U, V.
+			__m128i u = _mm_packs_epi32(_mm_and_si128(c0, lo), _mm_and_si128(c1, lo));
+			__m128i v = _mm_packs_epi32(_mm_srli_epi32(c0, 16), _mm_srli_epi32(c1, 16));
+			_mm_storeu_si128((__m128i *)(pU + x/2), _mm_add_epi16(u, o));
+			_mm_storeu_si128((__m128i *)(pV + x/2), _mm_add_epi16(v, o));
+		}//end for x...
+	}//end if simd...
+#endif
+	for(; x < width; x += 2)
+	{
+		const unsigned char* a = p0 + 2*x;
+		const unsigned char* b = p1 + 2*x;
+		pY0[x]			= a[l];
+		pY0[x + 1]	= a[l + 2];
+		pY1[x]			= b[l];
+		pY1[x + 1]	= b[l + 2];
+		pU[x/2]			= (short)(((a[c] + b[c] + 1) >> 1) + off);
+		pV[x/2]			= (short)(((a[c + 2] + b[c + 2] + 1) >> 1) + off);
+	}//end for x...
+}//end YUVIC_UnpackRows.
+
+/// 16 bit samples less an offset to saturated 8 bit samples.
+static void YUVIC_NarrowRow(const short* pIn, unsigned char* pOut, int len, int off, int simd)
+{
+	int x = 0;
+#ifdef YUVIC_HAVE_SSE2
+	if(simd)
+	{
+		__m128i o = _mm_set1_epi16((short)off);
+		for(; x <= (len - 16); x += 16)
+		{
+			__m128i a = _mm_subs_epi16(_mm_loadu_si128((const __m128i *)(pIn + x)), o);
+			__m128i b = _mm_subs_epi16(_mm_loadu_si128((const __m128i *)(pIn + x + 8)), o);
+			_mm_storeu_si128((__m128i *)(pOut + x), _mm_packus_epi16(a, b));
+		}//end for x...
+	}//end if simd...
+#endif
+	for(; x < len; x++)
+		pOut[x] = YUVIC_Clip(pIn[x] - off);
+}//end YUVIC_NarrowRow.
+
+/// 16 bit U and V rows of len samples to an interleaved NV12 UV row.
+static void YUVIC_MergeRow(const short* pU, const short* pV, unsigned char* pOut, int len, int off, int simd)
+{
+	int x = 0;
+#ifdef YUVIC_HAVE_SSE2
+	if(simd)
+	{
+		__m128i o = _mm_set1_epi16((short)off);
+		for(; x <= (len - 16); x += 16)
+		{
+			__m128i u = _mm_packus_epi16(_mm_subs_epi16(_mm_loadu_si128((const __m128i *)(pU + x)), o), _mm_subs_epi16(_mm_loadu_si128((const __m128i *)(pU + x + 8)), o));
+			__m128i v = _mm_packus_epi16(_mm_subs_epi16(_mm_loadu_si128((const __m128i *)(pV + x)), o), _mm_subs_epi16(_mm_loadu_si128((const __m128i *)(pV + x + 8)), o));
+			_mm_storeu_si128((__m128i *)(pOut + 2*x), _mm_unpacklo_epi8(u, v));
+			_mm_storeu_si128((__m128i *)(pOut + 2*x + 16), _mm_unpackhi_epi8(u, v));
+		}//end for x...
+	}//end if simd...
+#endif
+	for(; x < len; x++)
+	{
+		pOut[2*x]			= YUVIC_Clip(pU[x] - off);
+		pOut[2*x + 1]	= YUVIC_Clip(pV[x] - off);
+	}//end for x...
+}//end YUVIC_MergeRow.
+
+/// A lum row of width pels and a chr row of each of U and V to a packed 4:2:2 row.
+static void YUVIC_PackRow(const short* pY, const short* pU, const short* pV, unsigned char* pOut, int width, int off, int uyvy, int simd)
+{
+	int x = 0;
+	int l = uyvy ? 1 : 0;
+	int c = 1 - l;
+#ifdef YUVIC_HAVE_SSE2
+	if(simd)
+	{
+		__m128i o = _mm_set1_epi16((short)off);
+		for(; x <= (width - 16); x += 16)
+		{
+			__m128i y		= _mm_packus_epi16(_mm_loadu_si128((const __m128i *)(pY + x)), _mm_loadu_si128((const __m128i *)(pY + x + 8)));
+			__m128i u		= _mm_subs_epi16(_mm_loadu_si128((const __m128i *)(pU + x/2)), o);
+			__m128i v		= _mm_subs_epi16(_mm_loadu_si128((const __m128i *)(pV + x/2)), o);
+			__m128i uv	= _mm_unpacklo_epi8(_mm_packus_epi16(u, u), _mm_packus_epi16(v, v));
+			if(uyvy)
+			{
+				_mm_storeu_si128((__m128i *)(pOut + 2*x), _mm_unpacklo_epi8(uv, y));
+				_mm_storeu_si128((__m128i *)(pOut + 2*x + 16), _mm_unpackhi_epi8(uv, y));
+			}//end if uyvy...
+			else
+			{
+				_mm_storeu_si128((__m128i *)(pOut + 2*x), _mm_unpacklo_epi8(y, uv));
+				_mm_storeu_si128((__m128i *)(pOut + 2*x + 16), _mm_unpackhi_epi8(y, uv));
+			}//end else...
+		}//end for x...
+	}//end if simd...
+#endif
+	for(; x < width; x += 2)
+	{
+		unsigned char* p = pOut + 2*x;
+		p[l]			= YUVIC_Clip(pY[x]);
+		p[l + 2]	= YUVIC_Clip(pY[x + 1]);
+		p[c]			= YUVIC_Clip(pU[x/2] - off);
+		p[c + 2]	= YUVIC_Clip(pV[x/2] - off);
+	}//end for x...
+}//end YUVIC_PackRow.
+
+/*
+===========================================================================
+	Interface Methods.
+===========================================================================
+*/
+/** Convert an 8 bit image into 16 bit YUV420 planes.
+The out planes are typically the codec input image buffers and are written
+in place.
+@param pIn				: 8 bit image in the current format.
+@param inStride		: Bytes per lum row for I420 and NV12 or per packed row for YUY2 and UYVY. 0 = packed.
+@param pY					: Out lum plane.
+@param pU					: Out U chr plane.
+@param pV					: Out V chr plane.
+@param outStride	: Samples per out lum row. The chr rows are half.
+@return						: none.
+*/
+void YUV420IngestConverter::Convert(const void* pIn, int inStride, yuvType* pY, yuvType* pU, yuvType* pV, int outStride)
+{
+	const unsigned char* pSrc = (const unsigned char *)pIn;
+	int chrWidth	= _width/2;
+	int chrHeight	= _height/2;
+	int chrStride	= outStride/2;
+	int off				= _chrOff - 128;
+	int y;
+
+	if((_format == YUVIC_YUY2)||(_format == YUVIC_UYVY))
+	{
+		int s = inStride ? inStride : (2 * _width);
+		for(y = 0; y < chrHeight; y++)
+			YUVIC_UnpackRows(pSrc + (2*y)*s, pSrc + (2*y + 1)*s, pY + (2*y)*outStride, pY + (2*y + 1)*outStride,
+											 pU + y*chrStride, pV + y*chrStride, _width, off, (_format == YUVIC_UYVY), _simd);
+		return;
+	}//end if YUY2...
+
+	/// Lum plane is common to I420 and NV12.
+	int s = inStride ? inStride : _width;
+	for(y = 0; y < _height; y++)
+		YUVIC_WidenRow(pSrc + y*s, pY + y*outStride, _width, 0, _simd);
+	pSrc += s * _height;
+
+	if(_format == YUVIC_NV12)
+	{
+		for(y = 0; y < chrHeight; y++)
+			YUVIC_SplitRow(pSrc + y*s, pU + y*chrStride, pV + y*chrStride, chrWidth, off, _simd);
+	}//end if NV12...
+	else
+	{
+		int cs = s/2;
+		for(y = 0; y < chrHeight; y++)
+			YUVIC_WidenRow(pSrc + y*cs, pU + y*chrStride, chrWidth, off, _simd);
+		pSrc += cs * chrHeight;
+		for(y = 0; y < chrHeight; y++)
+			YUVIC_WidenRow(pSrc + y*cs, pV + y*chrStride, chrWidth, off, _simd);
+	}//end else...
+}//end Convert.
+
+/** Export 16 bit YUV420 planes to an 8 bit image.
+The samples are saturated to 8 bits. The chr rows are repeated for the
+4:2:2 packed formats.
+@param pY					: Lum plane.
+@param pU					: U chr plane.
+@param pV					: V chr plane.
+@param inStride		: Samples per lum row. The chr rows are half.
+@param pOut				: 8 bit image in the current format.
+@param outStride	: Bytes per lum row for I420 and NV12 or per packed row for YUY2 and UYVY. 0 = packed.
+@return						: none.
+*/
+void YUV420IngestConverter::Export(const yuvType* pY, const yuvType* pU, const yuvType* pV, int inStride, void* pOut, int outStride)
+{
+	unsigned char* pDst = (unsigned char *)pOut;
+	int chrWidth	= _width/2;
+	int chrHeight	= _height/2;
+	int chrStride	= inStride/2;
+	int off				= _chrOff - 128;
+	int y;
+
+	if((_format == YUVIC_YUY2)||(_format == YUVIC_UYVY))
+	{
+		int s = outStride ? outStride : (2 * _width);
+		for(y = 0; y < _height; y++)
+			YUVIC_PackRow(pY + y*inStride, pU + (y/2)*chrStride, pV + (y/2)*chrStride, pDst + y*s, _width, off, (_format == YUVIC_UYVY), _simd);
+		return;
+	}//end if YUY2...
+
+	int s = outStride ? outStride : _width;
+	for(y = 0; y < _height; y++)
+		YUVIC_NarrowRow(pY + y*inStride, pDst + y*s, _width, 0, _simd);
+	pDst += s * _height;
+
+	if(_format == YUVIC_NV12)
+	{
+		for(y = 0; y < chrHeight; y++)
+			YUVIC_MergeRow(pU + y*chrStride, pV + y*chrStride, pDst + y*s, chrWidth, off, _simd);
+	}//end if NV12...
+	else
+	{
+		int cs = s/2;
+		for(y = 0; y < chrHeight; y++)
+			YUVIC_NarrowRow(pU + y*chrStride, pDst + y*cs, chrWidth, off, _simd);
+		pDst += cs * chrHeight;
+		for(y = 0; y < chrHeight; y++)
+			YUVIC_NarrowRow(pV + y*chrStride, pDst + y*cs, chrWidth, off, _simd);
+	}//end else...
+}//end Export.
+